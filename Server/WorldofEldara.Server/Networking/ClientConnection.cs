@@ -1,6 +1,7 @@
 using System;
 using System.Collections.Concurrent;
 using System.Collections.Generic;
+using System.Diagnostics;
 using System.Linq;
 using System.Net.Sockets;
 using System.Threading.Tasks;
@@ -16,7 +17,6 @@ using WorldofEldara.Shared.Data.Quest;
 using WorldofEldara.Shared.Protocol;
 using WorldofEldara.Shared.Protocol.Packets;
 using WorldofEldara.Shared.Data.World;
-using ProtocolEntityType = WorldofEldara.Shared.Protocol.Packets.EntityType;
 
 namespace WorldofEldara.Server.Networking;
 
@@ -27,13 +27,18 @@ namespace WorldofEldara.Server.Networking;
 public class ClientConnection
 {
     private readonly object _sendLock = new();
-    private readonly Queue<byte[]> _sendQueue = new();
+    private readonly object _queueLock = new();
+    private readonly Queue<QueuedPacket>[] _sendQueues = CreateSendQueues();
+    private readonly TrafficClassStats[] _trafficStats = CreateTrafficStats();
     private readonly NetworkServer _server;
     private readonly NetworkStream _stream;
 
     private readonly TcpClient _tcpClient;
     private readonly WorldSimulation _worldSimulation;
 
+    private readonly object _interestLock = new();
+    private HashSet<ulong> _dormantEntityIds = new();
+
     private bool _isConnected = true;
     private Thread? _receiveThread;
 
@@ -55,6 +60,28 @@ public class ClientConnection
     public ulong? AccountId { get; private set; }
     public ulong? PlayerEntityId { get; private set; }
     public string? CurrentZoneId { get; private set; }
+    public string? SessionToken { get; private set; }
+
+    /// <summary>
+    ///     Flat codec version negotiated at login (0 = MessagePack only for every packet).
+    /// </summary>
+    public byte FlatCodecVersion { get; private set; }
+
+    /// <summary>
+    ///     Client-reported interest radius in cm (0 = no report yet, treat as unlimited).
+    /// </summary>
+    public float InterestRadius { get; private set; }
+
+    /// <summary>
+    ///     True if the client reported this entity as dormant and would drop its movement updates.
+    /// </summary>
+    public bool IsEntityDormant(ulong entityId)
+    {
+        lock (_interestLock)
+        {
+            return _dormantEntityIds.Contains(entityId);
+        }
+    }
 
     public void Start()
     {
@@ -73,6 +100,10 @@ public class ClientConnection
         Log.Information($"Disconnecting client [{ConnectionId}]: {reason}");
         _isConnected = false;
 
+        foreach (var stats in GetTrafficStats().Where(stats => stats.SentPackets > 0))
+            Log.Debug(
+                $"Send queue [{ConnectionId}] {stats.Class}: {stats.SentPackets} packets, avg wait {stats.AverageWaitMs:F2} ms, max {stats.MaxWaitMs:F2} ms");
+
         try
         {
             _stream.Close();
@@ -86,46 +117,119 @@ public class ClientConnection
         _server.OnClientDisconnected(ConnectionId);
     }
 
+    /// <summary>
+    ///     Send the flat encoding when this client negotiated it and one was provided, MessagePack otherwise.
+    /// </summary>
+    public void SendPacket(byte[] data, byte[]? flatData)
+    {
+        SendPacket(flatData != null && FlatCodecVersion > 0 ? flatData : data);
+    }
+
     public void SendPacket(byte[] data)
     {
         if (!_isConnected) return;
 
-        lock (_sendLock)
+        var trafficClass = PacketTraffic.Classify(data);
+        lock (_queueLock)
         {
-            _sendQueue.Enqueue(data);
+            _sendQueues[(int)trafficClass].Enqueue(new QueuedPacket(data, Stopwatch.GetTimestamp()));
         }
 
-        // Send immediately
+        // Send immediately (or leave it to whichever thread is already writing)
         ProcessSendQueue();
     }
 
+    /// <summary>
+    ///     Per-traffic-class queue wait metrics for this connection.
+    /// </summary>
+    public TrafficClassStats[] GetTrafficStats()
+    {
+        lock (_queueLock)
+        {
+            return _trafficStats.Select(stats => stats with { }).ToArray();
+        }
+    }
+
     private void ProcessSendQueue()
     {
-        lock (_sendLock)
+        while (true)
         {
-            while (_sendQueue.Count > 0 && _isConnected)
+            // One writer at a time. A sender that finds the writer busy returns at once; the writer
+            // picks its packet up in priority order, so combat and movement overtake a queued
+            // snapshot or chat burst instead of waiting behind it.
+            if (!Monitor.TryEnter(_sendLock)) return;
+
+            try
             {
-                var data = _sendQueue.Dequeue();
+                while (_isConnected && TryDequeueNext(out var data))
+                    try
+                    {
+                        // Write packet length (4 bytes)
+                        var lengthBytes = BitConverter.GetBytes(data.Length);
+                        _stream.Write(lengthBytes, 0, 4);
 
-                try
-                {
-                    // Write packet length (4 bytes)
-                    var lengthBytes = BitConverter.GetBytes(data.Length);
-                    _stream.Write(lengthBytes, 0, 4);
+                        // Write packet data
+                        _stream.Write(data, 0, data.Length);
+                    }
+                    catch (Exception ex)
+                    {
+                        Log.Error(ex, $"Error sending packet to [{ConnectionId}]");
+                        Disconnect("Send error");
+                        return;
+                    }
+            }
+            finally
+            {
+                Monitor.Exit(_sendLock);
+            }
 
-                    // Write packet data
-                    _stream.Write(data, 0, data.Length);
-                }
-                catch (Exception ex)
-                {
-                    Log.Error(ex, $"Error sending packet to [{ConnectionId}]");
-                    Disconnect("Send error");
-                    break;
-                }
+            // A packet queued between our last dequeue and releasing the writer would otherwise strand
+            lock (_queueLock)
+            {
+                if (!_isConnected || _sendQueues.All(queue => queue.Count == 0)) return;
             }
         }
     }
 
+    private bool TryDequeueNext(out byte[] data)
+    {
+        lock (_queueLock)
+        {
+            for (var classIndex = 0; classIndex < _sendQueues.Length; classIndex++)
+            {
+                if (!_sendQueues[classIndex].TryDequeue(out var packet)) continue;
+
+                var waitMs = Stopwatch.GetElapsedTime(packet.EnqueuedAt).TotalMilliseconds;
+                var stats = _trafficStats[classIndex];
+                stats.SentPackets++;
+                stats.TotalWaitMs += waitMs;
+                stats.MaxWaitMs = Math.Max(stats.MaxWaitMs, waitMs);
+
+                data = packet.Data;
+                return true;
+            }
+        }
+
+        data = Array.Empty<byte>();
+        return false;
+    }
+
+    private static Queue<QueuedPacket>[] CreateSendQueues()
+    {
+        var queues = new Queue<QueuedPacket>[PacketTraffic.ClassCount];
+        for (var i = 0; i < queues.Length; i++) queues[i] = new Queue<QueuedPacket>();
+        return queues;
+    }
+
+    private static TrafficClassStats[] CreateTrafficStats()
+    {
+        var stats = new TrafficClassStats[PacketTraffic.ClassCount];
+        for (var i = 0; i < stats.Length; i++) stats[i] = new TrafficClassStats { Class = (TrafficClass)i };
+        return stats;
+    }
+
+    private readonly record struct QueuedPacket(byte[] Data, long EnqueuedAt);
+
     private void ReceiveLoop()
     {
         var lengthBuffer = new byte[4];
@@ -187,6 +291,12 @@ public class ClientConnection
     {
         try
         {
+            if (FlatCodec.IsFlat(data))
+            {
+                ProcessFlatPacket(data);
+                return;
+            }
+
             var packet = MessagePackSerializer.Deserialize<PacketBase>(data);
 
             // Route packet to appropriate handler
@@ -196,6 +306,10 @@ public class ClientConnection
                     HandleLogin(loginRequest);
                     break;
 
+                case AuthPackets.ResumeSessionRequest resumeRequest:
+                    HandleResumeSession(resumeRequest);
+                    break;
+
                 case CharacterPackets.CharacterListRequest listRequest:
                     HandleCharacterListRequest(listRequest);
                     break;
@@ -228,6 +342,10 @@ public class ClientConnection
                     HandleQuestDialogue(dialogueRequest);
                     break;
 
+                case WorldPackets.InterestUpdatePacket interestUpdate:
+                    HandleInterestUpdate(interestUpdate);
+                    break;
+
                 default:
                     Log.Warning($"Unhandled packet type: {packet.GetType().Name}");
                     break;
@@ -239,6 +357,21 @@ public class ClientConnection
         }
     }
 
+    private void ProcessFlatPacket(byte[] data)
+    {
+        var packetType = FlatCodec.GetPacketType(data);
+        if (FlatCodecVersion == 0)
+        {
+            Log.Warning($"Flat {packetType} from [{ConnectionId}] without negotiating the flat codec");
+            return;
+        }
+
+        if (packetType == PacketType.MovementInput && FlatCodec.TryDecodeMovementInput(data, out var movementInput))
+            HandleMovementInput(movementInput);
+        else
+            Log.Warning($"Unhandled or malformed flat packet {packetType} from [{ConnectionId}]");
+    }
+
     // ===== Packet Handlers =====
 
     private void HandleLogin(AuthPackets.LoginRequest request)
@@ -251,17 +384,115 @@ public class ClientConnection
         AccountId = 1000 + ConnectionId; // Fake account ID
         AccountCharacters.TryAdd(AccountId.Value, new List<CharacterData>());
 
+        FlatCodecVersion = request.FlatCodecVersion >= FlatCodec.Version ? FlatCodec.Version : (byte)0;
+
+        SessionToken = Guid.NewGuid().ToString();
+        _server.Sessions.Register(SessionToken, AccountId.Value, ConnectionId, FlatCodecVersion);
+
         var response = new AuthPackets.LoginResponse
         {
             Result = ResponseCode.Success,
             Message = "Login successful",
             AccountId = AccountId.Value,
-            SessionToken = Guid.NewGuid().ToString()
+            SessionToken = SessionToken,
+            FlatCodecVersion = FlatCodecVersion
         };
 
         SendPacket(MessagePackSerializer.Serialize<PacketBase>(response));
     }
 
+    private void HandleResumeSession(AuthPackets.ResumeSessionRequest request)
+    {
+        Log.Information($"Resume session request from [{ConnectionId}] for character {request.CharacterId}");
+
+        if (!ProtocolVersions.Supported.Contains(request.ProtocolVersion))
+        {
+            SendResumeFailure(ResponseCode.InvalidRequest, "Unsupported protocol version");
+            return;
+        }
+
+        var session = _server.Sessions.TryResume(request.SessionToken, request.CharacterId, ConnectionId,
+            out var previousConnectionId);
+        if (session == null)
+        {
+            SendResumeFailure(ResponseCode.NotAuthenticated, "Session expired");
+            return;
+        }
+
+        // Old socket may still look alive if the drop was one-sided; it no longer owns the player
+        if (previousConnectionId.HasValue)
+            _server.CloseConnection(previousConnectionId.Value, "Session resumed on another connection");
+
+        if (_worldSimulation.Entities.GetEntity(session.PlayerEntityId!.Value) is not PlayerEntity player)
+        {
+            _server.Sessions.Remove(session.Token);
+            SendResumeFailure(ResponseCode.NotFound, "Character no longer in world");
+            return;
+        }
+
+        AccountId = session.AccountId;
+        SessionToken = session.Token;
+        FlatCodecVersion = session.FlatCodecVersion;
+        PlayerEntityId = player.EntityId;
+        CurrentZoneId = player.ZoneId;
+        player.ClientConnection = this;
+
+        var zoneEntities = _worldSimulation.Entities.GetEntitiesInZone(player.ZoneId)
+            .Where(e => e.EntityId != player.EntityId)
+            .ToList();
+        var known = new HashSet<ulong>(request.KnownEntityIds);
+        var current = new HashSet<ulong>(zoneEntities.Select(e => e.EntityId));
+
+        SendPacket(MessagePackSerializer.Serialize<PacketBase>(new AuthPackets.ResumeSessionResponse
+        {
+            Result = ResponseCode.Success,
+            Message = "Session resumed",
+            AccountId = session.AccountId,
+            PlayerEntityId = player.EntityId,
+            Position = player.Position,
+            RotationYaw = player.RotationYaw,
+            ServerTime = _worldSimulation.GetServerTimestamp(),
+            DespawnedEntityIds = known.Where(id => !current.Contains(id)).ToList()
+        }));
+
+        // Delta sync in the same flight as the response: fresh state for known entities, full spawns for new ones
+        var serverTime = _worldSimulation.GetServerTimestamp();
+        foreach (var entity in zoneEntities)
+        {
+            if (!known.Contains(entity.EntityId))
+            {
+                SendPacket(MessagePackSerializer.Serialize<PacketBase>(NetworkServer.BuildSpawnPacket(entity)));
+                continue;
+            }
+
+            var update = new MovementPackets.MovementUpdatePacket
+            {
+                EntityId = entity.EntityId,
+                Position = entity.Position,
+                Velocity = entity.Velocity,
+                RotationYaw = entity.RotationYaw,
+                RotationPitch = entity.RotationPitch,
+                State = entity.MovementState,
+                ServerTimestamp = serverTime
+            };
+            SendPacket(FlatCodecVersion > 0
+                ? FlatCodec.Encode(update)
+                : MessagePackSerializer.Serialize<PacketBase>(update));
+        }
+
+        Log.Information($"Player [{ConnectionId}] resumed session as {player.Name} " +
+                        $"({known.Count} known, {zoneEntities.Count} in zone)");
+    }
+
+    private void SendResumeFailure(ResponseCode result, string message)
+    {
+        SendPacket(MessagePackSerializer.Serialize<PacketBase>(new AuthPackets.ResumeSessionResponse
+        {
+            Result = result,
+            Message = message
+        }));
+    }
+
     private void HandleCharacterListRequest(CharacterPackets.CharacterListRequest request)
     {
         Log.Debug($"Character list request from [{ConnectionId}]");
@@ -443,6 +674,7 @@ public class ClientConnection
         _worldSimulation.Entities.AddEntity(playerEntity);
         PlayerEntityId = playerEntity.EntityId;
         CurrentZoneId = character.Position.ZoneId;
+        if (SessionToken != null) _server.Sessions.BindCharacter(SessionToken, character.CharacterId, playerEntity.EntityId);
 
         // Send success response
         var selectResponse = new CharacterPackets.SelectCharacterResponse
@@ -487,33 +719,7 @@ public class ClientConnection
         // Send existing entities in the same zone to the player for initial sync
         foreach (var entity in _worldSimulation.Entities.GetEntitiesInZone(playerEntity.ZoneId)
                      .Where(e => e.EntityId != playerEntity.EntityId))
-        {
-            var spawn = new WorldPackets.EntitySpawnPacket
-            {
-                EntityId = entity.EntityId,
-                Type = (ProtocolEntityType)(int)entity.GetEntityType(),
-                Name = entity.Name,
-                Position = entity.Position,
-                RotationYaw = entity.RotationYaw
-            };
-
-            if (entity is PlayerEntity otherPlayer) spawn.CharacterData = otherPlayer.CharacterData;
-            if (entity is NPCEntity npc)
-                spawn.NPCData = new NPCData
-                {
-                    NPCTemplateId = npc.NPCTemplateId,
-                    Name = npc.Name,
-                    Level = npc.Level,
-                    Faction = npc.Faction,
-                    IsHostile = npc.IsHostile,
-                    IsQuestGiver = npc.IsQuestGiver,
-                    IsVendor = npc.IsVendor,
-                    MaxHealth = npc.MaxHealth,
-                    CurrentHealth = npc.CurrentHealth
-                };
-
-            SendPacket(MessagePackSerializer.Serialize<PacketBase>(spawn));
-        }
+            SendPacket(MessagePackSerializer.Serialize<PacketBase>(NetworkServer.BuildSpawnPacket(entity)));
 
         Log.Information($"Player [{ConnectionId}] entered world as {character.Name}");
     }
@@ -591,12 +797,14 @@ public class ClientConnection
             ServerTimestamp = _worldSimulation.GetServerTimestamp()
         };
 
+        // Both encodings are built once and shared by every recipient
         var serialized = MessagePackSerializer.Serialize<PacketBase>(movementUpdate);
+        var flat = FlatCodec.Encode(movementUpdate);
 
         // Send authoritative update back to mover and broadcast to others in zone
-        SendPacket(serialized);
+        SendPacket(serialized, flat);
         if (CurrentZoneId != null)
-            _server.BroadcastToZone(CurrentZoneId, serialized, ConnectionId);
+            _server.BroadcastToZone(CurrentZoneId, serialized, flat, ConnectionId);
     }
 
     private void HandleUseAbility(CombatPackets.UseAbilityRequest packet)
@@ -734,6 +942,20 @@ public class ClientConnection
         _server.BroadcastToZone(CurrentZoneId, serialized);
     }
 
+    private void HandleInterestUpdate(WorldPackets.InterestUpdatePacket packet)
+    {
+        if (!PlayerEntityId.HasValue) return;
+
+        var dormant = new HashSet<ulong>(packet.DormantEntityIds);
+        lock (_interestLock)
+        {
+            InterestRadius = Math.Max(0f, packet.InterestRadius);
+            _dormantEntityIds = dormant;
+        }
+
+        Log.Debug($"Interest update from [{ConnectionId}]: radius {InterestRadius:F0}, {dormant.Count} dormant entities");
+    }
+
     private void HandleQuestAccept(QuestPackets.QuestAcceptRequest request)
     {
         if (!PlayerEntityId.HasValue) return;
@@ -1154,3 +1376,15 @@ public class ClientConnection
     }
 
 }
+
+/// <summary>
+///     Send-queue wait metrics for one traffic class of a connection.
+/// </summary>
+public record TrafficClassStats
+{
+    public TrafficClass Class { get; init; }
+    public long SentPackets { get; set; }
+    public double TotalWaitMs { get; set; }
+    public double MaxWaitMs { get; set; }
+    public double AverageWaitMs => SentPackets > 0 ? TotalWaitMs / SentPackets : 0;
+}
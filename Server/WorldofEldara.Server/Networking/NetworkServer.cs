@@ -30,6 +30,7 @@ public class NetworkServer
     private readonly WorldSimulation _worldSimulation;
     private Thread? _acceptThread;
     private bool _isRunning;
+    private Timer? _sessionSweepTimer;
 
     private TcpListener? _listener;
 
@@ -42,6 +43,11 @@ public class NetworkServer
         _worldSimulation = worldSimulation;
     }
 
+    /// <summary>
+    ///     Session tokens issued at login, used for fast reconnect
+    /// </summary>
+    public SessionRegistry Sessions { get; } = new();
+
     public async Task Initialize()
     {
         Log.Information("Network server initialized");
@@ -74,6 +80,10 @@ public class NetworkServer
             };
             _acceptThread.Start();
 
+            // Players of dropped sessions stay in the world until their resume window runs out
+            _sessionSweepTimer = new Timer(_ => SweepExpiredSessions(), null, TimeSpan.FromSeconds(5),
+                TimeSpan.FromSeconds(5));
+
             await Task.CompletedTask;
         }
         catch (Exception ex)
@@ -92,6 +102,8 @@ public class NetworkServer
 
         // Stop listener
         _listener?.Stop();
+        _sessionSweepTimer?.Dispose();
+        _sessionSweepTimer = null;
 
         // Disconnect all clients
         foreach (var connection in _connections.Values) connection.Disconnect("Server shutting down");
@@ -168,12 +180,54 @@ public class NetworkServer
         {
             Log.Information($"Connection [{connectionId}] disconnected");
 
+            var token = connection.SessionToken;
+            if (token != null && !Sessions.IsOwnedBy(token, connectionId))
+                // Session was already resumed on another connection, which now owns the player
+                return;
+
+            if (token != null && Sessions.MarkDisconnected(token))
+            {
+                // Keep the player in the world so the client can resume without a full re-login
+                if (connection.PlayerEntityId.HasValue &&
+                    _worldSimulation.Entities.GetEntity(connection.PlayerEntityId.Value) is PlayerEntity player)
+                    player.ClientConnection = null;
+
+                Log.Information($"Session for connection [{connectionId}] parked for resume");
+                return;
+            }
+
             // Remove player entity if exists
             if (connection.PlayerEntityId.HasValue)
                 _worldSimulation.Entities.RemoveEntity(connection.PlayerEntityId.Value);
         }
     }
 
+    /// <summary>
+    ///     Close a connection that has been superseded (e.g. by a session resume)
+    /// </summary>
+    internal void CloseConnection(ulong connectionId, string reason)
+    {
+        if (_connections.TryGetValue(connectionId, out var connection)) connection.Disconnect(reason);
+    }
+
+    private void SweepExpiredSessions()
+    {
+        try
+        {
+            foreach (var session in Sessions.RemoveExpired())
+            {
+                if (!session.PlayerEntityId.HasValue) continue;
+
+                Log.Information($"Resume window expired for account {session.AccountId}, removing player entity");
+                _worldSimulation.Entities.RemoveEntity(session.PlayerEntityId.Value);
+            }
+        }
+        catch (Exception ex)
+        {
+            Log.Error(ex, "Failed to sweep expired sessions");
+        }
+    }
+
     /// <summary>
     ///     Broadcast a packet to all connected clients
     /// </summary>
@@ -186,13 +240,22 @@ public class NetworkServer
     ///     Broadcast to all clients in a zone
     /// </summary>
     public void BroadcastToZone(string zoneId, byte[] packetData, ulong? excludeConnectionId = null)
+    {
+        BroadcastToZone(zoneId, packetData, null, excludeConnectionId);
+    }
+
+    /// <summary>
+    ///     Broadcast to all clients in a zone; clients that negotiated the flat codec get flatPacketData
+    /// </summary>
+    public void BroadcastToZone(string zoneId, byte[] packetData, byte[]? flatPacketData,
+        ulong? excludeConnectionId = null)
     {
         foreach (var connection in _connections.Values)
         {
             if (connection.ConnectionId == excludeConnectionId)
                 continue;
 
-            if (connection.CurrentZoneId == zoneId) connection.SendPacket(packetData);
+            if (connection.CurrentZoneId == zoneId) connection.SendPacket(packetData, flatPacketData);
         }
     }
 
@@ -213,38 +276,7 @@ public class NetworkServer
     {
         try
         {
-            var spawnPacket = new WorldPackets.EntitySpawnPacket
-            {
-                EntityId = entity.EntityId,
-                Type = (ProtocolEntityType)(int)entity.GetEntityType(),
-                Name = entity.Name,
-                Position = entity.Position,
-                RotationYaw = entity.RotationYaw
-            };
-
-            if (entity is PlayerEntity player)
-            {
-                spawnPacket.CharacterData = player.CharacterData;
-                spawnPacket.Resources = ResourceSnapshot.FromStats(player.CharacterData.Stats);
-                spawnPacket.AbilityIds = player.KnownAbilities.ToList();
-            }
-            else if (entity is NPCEntity npc)
-            {
-                spawnPacket.NPCData = new NPCData
-                {
-                    NPCTemplateId = npc.NPCTemplateId,
-                    Name = npc.Name,
-                    Level = npc.Level,
-                    Faction = npc.Faction,
-                    IsHostile = npc.IsHostile,
-                    IsQuestGiver = npc.IsQuestGiver,
-                    IsVendor = npc.IsVendor,
-                    MaxHealth = npc.MaxHealth,
-                    CurrentHealth = npc.CurrentHealth
-                };
-            }
-
-            BroadcastToZone(entity.ZoneId, MessagePackSerializer.Serialize<PacketBase>(spawnPacket));
+            BroadcastToZone(entity.ZoneId, MessagePackSerializer.Serialize<PacketBase>(BuildSpawnPacket(entity)));
         }
         catch (Exception ex)
         {
@@ -252,6 +284,45 @@ public class NetworkServer
         }
     }
 
+    /// <summary>
+    ///     Build the spawn packet describing an entity to clients
+    /// </summary>
+    internal static WorldPackets.EntitySpawnPacket BuildSpawnPacket(Entity entity)
+    {
+        var spawnPacket = new WorldPackets.EntitySpawnPacket
+        {
+            EntityId = entity.EntityId,
+            Type = (ProtocolEntityType)(int)entity.GetEntityType(),
+            Name = entity.Name,
+            Position = entity.Position,
+            RotationYaw = entity.RotationYaw
+        };
+
+        if (entity is PlayerEntity player)
+        {
+            spawnPacket.CharacterData = player.CharacterData;
+            spawnPacket.Resources = ResourceSnapshot.FromStats(player.CharacterData.Stats);
+            spawnPacket.AbilityIds = player.KnownAbilities.ToList();
+        }
+        else if (entity is NPCEntity npc)
+        {
+            spawnPacket.NPCData = new NPCData
+            {
+                NPCTemplateId = npc.NPCTemplateId,
+                Name = npc.Name,
+                Level = npc.Level,
+                Faction = npc.Faction,
+                IsHostile = npc.IsHostile,
+                IsQuestGiver = npc.IsQuestGiver,
+                IsVendor = npc.IsVendor,
+                MaxHealth = npc.MaxHealth,
+                CurrentHealth = npc.CurrentHealth
+            };
+        }
+
+        return spawnPacket;
+    }
+
     private void OnEntityRemoved(Entity entity)
     {
         try
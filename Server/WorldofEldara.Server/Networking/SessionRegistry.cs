@@ -0,0 +1,136 @@
+using System.Collections.Concurrent;
+
+namespace WorldofEldara.Server.Networking;
+
+/// <summary>
+///     Tracks session tokens so a client that drops its connection can resume with a single
+///     request instead of logging in and selecting a character again.
+///     The player entity of a dropped session stays in the world for <see cref="ResumeGracePeriod" />.
+/// </summary>
+public class SessionRegistry
+{
+    public static readonly TimeSpan ResumeGracePeriod = TimeSpan.FromSeconds(30);
+
+    private readonly ConcurrentDictionary<string, SessionRecord> _sessions = new();
+
+    public void Register(string token, ulong accountId, ulong connectionId, byte flatCodecVersion)
+    {
+        _sessions[token] = new SessionRecord
+        {
+            Token = token,
+            AccountId = accountId,
+            ConnectionId = connectionId,
+            FlatCodecVersion = flatCodecVersion
+        };
+    }
+
+    public void BindCharacter(string token, ulong characterId, ulong playerEntityId)
+    {
+        if (!_sessions.TryGetValue(token, out var session)) return;
+
+        lock (session)
+        {
+            session.CharacterId = characterId;
+            session.PlayerEntityId = playerEntityId;
+        }
+    }
+
+    /// <summary>
+    ///     True if this connection still owns the session (it has not been resumed elsewhere).
+    /// </summary>
+    public bool IsOwnedBy(string token, ulong connectionId)
+    {
+        if (!_sessions.TryGetValue(token, out var session)) return false;
+
+        lock (session)
+        {
+            return session.ConnectionId == connectionId;
+        }
+    }
+
+    /// <summary>
+    ///     Start the resume grace period for a dropped connection.
+    ///     Returns false if the session has no player in the world (nothing worth keeping).
+    /// </summary>
+    public bool MarkDisconnected(string token)
+    {
+        if (!_sessions.TryGetValue(token, out var session)) return false;
+
+        lock (session)
+        {
+            if (!session.PlayerEntityId.HasValue)
+            {
+                _sessions.TryRemove(token, out _);
+                return false;
+            }
+
+            session.DisconnectedAt = DateTime.UtcNow;
+            return true;
+        }
+    }
+
+    /// <summary>
+    ///     Claim a session for a new connection.
+    ///     Returns null if the token is unknown, expired or bound to a different character.
+    /// </summary>
+    public SessionRecord? TryResume(string token, ulong characterId, ulong connectionId, out ulong? previousConnectionId)
+    {
+        previousConnectionId = null;
+        if (string.IsNullOrEmpty(token) || !_sessions.TryGetValue(token, out var session)) return null;
+
+        lock (session)
+        {
+            if (session.CharacterId != characterId || !session.PlayerEntityId.HasValue) return null;
+
+            if (session.DisconnectedAt.HasValue && DateTime.UtcNow - session.DisconnectedAt.Value > ResumeGracePeriod)
+                return null;
+
+            // The old connection may not have noticed the drop yet; the caller closes it
+            if (!session.DisconnectedAt.HasValue && session.ConnectionId != connectionId)
+                previousConnectionId = session.ConnectionId;
+
+            session.ConnectionId = connectionId;
+            session.DisconnectedAt = null;
+            return session;
+        }
+    }
+
+    /// <summary>
+    ///     Remove sessions whose grace period has elapsed and return them so their players can be removed.
+    /// </summary>
+    public List<SessionRecord> RemoveExpired()
+    {
+        var now = DateTime.UtcNow;
+        var expired = new List<SessionRecord>();
+
+        foreach (var session in _sessions.Values)
+        {
+            lock (session)
+            {
+                // Checked under the lock so a concurrent resume cannot be expired out from under it
+                if (!session.DisconnectedAt.HasValue || now - session.DisconnectedAt.Value <= ResumeGracePeriod)
+                    continue;
+
+                if (_sessions.TryRemove(session.Token, out var removed)) expired.Add(removed);
+            }
+        }
+
+        return expired;
+    }
+
+    public void Remove(string token)
+    {
+        _sessions.TryRemove(token, out _);
+    }
+}
+
+public class SessionRecord
+{
+    public string Token { get; init; } = string.Empty;
+    public ulong AccountId { get; init; }
+    public byte FlatCodecVersion { get; init; }
+    public ulong ConnectionId { get; set; }
+    public ulong? CharacterId { get; set; }
+    public ulong? PlayerEntityId { get; set; }
+    public DateTime? DisconnectedAt { get; set; }
+}
@@ -0,0 +1,153 @@
+using System;
+using System.Runtime.CompilerServices;
+using System.Runtime.InteropServices;
+using WorldofEldara.Shared.Protocol.Packets;
+
+namespace WorldofEldara.Shared.Protocol;
+
+/// <summary>
+///     Fixed-layout binary encoding for the tick-rate movement packets (MovementInput, MovementUpdate).
+///     A flat payload is [Marker, Version, PacketType (ushort LE)] followed by a packed little-endian body.
+///     Marker 0xC1 is never emitted by MessagePack, so both encodings share the same length-prefixed stream.
+///     Only used once both sides agreed on a version at login.
+///     Layouts must match Source/Eldara/Networking/EldaraFlatCodec.h on the client.
+/// </summary>
+public static class FlatCodec
+{
+    public const byte Marker = 0xC1;
+    public const byte Version = 1;
+    public const int HeaderSize = 4;
+
+    private const byte JumpFlag = 1;
+    private const byte SprintFlag = 2;
+
+    static FlatCodec()
+    {
+        if (!BitConverter.IsLittleEndian)
+            throw new PlatformNotSupportedException("Flat packet bodies assume a little-endian host");
+
+        if (Unsafe.SizeOf<Header>() != HeaderSize || Unsafe.SizeOf<MovementInputBody>() != 41 ||
+            Unsafe.SizeOf<MovementUpdateBody>() != 49)
+            throw new InvalidOperationException("Flat packet layout no longer matches the client");
+    }
+
+    public static bool IsFlat(ReadOnlySpan<byte> payload)
+    {
+        return payload.Length >= HeaderSize && payload[0] == Marker;
+    }
+
+    /// <summary>Packet type of a flat payload; call IsFlat first</summary>
+    public static PacketType GetPacketType(ReadOnlySpan<byte> payload)
+    {
+        return (PacketType)(payload[2] | (payload[3] << 8));
+    }
+
+    public static bool TryDecodeMovementInput(ReadOnlySpan<byte> payload,
+        out MovementPackets.MovementInputPacket packet)
+    {
+        packet = null!;
+        if (!TryReadBody(payload, PacketType.MovementInput, out MovementInputBody body)) return false;
+
+        packet = new MovementPackets.MovementInputPacket
+        {
+            InputSequence = body.InputSequence,
+            DeltaTime = body.DeltaTime,
+            Input = new MovementInput
+            {
+                Forward = body.Forward,
+                Strafe = body.Strafe,
+                Jump = (body.Flags & JumpFlag) != 0,
+                Sprint = (body.Flags & SprintFlag) != 0,
+                LookYaw = body.LookYaw,
+                LookPitch = body.LookPitch
+            },
+            PredictedPosition = new Vector3(body.PredictedX, body.PredictedY, body.PredictedZ),
+            PredictedRotationYaw = body.PredictedRotationYaw
+        };
+        return true;
+    }
+
+    public static byte[] Encode(MovementPackets.MovementUpdatePacket packet)
+    {
+        var body = new MovementUpdateBody
+        {
+            EntityId = packet.EntityId,
+            PositionX = packet.Position.X,
+            PositionY = packet.Position.Y,
+            PositionZ = packet.Position.Z,
+            VelocityX = packet.Velocity.X,
+            VelocityY = packet.Velocity.Y,
+            VelocityZ = packet.Velocity.Z,
+            RotationYaw = packet.RotationYaw,
+            RotationPitch = packet.RotationPitch,
+            State = (byte)packet.State,
+            ServerTimestamp = packet.ServerTimestamp
+        };
+
+        var data = new byte[HeaderSize + Unsafe.SizeOf<MovementUpdateBody>()];
+        WriteHeader(data, PacketType.MovementUpdate);
+        MemoryMarshal.Write(data.AsSpan(HeaderSize), in body);
+        return data;
+    }
+
+    private static void WriteHeader(Span<byte> data, PacketType packetType)
+    {
+        var header = new Header { Marker = Marker, Version = Version, PacketType = (ushort)packetType };
+        MemoryMarshal.Write(data, in header);
+    }
+
+    private static bool TryReadBody<T>(ReadOnlySpan<byte> payload, PacketType expectedType, out T body)
+        where T : struct
+    {
+        body = default;
+        if (!IsFlat(payload)) return false;
+
+        var header = MemoryMarshal.Read<Header>(payload);
+        if (header.Version != Version || header.PacketType != (ushort)expectedType ||
+            payload.Length < HeaderSize + Unsafe.SizeOf<T>())
+            return false;
+
+        body = MemoryMarshal.Read<T>(payload[HeaderSize..]);
+        return true;
+    }
+
+    [StructLayout(LayoutKind.Sequential, Pack = 1)]
+    private struct Header
+    {
+        public byte Marker;
+        public byte Version;
+        public ushort PacketType;
+    }
+
+    [StructLayout(LayoutKind.Sequential, Pack = 1)]
+    private struct MovementInputBody
+    {
+        public uint InputSequence;
+        public float DeltaTime;
+        public float Forward;
+        public float Strafe;
+        public byte Flags;
+        public float LookYaw;
+        public float LookPitch;
+        public float PredictedX;
+        public float PredictedY;
+        public float PredictedZ;
+        public float PredictedRotationYaw;
+    }
+
+    [StructLayout(LayoutKind.Sequential, Pack = 1)]
+    private struct MovementUpdateBody
+    {
+        public ulong EntityId;
+        public float PositionX;
+        public float PositionY;
+        public float PositionZ;
+        public float VelocityX;
+        public float VelocityY;
+        public float VelocityZ;
+        public float RotationYaw;
+        public float RotationPitch;
+        public byte State;
+        public long ServerTimestamp;
+    }
+}
@@ -11,6 +11,8 @@ namespace WorldofEldara.Shared.Protocol;
 [MessagePackObject]
 [Union((int)PacketType.LoginRequest, typeof(AuthPackets.LoginRequest))]
 [Union((int)PacketType.LoginResponse, typeof(AuthPackets.LoginResponse))]
+[Union((int)PacketType.ResumeSessionRequest, typeof(AuthPackets.ResumeSessionRequest))]
+[Union((int)PacketType.ResumeSessionResponse, typeof(AuthPackets.ResumeSessionResponse))]
 [Union((int)PacketType.CharacterListRequest, typeof(CharacterPackets.CharacterListRequest))]
 [Union((int)PacketType.CharacterListResponse, typeof(CharacterPackets.CharacterListResponse))]
 [Union((int)PacketType.CreateCharacterRequest, typeof(CharacterPackets.CreateCharacterRequest))]
@@ -35,6 +37,7 @@ namespace WorldofEldara.Shared.Protocol;
 [Union((int)PacketType.PlayerSpawn, typeof(WorldPackets.PlayerSpawnPacket))]
 [Union((int)PacketType.EntityDespawn, typeof(WorldPackets.EntityDespawnPacket))]
 [Union((int)PacketType.NPCStateUpdate, typeof(WorldPackets.NPCStateUpdatePacket))]
+[Union((int)PacketType.InterestUpdate, typeof(WorldPackets.InterestUpdatePacket))]
 [Union((int)PacketType.QuestAcceptRequest, typeof(QuestPackets.QuestAcceptRequest))]
 [Union((int)PacketType.QuestAcceptResponse, typeof(QuestPackets.QuestAcceptResponse))]
 [Union((int)PacketType.QuestProgressUpdate, typeof(QuestPackets.QuestProgressUpdate))]
@@ -72,6 +75,8 @@ public enum PacketType : ushort
     CreateCharacterResponse = 5,
     SelectCharacterRequest = 6,
     SelectCharacterResponse = 7,
+    ResumeSessionRequest = 8,
+    ResumeSessionResponse = 9,
 
     // Movement (10-19)
     MovementInput = 10,
@@ -99,6 +104,7 @@ public enum PacketType : ushort
     EntityUpdate = 104,
     PlayerSpawn = 105,
     NPCStateUpdate = 106,
+    InterestUpdate = 107,
 
     // Inventory (200-249)
     InventoryUpdate = 200,
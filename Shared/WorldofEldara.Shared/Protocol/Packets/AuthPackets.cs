@@ -17,6 +17,8 @@ public static class AuthPackets
         [Key(2)] public string ClientVersion { get; set; } = string.Empty;
 
         [Key(3)] public string ProtocolVersion { get; set; } = ProtocolVersions.Current;
+
+        [Key(4)] public byte FlatCodecVersion { get; set; } // Highest flat codec version the client speaks; 0 = none
     }
 
     [MessagePackObject]
@@ -31,5 +33,47 @@ public static class AuthPackets
         [Key(3)] public string SessionToken { get; set; } = string.Empty;
 
         [Key(4)] public string ServerProtocolVersion { get; set; } = ProtocolVersions.Current;
+
+        [Key(5)] public byte FlatCodecVersion { get; set; } // Version both sides use for tick-rate packets; 0 = MessagePack only
+    }
+
+    /// <summary>
+    ///     Sent on a fresh socket after a dropped connection to reclaim the session in one round trip.
+    ///     KnownEntityIds lets the server send only what changed while the client was away.
+    /// </summary>
+    [MessagePackObject]
+    public class ResumeSessionRequest : PacketBase
+    {
+        [Key(0)] public string SessionToken { get; set; } = string.Empty;
+
+        [Key(1)] public ulong CharacterId { get; set; }
+
+        [Key(2)] public IReadOnlyList<ulong> KnownEntityIds { get; set; } = Array.Empty<ulong>();
+
+        [Key(3)] public string ProtocolVersion { get; set; } = ProtocolVersions.Current;
+    }
+
+    /// <summary>
+    ///     Resume result. On success the server follows up immediately with EntitySpawn packets for
+    ///     entities the client does not know and MovementUpdate packets for the ones it does.
+    /// </summary>
+    [MessagePackObject]
+    public class ResumeSessionResponse : PacketBase
+    {
+        [Key(0)] public ResponseCode Result { get; set; }
+
+        [Key(1)] public string Message { get; set; } = string.Empty;
+
+        [Key(2)] public ulong AccountId { get; set; }
+
+        [Key(3)] public ulong PlayerEntityId { get; set; }
+
+        [Key(4)] public Vector3 Position { get; set; }
+
+        [Key(5)] public float RotationYaw { get; set; }
+
+        [Key(6)] public long ServerTime { get; set; }
+
+        [Key(7)] public IReadOnlyList<ulong> DespawnedEntityIds { get; set; } = Array.Empty<ulong>();
     }
 }
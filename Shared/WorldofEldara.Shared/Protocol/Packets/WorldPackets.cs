@@ -83,6 +83,19 @@ public static class WorldPackets
 
         [Key(2)] public ulong? TargetEntityId { get; set; }
     }
+
+    /// <summary>
+    ///     Client -> server: area-of-interest report. Lets the server skip updates the client would drop.
+    /// </summary>
+    [MessagePackObject]
+    public class InterestUpdatePacket : PacketBase
+    {
+        [Key(0)] public float FullRateRadius { get; set; }
+
+        [Key(1)] public float InterestRadius { get; set; }
+
+        [Key(2)] public IReadOnlyList<ulong> DormantEntityIds { get; set; } = Array.Empty<ulong>();
+    }
 }
 
 public enum EntityType
@@ -0,0 +1,75 @@
+using System;
+
+namespace WorldofEldara.Shared.Protocol;
+
+/// <summary>
+///     Traffic classes in send/dispatch priority order (highest first).
+///     Must stay in sync with EEldaraTrafficClass on the client.
+/// </summary>
+public enum TrafficClass : byte
+{
+    /// <summary>Login, session resume, character select, zone transitions</summary>
+    Control = 0,
+    Combat = 1,
+    Movement = 2,
+
+    /// <summary>Entity spawn/despawn, NPC state, quest state</summary>
+    World = 3,
+
+    /// <summary>Chat and quest dialogue</summary>
+    Chat = 4,
+
+    /// <summary>Large snapshots such as the quest log</summary>
+    Bulk = 5
+}
+
+public static class PacketTraffic
+{
+    public const int ClassCount = 6;
+
+    public static TrafficClass Classify(PacketType packetType)
+    {
+        return packetType switch
+        {
+            PacketType.MovementInput or PacketType.MovementUpdate or PacketType.PositionCorrection
+                or PacketType.MovementSync => TrafficClass.Movement,
+
+            PacketType.UseAbilityRequest or PacketType.AbilityResult or PacketType.Damage or PacketType.Healing
+                or PacketType.StatusEffect or PacketType.ThreatUpdate or PacketType.CombatEvent => TrafficClass.Combat,
+
+            PacketType.ChatMessage or PacketType.QuestDialogueRequest
+                or PacketType.QuestDialogueResponse => TrafficClass.Chat,
+
+            PacketType.QuestLogSnapshot => TrafficClass.Bulk,
+
+            PacketType.EntitySpawn or PacketType.EntityDespawn or PacketType.EntityUpdate or PacketType.NPCStateUpdate
+                or PacketType.InterestUpdate or PacketType.QuestAcceptRequest or PacketType.QuestAcceptResponse
+                or PacketType.QuestProgressUpdate => TrafficClass.World,
+
+            _ => TrafficClass.Control
+        };
+    }
+
+    /// <summary>
+    ///     Classify a serialized packet by peeking its union key ([key, [fields]]).
+    ///     Flat payloads are classified by their header type.
+    ///     Anything that does not look like a union packet is treated as Control.
+    /// </summary>
+    public static TrafficClass Classify(ReadOnlySpan<byte> payload)
+    {
+        const byte fixArrayOfTwo = 0x92;
+        const byte uint8Marker = 0xcc;
+        const byte uint16Marker = 0xcd;
+
+        if (FlatCodec.IsFlat(payload)) return Classify(FlatCodec.GetPacketType(payload));
+
+        if (payload.Length < 2 || payload[0] != fixArrayOfTwo) return TrafficClass.Control;
+
+        var key = payload[1];
+        if (key <= 0x7f) return Classify((PacketType)key);
+        if (key == uint8Marker && payload.Length >= 3) return Classify((PacketType)payload[2]);
+        if (key == uint16Marker && payload.Length >= 4) return Classify((PacketType)((payload[2] << 8) | payload[3]));
+
+        return TrafficClass.Control;
+    }
+}
@@ -1,16 +1,26 @@
 #include "EldaraAIController.h"
 #include "EldaraAIKeys.h"
+#include "EldaraBehaviorTreeComponent.h"
 #include "BehaviorTree/BehaviorTree.h"
 #include "BehaviorTree/BlackboardComponent.h"
+#include "BrainComponent.h"
 #include "Perception/AIPerceptionComponent.h"
 #include "Perception/AISenseConfig_Sight.h"
 #include "Perception/AISenseConfig_Hearing.h"
 #include "Perception/AISenseConfig_Damage.h"
+#include "Perception/AISense_Sight.h"
+#include "GameFramework/PawnMovementComponent.h"
 #include "../Characters/EldaraCharacterBase.h"
 #include "../Characters/EldaraNPCBase.h"
+#include "Eldara/Combat/EldaraCombatLog.h"
+#include "Engine/World.h"
+#include "TimerManager.h"
 
 AEldaraAIController::AEldaraAIController()
 {
+	// RunBehaviorTree reuses this instead of creating a plain behavior tree component
+	BrainComponent = CreateDefaultSubobject<UEldaraBehaviorTreeComponent>(TEXT("BrainComponent"));
+
 	// Create perception component
 	SetPerceptionComponent(*CreateDefaultSubobject<UAIPerceptionComponent>(TEXT("PerceptionComponent")));
 
@@ -37,6 +47,8 @@ void AEldaraAIController::BeginPlay()
 {
 	Super::BeginPlay();
 
+	ThreatTable.SetHalfLife(ThreatHalfLife);
+
 	if (UAIPerceptionComponent* LocalPerceptionComponent = GetPerceptionComponent())
 	{
 		LocalPerceptionComponent->OnTargetPerceptionUpdated.AddUniqueDynamic(this, &AEldaraAIController::OnTargetPerceptionUpdated);
@@ -59,6 +71,33 @@ void AEldaraAIController::OnPossess(APawn* InPawn)
 
 	// Initialize blackboard keys
 	UpdateBlackboardKeys();
+
+	if (UEldaraAILODSubsystem* LODSubsystem = GetWorld()->GetSubsystem<UEldaraAILODSubsystem>())
+	{
+		LODSubsystem->Register(this);
+	}
+}
+
+void AEldaraAIController::OnUnPossess()
+{
+	if (UEldaraAILODSubsystem* LODSubsystem = GetWorld()->GetSubsystem<UEldaraAILODSubsystem>())
+	{
+		LODSubsystem->Unregister(this);
+	}
+
+	Super::OnUnPossess();
+}
+
+void AEldaraAIController::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UEldaraAILODSubsystem* LODSubsystem = GetWorld()->GetSubsystem<UEldaraAILODSubsystem>())
+	{
+		LODSubsystem->Unregister(this);
+	}
+	GetWorldTimerManager().ClearTimer(ThreatOverrideTimer);
+	GetWorldTimerManager().ClearTimer(ThreatPruneTimer);
+
+	Super::EndPlay(EndPlayReason);
 }
 
 void AEldaraAIController::InitializeBehaviorTree(UBehaviorTree* BehaviorTreeAsset)
@@ -91,48 +130,124 @@ void AEldaraAIController::AddThreat(AActor* ThreatSource, float ThreatAmount)
 		return;
 	}
 
-	float* ExistingThreat = ThreatTable.Find(ThreatSource);
-	if (ExistingThreat)
+	const float Threat = ThreatTable.AddThreat(ThreatSource, ThreatAmount, GetWorld()->GetTimeSeconds());
+
+	UE_LOG(LogTemp, Verbose, TEXT("AddThreat: %s now has %.1f threat from %s"), 
+		*GetName(), Threat, *ThreatSource->GetName());
+
+	if (UEldaraCombatLog* WorldCombatLog = GetCombatLog())
 	{
-		*ExistingThreat += ThreatAmount;
+		WorldCombatLog->RecordThreat(ThreatSource, GetPawn(), ThreatAmount);
 	}
-	else
+
+	RefreshThreatTarget();
+}
+
+AActor* AEldaraAIController::GetHighestThreatTarget()
+{
+	return ThreatTable.GetTopTarget(GetWorld()->GetTimeSeconds());
+}
+
+float AEldaraAIController::GetThreat(AActor* ThreatSource) const
+{
+	return ThreatTable.GetThreat(ThreatSource, GetWorld()->GetTimeSeconds());
+}
+
+void AEldaraAIController::RemoveThreat(AActor* ThreatSource)
+{
+	ThreatTable.RemoveActor(ThreatSource);
+	RefreshThreatTarget();
+}
+
+void AEldaraAIController::Taunt(AActor* Taunter, float Duration)
+{
+	ThreatTable.Taunt(Taunter, Duration, GetWorld()->GetTimeSeconds());
+	RefreshThreatTarget();
+}
+
+void AEldaraAIController::Fixate(AActor* Target, float Duration)
+{
+	ThreatTable.Fixate(Target, Duration, GetWorld()->GetTimeSeconds());
+	RefreshThreatTarget();
+}
+
+bool AEldaraAIController::IsInCombat() const
+{
+	const UWorld* World = GetWorld();
+	return World && ThreatTable.HasTarget(CombatThreatFloor, World->GetTimeSeconds());
+}
+
+void AEldaraAIController::PruneThreat()
+{
+	const double Now = GetWorld()->GetTimeSeconds();
+	for (auto It = LostSightTimes.CreateIterator(); It; ++It)
 	{
-		ThreatTable.Add(ThreatSource, ThreatAmount);
+		if (Now - It.Value() >= LostSightThreatTimeout)
+		{
+			ThreatTable.RemoveActor(It.Key().Get());
+			It.RemoveCurrent();
+		}
 	}
 
-	UE_LOG(LogTemp, Log, TEXT("AddThreat: %s now has %.1f threat from %s"), 
-		*GetName(), ThreatTable[ThreatSource], *ThreatSource->GetName());
+	ThreatTable.Prune(CombatThreatFloor, Now);
+	RefreshThreatTarget();
+}
 
-	// Update blackboard with highest threat target
-	AActor* HighestThreat = GetHighestThreatTarget();
-	if (HighestThreat && GetBlackboardComponent())
+void AEldaraAIController::RefreshThreatTarget()
+{
+	const double Now = GetWorld()->GetTimeSeconds();
+	AActor* TopTarget = ThreatTable.GetTopTarget(Now);
+
+	// Decay never empties the table on its own, so sweep it while anyone is on it
+	if (ThreatTable.Num() == 0)
+	{
+		GetWorldTimerManager().ClearTimer(ThreatPruneTimer);
+		LostSightTimes.Reset();
+	}
+	else if (!GetWorldTimerManager().IsTimerActive(ThreatPruneTimer))
+	{
+		GetWorldTimerManager().SetTimer(ThreatPruneTimer, this, &AEldaraAIController::PruneThreat, FMath::Max(ThreatPruneInterval, 0.1f), true);
+	}
+
+	// Decay scales every entry alike, so only adds, removals and taunt/fixate expiry change the top
+	const double OverrideEndTime = ThreatTable.GetOverrideEndTime();
+	if (OverrideEndTime > Now && !GetWorldTimerManager().IsTimerActive(ThreatOverrideTimer))
 	{
-		GetBlackboardComponent()->SetValueAsObject(EldaraAIKeys::TargetActor, HighestThreat);
-		GetBlackboardComponent()->SetValueAsBool(EldaraAIKeys::IsInCombat, true);
+		GetWorldTimerManager().SetTimer(ThreatOverrideTimer, this, &AEldaraAIController::RefreshThreatTarget, static_cast<float>(OverrideEndTime - Now), false);
 	}
+
+	UBlackboardComponent* LocalBlackboard = GetBlackboardComponent();
+	if (!LocalBlackboard || (TopTarget == BlackboardThreatTarget.Get() && bBlackboardInCombat == (TopTarget != nullptr)))
+	{
+		return;
+	}
+
+	LocalBlackboard->SetValueAsObject(EldaraAIKeys::TargetActor, TopTarget);
+	LocalBlackboard->SetValueAsBool(EldaraAIKeys::IsInCombat, TopTarget != nullptr);
+	BlackboardThreatTarget = TopTarget;
+	bBlackboardInCombat = TopTarget != nullptr;
 }
 
-AActor* AEldaraAIController::GetHighestThreatTarget()
+UEldaraCombatLog* AEldaraAIController::GetCombatLog()
 {
-	AActor* HighestThreatActor = nullptr;
-	float HighestThreatValue = 0.0f;
-
-	for (const auto& Entry : ThreatTable)
+	if (!CombatLog.IsValid())
 	{
-		if (Entry.Value > HighestThreatValue)
+		if (UWorld* World = GetWorld())
 		{
-			HighestThreatValue = Entry.Value;
-			HighestThreatActor = Entry.Key;
+			CombatLog = World->GetSubsystem<UEldaraCombatLog>();
 		}
 	}
-
-	return HighestThreatActor;
+	return CombatLog.Get();
 }
 
 void AEldaraAIController::ClearThreat()
 {
-	ThreatTable.Empty();
+	ThreatTable.Reset();
+	LostSightTimes.Reset();
+	GetWorldTimerManager().ClearTimer(ThreatOverrideTimer);
+	GetWorldTimerManager().ClearTimer(ThreatPruneTimer);
+	BlackboardThreatTarget.Reset();
+	bBlackboardInCombat = false;
 
 	if (GetBlackboardComponent())
 	{
@@ -143,6 +258,101 @@ void AEldaraAIController::ClearThreat()
 	UE_LOG(LogTemp, Log, TEXT("ClearThreat: %s threat table cleared"), *GetName());
 }
 
+void AEldaraAIController::SuspendForPool()
+{
+	// Back to full rate first so a paused tree is resumed before it is stopped
+	if (UEldaraAILODSubsystem* LODSubsystem = GetWorld()->GetSubsystem<UEldaraAILODSubsystem>())
+	{
+		LODSubsystem->Unregister(this);
+	}
+
+	ClearThreat();
+
+	if (BrainComponent)
+	{
+		BrainComponent->StopLogic(TEXT("Pooled"));
+	}
+
+	if (UAIPerceptionComponent* LocalPerceptionComponent = GetPerceptionComponent())
+	{
+		LocalPerceptionComponent->ForgetAll();
+		LocalPerceptionComponent->SetComponentTickEnabled(false);
+	}
+
+	SetActorTickEnabled(false);
+}
+
+void AEldaraAIController::ResumeFromPool()
+{
+	SetActorTickEnabled(true);
+
+	if (UAIPerceptionComponent* LocalPerceptionComponent = GetPerceptionComponent())
+	{
+		LocalPerceptionComponent->SetComponentTickEnabled(true);
+	}
+
+	// Reuse the existing BT instance when possible; only start one if none ran yet
+	if (BrainComponent && CurrentBehaviorTree)
+	{
+		BrainComponent->RestartLogic();
+	}
+	else if (AEldaraNPCBase* NPC = Cast<AEldaraNPCBase>(GetPawn()))
+	{
+		if (NPC->BehaviorTreeAsset)
+		{
+			InitializeBehaviorTree(NPC->BehaviorTreeAsset);
+		}
+	}
+
+	UpdateBlackboardKeys();
+
+	if (UEldaraAILODSubsystem* LODSubsystem = GetWorld()->GetSubsystem<UEldaraAILODSubsystem>())
+	{
+		LODSubsystem->Register(this);
+	}
+}
+
+void AEldaraAIController::ApplyAILOD(EEldaraAILOD NewLOD, const FEldaraAILODRates& Rates)
+{
+	if (NewLOD == CurrentLOD)
+	{
+		return;
+	}
+
+	const bool bWasDormant = CurrentLOD == EEldaraAILOD::Dormant;
+	const bool bDormant = NewLOD == EEldaraAILOD::Dormant;
+	CurrentLOD = NewLOD;
+
+	// Sight queries run in the perception system, so switch the sense rather than the component tick
+	if (UAIPerceptionComponent* LocalPerceptionComponent = GetPerceptionComponent())
+	{
+		LocalPerceptionComponent->SetSenseEnabled(UAISense_Sight::StaticClass(), !bDormant && Rates.bSightEnabled);
+	}
+
+	UPawnMovementComponent* MovementComponent = GetPawn() ? GetPawn()->GetMovementComponent() : nullptr;
+	if (MovementComponent)
+	{
+		MovementComponent->SetComponentTickEnabled(!bDormant);
+		MovementComponent->SetComponentTickInterval(Rates.MovementTickInterval);
+	}
+
+	if (BrainComponent)
+	{
+		if (bDormant)
+		{
+			BrainComponent->PauseLogic(TEXT("AI LOD"));
+		}
+		else if (bWasDormant)
+		{
+			BrainComponent->ResumeLogic(TEXT("AI LOD"));
+		}
+	}
+	if (UEldaraBehaviorTreeComponent* TreeComponent = Cast<UEldaraBehaviorTreeComponent>(BrainComponent))
+	{
+		TreeComponent->SetMinTickInterval(Rates.BrainTickInterval);
+	}
+}
+
 void AEldaraAIController::OnTargetPerceptionUpdated(AActor* Actor, FAIStimulus Stimulus)
 {
 	// TODO: Implement perception response
@@ -159,19 +369,29 @@ void AEldaraAIController::OnTargetPerceptionUpdated(AActor* Actor, FAIStimulus S
 		LocalBlackboard->SetValueAsBool(EldaraAIKeys::HasLineOfSight, Stimulus.WasSuccessfullySensed());
 		if (Stimulus.WasSuccessfullySensed())
 		{
-			LocalBlackboard->SetValueAsObject(EldaraAIKeys::TargetActor, Actor);
 			LocalBlackboard->SetValueAsVector(EldaraAIKeys::TargetLocation, Actor->GetActorLocation());
 		}
 	}
 
+	const bool bSight = Stimulus.Type == UAISense::GetSenseID<UAISense_Sight>();
 	if (Stimulus.WasSuccessfullySensed())
 	{
 		UE_LOG(LogTemp, Log, TEXT("OnTargetPerceptionUpdated: %s sensed %s"), 
 			*GetName(), *Actor->GetName());
 
-		// Add initial threat when first sensing target
+		if (bSight)
+		{
+			LostSightTimes.Remove(Actor);
+		}
+
+		// Add initial threat when first sensing target; this also picks the blackboard target
 		AddThreat(Actor, 10.0f);
 	}
+	else if (bSight && ThreatTable.GetThreat(Actor, GetWorld()->GetTimeSeconds()) > 0.0f)
+	{
+		// Ducking behind a pillar keeps threat; PruneThreat drops the actor if it stays unseen
+		LostSightTimes.Add(Actor, GetWorld()->GetTimeSeconds());
+	}
 }
 
 void AEldaraAIController::UpdateBlackboardKeys()
@@ -3,12 +3,15 @@
 #include "CoreMinimal.h"
 #include "AIController.h"
 #include "Perception/AIPerceptionTypes.h"
+#include "EldaraThreatTable.h"
+#include "EldaraAILODSubsystem.h"
 #include "EldaraAIController.generated.h"
 
 // Forward declarations
 class UBehaviorTree;
 class UBlackboardComponent;
 class UAISenseConfig_Sight;
+class UEldaraCombatLog;
 
 /**
  * AI Controller for NPCs and enemies in World of Eldara
@@ -25,8 +28,10 @@ public:
 protected:
 	/** Called when this controller possesses a pawn */
 	virtual void OnPossess(APawn* InPawn) override;
+	virtual void OnUnPossess() override;
 
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 public:
 	/**
@@ -45,22 +50,82 @@ public:
 	void AddThreat(AActor* ThreatSource, float ThreatAmount);
 
 	/**
-	 * Get the actor with the highest threat
+	 * Get the actor with the highest threat (or the taunting/fixated actor)
 	 * @return The highest threat target, or nullptr if no threats
 	 */
 	UFUNCTION(BlueprintCallable, Category = "AI|Combat")
 	AActor* GetHighestThreatTarget();
 
+	/** Current, decayed threat of an actor */
+	UFUNCTION(BlueprintCallable, Category = "AI|Combat")
+	float GetThreat(AActor* ThreatSource) const;
+
+	/** Drop an actor from the threat table */
+	UFUNCTION(BlueprintCallable, Category = "AI|Combat")
+	void RemoveThreat(AActor* ThreatSource);
+
+	/**
+	 * Force attacks onto Taunter for Duration and raise its threat to the current top's
+	 * @param Taunter The taunting actor
+	 * @param Duration Seconds the taunt lasts
+	 */
+	UFUNCTION(BlueprintCallable, Category = "AI|Combat")
+	void Taunt(AActor* Taunter, float Duration);
+
+	/**
+	 * Attack Target for Duration regardless of threat
+	 * @param Target The actor to fixate on
+	 * @param Duration Seconds the fixate lasts
+	 */
+	UFUNCTION(BlueprintCallable, Category = "AI|Combat")
+	void Fixate(AActor* Target, float Duration);
+
 	/**
 	 * Clear all threat (evade/reset)
 	 */
 	UFUNCTION(BlueprintCallable, Category = "AI|Combat")
 	void ClearThreat();
 
+	/**
+	 * Park this controller with its pooled pawn: stop the behavior tree, drop
+	 * threat and perception memory. The pawn stays possessed so reuse skips possession.
+	 */
+	void SuspendForPool();
+
+	/** Restart AI on a pooled pawn that was reinitialized for a new entity */
+	void ResumeFromPool();
+
+	/** Held in combat by a taunt or fixate, or by a living top target with at least CombatThreatFloor threat */
+	bool IsInCombat() const;
+
+	/**
+	 * Throttle or suspend the behavior tree, perception and pawn movement (called by UEldaraAILODSubsystem)
+	 * @param NewLOD The LOD to switch to
+	 * @param Rates Tick intervals for the LOD (ignored when Dormant)
+	 */
+	void ApplyAILOD(EEldaraAILOD NewLOD, const FEldaraAILODRates& Rates);
+
+	EEldaraAILOD GetAILOD() const { return CurrentLOD; }
+
 protected:
-	/** Threat table (Actor -> Threat Value) */
-	UPROPERTY()
-	TMap<TObjectPtr<AActor>, float> ThreatTable;
+	/** Threat per attacker, with the top target kept up to date */
+	FEldaraThreatTable ThreatTable;
+
+	/** Seconds for threat to halve when no new threat is generated; 0 disables decay */
+	UPROPERTY(EditDefaultsOnly, Category = "AI|Combat")
+	float ThreatHalfLife = 60.0f;
+
+	/** Decayed threat below which an attacker is dropped from the table and no longer holds the NPC in combat */
+	UPROPERTY(EditDefaultsOnly, Category = "AI|Combat")
+	float CombatThreatFloor = 1.0f;
+
+	/** Seconds an attacker may stay out of sight before it is dropped from the threat table */
+	UPROPERTY(EditDefaultsOnly, Category = "AI|Combat")
+	float LostSightThreatTimeout = 10.0f;
+
+	/** Seconds between sweeps that drop attackers decayed below CombatThreatFloor or long out of sight */
+	UPROPERTY(EditDefaultsOnly, Category = "AI|Combat")
+	float ThreatPruneInterval = 2.0f;
 
 	/** Current behavior tree */
 	UPROPERTY()
@@ -76,4 +141,31 @@ protected:
 
 	/** Update blackboard keys based on pawn state */
 	void UpdateBlackboardKeys();
+
+private:
+	/** Write the top threat target to the blackboard if it changed; re-checks when a taunt or fixate ends */
+	void RefreshThreatTarget();
+
+	/** Drop decayed, destroyed and long unseen attackers, then refresh the top target (runs while the table is not empty) */
+	void PruneThreat();
+
+	/** World time each attacker was last lost from sight; cleared when it is seen again */
+	TMap<TWeakObjectPtr<AActor>, double> LostSightTimes;
+
+	/** Binary combat log for the owning world (cached) */
+	UEldaraCombatLog* GetCombatLog();
+
+	/** Top threat target last written to the blackboard */
+	TWeakObjectPtr<AActor> BlackboardThreatTarget;
+	bool bBlackboardInCombat = false;
+
+	/** Fires when the current taunt or fixate expires */
+	FTimerHandle ThreatOverrideTimer;
+
+	/** Runs PruneThreat while anyone is on the threat table */
+	FTimerHandle ThreatPruneTimer;
+
+	TWeakObjectPtr<UEldaraCombatLog> CombatLog;
+
+	EEldaraAILOD CurrentLOD = EEldaraAILOD::Full;
 };
@@ -0,0 +1,230 @@
+#include "EldaraAILODSubsystem.h"
+#include "EldaraAIController.h"
+#include "Engine/World.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
+
+namespace
+{
+	constexpr float MinClassifyInterval = 0.05f;
+	constexpr float MinCellSize = 100.0f;
+}
+
+void UEldaraAILODSubsystem::Deinitialize()
+{
+	Entries.Reset();
+	IndexByController.Reset();
+	PlayerCells.Reset();
+	Cursor = 0;
+	PendingEvaluations = 0.0f;
+	FMemory::Memzero(LODCounts);
+
+	Super::Deinitialize();
+}
+
+bool UEldaraAILODSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId UEldaraAILODSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UEldaraAILODSubsystem, STATGROUP_Tickables);
+}
+
+void UEldaraAILODSubsystem::Register(AEldaraAIController* Controller)
+{
+	if (!Controller)
+	{
+		return;
+	}
+
+	const FObjectKey Key(Controller);
+	if (IndexByController.Contains(Key))
+	{
+		return;
+	}
+
+	FEntry& Entry = Entries.AddDefaulted_GetRef();
+	Entry.Key = Key;
+	Entry.Controller = Controller;
+	IndexByController.Add(Key, Entries.Num() - 1);
+	++LODCounts[static_cast<int32>(EEldaraAILOD::Full)];
+}
+
+void UEldaraAILODSubsystem::Unregister(AEldaraAIController* Controller)
+{
+	const int32* Found = IndexByController.Find(FObjectKey(Controller));
+	if (!Found)
+	{
+		return;
+	}
+
+	const int32 Index = *Found;
+	SetLOD(Entries[Index], EEldaraAILOD::Full);
+	RemoveEntry(Index);
+}
+
+void UEldaraAILODSubsystem::RemoveEntry(int32 Index)
+{
+	--LODCounts[static_cast<int32>(Entries[Index].LOD)];
+	IndexByController.Remove(Entries[Index].Key);
+
+	Entries.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	if (Index < Entries.Num())
+	{
+		IndexByController[Entries[Index].Key] = Index;
+	}
+}
+
+FEldaraAILODRates UEldaraAILODSubsystem::GetRates(EEldaraAILOD LOD) const
+{
+	FEldaraAILODRates Rates;
+	if (LOD == EEldaraAILOD::Reduced)
+	{
+		Rates.BrainTickInterval = ReducedBrainTickInterval;
+		Rates.MovementTickInterval = ReducedMovementTickInterval;
+	}
+	else if (LOD == EEldaraAILOD::Low)
+	{
+		Rates.BrainTickInterval = LowBrainTickInterval;
+		Rates.MovementTickInterval = LowMovementTickInterval;
+		Rates.bSightEnabled = false;
+	}
+	return Rates;
+}
+
+void UEldaraAILODSubsystem::SetLOD(FEntry& Entry, EEldaraAILOD NewLOD)
+{
+	if (Entry.LOD == NewLOD)
+	{
+		return;
+	}
+
+	--LODCounts[static_cast<int32>(Entry.LOD)];
+	++LODCounts[static_cast<int32>(NewLOD)];
+	Entry.LOD = NewLOD;
+
+	if (AEldaraAIController* Controller = Entry.Controller.Get())
+	{
+		Controller->ApplyAILOD(NewLOD, GetRates(NewLOD));
+	}
+}
+
+void UEldaraAILODSubsystem::Tick(float DeltaTime)
+{
+	if (Entries.Num() == 0)
+	{
+		return;
+	}
+
+	// Evaluate Num / ClassifyInterval entries per second, round-robin
+	PendingEvaluations += Entries.Num() * DeltaTime / FMath::Max(ClassifyInterval, MinClassifyInterval);
+	PendingEvaluations = FMath::Min(PendingEvaluations, static_cast<float>(Entries.Num()));
+	int32 NumToEvaluate = FMath::FloorToInt32(PendingEvaluations);
+	if (NumToEvaluate == 0)
+	{
+		return;
+	}
+	PendingEvaluations -= NumToEvaluate;
+
+	GatherPlayerLocations();
+
+	while (NumToEvaluate-- > 0 && Entries.Num() > 0)
+	{
+		if (Cursor >= Entries.Num())
+		{
+			Cursor = 0;
+		}
+
+		FEntry& Entry = Entries[Cursor];
+		AEldaraAIController* Controller = Entry.Controller.Get();
+		if (!Controller)
+		{
+			// The last entry was swapped in here; it is evaluated next
+			RemoveEntry(Cursor);
+			continue;
+		}
+
+		if (const APawn* Pawn = Controller->GetPawn())
+		{
+			EEldaraAILOD NewLOD = ClassifyDistance(GetNearestPlayerDistanceSq(Pawn->GetActorLocation()), Entry.LOD);
+
+			// A fight keeps full rate for as long as any player is in range
+			if (NewLOD != EEldaraAILOD::Dormant && Controller->IsInCombat())
+			{
+				NewLOD = EEldaraAILOD::Full;
+			}
+			SetLOD(Entry, NewLOD);
+		}
+		++Cursor;
+	}
+}
+
+void UEldaraAILODSubsystem::GatherPlayerLocations()
+{
+	PlayerCells.Reset();
+	PlayerCellSize = FMath::Max(ActiveRadius * (1.0f + DemotionHysteresis), MinCellSize);
+
+	for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+	{
+		const APlayerController* PlayerController = It->Get();
+		const APawn* Pawn = PlayerController ? PlayerController->GetPawn() : nullptr;
+		if (!Pawn)
+		{
+			continue;
+		}
+
+		const FVector Location = Pawn->GetActorLocation();
+		const FIntPoint Cell(FMath::FloorToInt32(Location.X / PlayerCellSize), FMath::FloorToInt32(Location.Y / PlayerCellSize));
+		PlayerCells.FindOrAdd(Cell).Add(Location);
+	}
+}
+
+float UEldaraAILODSubsystem::GetNearestPlayerDistanceSq(const FVector& Location) const
+{
+	// Cells are as wide as the active range, so every player that matters is in the 3x3 block around Location
+	const FIntPoint Center(FMath::FloorToInt32(Location.X / PlayerCellSize), FMath::FloorToInt32(Location.Y / PlayerCellSize));
+
+	float NearestSq = MAX_flt;
+	for (int32 OffsetY = -1; OffsetY <= 1; ++OffsetY)
+	{
+		for (int32 OffsetX = -1; OffsetX <= 1; ++OffsetX)
+		{
+			if (const TArray<FVector>* Players = PlayerCells.Find(Center + FIntPoint(OffsetX, OffsetY)))
+			{
+				for (const FVector& PlayerLocation : *Players)
+				{
+					NearestSq = FMath::Min(NearestSq, static_cast<float>(FVector::DistSquared(Location, PlayerLocation)));
+				}
+			}
+		}
+	}
+	return NearestSq;
+}
+
+EEldaraAILOD UEldaraAILODSubsystem::ClassifyDistance(float DistanceSq, EEldaraAILOD CurrentLOD) const
+{
+	const float HysteresisScale = FMath::Square(1.0f + DemotionHysteresis);
+
+	// An NPC already at Level (or better) keeps it out to the radius plus the hysteresis margin
+	auto IsWithin = [DistanceSq, CurrentLOD, HysteresisScale](float Radius, EEldaraAILOD Level)
+	{
+		const float Scale = CurrentLOD <= Level ? HysteresisScale : 1.0f;
+		return DistanceSq <= FMath::Square(Radius) * Scale;
+	};
+
+	if (IsWithin(FullRadius, EEldaraAILOD::Full))
+	{
+		return EEldaraAILOD::Full;
+	}
+	if (IsWithin(ReducedRadius, EEldaraAILOD::Reduced))
+	{
+		return EEldaraAILOD::Reduced;
+	}
+	if (IsWithin(ActiveRadius, EEldaraAILOD::Low))
+	{
+		return EEldaraAILOD::Low;
+	}
+	return EEldaraAILOD::Dormant;
+}
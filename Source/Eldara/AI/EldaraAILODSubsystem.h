@@ -0,0 +1,138 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "EldaraAILODSubsystem.generated.h"
+
+class AEldaraAIController;
+
+/** How much CPU an NPC's AI gets */
+UENUM(BlueprintType)
+enum class EEldaraAILOD : uint8
+{
+	/** In combat or near a player: everything at full rate */
+	Full,
+	/** Players in the area but not close: behavior tree and movement throttled */
+	Reduced,
+	/** Players at the edge of the active range, beyond sight: heavily throttled, sight off */
+	Low,
+	/** No player in range: behavior tree paused, sight and movement off */
+	Dormant
+};
+
+/** Tick intervals (seconds, 0 = every frame) and senses for one AI LOD */
+struct FEldaraAILODRates
+{
+	float BrainTickInterval = 0.0f;
+	float MovementTickInterval = 0.0f;
+	bool bSightEnabled = true;
+};
+
+/**
+ * Server-side AI level of detail.
+ *
+ * AI controllers register when they possess a pawn. The subsystem buckets them by distance
+ * to the nearest player pawn and by combat state, throttles behavior tree and movement ticks
+ * per bucket, and turns sight off for NPCs that are too far from any player to see one.
+ * NPCs with no player in range are suspended outright. AI
+ * cost therefore follows where players are fighting rather than how many NPCs the zone holds.
+ *
+ * Each NPC is re-evaluated once per ClassifyInterval, a slice of the registry per frame, so
+ * LOD changes (and the tick phases they reset) are spread across frames instead of landing
+ * together. Demotion waits until an NPC is a hysteresis margin past a radius so NPCs on a
+ * boundary do not flap.
+ */
+UCLASS(Config=Game)
+class ELDARA_API UEldaraAILODSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	/** Start managing a controller (no-op if already registered); it starts at Full */
+	void Register(AEldaraAIController* Controller);
+
+	/** Stop managing a controller and put it back to full rate */
+	void Unregister(AEldaraAIController* Controller);
+
+	/** Controllers in an LOD as of their last evaluation */
+	UFUNCTION(BlueprintPure, Category = "Eldara|AI")
+	int32 GetLODCount(EEldaraAILOD LOD) const { return LODCounts[static_cast<int32>(LOD)]; }
+
+	UFUNCTION(BlueprintPure, Category = "Eldara|AI")
+	int32 GetNumControllers() const { return Entries.Num(); }
+
+protected:
+	/** Players within this radius (cm) keep an NPC at Full */
+	UPROPERTY(Config, EditDefaultsOnly, Category = "AI LOD")
+	float FullRadius = 3000.0f;
+
+	/** Players within this radius (cm) keep an NPC at Reduced; keep it above NPC sight range */
+	UPROPERTY(Config, EditDefaultsOnly, Category = "AI LOD")
+	float ReducedRadius = 8000.0f;
+
+	/** Players within this radius (cm) keep an NPC at Low; beyond it the NPC is Dormant, even in combat */
+	UPROPERTY(Config, EditDefaultsOnly, Category = "AI LOD")
+	float ActiveRadius = 15000.0f;
+
+	/** Fraction past a radius an NPC must be before it is demoted */
+	UPROPERTY(Config, EditDefaultsOnly, Category = "AI LOD")
+	float DemotionHysteresis = 0.1f;
+
+	/** Seconds in which every NPC is re-evaluated once */
+	UPROPERTY(Config, EditDefaultsOnly, Category = "AI LOD")
+	float ClassifyInterval = 0.5f;
+
+	UPROPERTY(Config, EditDefaultsOnly, Category = "AI LOD")
+	float ReducedBrainTickInterval = 0.1f;
+
+	UPROPERTY(Config, EditDefaultsOnly, Category = "AI LOD")
+	float ReducedMovementTickInterval = 0.05f;
+
+	UPROPERTY(Config, EditDefaultsOnly, Category = "AI LOD")
+	float LowBrainTickInterval = 0.5f;
+
+	UPROPERTY(Config, EditDefaultsOnly, Category = "AI LOD")
+	float LowMovementTickInterval = 0.2f;
+
+private:
+	struct FEntry
+	{
+		FObjectKey Key;
+		TWeakObjectPtr<AEldaraAIController> Controller;
+		EEldaraAILOD LOD = EEldaraAILOD::Full;
+	};
+
+	FEldaraAILODRates GetRates(EEldaraAILOD LOD) const;
+
+	/** Bucket player pawn locations into cells one ActiveRadius (plus hysteresis) wide */
+	void GatherPlayerLocations();
+
+	/** Squared distance to the closest player pawn within the active range, or MAX_flt */
+	float GetNearestPlayerDistanceSq(const FVector& Location) const;
+
+	/** LOD an NPC at DistanceSq from the nearest player should have, given its current one */
+	EEldaraAILOD ClassifyDistance(float DistanceSq, EEldaraAILOD CurrentLOD) const;
+
+	void SetLOD(FEntry& Entry, EEldaraAILOD NewLOD);
+	void RemoveEntry(int32 Index);
+
+	TArray<FEntry> Entries;
+	TMap<FObjectKey, int32> IndexByController;
+
+	/** Next entry to evaluate */
+	int32 Cursor = 0;
+
+	/** Fractional entries carried over between frames */
+	float PendingEvaluations = 0.0f;
+
+	TMap<FIntPoint, TArray<FVector>> PlayerCells;
+	float PlayerCellSize = 1.0f;
+
+	int32 LODCounts[4] = { 0, 0, 0, 0 };
+};
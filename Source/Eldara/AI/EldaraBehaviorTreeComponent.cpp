@@ -0,0 +1,33 @@
+#include "EldaraBehaviorTreeComponent.h"
+
+void UEldaraBehaviorTreeComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	// The tree has just rescheduled itself; hold it to the cap
+	if (MinTickInterval > 0.0f && IsComponentTickEnabled() && GetComponentTickInterval() < MinTickInterval)
+	{
+		SetComponentTickIntervalAndCooldown(MinTickInterval);
+	}
+}
+
+void UEldaraBehaviorTreeComponent::SetMinTickInterval(float Interval)
+{
+	const float PreviousInterval = MinTickInterval;
+	MinTickInterval = FMath::Max(0.0f, Interval);
+
+	if (!IsComponentTickEnabled())
+	{
+		return;
+	}
+
+	if (MinTickInterval > GetComponentTickInterval())
+	{
+		SetComponentTickIntervalAndCooldown(MinTickInterval);
+	}
+	else if (MinTickInterval < PreviousInterval)
+	{
+		// Tick next frame so the tree can schedule itself at its own rate again
+		SetComponentTickIntervalAndCooldown(0.0f);
+	}
+}
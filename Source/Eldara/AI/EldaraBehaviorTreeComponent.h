@@ -0,0 +1,30 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BehaviorTree/BehaviorTreeComponent.h"
+#include "EldaraBehaviorTreeComponent.generated.h"
+
+/**
+ * Behavior tree component whose tick rate can be capped for AI LOD.
+ *
+ * The tree schedules its own next tick after every update, so an interval set from outside
+ * would be overwritten on the next frame; this component re-applies the cap after each
+ * update instead. Execution requests (aborts, finished tasks) still tick on the next frame,
+ * so a throttled tree reacts to events at full speed and only its regular ticks slow down.
+ */
+UCLASS()
+class ELDARA_API UEldaraBehaviorTreeComponent : public UBehaviorTreeComponent
+{
+	GENERATED_BODY()
+
+public:
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
+	/** Tick at most once per Interval seconds (0 = as often as the tree asks) */
+	void SetMinTickInterval(float Interval);
+
+	float GetMinTickInterval() const { return MinTickInterval; }
+
+private:
+	float MinTickInterval = 0.0f;
+};
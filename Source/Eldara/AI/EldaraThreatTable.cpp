@@ -0,0 +1,232 @@
+#include "EldaraThreatTable.h"
+#include "GameFramework/Actor.h"
+
+namespace
+{
+	/** Rebase once stored values have grown by e^MaxDecayExponent, well inside float range */
+	constexpr double MaxDecayExponent = 20.0;
+
+	/** Entries decayed below this are dropped when rebasing */
+	constexpr float MinThreat = 0.01f;
+}
+
+void FEldaraThreatTable::SetHalfLife(float Seconds)
+{
+	DecayRate = Seconds > 0.0f ? UE_LN2 / Seconds : 0.0;
+}
+
+float FEldaraThreatTable::GetDecayScale(double Now) const
+{
+	return DecayRate > 0.0 ? static_cast<float>(FMath::Exp(DecayRate * (Now - BaseTime))) : 1.0f;
+}
+
+void FEldaraThreatTable::Rebase(double Now)
+{
+	const float InvScale = 1.0f / GetDecayScale(Now);
+	BaseTime = Now;
+
+	for (int32 Index = Entries.Num() - 1; Index >= 0; --Index)
+	{
+		Entries[Index].StoredThreat *= InvScale;
+		if (Entries[Index].StoredThreat < MinThreat && Index != TopIndex)
+		{
+			RemoveEntry(Index);
+		}
+	}
+}
+
+int32 FEldaraThreatTable::FindOrAddEntry(AActor* Actor)
+{
+	const FObjectKey Key(Actor);
+	if (const int32* Existing = IndexByActor.Find(Key))
+	{
+		return *Existing;
+	}
+
+	const int32 Index = Entries.AddDefaulted();
+	Entries[Index].Key = Key;
+	Entries[Index].Actor = Actor;
+	IndexByActor.Add(Key, Index);
+	return Index;
+}
+
+void FEldaraThreatTable::RemoveEntry(int32 Index)
+{
+	IndexByActor.Remove(Entries[Index].Key);
+
+	const int32 LastIndex = Entries.Num() - 1;
+	Entries.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	if (Index != LastIndex)
+	{
+		IndexByActor[Entries[Index].Key] = Index;
+	}
+
+	if (TopIndex == Index)
+	{
+		RefreshTop();
+	}
+	else if (TopIndex == LastIndex)
+	{
+		TopIndex = Index;
+	}
+}
+
+void FEldaraThreatTable::RefreshTop()
+{
+	TopIndex = INDEX_NONE;
+	float TopThreat = 0.0f;
+	for (int32 Index = 0; Index < Entries.Num(); ++Index)
+	{
+		if (Entries[Index].StoredThreat > TopThreat && Entries[Index].Actor.IsValid())
+		{
+			TopThreat = Entries[Index].StoredThreat;
+			TopIndex = Index;
+		}
+	}
+}
+
+float FEldaraThreatTable::AddThreat(AActor* Actor, float Amount, double Now)
+{
+	if (!Actor)
+	{
+		return 0.0f;
+	}
+
+	if (DecayRate * (Now - BaseTime) > MaxDecayExponent)
+	{
+		Rebase(Now);
+	}
+
+	const float Scale = GetDecayScale(Now);
+	const int32 Index = FindOrAddEntry(Actor);
+	FEntry& Entry = Entries[Index];
+	Entry.StoredThreat = FMath::Max(0.0f, Entry.StoredThreat + Amount * Scale);
+
+	if (Amount > 0.0f)
+	{
+		if (TopIndex == INDEX_NONE || Entry.StoredThreat > Entries[TopIndex].StoredThreat)
+		{
+			TopIndex = Index;
+		}
+	}
+	else if (Index == TopIndex)
+	{
+		RefreshTop();
+	}
+	return Entry.StoredThreat / Scale;
+}
+
+void FEldaraThreatTable::RemoveActor(const AActor* Actor)
+{
+	if (const int32* Index = IndexByActor.Find(FObjectKey(Actor)))
+	{
+		RemoveEntry(*Index);
+	}
+	if (OverrideTarget.Get() == Actor)
+	{
+		OverrideTarget.Reset();
+	}
+}
+
+float FEldaraThreatTable::GetThreat(const AActor* Actor, double Now) const
+{
+	const int32* Index = IndexByActor.Find(FObjectKey(Actor));
+	return Index ? Entries[*Index].StoredThreat / GetDecayScale(Now) : 0.0f;
+}
+
+AActor* FEldaraThreatTable::GetTopTarget(double Now)
+{
+	if (AActor* Override = OverrideTarget.Get())
+	{
+		if (Now < OverrideEndTime)
+		{
+			return Override;
+		}
+		OverrideTarget.Reset();
+	}
+
+	// The top actor was destroyed: drop dead entries, then find the next one
+	while (TopIndex != INDEX_NONE && !Entries[TopIndex].Actor.IsValid())
+	{
+		RemoveEntry(TopIndex);
+	}
+	return TopIndex != INDEX_NONE ? Entries[TopIndex].Actor.Get() : nullptr;
+}
+
+bool FEldaraThreatTable::HasTarget(float Floor, double Now) const
+{
+	if (OverrideTarget.IsValid() && Now < OverrideEndTime)
+	{
+		return true;
+	}
+
+	const float StoredFloor = Floor * GetDecayScale(Now);
+	if (TopIndex != INDEX_NONE && Entries[TopIndex].Actor.IsValid())
+	{
+		return Entries[TopIndex].StoredThreat >= StoredFloor;
+	}
+
+	// The top actor was destroyed and is not dropped yet: look for a living one
+	for (const FEntry& Entry : Entries)
+	{
+		if (Entry.Actor.IsValid() && Entry.StoredThreat >= StoredFloor)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+void FEldaraThreatTable::Prune(float Floor, double Now)
+{
+	const float StoredFloor = Floor * GetDecayScale(Now);
+	const AActor* Override = Now < OverrideEndTime ? OverrideTarget.Get() : nullptr;
+
+	// Removal swaps the last entry in, which has already been visited
+	for (int32 Index = Entries.Num() - 1; Index >= 0; --Index)
+	{
+		const AActor* Actor = Entries[Index].Actor.Get();
+		if (!Actor || (Entries[Index].StoredThreat < StoredFloor && Actor != Override))
+		{
+			RemoveEntry(Index);
+		}
+	}
+}
+
+void FEldaraThreatTable::Taunt(AActor* Actor, float Duration, double Now)
+{
+	if (!Actor)
+	{
+		return;
+	}
+
+	const int32 Index = FindOrAddEntry(Actor);
+	if (TopIndex != INDEX_NONE && TopIndex != Index)
+	{
+		Entries[Index].StoredThreat = FMath::Max(Entries[Index].StoredThreat, Entries[TopIndex].StoredThreat);
+	}
+	TopIndex = Index;
+
+	Fixate(Actor, Duration, Now);
+}
+
+void FEldaraThreatTable::Fixate(AActor* Actor, float Duration, double Now)
+{
+	if (!Actor || Duration <= 0.0f)
+	{
+		return;
+	}
+
+	OverrideTarget = Actor;
+	OverrideEndTime = Now + Duration;
+}
+
+void FEldaraThreatTable::Reset()
+{
+	Entries.Reset();
+	IndexByActor.Reset();
+	TopIndex = INDEX_NONE;
+	BaseTime = 0.0;
+	OverrideTarget.Reset();
+	OverrideEndTime = 0.0;
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
+
+/**
+ * Threat of one NPC towards the actors fighting it, in a flat array.
+ *
+ * Threat decays exponentially with one half-life for the whole table, so decay scales every
+ * entry by the same factor: values are stored relative to a base time and are never touched
+ * as time passes; only reads and writes convert with the decay accumulated since the base.
+ * Since decay cannot reorder entries, the top entry is maintained incrementally. Adding
+ * threat can only promote the entry it adds to, and only lowering or removing the top entry
+ * rescans.
+ *
+ * Taunt and fixate override the top entry until they expire. Taunt also raises the
+ * taunter's threat to the current top's, so it keeps aggro afterwards; fixate leaves
+ * threat untouched.
+ */
+struct ELDARA_API FEldaraThreatTable
+{
+	/** Seconds for threat to halve; 0 disables decay */
+	void SetHalfLife(float Seconds);
+
+	/** Add (or with a negative amount, remove) threat; returns the actor's threat afterwards */
+	float AddThreat(AActor* Actor, float Amount, double Now);
+
+	/** Drop an actor from the table (died, left combat) */
+	void RemoveActor(const AActor* Actor);
+
+	/** Current, decayed threat of an actor (0 if not on the table) */
+	float GetThreat(const AActor* Actor, double Now) const;
+
+	/** Taunting or fixated actor while that lasts, else the actor with the highest threat */
+	AActor* GetTopTarget(double Now);
+
+	/** Force the top target to Actor for Duration and raise its threat to the top's */
+	void Taunt(AActor* Actor, float Duration, double Now);
+
+	/** Force the top target to Actor for Duration without changing threat */
+	void Fixate(AActor* Actor, float Duration, double Now);
+
+	/** Whether anyone holds the NPC in combat: an active taunt or fixate, or a living top actor with at least Floor threat */
+	bool HasTarget(float Floor, double Now) const;
+
+	/** Drop destroyed actors and those decayed below Floor; an active taunt or fixate target is kept */
+	void Prune(float Floor, double Now);
+
+	/** Time at which the current taunt or fixate ends, or 0 if there is none */
+	double GetOverrideEndTime() const { return OverrideTarget.IsValid() ? OverrideEndTime : 0.0; }
+
+	int32 Num() const { return Entries.Num(); }
+
+	void Reset();
+
+private:
+	struct FEntry
+	{
+		FObjectKey Key;
+		TWeakObjectPtr<AActor> Actor;
+
+		/** Threat at BaseTime; actual threat is this times the decay since BaseTime */
+		float StoredThreat = 0.0f;
+	};
+
+	/** exp(DecayRate * (Now - BaseTime)): stored values are actual values times this */
+	float GetDecayScale(double Now) const;
+
+	/** Fold the accumulated decay into the stored values before they grow too large */
+	void Rebase(double Now);
+
+	int32 FindOrAddEntry(AActor* Actor);
+	void RemoveEntry(int32 Index);
+	void RefreshTop();
+
+	/** Most fights have a handful of attackers; large pulls spill to the heap */
+	TArray<FEntry, TInlineAllocator<8>> Entries;
+	TMap<FObjectKey, int32> IndexByActor;
+
+	int32 TopIndex = INDEX_NONE;
+
+	double DecayRate = 0.0;
+	double BaseTime = 0.0;
+
+	TWeakObjectPtr<AActor> OverrideTarget;
+	double OverrideEndTime = 0.0;
+};
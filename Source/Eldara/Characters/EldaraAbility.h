@@ -69,10 +69,22 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Targeting")
 	float Range;
 
-	/** Cooldown duration in seconds */
+	/** Cooldown duration in seconds (recharge time of one charge) */
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Ability")
 	float Cooldown;
 
+	/** Charges that can be stored; each recharges in Cooldown seconds, one at a time */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Ability", meta = (ClampMin = "1"))
+	int32 MaxCharges = 1;
+
+	/** Abilities with the same group share one cooldown (None = own cooldown) */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Ability")
+	FName CooldownGroup;
+
+	/** Does this ability trigger and respect the global cooldown? Off by default; rotational abilities opt in */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Ability")
+	bool bOnGlobalCooldown = false;
+
 	/** Resource type consumed by this ability */
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Resources")
 	EResourceType ResourceType;
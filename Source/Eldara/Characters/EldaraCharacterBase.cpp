@@ -2,6 +2,7 @@
 #include "EldaraCombatComponent.h"
 #include "Eldara/Data/EldaraRaceData.h"
 #include "Eldara/Data/EldaraClassData.h"
+#include "Eldara/Combat/EldaraCombatSpatialGrid.h"
 #include "Net/UnrealNetwork.h"
 #include "Internationalization/Text.h"
 #include "Misc/ConfigCacheIni.h"
@@ -73,7 +74,23 @@ void AEldaraCharacterBase::BeginPlay()
 {
 	Super::BeginPlay();
 	
+	BaseWalkSpeed = GetCharacterMovement()->MaxWalkSpeed;
 	InitializeStats();
+
+	if (UEldaraCombatSpatialGrid* SpatialGrid = GetWorld()->GetSubsystem<UEldaraCombatSpatialGrid>())
+	{
+		SpatialGrid->Register(this);
+	}
+}
+
+void AEldaraCharacterBase::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UEldaraCombatSpatialGrid* SpatialGrid = GetWorld() ? GetWorld()->GetSubsystem<UEldaraCombatSpatialGrid>() : nullptr)
+	{
+		SpatialGrid->Unregister(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
 }
 
 void AEldaraCharacterBase::Tick(float DeltaTime)
@@ -105,6 +122,11 @@ void AEldaraCharacterBase::SetVitals(float NewHealth, float NewResource, float N
 	Stamina = FMath::Clamp(NewStamina, 0.0f, MaxStamina);
 }
 
+EEldaraFaction AEldaraCharacterBase::GetCombatFaction() const
+{
+	return RaceData ? RaceData->Faction : EEldaraFaction::Neutral;
+}
+
 void AEldaraCharacterBase::SetCharacterName(const FString& NewName)
 {
 	CharacterName = NewName;
@@ -158,6 +180,18 @@ void AEldaraCharacterBase::ApplyHealing(float Amount)
 	Health = FMath::Clamp(Health + Amount, 0.0f, MaxHealth);
 }
 
+void AEldaraCharacterBase::ResetForReuse()
+{
+	Health = MaxHealth;
+	Resource = MaxResource;
+	Stamina = MaxStamina;
+
+	if (CombatComponent)
+	{
+		CombatComponent->ResetCombatState();
+	}
+}
+
 float AEldaraCharacterBase::TakeDamage(float DamageAmount, FDamageEvent const& DamageEvent, 
 	AController* EventInstigator, AActor* DamageCauser)
 {
@@ -181,6 +215,23 @@ float AEldaraCharacterBase::TakeDamage(float DamageAmount, FDamageEvent const& D
 	return DamageAmount;
 }
 
+void AEldaraCharacterBase::ApplyHealthChange(float Damage, float Healing, AController* EventInstigator, AActor* DamageCauser)
+{
+	if (IsDead())
+	{
+		return;
+	}
+
+	Health = FMath::Clamp(Health + Healing - Damage, 0.0f, MaxHealth);
+
+	if (IsDead())
+	{
+		UE_LOG(LogTemp, Log, TEXT("%s took %.1f damage and %.1f healing this frame, killed by %s"),
+			*GetName(), Damage, Healing, DamageCauser ? *DamageCauser->GetName() : TEXT("unknown"));
+		HandleDeath();
+	}
+}
+
 void AEldaraCharacterBase::HandleDeath()
 {
 	UE_LOG(LogTemp, Log, TEXT("%s has died"), *GetName());
@@ -207,6 +258,18 @@ void AEldaraCharacterBase::InitializeStats()
 
 		UE_LOG(LogTemp, Log, TEXT("%s initialized with ClassData: Health=%.1f, Resource=%.1f, Stamina=%.1f"), 
 			*GetName(), Health, Resource, Stamina);
+
+		// Give known abilities their cooldown slots up front so action bars can bind to them
+		if (CombatComponent)
+		{
+			for (const FStartingAbility& Starting : ClassData->StartingAbilities)
+			{
+				if (Starting.Ability && Starting.GrantLevel <= Level)
+				{
+					CombatComponent->GrantAbility(Starting.Ability);
+				}
+			}
+		}
 	}
 
 	if (RaceData)
@@ -220,8 +283,59 @@ void AEldaraCharacterBase::InitializeStats()
 			*GetName(), MaxHealth, MaxStamina);
 	}
 
+	// Class/race values are the base; active buffs and debuffs apply on top
+	if (CombatComponent)
+	{
+		CombatComponent->SetStatBaseValue(EEldaraStat::MaxHealth, MaxHealth);
+		CombatComponent->SetStatBaseValue(EEldaraStat::MaxResource, MaxResource);
+		CombatComponent->SetStatBaseValue(EEldaraStat::MaxStamina, MaxStamina);
+
+		MaxHealth = CombatComponent->GetStatValue(EEldaraStat::MaxHealth);
+		Health = MaxHealth;
+		MaxResource = CombatComponent->GetStatValue(EEldaraStat::MaxResource);
+		Resource = MaxResource;
+		MaxStamina = CombatComponent->GetStatValue(EEldaraStat::MaxStamina);
+		Stamina = MaxStamina;
+	}
+
 	// TODO: Apply equipment bonuses
-	// TODO: Apply buffs/debuffs
+}
+
+void AEldaraCharacterBase::HandleCrowdControlChanged(uint32 CrowdControlMask, float MovementSpeedScale)
+{
+	UCharacterMovementComponent* Movement = GetCharacterMovement();
+	Movement->MaxWalkSpeed = BaseWalkSpeed * MovementSpeedScale;
+
+	if (CrowdControlMask & UEldaraCombatComponent::ImmobilizingCrowdControl)
+	{
+		Movement->DisableMovement();
+	}
+	else if (Movement->MovementMode == MOVE_None)
+	{
+		Movement->SetDefaultMovementMode();
+	}
+}
+
+void AEldaraCharacterBase::HandleStatChanged(EEldaraStat Stat, float NewValue)
+{
+	switch (Stat)
+	{
+	case EEldaraStat::MaxHealth:
+		MaxHealth = FMath::Max(NewValue, 1.0f);
+		Health = FMath::Min(Health, MaxHealth);
+		break;
+	case EEldaraStat::MaxResource:
+		MaxResource = FMath::Max(NewValue, 0.0f);
+		Resource = FMath::Min(Resource, MaxResource);
+		break;
+	case EEldaraStat::MaxStamina:
+		MaxStamina = FMath::Max(NewValue, 0.0f);
+		Stamina = FMath::Min(Stamina, MaxStamina);
+		break;
+	default:
+		// Other stats are read from the combat component when used
+		break;
+	}
 }
 
 void AEldaraCharacterBase::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
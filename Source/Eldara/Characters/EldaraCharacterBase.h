@@ -3,6 +3,8 @@
 #include "CoreMinimal.h"
 #include "GameFramework/Character.h"
 #include "EldaraAbility.h"
+#include "Eldara/Data/EldaraFaction.h"
+#include "Eldara/Combat/EldaraStatTypes.h"
 #include "EldaraCharacterBase.generated.h"
 
 // Forward declarations
@@ -26,6 +28,7 @@ public:
 
 protected:
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 public:
 	virtual void Tick(float DeltaTime) override;
@@ -88,6 +91,9 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Stats")
 	float GetMaxStamina() const { return MaxStamina; }
 
+	/** Get the combat component */
+	UEldaraCombatComponent* GetCombatComponent() const { return CombatComponent; }
+
 	/** Consume resource for abilities */
 	bool ConsumeResource(float Amount, EResourceType ResourceType, FString& OutErrorMessage);
 
@@ -101,10 +107,29 @@ public:
 	virtual float TakeDamage(float DamageAmount, struct FDamageEvent const& DamageEvent, 
 		class AController* EventInstigator, AActor* DamageCauser) override;
 
+	/** Apply a frame's combined damage and healing as one health write and one death check */
+	void ApplyHealthChange(float Damage, float Healing, AController* EventInstigator, AActor* DamageCauser);
+
 	/** Is this character dead? */
 	UFUNCTION(BlueprintCallable, Category = "Stats")
 	bool IsDead() const { return Health <= 0.0f; }
 
+	/** Faction used for combat targeting filters: the race's faction, or Neutral without race data */
+	virtual EEldaraFaction GetCombatFaction() const;
+
+	/** Stat final value changed (buffs/debuffs, base value); updates the replicated vitals */
+	virtual void HandleStatChanged(EEldaraStat Stat, float NewValue);
+
+	/**
+	 * Active crowd control changed; locks movement while immobilized and applies slows. Runs on
+	 * the server and, through the combat component's replicated state, on clients, so the owner's
+	 * movement prediction matches the server's.
+	 */
+	virtual void HandleCrowdControlChanged(uint32 CrowdControlMask, float MovementSpeedScale);
+
+	/** Restore vitals and clear combat state so a pooled actor can be reused for a new entity */
+	virtual void ResetForReuse();
+
 protected:
 	/** Race data for this character */
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Character", Replicated)
@@ -153,6 +178,9 @@ protected:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Combat")
 	TObjectPtr<UEldaraCombatComponent> CombatComponent;
 
+	/** Walk speed without crowd control, captured at BeginPlay */
+	float BaseWalkSpeed = 0.0f;
+
 	/** Camera boom to keep camera offset from character */
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Camera")
 	TObjectPtr<USpringArmComponent> CameraBoom;
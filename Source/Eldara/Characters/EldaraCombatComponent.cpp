@@ -2,17 +2,39 @@
 #include "EldaraAbility.h"
 #include "EldaraEffect.h"
 #include "EldaraCharacterBase.h"
+#include "Eldara/Combat/EldaraEffectScheduler.h"
+#include "Eldara/Combat/EldaraEffectTickBatch.h"
+#include "Eldara/Combat/EldaraCombatRules.h"
+#include "Eldara/Combat/EldaraCombatEventAggregator.h"
+#include "Eldara/Combat/EldaraEffectKernels.h"
+#include "Eldara/Combat/EldaraCombatLog.h"
 #include "GameFramework/Actor.h"
 #include "Engine/World.h"
+#include "TimerManager.h"
+#include "Animation/AnimMontage.h"
 #include "GameFramework/Pawn.h"
 #include "GameFramework/Controller.h"
-#include "GameFramework/DamageType.h"
 #include "Engine/EngineTypes.h"
-#include "Engine/DamageEvents.h"
+#include "Net/UnrealNetwork.h"
 
 UEldaraCombatComponent::UEldaraCombatComponent()
 {
-	PrimaryComponentTick.bCanEverTick = true;
+	// Effect ticks and expiries are driven by UEldaraEffectScheduler
+	PrimaryComponentTick.bCanEverTick = false;
+
+	// Ability RPCs and crowd control state go through the owning character's channel
+	SetIsReplicatedByDefault(true);
+
+	StatValues.SetNumZeroed(FEldaraStatAggregator::NumStats);
+}
+
+void UEldaraCombatComponent::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	DOREPLIFETIME(UEldaraCombatComponent, CrowdControlMask);
+	DOREPLIFETIME(UEldaraCombatComponent, MovementSpeedScale);
+	DOREPLIFETIME(UEldaraCombatComponent, StatValues);
 }
 
 void UEldaraCombatComponent::BeginPlay()
@@ -20,38 +42,270 @@ void UEldaraCombatComponent::BeginPlay()
 	Super::BeginPlay();
 }
 
-void UEldaraCombatComponent::TickComponent(float DeltaTime, ELevelTick TickType, 
-	FActorComponentTickFunction* ThisTickFunction)
+void UEldaraCombatComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
-	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+	CancelQueuedAbility();
+	CancelEffectEvents();
 
-	// Update active effects (DoT/HoT ticking)
-	UpdateActiveEffects(DeltaTime);
+	Super::EndPlay(EndPlayReason);
 }
 
-void UEldaraCombatComponent::Server_ActivateAbility_Implementation(UEldaraAbility* Ability, AActor* Target)
+void UEldaraCombatComponent::Server_ActivateAbility_Implementation(UEldaraAbility* Ability, AActor* Target, int32 PredictionKey)
 {
 	if (!Ability)
 	{
 		UE_LOG(LogTemp, Warning, TEXT("Server_ActivateAbility: Ability is null"));
+		SendPredictionResult(PredictionKey, nullptr, false);
+		return;
+	}
+
+	// Requests that arrive shortly before the ability is ready wait in the queue instead of failing
+	const float ReadyIn = GetAbilityCooldownRemaining(Ability);
+	if (ReadyIn > 0.0f && ReadyIn <= SpellQueueWindow)
+	{
+		QueueAbility(Ability, Target, ReadyIn, PredictionKey);
 		return;
 	}
 
+	SendPredictionResult(PredictionKey, Ability, TryActivateAbility(Ability, Target));
+}
+
+void UEldaraCombatComponent::Server_CancelQueuedAbility_Implementation()
+{
+	CancelQueuedAbility();
+}
+
+bool UEldaraCombatComponent::ActivateAbility(UEldaraAbility* Ability, AActor* Target)
+{
+	if (!Ability || GetOwnerRole() < ROLE_AutonomousProxy)
+	{
+		return false;
+	}
+
+	// Queue locally too: the predicted request then leaves exactly when the ability comes off cooldown
+	const float ReadyIn = GetAbilityCooldownRemaining(Ability);
+	if (ReadyIn > 0.0f && ReadyIn <= SpellQueueWindow)
+	{
+		QueueAbility(Ability, Target, ReadyIn, 0);
+		return true;
+	}
+
+	return ActivateAbilityNow(Ability, Target);
+}
+
+bool UEldaraCombatComponent::ActivateAbilityNow(UEldaraAbility* Ability, AActor* Target)
+{
+	if (GetOwnerRole() == ROLE_Authority)
+	{
+		return TryActivateAbility(Ability, Target);
+	}
+
 	FString ErrorMessage;
 	if (!ValidateAbilityActivation(Ability, Target, ErrorMessage))
 	{
-		UE_LOG(LogTemp, Warning, TEXT("Server_ActivateAbility: Validation failed - %s"), *ErrorMessage);
-		// TODO: Send error message back to client
+		UE_LOG(LogTemp, Verbose, TEXT("ActivateAbility: %s not predicted - %s"), *Ability->GetName(), *ErrorMessage);
+		return false;
+	}
+
+	// Too many unanswered predictions means a stalled connection; stop stacking local state on it
+	if (PendingPredictions.Num() >= MaxPendingPredictions)
+	{
+		Server_ActivateAbility(Ability, Target, 0);
+		return true;
+	}
+
+	Server_ActivateAbility(Ability, Target, PredictAbility(Ability));
+	return true;
+}
+
+int32 UEldaraCombatComponent::PredictAbility(UEldaraAbility* Ability)
+{
+	// Key 0 means "not predicted" on the wire
+	LastPredictionKey = LastPredictionKey == MAX_int32 ? 1 : LastPredictionKey + 1;
+
+	FPredictedActivation& Prediction = PendingPredictions.AddDefaulted_GetRef();
+	Prediction.Key = LastPredictionKey;
+	Prediction.Ability = Ability;
+	Prediction.Cooldown = CooldownTable.Commit(CooldownTable.Grant(Ability), GetWorld()->GetTimeSeconds(), GlobalCooldown);
+
+	AEldaraCharacterBase* OwnerCharacter = GetOwnerCharacter();
+	if (OwnerCharacter)
+	{
+		FString ErrorMessage;
+		if (Ability->ResourceCost > 0.0f && OwnerCharacter->ConsumeResource(Ability->ResourceCost, Ability->ResourceType, ErrorMessage))
+		{
+			Prediction.ResourceSpent = Ability->ResourceCost;
+			Prediction.bSpentHealth = Ability->ResourceType == EResourceType::Health;
+		}
+
+		if (Ability->CastAnimation)
+		{
+			OwnerCharacter->PlayAnimMontage(Ability->CastAnimation);
+		}
+	}
+
+	++NumPredictedActivations;
+	OnAbilityPredicted.Broadcast(Ability, Prediction.Key);
+	return Prediction.Key;
+}
+
+void UEldaraCombatComponent::SendPredictionResult(int32 PredictionKey, UEldaraAbility* Ability, bool bAccepted)
+{
+	if (PredictionKey != 0)
+	{
+		Client_ResolvePrediction(PredictionKey, Ability, bAccepted);
+	}
+}
+
+void UEldaraCombatComponent::Client_ResolvePrediction_Implementation(int32 PredictionKey, UEldaraAbility* Ability, bool bAccepted)
+{
+	ResolvePrediction(PredictionKey, Ability, bAccepted);
+}
+
+void UEldaraCombatComponent::ResolvePrediction(int32 PredictionKey, UEldaraAbility* Ability, bool bAccepted)
+{
+	const int32 Index = PendingPredictions.IndexOfByPredicate([PredictionKey](const FPredictedActivation& Prediction)
+	{
+		return Prediction.Key == PredictionKey;
+	});
+	if (Index == INDEX_NONE)
+	{
+		return;
+	}
+
+	// A null ability is the server failing to resolve the request, which can only reject it
+	if (Ability ? PendingPredictions[Index].Ability != Ability : bAccepted)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("ResolvePrediction: verdict for %s does not match prediction %d (%s), ignored"),
+			Ability ? *Ability->GetName() : TEXT("None"), PredictionKey,
+			PendingPredictions[Index].Ability ? *PendingPredictions[Index].Ability->GetName() : TEXT("None"));
+		return;
+	}
+
+	const FPredictedActivation Prediction = PendingPredictions[Index];
+	PendingPredictions.RemoveAt(Index, 1, EAllowShrinking::No);
+	if (bAccepted)
+	{
 		return;
 	}
 
+	// Roll back everything the prediction did locally
+	CooldownTable.Revert(Prediction.Cooldown);
+
+	AEldaraCharacterBase* OwnerCharacter = GetOwnerCharacter();
+	if (OwnerCharacter)
+	{
+		if (Prediction.bSpentHealth)
+		{
+			OwnerCharacter->ApplyHealing(Prediction.ResourceSpent);
+		}
+		else if (Prediction.ResourceSpent > 0.0f)
+		{
+			OwnerCharacter->RestoreResource(Prediction.ResourceSpent);
+		}
+
+		if (Prediction.Ability && Prediction.Ability->CastAnimation)
+		{
+			OwnerCharacter->StopAnimMontage(Prediction.Ability->CastAnimation);
+		}
+	}
+
+	++NumMispredictions;
+	UE_LOG(LogTemp, Log, TEXT("ActivateAbility: prediction %d (%s) rejected by server, rolled back (%d of %d mispredicted)"),
+		PredictionKey, Prediction.Ability ? *Prediction.Ability->GetName() : TEXT("None"), NumMispredictions, NumPredictedActivations);
+	OnAbilityPredictionRejected.Broadcast(Prediction.Ability, PredictionKey);
+}
+
+float UEldaraCombatComponent::GetMispredictionRate() const
+{
+	return NumPredictedActivations > 0 ? static_cast<float>(NumMispredictions) / NumPredictedActivations : 0.0f;
+}
+
+bool UEldaraCombatComponent::TryActivateAbility(UEldaraAbility* Ability, AActor* Target)
+{
+	FString ErrorMessage;
+	if (!ValidateAbilityActivation(Ability, Target, ErrorMessage))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Server_ActivateAbility: Validation failed - %s"), *ErrorMessage);
+		return false;
+	}
+
 	// Execute ability
 	ExecuteAbility(Ability, Target);
 
 	// Trigger cooldown
 	TriggerCooldown(Ability);
 
-	UE_LOG(LogTemp, Log, TEXT("Server_ActivateAbility: %s activated successfully"), *Ability->GetName());
+	if (UEldaraCombatLog* WorldCombatLog = GetCombatLog())
+	{
+		WorldCombatLog->RecordCast(GetOwner(), Target, Ability);
+	}
+
+	UE_LOG(LogTemp, Verbose, TEXT("Server_ActivateAbility: %s activated successfully"), *Ability->GetName());
+	return true;
+}
+
+void UEldaraCombatComponent::QueueAbility(UEldaraAbility* Ability, AActor* Target, float ReadyIn, int32 PredictionKey)
+{
+	if (QueuedAbility)
+	{
+		UE_LOG(LogTemp, Log, TEXT("Spell queue: %s replaced by %s"), *QueuedAbility->GetName(), *Ability->GetName());
+		SendPredictionResult(QueuedPredictionKey, QueuedAbility, false);
+	}
+
+	QueuedAbility = Ability;
+	QueuedTarget = Target;
+	QueuedPredictionKey = PredictionKey;
+	GetWorld()->GetTimerManager().SetTimer(QueuedAbilityTimer, this, &UEldaraCombatComponent::FireQueuedAbility, ReadyIn, false);
+}
+
+void UEldaraCombatComponent::CancelQueuedAbility()
+{
+	if (UWorld* World = GetWorld())
+	{
+		World->GetTimerManager().ClearTimer(QueuedAbilityTimer);
+	}
+	if (QueuedAbility)
+	{
+		SendPredictionResult(QueuedPredictionKey, QueuedAbility, false);
+	}
+	QueuedAbility = nullptr;
+	QueuedTarget.Reset();
+	QueuedPredictionKey = 0;
+}
+
+void UEldaraCombatComponent::FireQueuedAbility()
+{
+	UEldaraAbility* Ability = QueuedAbility;
+	AActor* Target = QueuedTarget.Get();
+	if (!Ability)
+	{
+		return;
+	}
+
+	// The timer can land a hair early, or another cast may have pushed the global cooldown out
+	const float ReadyIn = GetAbilityCooldownRemaining(Ability);
+	if (ReadyIn > 0.0f && ReadyIn <= SpellQueueWindow)
+	{
+		GetWorld()->GetTimerManager().SetTimer(QueuedAbilityTimer, this, &UEldaraCombatComponent::FireQueuedAbility, ReadyIn, false);
+		return;
+	}
+
+	const int32 PredictionKey = QueuedPredictionKey;
+	QueuedAbility = nullptr;
+	QueuedTarget.Reset();
+	QueuedPredictionKey = 0;
+
+	// Target, range and cost are validated as of now, not as of the request. A client's own
+	// queue predicts and sends the request; the server's answers the client's prediction.
+	if (PredictionKey != 0)
+	{
+		SendPredictionResult(PredictionKey, Ability, TryActivateAbility(Ability, Target));
+	}
+	else
+	{
+		ActivateAbilityNow(Ability, Target);
+	}
 }
 
 bool UEldaraCombatComponent::CanActivateAbility(UEldaraAbility* Ability, AActor* Target)
@@ -78,94 +332,187 @@ void UEldaraCombatComponent::ApplyEffect(UEldaraEffect* Effect, AActor* Instigat
 	if (Effect->Duration <= 0.0f)
 	{
 		// Instant effects apply immediately
-		ApplyEffectMagnitude(Effect, GetOwner(), Instigator);
-		Effect->ExecuteEffect(GetOwner(), Instigator);
+		ApplyEffectMagnitude(Effect, GetOwner(), Instigator, ComputeInstantAmount(*Effect));
 		return;
 	}
 
-	// Find existing stack
-	FActiveEffectRuntime* Existing = nullptr;
-	if (int32* ExistingIndex = EffectIndexMap.Find(Effect))
+	UEldaraEffectScheduler* Scheduler = GetEffectScheduler();
+	if (!Scheduler)
 	{
-		if (ActiveEffectRuntime.IsValidIndex(*ExistingIndex))
-		{
-			Existing = &ActiveEffectRuntime[*ExistingIndex];
-		}
-		else
-		{
-			EffectIndexMap.Remove(Effect);
-		}
+		UE_LOG(LogTemp, Warning, TEXT("ApplyEffect: No effect scheduler in this world, %s not applied"), *Effect->GetName());
+		return;
 	}
+	const double Now = Scheduler->GetTime();
 
-	if (Existing)
+	// Find existing stack (per effect, or per effect and instigator)
+	const FEldaraActiveEffectHandle ExistingHandle = ActiveEffectStore.FindStack(*Effect, Instigator);
+	if (FActiveEffectRuntime* Existing = ActiveEffectStore.Find(ExistingHandle))
 	{
-		if (Existing->Stacks < Effect->MaxStacks)
-		{
-			Existing->Stacks++;
-		}
-		if (Effect->bRefreshDuration)
+		if (EldaraCombatRules::Reapply(*Existing, *Effect, Now))
 		{
-			Existing->RemainingTime = Effect->Duration;
-			Existing->NextTickTime = Effect->TickInterval;
+			ScheduleEffectEvents(Scheduler, ExistingHandle, *Existing);
 		}
+		NotifyStatsChanged(StatAggregator.SetSourceStacks(ExistingHandle, Existing->Stacks));
 	}
 	else
 	{
 		FActiveEffectRuntime Runtime;
-		Runtime.Effect = Effect;
+		EldaraCombatRules::InitApplication(Runtime, Effect, Now);
 		Runtime.InstigatorActor = Instigator;
-		Runtime.RemainingTime = Effect->Duration;
-		Runtime.NextTickTime = Effect->TickInterval;
-		Runtime.Stacks = 1;
-		const int32 NewIndex = ActiveEffectRuntime.Add(Runtime);
-		EffectIndexMap.Add(Effect, NewIndex);
+		const FEldaraActiveEffectHandle NewHandle = ActiveEffectStore.Add(Runtime);
+		ScheduleEffectEvents(Scheduler, NewHandle, *ActiveEffectStore.Find(NewHandle));
+		if (Effect->StatModifiers.Num() > 0)
+		{
+			NotifyStatsChanged(StatAggregator.AddSource(NewHandle, Effect->StatModifiers, 1));
+		}
+		if (Effect->EffectType == EEffectType::CrowdControl)
+		{
+			RefreshCrowdControl();
+		}
 
 		// Apply initial tick immediately if no interval
 		if (Effect->TickInterval <= 0.0f)
 		{
-			ApplyEffectMagnitude(Effect, GetOwner(), Instigator);
+			ApplyEffectMagnitude(Effect, GetOwner(), Instigator, ComputeInstantAmount(*Effect));
 		}
 	}
 
-	UE_LOG(LogTemp, Log, TEXT("ApplyEffect: %s applied to %s (duration %.2fs)"), 
+	UE_LOG(LogTemp, Verbose, TEXT("ApplyEffect: %s applied to %s (duration %.2fs)"), 
 		*Effect->GetName(), *GetOwner()->GetName(), Effect->Duration);
 }
 
 bool UEldaraCombatComponent::IsAbilityOnCooldown(UEldaraAbility* Ability) const
 {
-	if (!Ability)
+	return IsAbilitySlotOnCooldown(CooldownTable.FindSlot(Ability));
+}
+
+float UEldaraCombatComponent::GetAbilityCooldownRemaining(UEldaraAbility* Ability) const
+{
+	const int32 Slot = CooldownTable.FindSlot(Ability);
+	if (Slot == INDEX_NONE)
+	{
+		return 0.0f;
+	}
+
+	const double Now = GetWorld()->GetTimeSeconds();
+	const float GlobalRemaining = CooldownTable.GetGlobalRemaining(Slot, Now);
+	if (CooldownTable.GetCharges(Slot, Now) > 0)
+	{
+		return GlobalRemaining;
+	}
+	return FMath::Max(CooldownTable.GetRechargeRemaining(Slot, Now), GlobalRemaining);
+}
+
+int32 UEldaraCombatComponent::GrantAbility(UEldaraAbility* Ability)
+{
+	return Ability ? CooldownTable.Grant(Ability) : INDEX_NONE;
+}
+
+bool UEldaraCombatComponent::IsAbilitySlotOnCooldown(int32 Slot) const
+{
+	// Never-granted abilities have never been used
+	if (Slot < 0 || Slot >= CooldownTable.Num())
 	{
 		return false;
 	}
+	return CooldownTable.IsOnCooldown(Slot, GetWorld()->GetTimeSeconds());
+}
 
-	const float* CooldownEndTime = AbilityCooldowns.Find(Ability->GetFName());
-	if (CooldownEndTime)
+void UEldaraCombatComponent::GetCooldownSnapshot(TArray<FEldaraCooldownState>& OutStates) const
+{
+	CooldownTable.GetSnapshot(GetWorld()->GetTimeSeconds(), OutStates);
+}
+
+void UEldaraCombatComponent::SetStatBaseValue(EEldaraStat Stat, float Value)
+{
+	NotifyStatsChanged(StatAggregator.SetBaseValue(Stat, Value));
+}
+
+void UEldaraCombatComponent::NotifyStatsChanged(uint32 ChangedMask)
+{
+	if (ChangedMask == 0)
 	{
-		return GetWorld()->GetTimeSeconds() < *CooldownEndTime;
+		return;
 	}
 
-	return false;
+	AEldaraCharacterBase* OwnerCharacter = GetOwnerCharacter();
+	for (int32 StatIndex = 0; StatIndex < FEldaraStatAggregator::NumStats; ++StatIndex)
+	{
+		if (ChangedMask & (1u << StatIndex))
+		{
+			const EEldaraStat Stat = static_cast<EEldaraStat>(StatIndex);
+			const float NewValue = StatAggregator.GetValue(Stat);
+			StatValues[StatIndex] = NewValue;
+			if (OwnerCharacter)
+			{
+				OwnerCharacter->HandleStatChanged(Stat, NewValue);
+			}
+			OnStatChanged.Broadcast(Stat, NewValue);
+		}
+	}
 }
 
-float UEldaraCombatComponent::GetAbilityCooldownRemaining(UEldaraAbility* Ability) const
+void UEldaraCombatComponent::OnRep_StatValues(const TArray<float>& OldStatValues)
 {
-	if (!Ability)
+	// The owner's vitals replicate on their own, so only listeners are notified here
+	for (int32 StatIndex = 0; StatIndex < StatValues.Num(); ++StatIndex)
 	{
-		return 0.0f;
+		if (!OldStatValues.IsValidIndex(StatIndex) || OldStatValues[StatIndex] != StatValues[StatIndex])
+		{
+			OnStatChanged.Broadcast(static_cast<EEldaraStat>(StatIndex), StatValues[StatIndex]);
+		}
+	}
+}
+
+void UEldaraCombatComponent::ResetCombatState()
+{
+	CancelQueuedAbility();
+	PendingPredictions.Reset();
+	CancelEffectEvents();
+	CooldownTable.ResetCooldowns();
+	ActiveEffects.Reset();
+	ActiveEffectStore.Reset();
+	NotifyStatsChanged(StatAggregator.RemoveAllSources());
+	RefreshCrowdControl();
+}
+
+void UEldaraCombatComponent::GetActiveEffectHandles(TArray<FEldaraActiveEffectHandle>& OutHandles) const
+{
+	OutHandles.Reset(ActiveEffectStore.Num());
+	for (int32 DenseIndex = 0; DenseIndex < ActiveEffectStore.Num(); ++DenseIndex)
+	{
+		OutHandles.Add(ActiveEffectStore.GetHandle(DenseIndex));
 	}
+}
 
-	const float* CooldownEndTime = AbilityCooldowns.Find(Ability->GetFName());
-	if (CooldownEndTime)
+UEldaraEffect* UEldaraCombatComponent::GetActiveEffectInfo(FEldaraActiveEffectHandle Handle, int32& OutStacks, float& OutRemainingTime) const
+{
+	const FActiveEffectRuntime* Runtime = ActiveEffectStore.Find(Handle);
+	if (!Runtime)
 	{
-		float Remaining = *CooldownEndTime - GetWorld()->GetTimeSeconds();
-		return FMath::Max(0.0f, Remaining);
+		OutStacks = 0;
+		OutRemainingTime = 0.0f;
+		return nullptr;
 	}
 
-	return 0.0f;
+	OutStacks = Runtime->Stacks;
+	OutRemainingTime = FMath::Max(0.0f, static_cast<float>(Runtime->ExpireTime - GetWorld()->GetTimeSeconds()));
+	return Runtime->Effect;
 }
 
 bool UEldaraCombatComponent::ValidateAbilityActivation(UEldaraAbility* Ability, AActor* Target, FString& OutErrorMessage)
 {
+	if (CrowdControlMask & IncapacitatingCrowdControl)
+	{
+		OutErrorMessage = TEXT("Incapacitated");
+		return false;
+	}
+	if (HasCrowdControl(ECrowdControlType::Silence))
+	{
+		OutErrorMessage = TEXT("Silenced");
+		return false;
+	}
+
 	// Check cooldown
 	if (IsAbilityOnCooldown(Ability))
 	{
@@ -173,31 +520,10 @@ bool UEldaraCombatComponent::ValidateAbilityActivation(UEldaraAbility* Ability,
 		return false;
 	}
 
-	AEldaraCharacterBase* OwnerCharacter = GetOwnerCharacter();
-	if (OwnerCharacter && Ability->ResourceCost > 0.0f)
+	const AEldaraCharacterBase* OwnerCharacter = GetOwnerCharacter();
+	if (OwnerCharacter && !EldaraCombatRules::CanPayCost(*Ability, OwnerCharacter->GetHealth(), OwnerCharacter->GetResource(), OutErrorMessage))
 	{
-		switch (Ability->ResourceType)
-		{
-		case EResourceType::Health:
-			if (OwnerCharacter->GetHealth() < Ability->ResourceCost)
-			{
-				OutErrorMessage = TEXT("Not enough health to cast");
-				return false;
-			}
-			break;
-		case EResourceType::Mana:
-		case EResourceType::Rage:
-		case EResourceType::Energy:
-		case EResourceType::Focus:
-		case EResourceType::Corruption:
-		default:
-			if (OwnerCharacter->GetResource() < Ability->ResourceCost)
-			{
-				OutErrorMessage = TEXT("Not enough resource");
-				return false;
-			}
-			break;
-		}
+		return false;
 	}
 
 	// Target validation
@@ -249,7 +575,7 @@ void UEldaraCombatComponent::ExecuteAbility(UEldaraAbility* Ability, AActor* Tar
 		ResolvedTarget = GetOwner();
 	}
 
-	UE_LOG(LogTemp, Log, TEXT("ExecuteAbility: %s executed on %s"), 
+	UE_LOG(LogTemp, Verbose, TEXT("ExecuteAbility: %s executed on %s"), 
 		*Ability->GetName(), ResolvedTarget ? *ResolvedTarget->GetName() : TEXT("No Target"));
 
 	// Apply effects
@@ -279,111 +605,199 @@ void UEldaraCombatComponent::TriggerCooldown(UEldaraAbility* Ability)
 		return;
 	}
 
-	float CooldownEndTime = GetWorld()->GetTimeSeconds() + Ability->Cooldown;
-	AbilityCooldowns.Add(Ability->GetFName(), CooldownEndTime);
+	const int32 Slot = CooldownTable.Grant(Ability);
+	CooldownTable.Commit(Slot, GetWorld()->GetTimeSeconds(), GlobalCooldown);
 
-	UE_LOG(LogTemp, Log, TEXT("TriggerCooldown: %s cooldown set for %.1f seconds"), 
+	UE_LOG(LogTemp, Verbose, TEXT("TriggerCooldown: %s cooldown set for %.1f seconds"), 
 		*Ability->GetName(), Ability->Cooldown);
 }
 
-void UEldaraCombatComponent::UpdateActiveEffects(float DeltaTime)
+int32 UEldaraCombatComponent::GatherEffectTick(FEldaraActiveEffectHandle Handle, FEldaraEffectTickBatch& Batch) const
 {
-	bool bNeedsCleanup = false;
+	const FActiveEffectRuntime* Runtime = ActiveEffectStore.Find(Handle);
+	if (!Runtime || !Runtime->Effect)
+	{
+		return INDEX_NONE;
+	}
+
+	return Batch.Add(*Runtime->Effect, Runtime->Stacks);
+}
 
-	for (FActiveEffectRuntime& Runtime : ActiveEffectRuntime)
+void UEldaraCombatComponent::CommitEffectTick(FEldaraActiveEffectHandle Handle, double DueTime, float Amount)
+{
+	FActiveEffectRuntime* Runtime = ActiveEffectStore.Find(Handle);
+	if (!Runtime || !Runtime->Effect)
 	{
-		if (!Runtime.Effect)
-		{
-			bNeedsCleanup = true;
-			continue;
-		}
+		return;
+	}
 
-		Runtime.RemainingTime -= DeltaTime;
+	Runtime->TickEvent.Invalidate();
+	ApplyEffectMagnitude(Runtime->Effect, GetOwner(), Runtime->InstigatorActor.Get(), Amount);
 
-		if (Runtime.Effect->TickInterval > 0.0f)
-		{
-			Runtime.NextTickTime -= DeltaTime;
-			if (Runtime.NextTickTime <= 0.0f)
-			{
-				AActor* InstigatorActor = Runtime.InstigatorActor.Get();
-				ApplyEffectMagnitude(Runtime.Effect, GetOwner(), InstigatorActor);
-				Runtime.NextTickTime = Runtime.Effect->TickInterval;
-			}
-		}
+	// Damage can kill and reset the owner, and the store may have moved rows; resolve the handle again
+	Runtime = ActiveEffectStore.Find(Handle);
+	UEldaraEffectScheduler* Scheduler = GetEffectScheduler();
+	if (!Runtime || !Scheduler)
+	{
+		return;
+	}
 
-		if (Runtime.RemainingTime <= 0.0f)
+	if (Runtime->TickEvent.IsValid())
+	{
+		// Refreshed from inside the tick; already rescheduled
+		return;
+	}
+
+	if (EldaraCombatRules::ChainTick(*Runtime, *Runtime->Effect, DueTime))
+	{
+		Runtime->TickEvent = Scheduler->ScheduleEffectEvent(this, Handle, EEldaraEffectEvent::Tick, Runtime->NextTickTime);
+	}
+}
+
+void UEldaraCombatComponent::ExpireEffect(FEldaraActiveEffectHandle Handle)
+{
+	if (FActiveEffectRuntime* Runtime = ActiveEffectStore.Find(Handle))
+	{
+		const bool bWasCrowdControl = Runtime->Effect && Runtime->Effect->EffectType == EEffectType::CrowdControl;
+		CancelEffectEvents(*Runtime);
+		ActiveEffectStore.Remove(Handle);
+		NotifyStatsChanged(StatAggregator.RemoveSource(Handle));
+		if (bWasCrowdControl)
 		{
-			bNeedsCleanup = true;
+			RefreshCrowdControl();
 		}
 	}
+}
+
+float UEldaraCombatComponent::ComputeInstantAmount(const UEldaraEffect& Effect)
+{
+	const UEldaraEffectScheduler* Scheduler = GetEffectScheduler();
+	const float DamageTypeScale = Scheduler ? Scheduler->GetDamageTypeScale(Effect.DamageType) : 1.0f;
+	return FEldaraEffectTickBatch::ComputeAmount(Effect.EffectType, Effect.Magnitude, 1, DamageTypeScale);
+}
 
-	if (bNeedsCleanup)
+void UEldaraCombatComponent::ScheduleEffectEvents(UEldaraEffectScheduler* Scheduler, FEldaraActiveEffectHandle Handle, FActiveEffectRuntime& Runtime)
+{
+	Scheduler->CancelEffectEvent(Runtime.TickEvent);
+	Scheduler->CancelEffectEvent(Runtime.ExpireEvent);
+
+	if (Runtime.Effect->TickInterval > 0.0f)
 	{
-		ActiveEffectRuntime.RemoveAllSwap([](const FActiveEffectRuntime& Runtime)
-		{
-			return !Runtime.Effect || Runtime.RemainingTime <= 0.0f;
-		});
-		RebuildEffectIndexMap();
+		Runtime.TickEvent = Scheduler->ScheduleEffectEvent(this, Handle, EEldaraEffectEvent::Tick, Runtime.NextTickTime);
 	}
+	Runtime.ExpireEvent = Scheduler->ScheduleEffectEvent(this, Handle, EEldaraEffectEvent::Expire, Runtime.ExpireTime);
 }
 
-void UEldaraCombatComponent::ApplyEffectMagnitude(UEldaraEffect* Effect, AActor* Target, AActor* Instigator)
+void UEldaraCombatComponent::CancelEffectEvents(FActiveEffectRuntime& Runtime)
 {
-	if (!Effect || !Target)
+	if (UEldaraEffectScheduler* Scheduler = EffectScheduler.Get())
 	{
-		return;
+		Scheduler->CancelEffectEvent(Runtime.TickEvent);
+		Scheduler->CancelEffectEvent(Runtime.ExpireEvent);
 	}
+}
 
-	AEldaraCharacterBase* TargetCharacter = Cast<AEldaraCharacterBase>(Target);
-	APawn* InstigatorPawn = Instigator ? Cast<APawn>(Instigator) : nullptr;
-	AController* InstigatorController = InstigatorPawn ? InstigatorPawn->GetController() : nullptr;
+void UEldaraCombatComponent::CancelEffectEvents()
+{
+	for (int32 DenseIndex = 0; DenseIndex < ActiveEffectStore.Num(); ++DenseIndex)
+	{
+		CancelEffectEvents(ActiveEffectStore.GetRuntime(DenseIndex));
+	}
+}
 
-	switch (Effect->EffectType)
+UEldaraEffectScheduler* UEldaraCombatComponent::GetEffectScheduler()
+{
+	if (!EffectScheduler.IsValid())
 	{
-	case EEffectType::Damage:
-		if (TargetCharacter)
-		{
-			FDamageEvent DamageEvent(UDamageType::StaticClass());
-			TargetCharacter->TakeDamage(Effect->Magnitude, DamageEvent, InstigatorController, Instigator);
-		}
-		else
+		if (UWorld* World = GetWorld())
 		{
-			Target->TakeDamage(Effect->Magnitude, FDamageEvent(), InstigatorController, Instigator);
+			EffectScheduler = World->GetSubsystem<UEldaraEffectScheduler>();
 		}
-		break;
-	case EEffectType::Healing:
-		if (TargetCharacter)
+	}
+	return EffectScheduler.Get();
+}
+
+UEldaraCombatEventAggregator* UEldaraCombatComponent::GetCombatEventAggregator()
+{
+	if (!CombatEventAggregator.IsValid())
+	{
+		if (UWorld* World = GetWorld())
 		{
-			TargetCharacter->ApplyHealing(Effect->Magnitude);
+			CombatEventAggregator = World->GetSubsystem<UEldaraCombatEventAggregator>();
 		}
-		break;
-	case EEffectType::ResourceRestore:
-		if (TargetCharacter)
+	}
+	return CombatEventAggregator.Get();
+}
+
+UEldaraCombatLog* UEldaraCombatComponent::GetCombatLog()
+{
+	if (!CombatLog.IsValid())
+	{
+		if (UWorld* World = GetWorld())
 		{
-			TargetCharacter->RestoreResource(Effect->Magnitude);
+			CombatLog = World->GetSubsystem<UEldaraCombatLog>();
 		}
-		break;
-	default:
-		// For buffs/debuffs/CC we allow Blueprint to implement details
-		break;
 	}
-
-	Effect->ExecuteEffect(Target, Instigator);
+	return CombatLog.Get();
 }
 
-AEldaraCharacterBase* UEldaraCombatComponent::GetOwnerCharacter() const
+void UEldaraCombatComponent::ApplyEffectMagnitude(UEldaraEffect* Effect, AActor* Target, AActor* Instigator, float Amount)
 {
-	return Cast<AEldaraCharacterBase>(GetOwner());
+	if (!Effect || !Target)
+	{
+		return;
+	}
+
+	FEldaraEffectApplication Application;
+	Application.Effect = Effect;
+	Application.Target = Target;
+	Application.TargetCharacter = Cast<AEldaraCharacterBase>(Target);
+	Application.Instigator = Instigator;
+	const APawn* InstigatorPawn = Cast<APawn>(Instigator);
+	Application.InstigatorController = InstigatorPawn ? InstigatorPawn->GetController() : nullptr;
+	Application.Aggregator = Application.TargetCharacter ? GetCombatEventAggregator() : nullptr;
+	Application.Amount = Amount;
+
+	EldaraEffectKernels::Execute(Application);
 }
 
-void UEldaraCombatComponent::RebuildEffectIndexMap()
+void UEldaraCombatComponent::RefreshCrowdControl()
 {
-	EffectIndexMap.Empty();
-	for (int32 Index = 0; Index < ActiveEffectRuntime.Num(); ++Index)
+	uint32 NewMask = 0;
+	float StrongestSlow = 0.0f;
+	for (int32 DenseIndex = 0; DenseIndex < ActiveEffectStore.Num(); ++DenseIndex)
 	{
-		if (ActiveEffectRuntime[Index].Effect)
+		const UEldaraEffect* Effect = ActiveEffectStore.GetRuntime(DenseIndex).Effect;
+		if (Effect && Effect->EffectType == EEffectType::CrowdControl)
 		{
-			EffectIndexMap.Add(ActiveEffectRuntime[Index].Effect.Get(), Index);
+			NewMask |= 1u << static_cast<uint32>(Effect->CCType);
+			if (Effect->CCType == ECrowdControlType::Slow)
+			{
+				StrongestSlow = FMath::Max(StrongestSlow, Effect->Magnitude);
+			}
 		}
 	}
+
+	const float NewSpeedScale = 1.0f - FMath::Clamp(StrongestSlow, 0.0f, 1.0f);
+	if (NewMask == CrowdControlMask && NewSpeedScale == MovementSpeedScale)
+	{
+		return;
+	}
+
+	CrowdControlMask = NewMask;
+	MovementSpeedScale = NewSpeedScale;
+	OnRep_CrowdControl();
+}
+
+void UEldaraCombatComponent::OnRep_CrowdControl()
+{
+	if (AEldaraCharacterBase* OwnerCharacter = GetOwnerCharacter())
+	{
+		OwnerCharacter->HandleCrowdControlChanged(CrowdControlMask, MovementSpeedScale);
+	}
+}
+
+AEldaraCharacterBase* UEldaraCombatComponent::GetOwnerCharacter() const
+{
+	return Cast<AEldaraCharacterBase>(GetOwner());
 }
@@ -2,33 +2,22 @@
 
 #include "CoreMinimal.h"
 #include "Components/ActorComponent.h"
+#include "Engine/EngineTypes.h"
+#include "EldaraEffect.h"
+#include "Eldara/Combat/EldaraActiveEffectStore.h"
+#include "Eldara/Combat/EldaraCooldownTable.h"
+#include "Eldara/Combat/EldaraStatAggregator.h"
 #include "EldaraCombatComponent.generated.h"
 
 // Forward declarations
 class UEldaraAbility;
-class UEldaraEffect;
+class UEldaraEffectScheduler;
+class UEldaraCombatEventAggregator;
+class UEldaraCombatLog;
+struct FEldaraEffectTickBatch;
 
-/** Runtime state for an applied UEldaraEffect (duration, ticking, instigator) */
-USTRUCT()
-struct FActiveEffectRuntime
-{
-	GENERATED_BODY()
-
-	UPROPERTY()
-	TObjectPtr<UEldaraEffect> Effect;
-
-	UPROPERTY()
-	TWeakObjectPtr<AActor> InstigatorActor;
-
-	UPROPERTY()
-	float RemainingTime = 0.0f;
-
-	UPROPERTY()
-	float NextTickTime = 0.0f;
-
-	UPROPERTY()
-	int32 Stacks = 1;
-};
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnEldaraStatChanged, EEldaraStat, Stat, float, NewValue);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnEldaraAbilityPrediction, UEldaraAbility*, Ability, int32, PredictionKey);
 
 /**
  * Combat Component
@@ -45,18 +34,68 @@ public:
 
 protected:
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 public:	
-	virtual void TickComponent(float DeltaTime, ELevelTick TickType, 
-		FActorComponentTickFunction* ThisTickFunction) override;
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+
+	/**
+	 * Activate an ability from local input. On a client the cooldown, cost and cast animation
+	 * are applied at once under a prediction key and rolled back if the server rejects it; on
+	 * the server the ability runs directly.
+	 * @return False if the ability cannot be used now (nothing was sent)
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Combat")
+	bool ActivateAbility(UEldaraAbility* Ability, AActor* Target);
 
 	/**
 	 * Server RPC: Activate an ability
 	 * @param Ability The ability to activate
 	 * @param Target The target actor (can be nullptr for self/ground-targeted abilities)
+	 * @param PredictionKey Client prediction to confirm or reject (0 = not predicted)
 	 */
 	UFUNCTION(Server, Reliable)
-	void Server_ActivateAbility(UEldaraAbility* Ability, AActor* Target);
+	void Server_ActivateAbility(UEldaraAbility* Ability, AActor* Target, int32 PredictionKey);
+
+	/** Client RPC: Server verdict on a predicted activation of Ability (nullptr if the server could not resolve it) */
+	UFUNCTION(Client, Reliable)
+	void Client_ResolvePrediction(int32 PredictionKey, UEldaraAbility* Ability, bool bAccepted);
+
+	/**
+	 * Confirm or roll back a predicted activation. Unknown keys are ignored, as are verdicts
+	 * naming a different ability than the one predicted under the key.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Combat")
+	void ResolvePrediction(int32 PredictionKey, UEldaraAbility* Ability, bool bAccepted);
+
+	/** Fired on the owning client when an activation is predicted */
+	UPROPERTY(BlueprintAssignable, Category = "Combat")
+	FOnEldaraAbilityPrediction OnAbilityPredicted;
+
+	/** Fired on the owning client after a rejected prediction has been rolled back */
+	UPROPERTY(BlueprintAssignable, Category = "Combat")
+	FOnEldaraAbilityPrediction OnAbilityPredictionRejected;
+
+	/** Predictions made by this client, and how many of them the server rejected */
+	UFUNCTION(BlueprintPure, Category = "Combat")
+	int32 GetNumPredictedActivations() const { return NumPredictedActivations; }
+
+	UFUNCTION(BlueprintPure, Category = "Combat")
+	int32 GetNumMispredictions() const { return NumMispredictions; }
+
+	UFUNCTION(BlueprintPure, Category = "Combat")
+	float GetMispredictionRate() const;
+
+	/** Server RPC: Drop the ability waiting in the spell queue, if any */
+	UFUNCTION(Server, Reliable)
+	void Server_CancelQueuedAbility();
+
+	/** Ability waiting in the spell queue (server only), or nullptr */
+	UFUNCTION(BlueprintPure, Category = "Combat")
+	UEldaraAbility* GetQueuedAbility() const { return QueuedAbility; }
+
+	/** Drop the queued ability without casting it */
+	void CancelQueuedAbility();
 
 	/**
 	 * Check if an ability can be activated
@@ -91,10 +130,95 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Combat")
 	float GetAbilityCooldownRemaining(UEldaraAbility* Ability) const;
 
+	/**
+	 * Grant an ability a cooldown slot (abilities are also granted implicitly on first use)
+	 * @return The ability's slot, stable until ResetCombatState
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Combat")
+	int32 GrantAbility(UEldaraAbility* Ability);
+
+	/** Slot of a granted ability, or -1 */
+	UFUNCTION(BlueprintPure, Category = "Combat")
+	int32 GetAbilitySlot(const UEldaraAbility* Ability) const { return CooldownTable.FindSlot(Ability); }
+
+	/** Constant-time cooldown check by slot, for action bars that cache their slot */
+	UFUNCTION(BlueprintPure, Category = "Combat")
+	bool IsAbilitySlotOnCooldown(int32 Slot) const;
+
+	/** Cooldown state of every granted ability in one pass (index = slot) */
+	UFUNCTION(BlueprintCallable, Category = "Combat")
+	void GetCooldownSnapshot(TArray<FEldaraCooldownState>& OutStates) const;
+
+	/** Final value of a stat after active effect modifiers (cached; replicated to clients) */
+	UFUNCTION(BlueprintPure, Category = "Combat")
+	float GetStatValue(EEldaraStat Stat) const { return StatValues[static_cast<int32>(Stat)]; }
+
+	/** Set the unmodified value of a stat (from class/race data, equipment, level) */
+	UFUNCTION(BlueprintCallable, Category = "Combat")
+	void SetStatBaseValue(EEldaraStat Stat, float Value);
+
+	/** Fired when a stat's final value changes, on the server and on clients as the value replicates */
+	UPROPERTY(BlueprintAssignable, Category = "Combat")
+	FOnEldaraStatChanged OnStatChanged;
+
+	static constexpr uint32 CrowdControlBit(ECrowdControlType Type) { return 1u << static_cast<uint32>(Type); }
+
+	/** Crowd control that prevents casting */
+	static constexpr uint32 IncapacitatingCrowdControl = CrowdControlBit(ECrowdControlType::Stun) | CrowdControlBit(ECrowdControlType::Sleep)
+		| CrowdControlBit(ECrowdControlType::Fear) | CrowdControlBit(ECrowdControlType::Polymorph);
+
+	/** Crowd control that prevents moving */
+	static constexpr uint32 ImmobilizingCrowdControl = CrowdControlBit(ECrowdControlType::Stun) | CrowdControlBit(ECrowdControlType::Root)
+		| CrowdControlBit(ECrowdControlType::Sleep) | CrowdControlBit(ECrowdControlType::Polymorph);
+
+	/** Is a crowd control effect of this type active on the owner? */
+	UFUNCTION(BlueprintPure, Category = "Combat")
+	bool HasCrowdControl(ECrowdControlType Type) const { return (CrowdControlMask & CrowdControlBit(Type)) != 0; }
+
+	/** Movement speed multiplier from the strongest active slow (1 = unslowed) */
+	UFUNCTION(BlueprintPure, Category = "Combat")
+	float GetMovementSpeedScale() const { return MovementSpeedScale; }
+
+	/** Clear all cooldowns (grants are kept) and drop active effects (used when a pooled actor is reused) */
+	void ResetCombatState();
+
+	/** Handles of every active effect, for buff/debuff UI; valid until the effect is removed */
+	UFUNCTION(BlueprintCallable, Category = "Combat")
+	void GetActiveEffectHandles(TArray<FEldaraActiveEffectHandle>& OutHandles) const;
+
+	/**
+	 * Look up an active effect by handle
+	 * @return The effect asset, or nullptr if the handle is stale
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Combat")
+	UEldaraEffect* GetActiveEffectInfo(FEldaraActiveEffectHandle Handle, int32& OutStacks, float& OutRemainingTime) const;
+
+	/**
+	 * Effect scheduler callbacks, run once per due event.
+	 * GatherEffectTick snapshots a tick's inputs into the frame batch (row index, or INDEX_NONE
+	 * if the instance is gone); CommitEffectTick applies the computed amount and chains the
+	 * next tick; ExpireEffect removes the instance. Stale handles are ignored.
+	 */
+	int32 GatherEffectTick(FEldaraActiveEffectHandle Handle, FEldaraEffectTickBatch& Batch) const;
+	void CommitEffectTick(FEldaraActiveEffectHandle Handle, double DueTime, float Amount);
+	void ExpireEffect(FEldaraActiveEffectHandle Handle);
+
 protected:
-	/** Map of ability names to their cooldown end times for better performance */
+	/** Global cooldown in seconds started by abilities that are on it */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Combat")
+	float GlobalCooldown = 1.0f;
+
+	/**
+	 * Spell queue window in seconds. A request for an ability that becomes castable within
+	 * this time is held and cast the moment it is ready instead of being rejected, so
+	 * players with high latency keep the same cast uptime as local ones. 0 disables queuing.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Combat", meta = (ClampMin = "0.0"))
+	float SpellQueueWindow = 0.4f;
+
+	/** Charges, shared groups and global cooldown of granted abilities */
 	UPROPERTY()
-	TMap<FName, float> AbilityCooldowns;
+	FEldaraCooldownTable CooldownTable;
 
 	/** List of active effects on this actor */
 	UPROPERTY()
@@ -102,10 +226,86 @@ protected:
 
 	/** Internal active effect tracking */
 	UPROPERTY()
-	TArray<struct FActiveEffectRuntime> ActiveEffectRuntime;
+	FEldaraActiveEffectStore ActiveEffectStore;
+
+	/** Stat values with the modifiers of active effects applied */
+	UPROPERTY()
+	FEldaraStatAggregator StatAggregator;
+
+	/** Final stat values by EEldaraStat, mirrored from StatAggregator so clients can read and bind to them */
+	UPROPERTY(ReplicatedUsing = OnRep_StatValues)
+	TArray<float> StatValues;
+
+	/** Push changed stats to the owning character, the replicated values and listeners */
+	void NotifyStatsChanged(uint32 ChangedMask);
+
+	/** Broadcast OnStatChanged on clients for the stats that replicated a new value */
+	UFUNCTION()
+	void OnRep_StatValues(const TArray<float>& OldStatValues);
 
+	/**
+	 * Active crowd control types, one bit per ECrowdControlType, and the slow it applies.
+	 * Replicated so the owning client predicts movement and casts under the same control.
+	 */
+	UPROPERTY(ReplicatedUsing = OnRep_CrowdControl)
+	uint32 CrowdControlMask = 0;
+
+	UPROPERTY(ReplicatedUsing = OnRep_CrowdControl)
+	float MovementSpeedScale = 1.0f;
+
+	/** Apply replicated crowd control to the owner's movement on clients */
+	UFUNCTION()
+	void OnRep_CrowdControl();
+
+	/** Rebuild crowd control state from the active effects and notify the owner if it changed */
+	void RefreshCrowdControl();
+
+	/** The single spell queue slot; a newer request replaces the pending one */
 	UPROPERTY()
-	TMap<TObjectPtr<UEldaraEffect>, int32> EffectIndexMap;
+	TObjectPtr<UEldaraAbility> QueuedAbility;
+
+	TWeakObjectPtr<AActor> QueuedTarget;
+	int32 QueuedPredictionKey = 0;
+	FTimerHandle QueuedAbilityTimer;
+
+	/** Local state applied by one unanswered prediction, kept for rollback */
+	struct FPredictedActivation
+	{
+		int32 Key = 0;
+		TObjectPtr<UEldaraAbility> Ability;
+		FEldaraCooldownCommit Cooldown;
+		float ResourceSpent = 0.0f;
+		bool bSpentHealth = false;
+	};
+
+	/** Unanswered predictions, oldest first */
+	TArray<FPredictedActivation> PendingPredictions;
+	int32 LastPredictionKey = 0;
+
+	/** Cap on unanswered predictions; beyond it requests are sent unpredicted */
+	static constexpr int32 MaxPendingPredictions = 8;
+
+	/** Misprediction telemetry (owning client only) */
+	int32 NumPredictedActivations = 0;
+	int32 NumMispredictions = 0;
+
+	/** Run now: directly on the server, predicted and sent from a client */
+	bool ActivateAbilityNow(UEldaraAbility* Ability, AActor* Target);
+
+	/** Apply an activation locally ahead of the server; returns its prediction key */
+	int32 PredictAbility(UEldaraAbility* Ability);
+
+	/** Answer a client's prediction (no-op for unpredicted requests) */
+	void SendPredictionResult(int32 PredictionKey, UEldaraAbility* Ability, bool bAccepted);
+
+	/** Validate, execute and start the cooldown of an ability; false if it was rejected */
+	bool TryActivateAbility(UEldaraAbility* Ability, AActor* Target);
+
+	/** Hold Ability in the spell queue until it comes off cooldown in ReadyIn seconds */
+	void QueueAbility(UEldaraAbility* Ability, AActor* Target, float ReadyIn, int32 PredictionKey);
+
+	/** Spell queue timer: cast the queued ability now that it should be ready */
+	void FireQueuedAbility();
 
 	/** Validate ability activation (cooldown, resources, range, etc.) */
 	bool ValidateAbilityActivation(UEldaraAbility* Ability, AActor* Target, FString& OutErrorMessage);
@@ -116,15 +316,32 @@ protected:
 	/** Trigger ability cooldown */
 	void TriggerCooldown(UEldaraAbility* Ability);
 
-	/** Update active effects (tick DoTs/HoTs) */
-	void UpdateActiveEffects(float DeltaTime);
+	/** Register the runtime's next tick (if periodic) and expiry with the effect scheduler */
+	void ScheduleEffectEvents(UEldaraEffectScheduler* Scheduler, FEldaraActiveEffectHandle Handle, FActiveEffectRuntime& Runtime);
+
+	/** Cancel pending scheduler events for one runtime, or for every active effect */
+	void CancelEffectEvents(FActiveEffectRuntime& Runtime);
+	void CancelEffectEvents();
+
+	/** Scheduler for the owning world (cached) */
+	UEldaraEffectScheduler* GetEffectScheduler();
+
+	/** Per-frame damage/healing aggregator for the owning world (cached) */
+	UEldaraCombatEventAggregator* GetCombatEventAggregator();
+
+	/** Binary combat log for the owning world (cached) */
+	UEldaraCombatLog* GetCombatLog();
+
+	/** Apply a single effect tick or instant payload with its already computed amount */
+	void ApplyEffectMagnitude(UEldaraEffect* Effect, AActor* Target, AActor* Instigator, float Amount);
 
-	/** Apply a single effect tick or instant payload */
-	void ApplyEffectMagnitude(UEldaraEffect* Effect, AActor* Target, AActor* Instigator);
+	/** Amount of a single unstacked application, using the world's damage-type scales */
+	float ComputeInstantAmount(const UEldaraEffect& Effect);
 
 	/** Helper to get owning character for resource/vitals */
 	class AEldaraCharacterBase* GetOwnerCharacter() const;
 
-	/** Rebuild effect lookup for fast stacking checks */
-	void RebuildEffectIndexMap();
+	TWeakObjectPtr<UEldaraEffectScheduler> EffectScheduler;
+	TWeakObjectPtr<UEldaraCombatEventAggregator> CombatEventAggregator;
+	TWeakObjectPtr<UEldaraCombatLog> CombatLog;
 };
@@ -2,6 +2,7 @@
 
 #include "CoreMinimal.h"
 #include "Engine/DataAsset.h"
+#include "Eldara/Combat/EldaraStatTypes.h"
 #include "EldaraEffect.generated.h"
 
 // Forward declarations
@@ -76,7 +77,7 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Effect")
 	EDamageType DamageType;
 
-	/** Magnitude of the effect (damage amount, healing amount, stat modifier, etc.) */
+	/** Magnitude of the effect (damage/healing/resource amount; slow fraction for Slow crowd control) */
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Effect")
 	float Magnitude;
 
@@ -96,10 +97,26 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Effect")
 	bool bRefreshDuration;
 
-	/** Crowd control type (for CC effects only) */
+	/** Do applications from different instigators stack separately (e.g. one DoT per caster)? */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Effect")
+	bool bStacksPerInstigator = false;
+
+	/** Stat changes held while the effect is active, scaled by stacks (duration effects only) */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Effect")
+	TArray<FEldaraStatModifier> StatModifiers;
+
+	/** Crowd control type (for CC effects only); held natively for the effect's duration */
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Effect")
 	ECrowdControlType CCType;
 
+	/**
+	 * Also run the ExecuteEffect Blueprint graph on every application and tick. Damage,
+	 * healing, resource restores, stat modifiers and crowd control are all handled natively;
+	 * set this only for effects with custom scripted behaviour.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Effect")
+	bool bExecuteBlueprint = false;
+
 	/** Visual effect on target */
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Visual")
 	TObjectPtr<UParticleSystem> EffectVisual;
@@ -109,7 +126,7 @@ public:
 	TObjectPtr<USoundBase> ApplySound;
 
 	/**
-	 * Execute effect logic (Blueprint implementable)
+	 * Custom effect logic (Blueprint implementable), run only when bExecuteBlueprint is set
 	 * @param Target The actor this effect is applied to
 	 * @param Instigator The actor that caused this effect
 	 */
@@ -7,3 +7,9 @@ AEldaraNPCBase::AEldaraNPCBase()
 	AIControllerClass = AEldaraAIController::StaticClass();
 	AutoPossessAI = EAutoPossessAI::PlacedInWorldOrSpawned;
 }
+
+void AEldaraNPCBase::ResetForReuse()
+{
+	Super::ResetForReuse();
+	ServerState = EEldaraNPCServerState::Idle;
+}
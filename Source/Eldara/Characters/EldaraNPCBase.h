@@ -39,4 +39,8 @@ public:
 
 	/** Apply authoritative state update from server */
 	void ApplyServerState(EEldaraNPCServerState NewState) { ServerState = NewState; }
+
+	virtual EEldaraFaction GetCombatFaction() const override { return Faction; }
+
+	virtual void ResetForReuse() override;
 };
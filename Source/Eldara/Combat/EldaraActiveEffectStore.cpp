@@ -0,0 +1,128 @@
+#include "EldaraActiveEffectStore.h"
+#include "Eldara/Characters/EldaraEffect.h"
+
+FObjectKey FEldaraActiveEffectStore::GetStackInstigator(const UEldaraEffect& Effect, const AActor* Instigator)
+{
+	return Effect.bStacksPerInstigator ? FObjectKey(Instigator) : FObjectKey();
+}
+
+FEldaraActiveEffectHandle FEldaraActiveEffectStore::Add(const FActiveEffectRuntime& Runtime)
+{
+	check(Runtime.Effect);
+
+	int32 SlotIndex = FreeSlot;
+	if (SlotIndex != INDEX_NONE)
+	{
+		FreeSlot = Slots[SlotIndex].NextFree;
+	}
+	else
+	{
+		SlotIndex = Slots.AddDefaulted();
+	}
+
+	FSlot& Slot = Slots[SlotIndex];
+	Slot.DenseIndex = Runtimes.Add(Runtime);
+	Slot.NextFree = INDEX_NONE;
+
+	FStackKey Key;
+	Key.Effect = FObjectKey(Runtime.Effect);
+	Key.Instigator = GetStackInstigator(*Runtime.Effect, Runtime.InstigatorActor.Get());
+	DenseToSlot.Add(SlotIndex);
+	DenseKeys.Add(Key);
+
+	FEldaraActiveEffectHandle Handle;
+	Handle.Index = SlotIndex;
+	Handle.Generation = Slot.Generation;
+	StackIndex.Add(Key, Handle);
+	return Handle;
+}
+
+bool FEldaraActiveEffectStore::Remove(FEldaraActiveEffectHandle Handle)
+{
+	if (!Find(Handle))
+	{
+		return false;
+	}
+
+	FSlot& Slot = Slots[Handle.Index];
+	const int32 DenseIndex = Slot.DenseIndex;
+
+	// Only drop the key if it still points at this instance
+	const FEldaraActiveEffectHandle* Indexed = StackIndex.Find(DenseKeys[DenseIndex]);
+	if (Indexed && *Indexed == Handle)
+	{
+		StackIndex.Remove(DenseKeys[DenseIndex]);
+	}
+
+	const int32 LastIndex = Runtimes.Num() - 1;
+	if (DenseIndex != LastIndex)
+	{
+		Slots[DenseToSlot[LastIndex]].DenseIndex = DenseIndex;
+	}
+	Runtimes.RemoveAtSwap(DenseIndex, 1, EAllowShrinking::No);
+	DenseToSlot.RemoveAtSwap(DenseIndex, 1, EAllowShrinking::No);
+	DenseKeys.RemoveAtSwap(DenseIndex, 1, EAllowShrinking::No);
+
+	Slot.DenseIndex = INDEX_NONE;
+	++Slot.Generation;
+	Slot.NextFree = FreeSlot;
+	FreeSlot = Handle.Index;
+	return true;
+}
+
+FActiveEffectRuntime* FEldaraActiveEffectStore::Find(FEldaraActiveEffectHandle Handle)
+{
+	return const_cast<FActiveEffectRuntime*>(static_cast<const FEldaraActiveEffectStore*>(this)->Find(Handle));
+}
+
+const FActiveEffectRuntime* FEldaraActiveEffectStore::Find(FEldaraActiveEffectHandle Handle) const
+{
+	if (!Slots.IsValidIndex(Handle.Index))
+	{
+		return nullptr;
+	}
+
+	const FSlot& Slot = Slots[Handle.Index];
+	if (Slot.Generation != Handle.Generation || Slot.DenseIndex == INDEX_NONE)
+	{
+		return nullptr;
+	}
+	return &Runtimes[Slot.DenseIndex];
+}
+
+FEldaraActiveEffectHandle FEldaraActiveEffectStore::FindStack(const UEldaraEffect& Effect, const AActor* Instigator) const
+{
+	FStackKey Key;
+	Key.Effect = FObjectKey(&Effect);
+	Key.Instigator = GetStackInstigator(Effect, Instigator);
+
+	const FEldaraActiveEffectHandle* Handle = StackIndex.Find(Key);
+	return Handle ? *Handle : FEldaraActiveEffectHandle();
+}
+
+FEldaraActiveEffectHandle FEldaraActiveEffectStore::GetHandle(int32 DenseIndex) const
+{
+	FEldaraActiveEffectHandle Handle;
+	Handle.Index = DenseToSlot[DenseIndex];
+	Handle.Generation = Slots[Handle.Index].Generation;
+	return Handle;
+}
+
+void FEldaraActiveEffectStore::Reset()
+{
+	// Keep slots (and bump their generations) so handles from before the reset stay stale
+	for (int32 DenseIndex = 0; DenseIndex < Runtimes.Num(); ++DenseIndex)
+	{
+		const int32 SlotIndex = DenseToSlot[DenseIndex];
+		FSlot& Slot = Slots[SlotIndex];
+		Slot.DenseIndex = INDEX_NONE;
+		++Slot.Generation;
+		Slot.NextFree = FreeSlot;
+		FreeSlot = SlotIndex;
+	}
+
+	Runtimes.Reset();
+	DenseToSlot.Reset();
+	DenseKeys.Reset();
+	StackIndex.Reset();
+}
@@ -0,0 +1,142 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
+#include "EldaraTimingWheel.h"
+#include "EldaraActiveEffectStore.generated.h"
+
+class UEldaraEffect;
+
+/**
+ * Stable reference to one active effect instance on one combat component.
+ * Stays valid until that instance is removed; a reused slot gets a new generation, so
+ * stale handles held by UI or in flight in the scheduler never resolve to another effect.
+ */
+USTRUCT(BlueprintType)
+struct FEldaraActiveEffectHandle
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	int32 Index = INDEX_NONE;
+
+	UPROPERTY()
+	uint32 Generation = 0;
+
+	bool IsValid() const { return Index != INDEX_NONE; }
+
+	bool operator==(const FEldaraActiveEffectHandle& Other) const
+	{
+		return Index == Other.Index && Generation == Other.Generation;
+	}
+
+	friend uint32 GetTypeHash(const FEldaraActiveEffectHandle& Handle)
+	{
+		return HashCombine(::GetTypeHash(Handle.Index), ::GetTypeHash(Handle.Generation));
+	}
+};
+
+/** Runtime state for an applied UEldaraEffect (duration, ticking, instigator) */
+USTRUCT()
+struct FActiveEffectRuntime
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TObjectPtr<UEldaraEffect> Effect;
+
+	UPROPERTY()
+	TWeakObjectPtr<AActor> InstigatorActor;
+
+	/** World time the effect expires */
+	UPROPERTY()
+	double ExpireTime = 0.0;
+
+	/** World time of the next periodic tick (unused if the effect does not tick) */
+	UPROPERTY()
+	double NextTickTime = 0.0;
+
+	UPROPERTY()
+	int32 Stacks = 1;
+
+	FEldaraTimerHandle TickEvent;
+	FEldaraTimerHandle ExpireEvent;
+};
+
+/**
+ * Active effects of one combat component, as a slot map.
+ *
+ * Runtimes are packed in a dense array for iteration; a sparse slot array maps handles to
+ * dense rows and carries a generation per slot. Add, Find and Remove are O(1): removal
+ * swaps the last row into the hole and patches that row's slot, so nothing is rebuilt.
+ *
+ * Applications stack by (effect, instigator) when the effect stacks per instigator and by
+ * effect alone otherwise; the stack-key index is maintained incrementally alongside.
+ */
+USTRUCT()
+struct ELDARA_API FEldaraActiveEffectStore
+{
+	GENERATED_BODY()
+
+	/** Stack key for an application of Effect by Instigator */
+	static FObjectKey GetStackInstigator(const UEldaraEffect& Effect, const AActor* Instigator);
+
+	FEldaraActiveEffectHandle Add(const FActiveEffectRuntime& Runtime);
+
+	/** Remove an instance; false for stale handles */
+	bool Remove(FEldaraActiveEffectHandle Handle);
+
+	FActiveEffectRuntime* Find(FEldaraActiveEffectHandle Handle);
+	const FActiveEffectRuntime* Find(FEldaraActiveEffectHandle Handle) const;
+
+	/** Instance an application of Effect by Instigator would stack onto (invalid if none) */
+	FEldaraActiveEffectHandle FindStack(const UEldaraEffect& Effect, const AActor* Instigator) const;
+
+	int32 Num() const { return Runtimes.Num(); }
+
+	/** Dense access for iteration; rows move on Remove */
+	FActiveEffectRuntime& GetRuntime(int32 DenseIndex) { return Runtimes[DenseIndex]; }
+	const FActiveEffectRuntime& GetRuntime(int32 DenseIndex) const { return Runtimes[DenseIndex]; }
+	FEldaraActiveEffectHandle GetHandle(int32 DenseIndex) const;
+
+	/** Drop every instance; outstanding handles become stale */
+	void Reset();
+
+private:
+	struct FSlot
+	{
+		int32 DenseIndex = INDEX_NONE;
+		uint32 Generation = 0;
+		/** Next free slot while this one is free */
+		int32 NextFree = INDEX_NONE;
+	};
+
+	struct FStackKey
+	{
+		FObjectKey Effect;
+		FObjectKey Instigator;
+
+		bool operator==(const FStackKey& Other) const
+		{
+			return Effect == Other.Effect && Instigator == Other.Instigator;
+		}
+
+		friend uint32 GetTypeHash(const FStackKey& Key)
+		{
+			return HashCombine(GetTypeHash(Key.Effect), GetTypeHash(Key.Instigator));
+		}
+	};
+
+	/** Dense rows */
+	UPROPERTY()
+	TArray<FActiveEffectRuntime> Runtimes;
+
+	/** Slot index and stack key of each dense row */
+	TArray<int32> DenseToSlot;
+	TArray<FStackKey> DenseKeys;
+
+	TArray<FSlot> Slots;
+	int32 FreeSlot = INDEX_NONE;
+
+	TMap<FStackKey, FEldaraActiveEffectHandle> StackIndex;
+};
@@ -0,0 +1,146 @@
+#include "EldaraCombatEventAggregator.h"
+#include "Eldara/Characters/EldaraCharacterBase.h"
+#include "Eldara/Characters/EldaraEffect.h"
+#include "Engine/World.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/Controller.h"
+
+void UEldaraCombatEventAggregator::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	// Post-actor-tick runs after every tick group and tickable (including the effect scheduler)
+	PostActorTickHandle = FWorldDelegates::OnWorldPostActorTick.AddUObject(this, &UEldaraCombatEventAggregator::HandlePostActorTick);
+}
+
+void UEldaraCombatEventAggregator::Deinitialize()
+{
+	FWorldDelegates::OnWorldPostActorTick.Remove(PostActorTickHandle);
+	PostActorTickHandle.Reset();
+
+	PendingTargets.Reset();
+	PendingIndexByTarget.Reset();
+	FlushingTargets.Reset();
+	PendingHits.Reset();
+	Hits.Reset();
+	Summaries.Reset();
+
+	Super::Deinitialize();
+}
+
+bool UEldaraCombatEventAggregator::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UEldaraCombatEventAggregator::HandlePostActorTick(UWorld* InWorld, ELevelTick TickType, float DeltaSeconds)
+{
+	if (InWorld == GetWorld())
+	{
+		Flush();
+	}
+}
+
+void UEldaraCombatEventAggregator::AddDamage(AEldaraCharacterBase* Target, AActor* Instigator, UEldaraEffect* Effect, float Amount)
+{
+	AddHit(Target, Instigator, Effect, Amount, false);
+}
+
+void UEldaraCombatEventAggregator::AddHealing(AEldaraCharacterBase* Target, AActor* Instigator, UEldaraEffect* Effect, float Amount)
+{
+	AddHit(Target, Instigator, Effect, Amount, true);
+}
+
+UEldaraCombatEventAggregator::FPendingTarget& UEldaraCombatEventAggregator::FindOrAddPending(AEldaraCharacterBase* Target)
+{
+	const FObjectKey Key(Target);
+	if (const int32* Index = PendingIndexByTarget.Find(Key))
+	{
+		return PendingTargets[*Index];
+	}
+
+	const int32 Index = PendingTargets.AddDefaulted();
+	PendingIndexByTarget.Add(Key, Index);
+	PendingTargets[Index].Target = Target;
+	return PendingTargets[Index];
+}
+
+void UEldaraCombatEventAggregator::AddHit(AEldaraCharacterBase* Target, AActor* Instigator, UEldaraEffect* Effect, float Amount, bool bHealing)
+{
+	if (!Target || Amount <= 0.0f)
+	{
+		return;
+	}
+
+	FPendingTarget& Pending = FindOrAddPending(Target);
+	if (bHealing)
+	{
+		Pending.Healing += Amount;
+	}
+	else
+	{
+		Pending.Damage += Amount;
+		if (Instigator)
+		{
+			Pending.LastDamageInstigator = Instigator;
+		}
+	}
+	++Pending.NumHits;
+
+	if (OnCombatFrameFlushed.IsBound())
+	{
+		FEldaraCombatHit& Hit = PendingHits.AddDefaulted_GetRef();
+		Hit.Target = Target;
+		Hit.Instigator = Instigator;
+		Hit.Effect = Effect;
+		Hit.Amount = Amount;
+		Hit.bHealing = bHealing;
+	}
+}
+
+void UEldaraCombatEventAggregator::Flush()
+{
+	Summaries.Reset();
+	Hits.Reset();
+	HitsLastFlush = 0;
+	if (PendingTargets.Num() == 0)
+	{
+		return;
+	}
+
+	// Death handling can raise new hits; those queue for the next flush
+	Swap(PendingTargets, FlushingTargets);
+	Swap(PendingHits, Hits);
+	PendingTargets.Reset();
+	PendingHits.Reset();
+	PendingIndexByTarget.Reset();
+
+	for (const FPendingTarget& Pending : FlushingTargets)
+	{
+		HitsLastFlush += Pending.NumHits;
+
+		AEldaraCharacterBase* Target = Pending.Target.Get();
+		if (!Target)
+		{
+			continue;
+		}
+
+		AActor* Instigator = Pending.LastDamageInstigator.Get();
+		const APawn* InstigatorPawn = Cast<APawn>(Instigator);
+		AController* InstigatorController = InstigatorPawn ? InstigatorPawn->GetController() : nullptr;
+
+		const bool bWasDead = Target->IsDead();
+		Target->ApplyHealthChange(Pending.Damage, Pending.Healing, InstigatorController, Instigator);
+
+		FEldaraCombatTargetSummary& Summary = Summaries.AddDefaulted_GetRef();
+		Summary.Target = Target;
+		Summary.Damage = Pending.Damage;
+		Summary.Healing = Pending.Healing;
+		Summary.NumHits = Pending.NumHits;
+		Summary.RemainingHealth = Target->GetHealth();
+		Summary.bKilled = !bWasDead && Target->IsDead();
+	}
+	FlushingTargets.Reset();
+
+	OnCombatFrameFlushed.Broadcast(Summaries, Hits);
+}
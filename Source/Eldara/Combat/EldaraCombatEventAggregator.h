@@ -0,0 +1,141 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "Engine/EngineBaseTypes.h"
+#include "EldaraCombatEventAggregator.generated.h"
+
+class AEldaraCharacterBase;
+class UEldaraEffect;
+
+/** One damage or healing application, as reported to UI and the combat log */
+USTRUCT(BlueprintType)
+struct FEldaraCombatHit
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "Combat")
+	TObjectPtr<AActor> Target = nullptr;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Combat")
+	TObjectPtr<AActor> Instigator = nullptr;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Combat")
+	TObjectPtr<UEldaraEffect> Effect = nullptr;
+
+	/** Amount before clamping to the target's health */
+	UPROPERTY(BlueprintReadOnly, Category = "Combat")
+	float Amount = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Combat")
+	bool bHealing = false;
+};
+
+/** Net result of one frame of damage and healing on one target */
+USTRUCT(BlueprintType)
+struct FEldaraCombatTargetSummary
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "Combat")
+	TObjectPtr<AActor> Target = nullptr;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Combat")
+	float Damage = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Combat")
+	float Healing = 0.0f;
+
+	/** Hits folded into this summary */
+	UPROPERTY(BlueprintReadOnly, Category = "Combat")
+	int32 NumHits = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Combat")
+	float RemainingHealth = 0.0f;
+
+	/** The net change killed the target */
+	UPROPERTY(BlueprintReadOnly, Category = "Combat")
+	bool bKilled = false;
+};
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnCombatFrameFlushed, const TArray<FEldaraCombatTargetSummary>&, Targets, const TArray<FEldaraCombatHit>&, Hits);
+
+/**
+ * Coalesces a frame's damage and healing per target before touching health.
+ *
+ * Effect ticks and instant applications report their amounts here instead of writing
+ * Health one hit at a time. After all actors and tickables have run, each target gets a
+ * single net health change and a single death check, so a boss under dozens of DoTs
+ * dirties its replicated Health once per frame. Then one batched event carries the
+ * per-target summaries and the individual hits for UI and the combat log.
+ *
+ * Kill credit goes to the last instigator that dealt damage to the target that frame.
+ * Healing and damage in the same frame net out before the death check.
+ */
+UCLASS()
+class ELDARA_API UEldaraCombatEventAggregator : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	/** Queue damage to Target; applied at the end of the frame */
+	void AddDamage(AEldaraCharacterBase* Target, AActor* Instigator, UEldaraEffect* Effect, float Amount);
+
+	/** Queue healing to Target; applied at the end of the frame */
+	void AddHealing(AEldaraCharacterBase* Target, AActor* Instigator, UEldaraEffect* Effect, float Amount);
+
+	/** Apply everything queued so far and broadcast it (runs automatically each frame) */
+	void Flush();
+
+	/** Fired once per frame that had any damage or healing */
+	UPROPERTY(BlueprintAssignable, Category = "Eldara|Combat")
+	FOnCombatFrameFlushed OnCombatFrameFlushed;
+
+	/** Hits folded into the last flush */
+	UFUNCTION(BlueprintPure, Category = "Eldara|Combat")
+	int32 GetHitsLastFlush() const { return HitsLastFlush; }
+
+	/** Health writes made by the last flush */
+	UFUNCTION(BlueprintPure, Category = "Eldara|Combat")
+	int32 GetTargetsLastFlush() const { return Summaries.Num(); }
+
+private:
+	struct FPendingTarget
+	{
+		TWeakObjectPtr<AEldaraCharacterBase> Target;
+		TWeakObjectPtr<AActor> LastDamageInstigator;
+		float Damage = 0.0f;
+		float Healing = 0.0f;
+		int32 NumHits = 0;
+	};
+
+	FPendingTarget& FindOrAddPending(AEldaraCharacterBase* Target);
+	void AddHit(AEldaraCharacterBase* Target, AActor* Instigator, UEldaraEffect* Effect, float Amount, bool bHealing);
+	void HandlePostActorTick(UWorld* InWorld, ELevelTick TickType, float DeltaSeconds);
+
+	TArray<FPendingTarget> PendingTargets;
+	TMap<FObjectKey, int32> PendingIndexByTarget;
+
+	/** Targets being applied; swapped with PendingTargets so hits raised during a flush wait for the next one */
+	TArray<FPendingTarget> FlushingTargets;
+
+	/** Individual hits of the current frame; only recorded while OnCombatFrameFlushed is bound */
+	UPROPERTY()
+	TArray<FEldaraCombatHit> PendingHits;
+
+	/** Contents of the last broadcast; reused across frames */
+	UPROPERTY()
+	TArray<FEldaraCombatHit> Hits;
+
+	UPROPERTY()
+	TArray<FEldaraCombatTargetSummary> Summaries;
+
+	int32 HitsLastFlush = 0;
+
+	FDelegateHandle PostActorTickHandle;
+};
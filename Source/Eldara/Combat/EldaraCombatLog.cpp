@@ -0,0 +1,464 @@
+#include "EldaraCombatLog.h"
+#include "Eldara/Characters/EldaraAbility.h"
+#include "Eldara/Characters/EldaraCharacterBase.h"
+#include "Eldara/Characters/EldaraEffect.h"
+#include "Async/Async.h"
+#include "Engine/World.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/DateTime.h"
+#include "Misc/Paths.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogEldaraCombatLog, Log, All);
+
+namespace
+{
+	constexpr int32 MinRingCapacity = 1024;
+	constexpr float MinFlushInterval = 0.1f;
+	constexpr int64 BytesPerMB = 1024 * 1024;
+	constexpr int32 MaxNameLength = MAX_uint16;
+
+	const TCHAR* CombatLogExtension = TEXT(".eclog");
+
+	void AppendBytes(TArray<uint8>& Out, const void* Data, int32 Size)
+	{
+		Out.Append(static_cast<const uint8*>(Data), Size);
+	}
+
+	template <typename T>
+	void AppendValue(TArray<uint8>& Out, const T& Value)
+	{
+		AppendBytes(Out, &Value, sizeof(T));
+	}
+
+	/** Unique display name: characters show their name and actor, assets their asset name */
+	FString GetLogName(const UObject* Object)
+	{
+		if (const AEldaraCharacterBase* Character = Cast<AEldaraCharacterBase>(Object))
+		{
+			const FString CharacterName = Character->GetCharacterName();
+			if (!CharacterName.IsEmpty())
+			{
+				return FString::Printf(TEXT("%s (%s)"), *CharacterName, *Character->GetName());
+			}
+		}
+		return Object->GetName();
+	}
+}
+
+/**
+ * Owns the open log file; runs on the thread pool, one write at a time.
+ */
+class FEldaraCombatLogWriter
+{
+public:
+	FEldaraCombatLogWriter(const FString& InDirectory, int32 InMaxFiles)
+		: Directory(InDirectory)
+		, MaxFiles(FMath::Max(1, InMaxFiles))
+	{
+	}
+
+	/** Append one batch, starting a new file first if asked to */
+	void Write(const TArray<uint8>& Batch, bool bNewFile)
+	{
+		if (bNewFile || !File)
+		{
+			OpenNewFile();
+		}
+		if (File && !File->Write(Batch.GetData(), Batch.Num()))
+		{
+			UE_LOG(LogEldaraCombatLog, Warning, TEXT("Combat log write of %d bytes failed; closing the file"), Batch.Num());
+			File.Reset();
+		}
+		if (File)
+		{
+			File->Flush();
+		}
+	}
+
+private:
+	void OpenNewFile()
+	{
+		File.Reset();
+
+		IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+		PlatformFile.CreateDirectoryTree(*Directory);
+
+		const FDateTime Now = FDateTime::UtcNow();
+		const FString Path = FPaths::Combine(Directory, FString::Printf(TEXT("CombatLog_%s_%03d%s"), *Now.ToString(TEXT("%Y%m%d-%H%M%S")), FileIndex++, CombatLogExtension));
+		File.Reset(PlatformFile.OpenWrite(*Path));
+		if (!File)
+		{
+			UE_LOG(LogEldaraCombatLog, Warning, TEXT("Could not open combat log %s"), *Path);
+			return;
+		}
+
+		FEldaraCombatLogFileHeader Header;
+		Header.StartTicks = Now.GetTicks();
+		File->Write(reinterpret_cast<const uint8*>(&Header), sizeof(Header));
+
+		DeleteOldFiles();
+	}
+
+	/** Keep the newest MaxFiles logs */
+	void DeleteOldFiles() const
+	{
+		TArray<FString> Files;
+		IFileManager::Get().FindFiles(Files, *FPaths::Combine(Directory, FString(TEXT("*")) + CombatLogExtension), true, false);
+		if (Files.Num() <= MaxFiles)
+		{
+			return;
+		}
+
+		// Timestamp and sequence number sort chronologically
+		Files.Sort();
+		for (int32 Index = 0; Index < Files.Num() - MaxFiles; ++Index)
+		{
+			IFileManager::Get().Delete(*FPaths::Combine(Directory, Files[Index]));
+		}
+	}
+
+	FString Directory;
+	int32 MaxFiles = 1;
+	int32 FileIndex = 0;
+	TUniquePtr<IFileHandle> File;
+};
+
+void UEldaraCombatLog::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	if (!bEnabled)
+	{
+		return;
+	}
+
+	Ring.SetNumUninitialized(FMath::Max(RingCapacity, MinRingCapacity));
+	Writer = MakeShared<FEldaraCombatLogWriter, ESPMode::ThreadSafe>(FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("CombatLogs")), MaxFiles);
+
+	UEldaraCombatEventAggregator* EventAggregator = Collection.InitializeDependency<UEldaraCombatEventAggregator>();
+	if (EventAggregator)
+	{
+		EventAggregator->OnCombatFrameFlushed.AddDynamic(this, &UEldaraCombatLog::HandleCombatFrame);
+		Aggregator = EventAggregator;
+	}
+}
+
+void UEldaraCombatLog::Deinitialize()
+{
+	if (UEldaraCombatEventAggregator* EventAggregator = Aggregator.Get())
+	{
+		EventAggregator->OnCombatFrameFlushed.RemoveDynamic(this, &UEldaraCombatLog::HandleCombatFrame);
+	}
+	Aggregator.Reset();
+
+	// Finish the write in flight, then write what is left on this thread
+	if (PendingWrite.IsValid())
+	{
+		PendingWrite.Wait();
+		PendingWrite.Reset();
+	}
+	if (Writer)
+	{
+		const bool bNewFile = bStartNewFile;
+		TArray<uint8> Batch;
+		if (BuildBatch(Batch))
+		{
+			Writer->Write(Batch, bNewFile);
+		}
+		Writer.Reset();
+	}
+
+	Ring.Empty();
+	ObjectIds.Empty();
+	PendingNames.Empty();
+	Meters.Empty();
+
+	Super::Deinitialize();
+}
+
+bool UEldaraCombatLog::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId UEldaraCombatLog::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UEldaraCombatLog, STATGROUP_Tickables);
+}
+
+void UEldaraCombatLog::Tick(float DeltaTime)
+{
+	if (!Writer)
+	{
+		return;
+	}
+
+	TimeSinceFlush += DeltaTime;
+	const bool bHalfFull = WriteCount - FlushedCount >= Ring.Num() / 2;
+	if (TimeSinceFlush >= FMath::Max(FlushInterval, MinFlushInterval) || bHalfFull)
+	{
+		Flush();
+	}
+}
+
+void UEldaraCombatLog::Flush()
+{
+	if (!Writer)
+	{
+		return;
+	}
+
+	// One write in flight at a time; records keep accumulating in the ring meanwhile
+	if (PendingWrite.IsValid() && !PendingWrite.IsReady())
+	{
+		return;
+	}
+	TimeSinceFlush = 0.0f;
+
+	// Forget meter sources that have been idle for the whole history
+	const int64 NowSecond = FMath::FloorToInt64(GetWorld()->GetTimeSeconds());
+	for (auto It = Meters.CreateIterator(); It; ++It)
+	{
+		if (!It.Value().Actor.IsValid() || NowSecond - It.Value().LastSecond >= NumMeterBuckets)
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	const bool bNewFile = bStartNewFile;
+	TArray<uint8> Batch;
+	if (!BuildBatch(Batch))
+	{
+		return;
+	}
+
+	PendingWrite = Async(EAsyncExecution::ThreadPool, [BatchWriter = Writer, Bytes = MoveTemp(Batch), bNewFile]()
+	{
+		BatchWriter->Write(Bytes, bNewFile);
+	});
+}
+
+bool UEldaraCombatLog::BuildBatch(TArray<uint8>& OutBatch)
+{
+	const int64 NumPending = WriteCount - FlushedCount;
+	if (NumPending <= 0)
+	{
+		return false;
+	}
+
+	OutBatch.Reset(PendingNames.Num() + static_cast<int32>(NumPending) * sizeof(FEldaraCombatLogRecord) + 16);
+	if (NumPendingNames > 0)
+	{
+		AppendValue(OutBatch, EldaraCombatLogFormat::NamesChunk);
+		AppendValue(OutBatch, NumPendingNames);
+		OutBatch.Append(PendingNames);
+		PendingNames.Reset();
+		NumPendingNames = 0;
+	}
+
+	// Pending records may wrap around the end of the ring
+	AppendValue(OutBatch, EldaraCombatLogFormat::RecordsChunk);
+	AppendValue(OutBatch, static_cast<uint32>(NumPending));
+	const int32 Capacity = Ring.Num();
+	const int32 First = static_cast<int32>(FlushedCount % Capacity);
+	const int32 FirstSpan = FMath::Min(static_cast<int32>(NumPending), Capacity - First);
+	AppendBytes(OutBatch, Ring.GetData() + First, FirstSpan * sizeof(FEldaraCombatLogRecord));
+	AppendBytes(OutBatch, Ring.GetData(), (static_cast<int32>(NumPending) - FirstSpan) * sizeof(FEldaraCombatLogRecord));
+	FlushedCount = WriteCount;
+
+	// Rotate between batches, when the ring is empty, so no pending record uses an id of the old file
+	BytesInFile += OutBatch.Num();
+	bStartNewFile = false;
+	if (BytesInFile >= static_cast<int64>(FMath::Max(MaxFileSizeMB, 1)) * BytesPerMB)
+	{
+		BytesInFile = 0;
+		bStartNewFile = true;
+		ObjectIds.Reset();
+		NextObjectId = 1;
+	}
+	return true;
+}
+
+uint32 UEldaraCombatLog::GetObjectId(const UObject* Object)
+{
+	if (!Object)
+	{
+		return EldaraCombatLogFormat::NoId;
+	}
+
+	const FObjectKey Key(Object);
+	if (const uint32* Existing = ObjectIds.Find(Key))
+	{
+		return *Existing;
+	}
+
+	const uint32 Id = NextObjectId++;
+	ObjectIds.Add(Key, Id);
+
+	const FTCHARToUTF8 Utf8(*GetLogName(Object));
+	const uint16 Length = static_cast<uint16>(FMath::Min(Utf8.Length(), MaxNameLength));
+	AppendValue(PendingNames, Id);
+	AppendValue(PendingNames, Length);
+	AppendBytes(PendingNames, Utf8.Get(), Length);
+	++NumPendingNames;
+	return Id;
+}
+
+void UEldaraCombatLog::Push(EEldaraCombatLogEvent Event, const UObject* Source, const UObject* Target, const UObject* Ability, const UObject* Effect, float Amount, uint8 Flags)
+{
+	if (!Writer)
+	{
+		return;
+	}
+
+	// Full ring: the oldest unwritten record is overwritten
+	const int32 Capacity = Ring.Num();
+	if (WriteCount - FlushedCount >= Capacity)
+	{
+		++FlushedCount;
+		++DroppedRecords;
+	}
+
+	FEldaraCombatLogRecord& Record = Ring[static_cast<int32>(WriteCount % Capacity)];
+	Record.Time = GetWorld()->GetTimeSeconds();
+	Record.Source = GetObjectId(Source);
+	Record.Target = GetObjectId(Target);
+	Record.Ability = GetObjectId(Ability);
+	Record.Effect = GetObjectId(Effect);
+	Record.Amount = Amount;
+	Record.Event = Event;
+	Record.Flags = Flags;
+	Record.Reserved = 0;
+	++WriteCount;
+}
+
+void UEldaraCombatLog::RecordCast(AActor* Source, AActor* Target, UEldaraAbility* Ability)
+{
+	Push(EEldaraCombatLogEvent::Cast, Source, Target, Ability, nullptr, 0.0f, 0);
+}
+
+void UEldaraCombatLog::RecordThreat(AActor* Source, AActor* Target, float Amount)
+{
+	Push(EEldaraCombatLogEvent::Threat, Source, Target, nullptr, nullptr, Amount, 0);
+}
+
+void UEldaraCombatLog::HandleCombatFrame(const TArray<FEldaraCombatTargetSummary>& Targets, const TArray<FEldaraCombatHit>& Hits)
+{
+	for (const FEldaraCombatHit& Hit : Hits)
+	{
+		// Effects that tick only deal their magnitude on ticks
+		const bool bPeriodic = Hit.Effect && Hit.Effect->Duration > 0.0f && Hit.Effect->TickInterval > 0.0f;
+		Push(Hit.bHealing ? EEldaraCombatLogEvent::Healing : EEldaraCombatLogEvent::Damage, Hit.Instigator, Hit.Target, nullptr, Hit.Effect, Hit.Amount,
+			bPeriodic ? EEldaraCombatLogFlags::Periodic : 0);
+		AddToMeter(Hit.Instigator, Hit.bHealing ? 0.0f : Hit.Amount, Hit.bHealing ? Hit.Amount : 0.0f);
+	}
+
+	for (const FEldaraCombatTargetSummary& Summary : Targets)
+	{
+		if (!Summary.bKilled)
+		{
+			continue;
+		}
+
+		AActor* Killer = nullptr;
+		for (int32 Index = Hits.Num() - 1; Index >= 0; --Index)
+		{
+			if (Hits[Index].Target == Summary.Target && !Hits[Index].bHealing)
+			{
+				Killer = Hits[Index].Instigator;
+				break;
+			}
+		}
+		Push(EEldaraCombatLogEvent::Death, Killer, Summary.Target, nullptr, nullptr, 0.0f, 0);
+	}
+}
+
+void UEldaraCombatLog::AddToMeter(AActor* Source, float Damage, float Healing)
+{
+	if (!Source)
+	{
+		return;
+	}
+
+	const int64 NowSecond = FMath::FloorToInt64(GetWorld()->GetTimeSeconds());
+	FMeterEntry* Entry = Meters.Find(FObjectKey(Source));
+	if (!Entry)
+	{
+		Entry = &Meters.Add(FObjectKey(Source));
+		Entry->Actor = Source;
+		Entry->FirstSecond = NowSecond;
+	}
+	else if (NowSecond - Entry->LastSecond >= NumMeterBuckets)
+	{
+		// Idle for the whole history; rates restart from this hit
+		Entry->FirstSecond = NowSecond;
+	}
+
+	const int32 Bucket = static_cast<int32>(NowSecond % NumMeterBuckets);
+	if (Entry->Seconds[Bucket] != NowSecond)
+	{
+		Entry->Seconds[Bucket] = NowSecond;
+		Entry->Damage[Bucket] = 0.0f;
+		Entry->Healing[Bucket] = 0.0f;
+	}
+	Entry->Damage[Bucket] += Damage;
+	Entry->Healing[Bucket] += Healing;
+	Entry->LastSecond = NowSecond;
+}
+
+float UEldaraCombatLog::GetMeterRate(const FMeterEntry& Entry, bool bHealing, float WindowSeconds) const
+{
+	const int64 NowSecond = FMath::FloorToInt64(GetWorld()->GetTimeSeconds());
+	const int32 Window = FMath::Clamp(FMath::CeilToInt(WindowSeconds), 1, NumMeterBuckets);
+
+	float Total = 0.0f;
+	const float* Values = bHealing ? Entry.Healing : Entry.Damage;
+	for (int32 Bucket = 0; Bucket < NumMeterBuckets; ++Bucket)
+	{
+		if (NowSecond - Entry.Seconds[Bucket] < Window)
+		{
+			Total += Values[Bucket];
+		}
+	}
+
+	// A source that started fighting recently is averaged over its active time, not the full window
+	const int64 ActiveSeconds = FMath::Clamp<int64>(NowSecond - Entry.FirstSecond + 1, 1, Window);
+	return Total / static_cast<float>(ActiveSeconds);
+}
+
+float UEldaraCombatLog::GetDamagePerSecond(AActor* Source, float WindowSeconds) const
+{
+	const FMeterEntry* Entry = Source ? Meters.Find(FObjectKey(Source)) : nullptr;
+	return Entry ? GetMeterRate(*Entry, false, WindowSeconds) : 0.0f;
+}
+
+float UEldaraCombatLog::GetHealingPerSecond(AActor* Source, float WindowSeconds) const
+{
+	const FMeterEntry* Entry = Source ? Meters.Find(FObjectKey(Source)) : nullptr;
+	return Entry ? GetMeterRate(*Entry, true, WindowSeconds) : 0.0f;
+}
+
+int32 UEldaraCombatLog::GetDamageMeter(float WindowSeconds, TArray<FEldaraDamageMeterEntry>& OutEntries) const
+{
+	OutEntries.Reset(Meters.Num());
+	for (const TPair<FObjectKey, FMeterEntry>& Pair : Meters)
+	{
+		AActor* Actor = Pair.Value.Actor.Get();
+		if (!Actor)
+		{
+			continue;
+		}
+
+		FEldaraDamageMeterEntry& Entry = OutEntries.AddDefaulted_GetRef();
+		Entry.Source = Actor;
+		Entry.DamagePerSecond = GetMeterRate(Pair.Value, false, WindowSeconds);
+		Entry.HealingPerSecond = GetMeterRate(Pair.Value, true, WindowSeconds);
+	}
+
+	OutEntries.Sort([](const FEldaraDamageMeterEntry& A, const FEldaraDamageMeterEntry& B)
+	{
+		return A.DamagePerSecond > B.DamagePerSecond;
+	});
+	return OutEntries.Num();
+}
@@ -0,0 +1,155 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "Async/Future.h"
+#include "EldaraCombatLogFormat.h"
+#include "EldaraCombatEventAggregator.h"
+#include "EldaraCombatLog.generated.h"
+
+class UEldaraAbility;
+class FEldaraCombatLogWriter;
+
+/** One row of the live damage meter */
+USTRUCT(BlueprintType)
+struct FEldaraDamageMeterEntry
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "Combat")
+	TObjectPtr<AActor> Source = nullptr;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Combat")
+	float DamagePerSecond = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Combat")
+	float HealingPerSecond = 0.0f;
+};
+
+/**
+ * Binary combat log and live damage meter.
+ *
+ * Damage, healing and deaths come from the combat event aggregator's per-frame flush; casts
+ * and threat are reported by the combat component and AI. Each event becomes a fixed 32-byte
+ * record in a preallocated ring, with actors and assets referred to by small per-file ids.
+ * About once a second the pending records are copied out and appended to the current file
+ * on a worker thread, together with the names of ids first used since the last flush; the
+ * game thread never waits on disk. Files rotate at MaxFileSizeMB and only the newest
+ * MaxFiles are kept. If the writer falls behind the ring keeps the newest records and counts
+ * the dropped ones.
+ *
+ * The meter keeps one-second damage and healing buckets per source for the last minute, so
+ * rolling DPS/HPS queries read a few floats instead of scanning the log.
+ *
+ * Offline analysis: -run=EldaraCombatLog (see UEldaraCombatLogCommandlet).
+ */
+UCLASS(Config=Game)
+class ELDARA_API UEldaraCombatLog : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	/** Source activated Ability on Target */
+	void RecordCast(AActor* Source, AActor* Target, UEldaraAbility* Ability);
+
+	/** Source generated Amount threat on Target */
+	void RecordThreat(AActor* Source, AActor* Target, float Amount);
+
+	/** Damage per second dealt by Source over the last WindowSeconds (at most 60) */
+	UFUNCTION(BlueprintPure, Category = "Eldara|Combat")
+	float GetDamagePerSecond(AActor* Source, float WindowSeconds = 10.0f) const;
+
+	/** Healing per second done by Source over the last WindowSeconds (at most 60) */
+	UFUNCTION(BlueprintPure, Category = "Eldara|Combat")
+	float GetHealingPerSecond(AActor* Source, float WindowSeconds = 10.0f) const;
+
+	/** Every recently active source, highest DPS first; returns the number of entries */
+	UFUNCTION(BlueprintCallable, Category = "Eldara|Combat")
+	int32 GetDamageMeter(float WindowSeconds, TArray<FEldaraDamageMeterEntry>& OutEntries) const;
+
+	/** Hand all pending records to the writer now (if it is idle) */
+	UFUNCTION(BlueprintCallable, Category = "Eldara|Combat")
+	void Flush();
+
+	/** Records overwritten before they could be written */
+	int64 GetNumDroppedRecords() const { return DroppedRecords; }
+
+private:
+	static constexpr int32 NumMeterBuckets = 60;
+
+	/** Rolling per-second totals of one source */
+	struct FMeterEntry
+	{
+		TWeakObjectPtr<AActor> Actor;
+		float Damage[NumMeterBuckets] = {};
+		float Healing[NumMeterBuckets] = {};
+		int64 Seconds[NumMeterBuckets] = {};
+		int64 FirstSecond = 0;
+		int64 LastSecond = 0;
+	};
+
+	UFUNCTION()
+	void HandleCombatFrame(const TArray<FEldaraCombatTargetSummary>& Targets, const TArray<FEldaraCombatHit>& Hits);
+
+	void Push(EEldaraCombatLogEvent Event, const UObject* Source, const UObject* Target, const UObject* Ability, const UObject* Effect, float Amount, uint8 Flags);
+
+	/** Id of an actor or asset in the current file; queues its name on first use */
+	uint32 GetObjectId(const UObject* Object);
+
+	void AddToMeter(AActor* Source, float Damage, float Healing);
+
+	/** Sum of one meter column over the window, per second */
+	float GetMeterRate(const FMeterEntry& Entry, bool bHealing, float WindowSeconds) const;
+
+	/** Serialize pending names and records; returns false if there was nothing to write */
+	bool BuildBatch(TArray<uint8>& OutBatch);
+
+	/** Enable the binary combat log and meter */
+	UPROPERTY(Config)
+	bool bEnabled = true;
+
+	/** Records held in memory between flushes */
+	UPROPERTY(Config)
+	int32 RingCapacity = 65536;
+
+	/** Seconds between flushes to disk */
+	UPROPERTY(Config)
+	float FlushInterval = 1.0f;
+
+	/** Start a new file once the current one reaches this size */
+	UPROPERTY(Config)
+	int32 MaxFileSizeMB = 64;
+
+	/** Rotated files to keep, newest first */
+	UPROPERTY(Config)
+	int32 MaxFiles = 8;
+
+	TArray<FEldaraCombatLogRecord> Ring;
+	int64 WriteCount = 0;
+	int64 FlushedCount = 0;
+	int64 DroppedRecords = 0;
+
+	/** Ids of the current file, and serialized name entries not written yet */
+	TMap<FObjectKey, uint32> ObjectIds;
+	uint32 NextObjectId = 1;
+	TArray<uint8> PendingNames;
+	uint32 NumPendingNames = 0;
+
+	int64 BytesInFile = 0;
+	bool bStartNewFile = true;
+	float TimeSinceFlush = 0.0f;
+
+	TSharedPtr<FEldaraCombatLogWriter, ESPMode::ThreadSafe> Writer;
+	TFuture<void> PendingWrite;
+
+	TMap<FObjectKey, FMeterEntry> Meters;
+
+	TWeakObjectPtr<UEldaraCombatEventAggregator> Aggregator;
+};
@@ -0,0 +1,174 @@
+#include "EldaraCombatLogCommandlet.h"
+#include "EldaraCombatLogFormat.h"
+#include "HAL/FileManager.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogEldaraCombatLogTool, Log, All);
+
+namespace
+{
+	constexpr float DefaultEncounterGap = 5.0f;
+	constexpr int32 DefaultTopSources = 10;
+	constexpr double MinEncounterSeconds = 1.0;
+
+	/** One source's totals within an encounter */
+	struct FSourceTotals
+	{
+		uint32 Source = EldaraCombatLogFormat::NoId;
+		double Damage = 0.0;
+		double PeriodicDamage = 0.0;
+		double Healing = 0.0;
+		double Threat = 0.0;
+		int32 Casts = 0;
+		int32 Kills = 0;
+	};
+
+	/** Print one encounter of Records [First, Last) */
+	void ReportEncounter(const FEldaraCombatLogReader& Reader, int32 EncounterIndex, int32 First, int32 Last, int32 NumTop)
+	{
+		const TConstArrayView<FEldaraCombatLogRecord> Records = Reader.GetRecords();
+		const double StartTime = Records[First].Time;
+		const double Duration = FMath::Max(Records[Last - 1].Time - StartTime, MinEncounterSeconds);
+
+		TMap<uint32, FSourceTotals> Totals;
+		int32 NumDeaths = 0;
+		for (int32 Index = First; Index < Last; ++Index)
+		{
+			const FEldaraCombatLogRecord& Record = Records[Index];
+			if (Record.Event == EEldaraCombatLogEvent::Death)
+			{
+				++NumDeaths;
+			}
+			if (Record.Source == EldaraCombatLogFormat::NoId)
+			{
+				continue;
+			}
+
+			FSourceTotals& Source = Totals.FindOrAdd(Record.Source);
+			Source.Source = Record.Source;
+			switch (Record.Event)
+			{
+			case EEldaraCombatLogEvent::Damage:
+				Source.Damage += Record.Amount;
+				if (Record.Flags & EEldaraCombatLogFlags::Periodic)
+				{
+					Source.PeriodicDamage += Record.Amount;
+				}
+				break;
+			case EEldaraCombatLogEvent::Healing:
+				Source.Healing += Record.Amount;
+				break;
+			case EEldaraCombatLogEvent::Cast:
+				++Source.Casts;
+				break;
+			case EEldaraCombatLogEvent::Death:
+				++Source.Kills;
+				break;
+			case EEldaraCombatLogEvent::Threat:
+				Source.Threat += Record.Amount;
+				break;
+			}
+		}
+
+		TArray<FSourceTotals> Sorted;
+		Totals.GenerateValueArray(Sorted);
+		Sorted.Sort([](const FSourceTotals& A, const FSourceTotals& B)
+		{
+			return A.Damage != B.Damage ? A.Damage > B.Damage : A.Healing > B.Healing;
+		});
+
+		UE_LOG(LogEldaraCombatLogTool, Display, TEXT("Encounter %d: %.1fs at t=%.1f, %d events, %d sources, %d deaths"),
+			EncounterIndex, Duration, StartTime, Last - First, Sorted.Num(), NumDeaths);
+		UE_LOG(LogEldaraCombatLogTool, Display, TEXT("  %-40s %10s %9s %6s %10s %9s %10s %9s %6s %5s"),
+			TEXT("Source"), TEXT("Damage"), TEXT("DPS"), TEXT("DoT%"), TEXT("Healing"), TEXT("HPS"), TEXT("Threat"), TEXT("TPS"), TEXT("Casts"), TEXT("Kills"));
+		for (int32 Index = 0; Index < FMath::Min(NumTop, Sorted.Num()); ++Index)
+		{
+			const FSourceTotals& Source = Sorted[Index];
+			UE_LOG(LogEldaraCombatLogTool, Display, TEXT("  %-40s %10.0f %9.1f %5.0f%% %10.0f %9.1f %10.0f %9.1f %6d %5d"),
+				*Reader.GetName(Source.Source).Left(40),
+				Source.Damage, Source.Damage / Duration, Source.Damage > 0.0 ? 100.0 * Source.PeriodicDamage / Source.Damage : 0.0,
+				Source.Healing, Source.Healing / Duration,
+				Source.Threat, Source.Threat / Duration,
+				Source.Casts, Source.Kills);
+		}
+	}
+}
+
+UEldaraCombatLogCommandlet::UEldaraCombatLogCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = false;
+	LogToConsole = true;
+}
+
+int32 UEldaraCombatLogCommandlet::Main(const FString& Params)
+{
+	FString Path;
+	if (!FParse::Value(*Params, TEXT("File="), Path))
+	{
+		UE_LOG(LogEldaraCombatLogTool, Error, TEXT("No input: pass -File=<combat log or directory of logs>"));
+		return 1;
+	}
+
+	float Gap = DefaultEncounterGap;
+	int32 NumTop = DefaultTopSources;
+	float MinDuration = 0.0f;
+	FParse::Value(*Params, TEXT("Gap="), Gap);
+	FParse::Value(*Params, TEXT("Top="), NumTop);
+	FParse::Value(*Params, TEXT("MinDuration="), MinDuration);
+
+	TArray<FString> Files;
+	if (IFileManager::Get().DirectoryExists(*Path))
+	{
+		IFileManager::Get().FindFiles(Files, *FPaths::Combine(Path, TEXT("*.eclog")), true, false);
+
+		// File names carry a timestamp and sequence number, so this is chronological
+		Files.Sort();
+		for (FString& File : Files)
+		{
+			File = FPaths::Combine(Path, File);
+		}
+	}
+	else
+	{
+		Files.Add(Path);
+	}
+
+	FEldaraCombatLogReader Reader;
+	int32 NumLoaded = 0;
+	for (const FString& File : Files)
+	{
+		NumLoaded += Reader.LoadFile(File) ? 1 : 0;
+	}
+	if (NumLoaded == 0)
+	{
+		UE_LOG(LogEldaraCombatLogTool, Error, TEXT("No combat logs could be read from %s"), *Path);
+		return 1;
+	}
+
+	const TConstArrayView<FEldaraCombatLogRecord> Records = Reader.GetRecords();
+	UE_LOG(LogEldaraCombatLogTool, Display, TEXT("Read %d records from %d of %d files"), Records.Num(), NumLoaded, Files.Num());
+
+	// An encounter ends at a gap in combat, or where world time restarts in the next session
+	int32 EncounterIndex = 0;
+	int32 First = 0;
+	for (int32 Index = 1; Index <= Records.Num(); ++Index)
+	{
+		const bool bEnd = Index == Records.Num()
+			|| Records[Index].Time - Records[Index - 1].Time > Gap
+			|| Records[Index].Time < Records[Index - 1].Time;
+		if (!bEnd)
+		{
+			continue;
+		}
+
+		if (Records[Index - 1].Time - Records[First].Time >= MinDuration)
+		{
+			ReportEncounter(Reader, ++EncounterIndex, First, Index, NumTop);
+		}
+		First = Index;
+	}
+	return 0;
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "EldaraCombatLogCommandlet.generated.h"
+
+/**
+ * Reads binary combat logs written by UEldaraCombatLog, splits them into encounters at gaps
+ * in combat, and prints per-source damage, healing and threat totals and rates.
+ *
+ * UnrealEditor-Cmd Eldara.uproject -run=EldaraCombatLog -File=Saved/CombatLogs
+ *
+ * -File=<file or directory of .eclog files>  [-Gap=5] (seconds without events that end an
+ * encounter)  [-Top=10] (sources listed per encounter)  [-MinDuration=0] (skip shorter encounters)
+ */
+UCLASS()
+class UEldaraCombatLogCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UEldaraCombatLogCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
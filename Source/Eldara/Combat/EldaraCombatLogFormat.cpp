@@ -0,0 +1,162 @@
+#include "EldaraCombatLogFormat.h"
+#include "Misc/FileHelper.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogEldaraCombatLogReader, Log, All);
+
+namespace
+{
+	/** Bounds-checked sequential reads over a loaded file */
+	struct FByteReader
+	{
+		TConstArrayView<uint8> Bytes;
+		int64 Offset = 0;
+
+		bool Read(void* Out, int64 Size)
+		{
+			if (Size < 0 || Offset + Size > Bytes.Num())
+			{
+				return false;
+			}
+			FMemory::Memcpy(Out, Bytes.GetData() + Offset, Size);
+			Offset += Size;
+			return true;
+		}
+
+		template <typename T>
+		bool Read(T& Out)
+		{
+			return Read(&Out, sizeof(T));
+		}
+
+		bool AtEnd() const { return Offset >= Bytes.Num(); }
+
+		int64 Remaining() const { return Bytes.Num() - Offset; }
+	};
+}
+
+FEldaraCombatLogReader::FEldaraCombatLogReader()
+{
+	Names.Add(FString());
+}
+
+bool FEldaraCombatLogReader::LoadFile(const FString& Path)
+{
+	TArray<uint8> Bytes;
+	if (!FFileHelper::LoadFileToArray(Bytes, *Path))
+	{
+		UE_LOG(LogEldaraCombatLogReader, Error, TEXT("Could not read %s"), *Path);
+		return false;
+	}
+
+	FByteReader Reader{Bytes};
+	FEldaraCombatLogFileHeader Header;
+	if (!Reader.Read(Header) || Header.Magic != EldaraCombatLogFormat::Magic)
+	{
+		UE_LOG(LogEldaraCombatLogReader, Error, TEXT("%s is not a combat log"), *Path);
+		return false;
+	}
+	if (Header.Version != EldaraCombatLogFormat::Version || Header.RecordSize != sizeof(FEldaraCombatLogRecord))
+	{
+		UE_LOG(LogEldaraCombatLogReader, Error, TEXT("%s has unsupported version %d (record size %d)"), *Path, Header.Version, Header.RecordSize);
+		return false;
+	}
+
+	// File id -> reader id
+	TMap<uint32, uint32> IdMap;
+	IdMap.Add(EldaraCombatLogFormat::NoId, EldaraCombatLogFormat::NoId);
+
+	const int32 FirstNewRecord = Records.Num();
+	TArray<uint8> NameBytes;
+	while (!Reader.AtEnd())
+	{
+		uint8 ChunkType = 0;
+		uint32 Count = 0;
+		if (!Reader.Read(ChunkType) || !Reader.Read(Count))
+		{
+			break;
+		}
+
+		bool bValid = true;
+		if (ChunkType == EldaraCombatLogFormat::NamesChunk)
+		{
+			for (uint32 Index = 0; Index < Count && bValid; ++Index)
+			{
+				uint32 FileId = 0;
+				uint16 Length = 0;
+				bValid = Reader.Read(FileId) && Reader.Read(Length);
+				if (bValid)
+				{
+					NameBytes.SetNumUninitialized(Length, EAllowShrinking::No);
+					bValid = Reader.Read(NameBytes.GetData(), Length);
+				}
+				if (bValid)
+				{
+					const FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(NameBytes.GetData()), Length);
+					IdMap.Add(FileId, FindOrAddName(FString(Converted.Length(), Converted.Get())));
+				}
+			}
+		}
+		else if (ChunkType == EldaraCombatLogFormat::RecordsChunk)
+		{
+			// Check the count against the file before allocating; a corrupt one must not size the array
+			const int64 RecordBytes = static_cast<int64>(Count) * sizeof(FEldaraCombatLogRecord);
+			bValid = RecordBytes <= Reader.Remaining();
+			if (bValid)
+			{
+				const int32 First = Records.Num();
+				Records.AddUninitialized(Count);
+				bValid = Reader.Read(Records.GetData() + First, RecordBytes);
+			}
+		}
+		else
+		{
+			bValid = false;
+		}
+
+		if (!bValid)
+		{
+			// A crash can leave a partial chunk at the end; keep everything before it
+			UE_LOG(LogEldaraCombatLogReader, Warning, TEXT("%s is truncated or corrupt at offset %lld"), *Path, Reader.Offset);
+			break;
+		}
+	}
+
+	auto Remap = [&IdMap](uint32& Id)
+	{
+		const uint32* Mapped = IdMap.Find(Id);
+		Id = Mapped ? *Mapped : EldaraCombatLogFormat::NoId;
+	};
+	for (int32 Index = FirstNewRecord; Index < Records.Num(); ++Index)
+	{
+		FEldaraCombatLogRecord& Record = Records[Index];
+		Remap(Record.Source);
+		Remap(Record.Target);
+		Remap(Record.Ability);
+		Remap(Record.Effect);
+	}
+	return true;
+}
+
+const FString& FEldaraCombatLogReader::GetName(uint32 Id) const
+{
+	return Names.IsValidIndex(Id) ? Names[Id] : Names[EldaraCombatLogFormat::NoId];
+}
+
+void FEldaraCombatLogReader::Reset()
+{
+	Records.Reset();
+	Names.Reset();
+	Names.Add(FString());
+	IdByName.Reset();
+}
+
+uint32 FEldaraCombatLogReader::FindOrAddName(const FString& Name)
+{
+	if (const uint32* Existing = IdByName.Find(Name))
+	{
+		return *Existing;
+	}
+	const uint32 Id = Names.Add(Name);
+	IdByName.Add(Name, Id);
+	return Id;
+}
@@ -0,0 +1,102 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * On-disk format of the binary combat log, shared by the in-game writer and the offline
+ * reader.
+ *
+ * A file is a header followed by chunks. A names chunk maps the small integer ids used in
+ * records to display names; a records chunk is a packed array of fixed-size records. Ids
+ * are assigned per file and every file carries the names it uses, so each rotated file
+ * can be read on its own. Integers are little-endian.
+ */
+namespace EldaraCombatLogFormat
+{
+	constexpr uint32 Magic = 0x474C4345; // "ECLG"
+	constexpr uint16 Version = 1;
+
+	constexpr uint8 NamesChunk = 1;
+	constexpr uint8 RecordsChunk = 2;
+
+	/** Id 0 means "none" (no source, no ability, ...) */
+	constexpr uint32 NoId = 0;
+}
+
+/** What a combat log record describes */
+enum class EEldaraCombatLogEvent : uint8
+{
+	Damage,
+	Healing,
+	/** An ability was activated; Amount is unused */
+	Cast,
+	/** Target died; Source is the last damage dealer of the frame, if known */
+	Death,
+	/** Source generated Amount threat on Target */
+	Threat
+};
+
+/** Record flags */
+namespace EEldaraCombatLogFlags
+{
+	/** Applied by a periodic tick rather than on application */
+	constexpr uint8 Periodic = 1 << 0;
+}
+
+/** One combat event, 32 bytes */
+struct FEldaraCombatLogRecord
+{
+	/** World time in seconds */
+	double Time = 0.0;
+
+	uint32 Source = EldaraCombatLogFormat::NoId;
+	uint32 Target = EldaraCombatLogFormat::NoId;
+	uint32 Ability = EldaraCombatLogFormat::NoId;
+	uint32 Effect = EldaraCombatLogFormat::NoId;
+	float Amount = 0.0f;
+	EEldaraCombatLogEvent Event = EEldaraCombatLogEvent::Damage;
+	uint8 Flags = 0;
+	uint16 Reserved = 0;
+};
+static_assert(sizeof(FEldaraCombatLogRecord) == 32, "Combat log records are written raw; keep the layout fixed");
+
+/** File header */
+struct FEldaraCombatLogFileHeader
+{
+	uint32 Magic = EldaraCombatLogFormat::Magic;
+	uint16 Version = EldaraCombatLogFormat::Version;
+	uint16 RecordSize = sizeof(FEldaraCombatLogRecord);
+
+	/** UTC wall clock (FDateTime ticks) when the file was started */
+	int64 StartTicks = 0;
+};
+static_assert(sizeof(FEldaraCombatLogFileHeader) == 16, "Combat log header is written raw; keep the layout fixed");
+
+/**
+ * Loads combat log files for offline analysis. Files are appended in the order they are
+ * loaded; ids are remapped so one name has one id across every loaded file.
+ */
+class ELDARA_API FEldaraCombatLogReader
+{
+public:
+	FEldaraCombatLogReader();
+
+	/** Append the records of one file; false (and nothing appended) if it is not a valid log */
+	bool LoadFile(const FString& Path);
+
+	TConstArrayView<FEldaraCombatLogRecord> GetRecords() const { return Records; }
+
+	/** Display name of an id, or an empty string for NoId */
+	const FString& GetName(uint32 Id) const;
+
+	void Reset();
+
+private:
+	uint32 FindOrAddName(const FString& Name);
+
+	TArray<FEldaraCombatLogRecord> Records;
+
+	/** Index = id; entry 0 is the empty "none" name */
+	TArray<FString> Names;
+	TMap<FString, uint32> IdByName;
+};
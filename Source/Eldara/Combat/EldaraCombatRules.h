@@ -0,0 +1,80 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Eldara/Characters/EldaraAbility.h"
+#include "Eldara/Characters/EldaraEffect.h"
+#include "EldaraActiveEffectStore.h"
+
+/**
+ * Combat rules shared by UEldaraCombatComponent and the headless combat simulator.
+ * Plain functions over values, so the same rules run with or without actors and a world.
+ */
+namespace EldaraCombatRules
+{
+	/** Can a caster with these vitals pay the ability's cost? */
+	inline bool CanPayCost(const UEldaraAbility& Ability, float Health, float Resource, FString& OutErrorMessage)
+	{
+		if (Ability.ResourceCost <= 0.0f)
+		{
+			return true;
+		}
+
+		if (Ability.ResourceType == EResourceType::Health)
+		{
+			if (Health < Ability.ResourceCost)
+			{
+				OutErrorMessage = TEXT("Not enough health to cast");
+				return false;
+			}
+			return true;
+		}
+
+		// Mana, rage, energy, focus and corruption share the resource pool
+		if (Resource < Ability.ResourceCost)
+		{
+			OutErrorMessage = TEXT("Not enough resource");
+			return false;
+		}
+		return true;
+	}
+
+	/** Timers and stacks of a fresh application at Now */
+	inline void InitApplication(FActiveEffectRuntime& Runtime, UEldaraEffect* Effect, double Now)
+	{
+		Runtime.Effect = Effect;
+		Runtime.ExpireTime = Now + Effect->Duration;
+		Runtime.NextTickTime = Now + Effect->TickInterval;
+		Runtime.Stacks = 1;
+	}
+
+	/**
+	 * Apply Effect again onto an existing stack at Now
+	 * @return True if the duration was refreshed and the timers must be rescheduled
+	 */
+	inline bool Reapply(FActiveEffectRuntime& Runtime, const UEldaraEffect& Effect, double Now)
+	{
+		if (Runtime.Stacks < Effect.MaxStacks)
+		{
+			Runtime.Stacks++;
+		}
+		if (!Effect.bRefreshDuration)
+		{
+			return false;
+		}
+
+		Runtime.ExpireTime = Now + Effect.Duration;
+		Runtime.NextTickTime = Now + Effect.TickInterval;
+		return true;
+	}
+
+	/**
+	 * Move a periodic effect past the tick due at DueTime. Chains from the due time, not the
+	 * time it was processed, so ticks land on exact multiples of the interval.
+	 * @return True if another tick falls within the duration
+	 */
+	inline bool ChainTick(FActiveEffectRuntime& Runtime, const UEldaraEffect& Effect, double DueTime)
+	{
+		Runtime.NextTickTime = DueTime + Effect.TickInterval;
+		return Runtime.NextTickTime <= Runtime.ExpireTime;
+	}
+}
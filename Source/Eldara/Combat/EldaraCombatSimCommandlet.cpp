@@ -0,0 +1,668 @@
+#include "EldaraCombatSimCommandlet.h"
+#include "EldaraCombatSimulator.h"
+#include "EldaraEffectScheduler.h"
+#include "EldaraEffectKernels.h"
+#include "EldaraEffectTickBatch.h"
+#include "EldaraActiveEffectStore.h"
+#include "EldaraCombatSpatialGrid.h"
+#include "Eldara/Characters/EldaraAbility.h"
+#include "Eldara/Characters/EldaraCharacterBase.h"
+#include "Eldara/Characters/EldaraEffect.h"
+#include "Eldara/Data/EldaraClassData.h"
+#include "Eldara/Core/EldaraBenchmark.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "Engine/DamageEvents.h"
+#include "GameFramework/DamageType.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/Parse.h"
+#include "Misc/ScopeExit.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogEldaraCombatSim, Log, All);
+
+namespace
+{
+	constexpr int32 DefaultEncounters = 10000;
+	constexpr int32 DefaultGrantLevel = 1;
+	constexpr int32 DefaultBenchTicks = 10000;
+	constexpr int32 DefaultBenchRounds = 20;
+	constexpr int32 DefaultBenchCombatants = 1000;
+	constexpr int32 DefaultBenchEffects = 16;
+	constexpr int32 DefaultGridCombatants = 2000;
+	constexpr int32 DefaultGridQueries = 10000;
+	constexpr float DefaultGridQueryRadius = 800.0f;
+	constexpr float DefaultGridExtent = 20000.0f;
+
+	/**
+	 * The active-effect layout FEldaraActiveEffectStore replaced: a plain array whose
+	 * instances are found by scanning for their id, with an effect -> row map that is
+	 * rebuilt after every removal. Kept only as the baseline for -EffectStoreBench.
+	 */
+	struct FLinearEffectList
+	{
+		struct FRuntime : FActiveEffectRuntime
+		{
+			uint32 InstanceId = 0;
+		};
+
+		TArray<FRuntime> Runtimes;
+		TMap<TObjectPtr<UEldaraEffect>, int32> EffectIndexMap;
+		uint32 NextInstanceId = 0;
+
+		uint32 Add(const FActiveEffectRuntime& Runtime)
+		{
+			FRuntime& Added = Runtimes.AddDefaulted_GetRef();
+			static_cast<FActiveEffectRuntime&>(Added) = Runtime;
+			Added.InstanceId = ++NextInstanceId;
+			EffectIndexMap.Add(Runtime.Effect, Runtimes.Num() - 1);
+			return Added.InstanceId;
+		}
+
+		FActiveEffectRuntime* Find(uint32 InstanceId)
+		{
+			return Runtimes.FindByPredicate([InstanceId](const FRuntime& Runtime) { return Runtime.InstanceId == InstanceId; });
+		}
+
+		int32 FindStack(UEldaraEffect* Effect) const
+		{
+			const int32* Index = EffectIndexMap.Find(Effect);
+			return Index ? *Index : INDEX_NONE;
+		}
+
+		void Remove(uint32 InstanceId)
+		{
+			const int32 Index = Runtimes.IndexOfByPredicate([InstanceId](const FRuntime& Runtime) { return Runtime.InstanceId == InstanceId; });
+			if (Index == INDEX_NONE)
+			{
+				return;
+			}
+
+			Runtimes.RemoveAtSwap(Index);
+			EffectIndexMap.Reset();
+			for (int32 Row = 0; Row < Runtimes.Num(); ++Row)
+			{
+				EffectIndexMap.Add(Runtimes[Row].Effect, Row);
+			}
+		}
+	};
+
+	/**
+	 * Effect payload as UEldaraCombatComponent applied it before the kernel table, on the
+	 * path without a frame aggregator: a switch on the effect type, then the Blueprint
+	 * ExecuteEffect event for every effect. Kept only as the baseline for -EffectKernelBench.
+	 */
+	void ApplyEffectBaseline(UEldaraEffect& Effect, AEldaraCharacterBase& Target, AActor* Instigator, float Amount)
+	{
+		switch (Effect.EffectType)
+		{
+		case EEffectType::Damage:
+		{
+			FDamageEvent DamageEvent(UDamageType::StaticClass());
+			Target.TakeDamage(Amount, DamageEvent, nullptr, Instigator);
+			break;
+		}
+		case EEffectType::Healing:
+			Target.ApplyHealing(Amount);
+			break;
+		case EEffectType::ResourceRestore:
+			Target.RestoreResource(Amount);
+			break;
+		default:
+			break;
+		}
+
+		Effect.ExecuteEffect(&Target, Instigator);
+	}
+
+	/** Throwaway game world for benches that need real actors and world subsystems */
+	struct FBenchWorld
+	{
+		UE_NONCOPYABLE(FBenchWorld);
+
+		explicit FBenchWorld(const TCHAR* Name)
+		{
+			World = UWorld::CreateWorld(EWorldType::Game, false, Name);
+			FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+			WorldContext.SetCurrentWorld(World);
+			World->InitializeActorsForPlay(FURL());
+			World->BeginPlay();
+		}
+
+		~FBenchWorld()
+		{
+			GEngine->DestroyWorldContext(World);
+			World->DestroyWorld(false);
+		}
+
+		template <typename ActorType>
+		ActorType* Spawn(const FVector& Location)
+		{
+			FActorSpawnParameters SpawnParams;
+			SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+			return World->SpawnActor<ActorType>(ActorType::StaticClass(), Location, FRotator::ZeroRotator, SpawnParams);
+		}
+
+		UWorld* World = nullptr;
+	};
+
+	/** Value at Fraction (0..1) of an ascending array */
+	float Percentile(const TArray<float>& Sorted, float Fraction)
+	{
+		if (Sorted.Num() == 0)
+		{
+			return 0.0f;
+		}
+		const int32 Index = FMath::Clamp(FMath::RoundToInt32(Fraction * (Sorted.Num() - 1)), 0, Sorted.Num() - 1);
+		return Sorted[Index];
+	}
+
+	void ReportDistribution(const TCHAR* Label, TArray<float>& Values)
+	{
+		Values.Sort();
+
+		double Sum = 0.0;
+		for (const float Value : Values)
+		{
+			Sum += Value;
+		}
+		const double Mean = Values.Num() > 0 ? Sum / Values.Num() : 0.0;
+
+		double SquaredError = 0.0;
+		for (const float Value : Values)
+		{
+			SquaredError += FMath::Square(Value - Mean);
+		}
+		const double StdDev = Values.Num() > 1 ? FMath::Sqrt(SquaredError / (Values.Num() - 1)) : 0.0;
+
+		UE_LOG(LogEldaraCombatSim, Display, TEXT("%s: mean %.1f  sd %.1f  min %.1f  p5 %.1f  p50 %.1f  p95 %.1f  max %.1f"),
+			Label, Mean, StdDev, Percentile(Values, 0.0f), Percentile(Values, 0.05f), Percentile(Values, 0.5f),
+			Percentile(Values, 0.95f), Percentile(Values, 1.0f));
+	}
+}
+
+UEldaraCombatSimCommandlet::UEldaraCombatSimCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = false;
+	LogToConsole = true;
+}
+
+bool UEldaraCombatSimCommandlet::LoadRotation(const FString& Params)
+{
+	Rotation.Reset();
+
+	FString ClassPath;
+	if (FParse::Value(*Params, TEXT("Class="), ClassPath))
+	{
+		const UEldaraClassData* ClassData = LoadObject<UEldaraClassData>(nullptr, *ClassPath);
+		if (!ClassData)
+		{
+			UE_LOG(LogEldaraCombatSim, Error, TEXT("Could not load class data %s"), *ClassPath);
+			return false;
+		}
+
+		int32 Level = DefaultGrantLevel;
+		FParse::Value(*Params, TEXT("Level="), Level);
+		for (const FStartingAbility& Starting : ClassData->StartingAbilities)
+		{
+			if (Starting.Ability && Starting.GrantLevel <= Level)
+			{
+				Rotation.Add(Starting.Ability);
+			}
+		}
+	}
+
+	FString AbilityPaths;
+	if (FParse::Value(*Params, TEXT("Abilities="), AbilityPaths, false))
+	{
+		TArray<FString> Paths;
+		AbilityPaths.ParseIntoArray(Paths, TEXT(","));
+		for (const FString& Path : Paths)
+		{
+			if (UEldaraAbility* Ability = LoadObject<UEldaraAbility>(nullptr, *Path.TrimStartAndEnd()))
+			{
+				Rotation.Add(Ability);
+			}
+			else
+			{
+				UE_LOG(LogEldaraCombatSim, Error, TEXT("Could not load ability %s"), *Path);
+				return false;
+			}
+		}
+	}
+
+	return Rotation.Num() > 0;
+}
+
+int32 UEldaraCombatSimCommandlet::RunEffectKernelBench(const FString& Params)
+{
+	int32 NumTicks = DefaultBenchTicks;
+	int32 NumRounds = DefaultBenchRounds;
+	FParse::Value(*Params, TEXT("Ticks="), NumTicks);
+	FParse::Value(*Params, TEXT("Rounds="), NumRounds);
+	NumTicks = FMath::Max(1, NumTicks);
+	NumRounds = FMath::Max(1, NumRounds);
+
+	UEldaraEffect* Effect = nullptr;
+	FString EffectPath;
+	if (FParse::Value(*Params, TEXT("Effect="), EffectPath))
+	{
+		Effect = LoadObject<UEldaraEffect>(nullptr, *EffectPath);
+		if (!Effect)
+		{
+			UE_LOG(LogEldaraCombatSim, Error, TEXT("Could not load effect %s"), *EffectPath);
+			return 1;
+		}
+	}
+	else
+	{
+		Effect = NewObject<UEldaraEffect>(GetTransientPackage());
+		Effect->EffectType = EEffectType::Damage;
+		Effect->DamageType = EDamageType::Fire;
+		Effect->Magnitude = 10.0f;
+	}
+	const bool bAssetExecutesBlueprint = Effect->bExecuteBlueprint;
+
+	FBenchWorld BenchWorld(TEXT("EldaraEffectKernelBench"));
+	AEldaraCharacterBase* Target = BenchWorld.Spawn<AEldaraCharacterBase>(FVector::ZeroVector);
+	AEldaraCharacterBase* Instigator = BenchWorld.Spawn<AEldaraCharacterBase>(FVector(500.0f, 0.0f, 0.0f));
+	if (!Target || !Instigator)
+	{
+		UE_LOG(LogEldaraCombatSim, Error, TEXT("Could not spawn the bench characters"));
+		return 1;
+	}
+
+	// Enough health that no round kills the target, with headroom for healing effects
+	const float TargetHealth = FMath::Max(1000.0f, 8.0f * NumTicks * FMath::Abs(Effect->Magnitude));
+	Target->HandleStatChanged(EEldaraStat::MaxHealth, 2.0f * TargetHealth);
+
+	// TakeDamage logs every hit; console output would swamp the timing on the paths that call it
+	const ELogVerbosity::Type TempVerbosity = LogTemp.GetVerbosity();
+	LogTemp.SetVerbosity(ELogVerbosity::Warning);
+	ON_SCOPE_EXIT
+	{
+		LogTemp.SetVerbosity(TempVerbosity);
+		Effect->bExecuteBlueprint = bAssetExecutesBlueprint;
+	};
+
+	// No frame aggregator, so every path writes the target's health per tick as the baseline did
+	FEldaraEffectApplication Application;
+	Application.Effect = Effect;
+	Application.Target = Target;
+	Application.TargetCharacter = Target;
+	Application.Instigator = Instigator;
+
+	// Each round starts from the same vitals, so every path ends on the same health
+	auto TimeTicks = [&](auto&& ApplyTick, float& OutHealth)
+	{
+		const double Seconds = EldaraBenchmark::TimeBestOf(NumRounds, [&]()
+		{
+			Target->SetVitals(TargetHealth, 0.0f, Target->GetMaxStamina());
+			for (int32 Tick = 0; Tick < NumTicks; ++Tick)
+			{
+				ApplyTick(FEldaraEffectTickBatch::ComputeAmount(Effect->EffectType, Effect->Magnitude, 1 + (Tick & 3), 1.0f));
+			}
+		});
+		OutHealth = Target->GetHealth();
+		return Seconds;
+	};
+
+	auto ApplyKernel = [&Application](float Amount)
+	{
+		Application.Amount = Amount;
+		EldaraEffectKernels::Execute(Application);
+	};
+
+	float BaselineHealth = 0.0f;
+	const double BaselineSeconds = TimeTicks([&](float Amount)
+	{
+		ApplyEffectBaseline(*Effect, *Target, Instigator, Amount);
+	}, BaselineHealth);
+
+	float BlueprintHealth = 0.0f;
+	Effect->bExecuteBlueprint = true;
+	const double BlueprintSeconds = TimeTicks(ApplyKernel, BlueprintHealth);
+
+	float NativeHealth = 0.0f;
+	Effect->bExecuteBlueprint = false;
+	const double NativeSeconds = TimeTicks(ApplyKernel, NativeHealth);
+
+	if (BaselineHealth != BlueprintHealth || BaselineHealth != NativeHealth)
+	{
+		UE_LOG(LogEldaraCombatSim, Error, TEXT("Effect paths disagree (target health %.1f / %.1f / %.1f)"), BaselineHealth, BlueprintHealth, NativeHealth);
+		return 1;
+	}
+
+	const double MsPer10kTicks = 10000.0 / NumTicks * 1000.0;
+	UE_LOG(LogEldaraCombatSim, Display, TEXT("Effect ticks on a character per 10k ticks, %s (best of %d rounds of %d):"),
+		*Effect->GetName(), NumRounds, NumTicks);
+	UE_LOG(LogEldaraCombatSim, Display, TEXT("  before, type switch + ExecuteEffect: %.3f ms"), BaselineSeconds * MsPer10kTicks);
+	UE_LOG(LogEldaraCombatSim, Display, TEXT("  kernel + ExecuteEffect:              %.3f ms"), BlueprintSeconds * MsPer10kTicks);
+	UE_LOG(LogEldaraCombatSim, Display, TEXT("  kernel only:                         %.3f ms (%.1fx faster than before)"),
+		NativeSeconds * MsPer10kTicks, BaselineSeconds / FMath::Max(NativeSeconds, UE_SMALL_NUMBER));
+	return 0;
+}
+
+int32 UEldaraCombatSimCommandlet::RunEffectStoreBench(const FString& Params)
+{
+	int32 NumCombatants = DefaultBenchCombatants;
+	int32 NumEffects = DefaultBenchEffects;
+	int32 NumRounds = DefaultBenchRounds;
+	FParse::Value(*Params, TEXT("Combatants="), NumCombatants);
+	FParse::Value(*Params, TEXT("Effects="), NumEffects);
+	FParse::Value(*Params, TEXT("Rounds="), NumRounds);
+	NumCombatants = FMath::Max(1, NumCombatants);
+	NumEffects = FMath::Max(1, NumEffects);
+	NumRounds = FMath::Max(1, NumRounds);
+
+	TArray<FActiveEffectRuntime> Applications;
+	for (int32 Index = 0; Index < NumEffects; ++Index)
+	{
+		FActiveEffectRuntime& Application = Applications.AddDefaulted_GetRef();
+		Application.Effect = NewObject<UEldaraEffect>(GetTransientPackage());
+		Application.ExpireTime = 10.0 + Index;
+	}
+
+	// Same shuffled lookup and removal order for both layouts, like expiries in a real fight
+	FRandomStream Random(1);
+	TArray<int32> Order;
+	for (int32 Index = 0; Index < NumEffects; ++Index)
+	{
+		Order.Add(Index);
+	}
+	for (int32 Index = NumEffects - 1; Index > 0; --Index)
+	{
+		Order.Swap(Index, Random.RandRange(0, Index));
+	}
+
+	enum EPhase { PhaseAdd, PhaseFind, PhaseStack, PhaseRemove, NumPhases };
+	static const TCHAR* PhaseNames[NumPhases] = { TEXT("add"), TEXT("find"), TEXT("stack lookup"), TEXT("remove") };
+
+	// One store per combatant with NumEffects active, as in a raid-sized fight
+	auto TimePhases = [&](auto& Stores, auto& Ids, auto&& AddFn, auto&& FindFn, auto&& StackFn, auto&& RemoveFn, EldaraBenchmark::FBestTime (&OutBest)[NumPhases])
+	{
+		int64 Found = 0;
+		for (int32 Round = 0; Round < NumRounds; ++Round)
+		{
+			double StartTime = FPlatformTime::Seconds();
+			for (int32 Combatant = 0; Combatant < NumCombatants; ++Combatant)
+			{
+				for (int32 Index = 0; Index < NumEffects; ++Index)
+				{
+					Ids[Combatant * NumEffects + Index] = AddFn(Stores[Combatant], Applications[Index]);
+				}
+			}
+			StartTime = OutBest[PhaseAdd].Lap(StartTime);
+
+			for (int32 Combatant = 0; Combatant < NumCombatants; ++Combatant)
+			{
+				for (const int32 Index : Order)
+				{
+					Found += FindFn(Stores[Combatant], Ids[Combatant * NumEffects + Index]) ? 1 : 0;
+				}
+			}
+			StartTime = OutBest[PhaseFind].Lap(StartTime);
+
+			for (int32 Combatant = 0; Combatant < NumCombatants; ++Combatant)
+			{
+				for (const int32 Index : Order)
+				{
+					Found += StackFn(Stores[Combatant], Applications[Index].Effect) ? 1 : 0;
+				}
+			}
+			StartTime = OutBest[PhaseStack].Lap(StartTime);
+
+			for (int32 Combatant = 0; Combatant < NumCombatants; ++Combatant)
+			{
+				for (const int32 Index : Order)
+				{
+					RemoveFn(Stores[Combatant], Ids[Combatant * NumEffects + Index]);
+				}
+			}
+			OutBest[PhaseRemove].Lap(StartTime);
+		}
+		return Found;
+	};
+
+	EldaraBenchmark::FBestTime SlotMapBest[NumPhases];
+	TArray<FEldaraActiveEffectStore> SlotMaps;
+	TArray<FEldaraActiveEffectHandle> Handles;
+	SlotMaps.SetNum(NumCombatants);
+	Handles.SetNum(NumCombatants * NumEffects);
+	const int64 SlotMapFound = TimePhases(SlotMaps, Handles,
+		[](FEldaraActiveEffectStore& Store, const FActiveEffectRuntime& Runtime) { return Store.Add(Runtime); },
+		[](FEldaraActiveEffectStore& Store, FEldaraActiveEffectHandle Handle) { return Store.Find(Handle) != nullptr; },
+		[](FEldaraActiveEffectStore& Store, UEldaraEffect* Effect) { return Store.FindStack(*Effect, nullptr).IsValid(); },
+		[](FEldaraActiveEffectStore& Store, FEldaraActiveEffectHandle Handle) { Store.Remove(Handle); },
+		SlotMapBest);
+
+	EldaraBenchmark::FBestTime LinearBest[NumPhases];
+	TArray<FLinearEffectList> Lists;
+	TArray<uint32> InstanceIds;
+	Lists.SetNum(NumCombatants);
+	InstanceIds.SetNum(NumCombatants * NumEffects);
+	const int64 LinearFound = TimePhases(Lists, InstanceIds,
+		[](FLinearEffectList& List, const FActiveEffectRuntime& Runtime) { return List.Add(Runtime); },
+		[](FLinearEffectList& List, uint32 InstanceId) { return List.Find(InstanceId) != nullptr; },
+		[](FLinearEffectList& List, UEldaraEffect* Effect) { return List.FindStack(Effect) != INDEX_NONE; },
+		[](FLinearEffectList& List, uint32 InstanceId) { List.Remove(InstanceId); },
+		LinearBest);
+
+	if (SlotMapFound != LinearFound)
+	{
+		UE_LOG(LogEldaraCombatSim, Error, TEXT("Effect store layouts disagree (%lld vs %lld lookups hit)"), SlotMapFound, LinearFound);
+		return 1;
+	}
+
+	const double OpsScale = 1.0e9 / (static_cast<double>(NumCombatants) * NumEffects);
+	UE_LOG(LogEldaraCombatSim, Display, TEXT("Active effect store, ns per operation (%d combatants x %d effects, best of %d rounds):"),
+		NumCombatants, NumEffects, NumRounds);
+	for (int32 Phase = 0; Phase < NumPhases; ++Phase)
+	{
+		UE_LOG(LogEldaraCombatSim, Display, TEXT("  %-12s slot map %7.1f   linear %7.1f (%.1fx)"), PhaseNames[Phase],
+			SlotMapBest[Phase].Seconds * OpsScale, LinearBest[Phase].Seconds * OpsScale,
+			LinearBest[Phase].Seconds / FMath::Max(SlotMapBest[Phase].Seconds, UE_SMALL_NUMBER));
+	}
+	return 0;
+}
+
+int32 UEldaraCombatSimCommandlet::RunSpatialGridBench(const FString& Params)
+{
+	int32 NumCombatants = DefaultGridCombatants;
+	int32 NumQueries = DefaultGridQueries;
+	int32 NumRounds = DefaultBenchRounds;
+	float Radius = DefaultGridQueryRadius;
+	float Extent = DefaultGridExtent;
+	FParse::Value(*Params, TEXT("Combatants="), NumCombatants);
+	FParse::Value(*Params, TEXT("Queries="), NumQueries);
+	FParse::Value(*Params, TEXT("Rounds="), NumRounds);
+	FParse::Value(*Params, TEXT("Radius="), Radius);
+	FParse::Value(*Params, TEXT("Extent="), Extent);
+	NumCombatants = FMath::Max(1, NumCombatants);
+	NumQueries = FMath::Max(1, NumQueries);
+	NumRounds = FMath::Max(1, NumRounds);
+	Radius = FMath::Max(0.0f, Radius);
+	Extent = FMath::Max(1.0f, Extent);
+
+	// The grid is a game-world subsystem tracking real characters, so the bench needs a world
+	FBenchWorld BenchWorld(TEXT("EldaraSpatialGridBench"));
+	UEldaraCombatSpatialGrid* Grid = BenchWorld.World->GetSubsystem<UEldaraCombatSpatialGrid>();
+	if (!Grid)
+	{
+		UE_LOG(LogEldaraCombatSim, Error, TEXT("Combat spatial grid is not available in the bench world"));
+		return 1;
+	}
+
+	FRandomStream Random(1);
+	auto RandomPoint = [&Random, Extent]()
+	{
+		return FVector(Random.FRandRange(-Extent, Extent), Random.FRandRange(-Extent, Extent), 0.0f);
+	};
+
+	TArray<AEldaraCharacterBase*> Combatants;
+	Combatants.Reserve(NumCombatants);
+	for (int32 Index = 0; Index < NumCombatants; ++Index)
+	{
+		if (AEldaraCharacterBase* Character = BenchWorld.Spawn<AEldaraCharacterBase>(RandomPoint()))
+		{
+			// Without a game mode the world may not dispatch BeginPlay; Register is a no-op if it did
+			Grid->Register(Character);
+			Combatants.Add(Character);
+		}
+	}
+
+	TArray<FVector> Centers;
+	Centers.Reserve(NumQueries);
+	for (int32 Index = 0; Index < NumQueries; ++Index)
+	{
+		Centers.Add(RandomPoint());
+	}
+
+	// Per-frame refresh of every entry, timed on its own since queries assume it already ran
+	const double RefreshSeconds = EldaraBenchmark::TimeBestOf(NumRounds, [Grid]()
+	{
+		Grid->Tick(0.0f);
+	});
+
+	FEldaraTargetFilter Filter;
+	const double RadiusSq = FMath::Square(static_cast<double>(Radius));
+	TArray<AEldaraCharacterBase*> Targets;
+	Targets.Reserve(Combatants.Num());
+
+	// Queries reuse one result buffer, as gameplay callers do
+	auto TimeQueries = [&](auto&& Query, int64& OutHits)
+	{
+		return EldaraBenchmark::TimeBestOf(NumRounds, [&]()
+		{
+			OutHits = 0;
+			for (const FVector& Center : Centers)
+			{
+				OutHits += Query(Center);
+			}
+		});
+	};
+
+	int64 GridHits = 0;
+	const double GridSeconds = TimeQueries([&](const FVector& Center)
+	{
+		return Grid->QuerySphere(Center, Radius, Filter, Targets);
+	}, GridHits);
+
+	int64 ScanHits = 0;
+	const double ScanSeconds = TimeQueries([&](const FVector& Center)
+	{
+		Targets.Reset();
+		for (AEldaraCharacterBase* Character : Combatants)
+		{
+			if (!Character->IsDead() && !Character->IsHidden() && FVector::DistSquared(Character->GetActorLocation(), Center) <= RadiusSq)
+			{
+				Targets.Add(Character);
+			}
+		}
+		return Targets.Num();
+	}, ScanHits);
+
+	if (GridHits != ScanHits)
+	{
+		UE_LOG(LogEldaraCombatSim, Error, TEXT("Spatial grid and scan disagree (%lld vs %lld targets)"), GridHits, ScanHits);
+		return 1;
+	}
+
+	const double QueriesScale = 1.0e6 / NumQueries;
+	UE_LOG(LogEldaraCombatSim, Display, TEXT("Combat spatial grid, %d combatants over %.0f x %.0f cm, %d cells (best of %d rounds):"),
+		Combatants.Num(), Extent * 2.0f, Extent * 2.0f, Grid->GetNumCells(), NumRounds);
+	UE_LOG(LogEldaraCombatSim, Display, TEXT("  per-frame refresh:       %.3f ms"), RefreshSeconds * 1000.0);
+	UE_LOG(LogEldaraCombatSim, Display, TEXT("  sphere query r=%.0f, us per query: grid %.3f   scan %.3f (%.1fx), %.1f targets/query"),
+		Radius, GridSeconds * QueriesScale, ScanSeconds * QueriesScale, ScanSeconds / FMath::Max(GridSeconds, UE_SMALL_NUMBER),
+		static_cast<double>(GridHits) / NumQueries);
+	return 0;
+}
+
+int32 UEldaraCombatSimCommandlet::Main(const FString& Params)
+{
+	if (FParse::Param(*Params, TEXT("EffectKernelBench")))
+	{
+		return RunEffectKernelBench(Params);
+	}
+
+	if (FParse::Param(*Params, TEXT("EffectStoreBench")))
+	{
+		return RunEffectStoreBench(Params);
+	}
+
+	if (FParse::Param(*Params, TEXT("SpatialGridBench")))
+	{
+		return RunSpatialGridBench(Params);
+	}
+
+	if (!LoadRotation(Params))
+	{
+		UE_LOG(LogEldaraCombatSim, Error, TEXT("No rotation: pass -Class=<class data> or -Abilities=<ability>,<ability>,..."));
+		return 1;
+	}
+
+	FEldaraCombatSimConfig Config;
+	for (UEldaraAbility* Ability : Rotation)
+	{
+		Config.Rotation.Add(Ability);
+	}
+	FParse::Value(*Params, TEXT("Casters="), Config.NumCasters);
+	FParse::Value(*Params, TEXT("Duration="), Config.Duration);
+	FParse::Value(*Params, TEXT("Step="), Config.TimeStep);
+	FParse::Value(*Params, TEXT("GCD="), Config.GlobalCooldown);
+	FParse::Value(*Params, TEXT("Health="), Config.CasterHealth);
+	FParse::Value(*Params, TEXT("Resource="), Config.CasterResource);
+	FParse::Value(*Params, TEXT("Regen="), Config.ResourceRegenPerSecond);
+	FParse::Value(*Params, TEXT("IncomingDps="), Config.IncomingDamagePerSecond);
+	FParse::Value(*Params, TEXT("Reaction="), Config.MaxReactionTime);
+	Config.NumCasters = FMath::Max(1, Config.NumCasters);
+
+	// Same damage-type tuning as the live effect scheduler
+	for (const TPair<EDamageType, float>& Scale : GetDefault<UEldaraEffectScheduler>()->GetConfiguredDamageTypeScales())
+	{
+		Config.DamageTypeScales[static_cast<int32>(Scale.Key)] = Scale.Value;
+	}
+
+	int32 NumEncounters = DefaultEncounters;
+	int32 Seed = 1;
+	FParse::Value(*Params, TEXT("Encounters="), NumEncounters);
+	FParse::Value(*Params, TEXT("Seed="), Seed);
+	const bool bSingleThread = FParse::Param(*Params, TEXT("SingleThread"));
+
+	UE_LOG(LogEldaraCombatSim, Display, TEXT("Simulating %d encounters: %d abilities, %d casters, %.0fs at %.4fs steps%s"),
+		NumEncounters, Config.Rotation.Num(), Config.NumCasters, Config.Duration, Config.TimeStep,
+		bSingleThread ? TEXT(", single-threaded") : TEXT(""));
+
+	TArray<FEldaraCombatSimResult> Results;
+	const double StartTime = FPlatformTime::Seconds();
+	FEldaraCombatSimulator::RunBatch(Config, NumEncounters, Seed, bSingleThread, Results);
+	const double WallSeconds = FMath::Max(FPlatformTime::Seconds() - StartTime, UE_SMALL_NUMBER);
+
+	TArray<float> Dps;
+	TArray<float> Hps;
+	Dps.Reserve(Results.Num());
+	Hps.Reserve(Results.Num());
+	double SimulatedSeconds = 0.0;
+	int64 TotalCasts = 0;
+	int64 TotalTicks = 0;
+	for (const FEldaraCombatSimResult& Result : Results)
+	{
+		Dps.Add(Result.GetDps(Config.NumCasters));
+		Hps.Add(Result.GetHps(Config.NumCasters));
+		SimulatedSeconds += Result.Duration;
+		TotalCasts += Result.Casts;
+		TotalTicks += Result.EffectTicks;
+	}
+
+	ReportDistribution(TEXT("DPS per caster"), Dps);
+	ReportDistribution(TEXT("HPS per caster"), Hps);
+
+	const int32 Count = FMath::Max(1, Results.Num());
+	UE_LOG(LogEldaraCombatSim, Display, TEXT("Per encounter: %.1f casts, %.1f effect ticks"),
+		static_cast<double>(TotalCasts) / Count, static_cast<double>(TotalTicks) / Count);
+	UE_LOG(LogEldaraCombatSim, Display, TEXT("Throughput: %.0f encounters/s, %.0fx real time, %.0f effect ticks/s (%.3fs wall)"),
+		Results.Num() / WallSeconds, SimulatedSeconds / WallSeconds, TotalTicks / WallSeconds, WallSeconds);
+
+	return 0;
+}
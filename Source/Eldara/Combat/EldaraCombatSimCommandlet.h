@@ -0,0 +1,59 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "EldaraCombatSimCommandlet.generated.h"
+
+class UEldaraAbility;
+
+/**
+ * Runs the headless combat simulator over many scripted encounters and reports DPS/HPS
+ * distributions and simulation throughput. Used as the combat balance tool and as the
+ * combat performance regression benchmark.
+ *
+ * UnrealEditor-Cmd Eldara.uproject -run=EldaraCombatSim -Class=/Game/Data/Classes/DA_Warrior
+ *
+ * Rotation: -Class=<class data asset> [-Level=1] (starting abilities in order) or -Abilities=<asset>,<asset>,...
+ * Options:  -Encounters=10000 -Casters=1 -Duration=180 -Step=0.0166 -Seed=1 -GCD=1
+ *           -Health=1000 -Resource=100 -Regen=5 -IncomingDps=0 -Reaction=0.2 -SingleThread
+ *
+ * -EffectKernelBench [-Ticks=10000 -Rounds=20 -Effect=<effect asset>] instead times effect ticks
+ * on a spawned character in a throwaway game world: the old type switch that always called the
+ * Blueprint ExecuteEffect event, the native kernel with the event, and the native kernel alone.
+ * Without -Effect it uses a plain fire damage-over-time effect.
+ *
+ * -EffectStoreBench [-Combatants=1000 -Effects=16 -Rounds=20] instead times add, find, stack
+ * lookup and remove on the active-effect slot map against the array it replaced, which found
+ * instances by a linear scan and rebuilt its effect index on every removal.
+ *
+ * -SpatialGridBench [-Combatants=2000 -Queries=10000 -Radius=800 -Extent=20000 -Rounds=20]
+ * instead spawns combatants spread over a square of +-Extent cm in a throwaway game world and
+ * times combat spatial grid sphere queries against a scan of every combatant.
+ */
+UCLASS()
+class UEldaraCombatSimCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UEldaraCombatSimCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+
+private:
+	/** Time effect ticks through the native kernels against the old Blueprint-event path; returns the exit code */
+	int32 RunEffectKernelBench(const FString& Params);
+
+	/** Time active-effect slot map operations against the old linear layout; returns the exit code */
+	int32 RunEffectStoreBench(const FString& Params);
+
+	/** Time spatial grid sphere queries against a linear scan; returns the exit code */
+	int32 RunSpatialGridBench(const FString& Params);
+
+	/** Resolve the rotation from -Class or -Abilities; false if nothing usable was given */
+	bool LoadRotation(const FString& Params);
+
+	/** Keeps the loaded assets referenced while the simulation reads them */
+	UPROPERTY()
+	TArray<TObjectPtr<UEldaraAbility>> Rotation;
+};
@@ -0,0 +1,409 @@
+#include "EldaraCombatSimulator.h"
+#include "EldaraCombatRules.h"
+#include "Eldara/Characters/EldaraAbility.h"
+#include "Eldara/Characters/EldaraEffect.h"
+#include "Async/ParallelFor.h"
+
+namespace
+{
+	constexpr float MinTimeStep = 0.001f;
+	constexpr int32 DummyIndex = 0;
+	constexpr int32 EncountersPerTask = 64;
+}
+
+FEldaraCombatSimConfig::FEldaraCombatSimConfig()
+{
+	for (float& Scale : DamageTypeScales)
+	{
+		Scale = 1.0f;
+	}
+}
+
+FEldaraCombatSimulator::FEldaraCombatSimulator(const FEldaraCombatSimConfig& InConfig)
+	: Config(InConfig)
+{
+	Units.SetNum(FMath::Max(1, Config.NumCasters) + 1);
+
+	// Grant once; every caster gets the same slots, in rotation order
+	for (int32 UnitIndex = DummyIndex + 1; UnitIndex < Units.Num(); ++UnitIndex)
+	{
+		for (UEldaraAbility* Ability : Config.Rotation)
+		{
+			if (Ability)
+			{
+				Units[UnitIndex].Cooldowns.Grant(Ability);
+			}
+		}
+	}
+}
+
+bool FEldaraCombatSimulator::IsFriendlyEffect(const UEldaraEffect& Effect)
+{
+	return Effect.EffectType == EEffectType::Healing || Effect.EffectType == EEffectType::Buff || Effect.EffectType == EEffectType::ResourceRestore;
+}
+
+void FEldaraCombatSimulator::ResetEncounter()
+{
+	Wheel.Reset(FMath::Max(Config.TimeStep, MinTimeStep));
+	DueEvents.Reset();
+	NextSequence = 0;
+	Result = FEldaraCombatSimResult();
+
+	for (int32 UnitIndex = 0; UnitIndex < Units.Num(); ++UnitIndex)
+	{
+		FSimUnit& Unit = Units[UnitIndex];
+		Unit.Cooldowns.ResetCooldowns();
+		Unit.Effects.Reset();
+		Unit.FreeEffects.Reset();
+		Unit.NextActionTime = 0.0;
+		Unit.CastingIndex = INDEX_NONE;
+		Unit.CastEndTime = 0.0;
+
+		// The dummy's vitals are never read
+		const bool bIsCaster = UnitIndex != DummyIndex;
+		Unit.MaxHealth = Unit.Health = bIsCaster ? Config.CasterHealth : 0.0f;
+		Unit.MaxResource = Unit.Resource = bIsCaster ? Config.CasterResource : 0.0f;
+	}
+}
+
+FEldaraCombatSimResult FEldaraCombatSimulator::Run(int32 Seed)
+{
+	Random.Initialize(Seed);
+	ResetEncounter();
+
+	const float TimeStep = FMath::Max(Config.TimeStep, MinTimeStep);
+	const int32 NumSteps = FMath::CeilToInt32(FMath::Max(Config.Duration, 0.0f) / TimeStep);
+
+	for (int32 Step = 0; Step < NumSteps; ++Step)
+	{
+		// Multiply rather than accumulate so long encounters do not drift
+		const double Now = Step * static_cast<double>(TimeStep);
+		DispatchDueEvents(Now);
+
+		for (int32 CasterIndex = DummyIndex + 1; CasterIndex < Units.Num(); ++CasterIndex)
+		{
+			UpdateCaster(CasterIndex, Now, TimeStep);
+		}
+	}
+
+	Result.Duration = NumSteps * TimeStep;
+	return Result;
+}
+
+void FEldaraCombatSimulator::RunBatch(const FEldaraCombatSimConfig& Config, int32 NumEncounters, int32 BaseSeed, bool bSingleThread, TArray<FEldaraCombatSimResult>& OutResults)
+{
+	OutResults.SetNum(FMath::Max(0, NumEncounters));
+
+	// Each task owns a simulator; an encounter's result depends only on its seed
+	const int32 NumTasks = FMath::DivideAndRoundUp(OutResults.Num(), EncountersPerTask);
+	ParallelFor(NumTasks, [&Config, &OutResults, BaseSeed](int32 TaskIndex)
+	{
+		FEldaraCombatSimulator Simulator(Config);
+		const int32 BeginIndex = TaskIndex * EncountersPerTask;
+		const int32 EndIndex = FMath::Min(BeginIndex + EncountersPerTask, OutResults.Num());
+		for (int32 Index = BeginIndex; Index < EndIndex; ++Index)
+		{
+			OutResults[Index] = Simulator.Run(BaseSeed + Index);
+		}
+	}, bSingleThread ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None);
+}
+
+void FEldaraCombatSimulator::DispatchDueEvents(double Now)
+{
+	DueEvents.Reset();
+	Wheel.Advance(Now, [this](const FSimEvent& Event, double)
+	{
+		DueEvents.Add(Event);
+	});
+
+	// Same ordering as UEldaraEffectScheduler: due time, then ticks before expiries, then schedule order
+	DueEvents.Sort([](const FSimEvent& A, const FSimEvent& B)
+	{
+		if (A.DueTime != B.DueTime)
+		{
+			return A.DueTime < B.DueTime;
+		}
+		if (A.Event != B.Event)
+		{
+			return A.Event < B.Event;
+		}
+		return A.Sequence < B.Sequence;
+	});
+
+	for (const FSimEvent& Event : DueEvents)
+	{
+		FSimEffect& Effect = Units[Event.Unit].Effects[Event.EffectIndex];
+		if (!Effect.bActive || Effect.Serial != Event.Serial)
+		{
+			continue;
+		}
+
+		if (Event.Event == EEldaraEffectEvent::Expire)
+		{
+			RemoveEffect(Event.Unit, Event.EffectIndex);
+			continue;
+		}
+
+		const UEldaraEffect& EffectData = *Effect.Runtime.Effect;
+		Effect.Runtime.TickEvent.Invalidate();
+		++Result.EffectTicks;
+
+		const float Amount = FEldaraEffectTickBatch::ComputeAmount(EffectData.EffectType, EffectData.Magnitude, Effect.Runtime.Stacks,
+			Config.DamageTypeScales[static_cast<int32>(EffectData.DamageType)]);
+		ApplyAmount(Event.Unit, Effect.Caster, EffectData, Amount);
+
+		if (EldaraCombatRules::ChainTick(Effect.Runtime, EffectData, Event.DueTime))
+		{
+			Effect.Runtime.TickEvent = Schedule(Event.Unit, Event.EffectIndex, EEldaraEffectEvent::Tick, Effect.Runtime.NextTickTime);
+		}
+	}
+}
+
+void FEldaraCombatSimulator::UpdateCaster(int32 CasterIndex, double Now, float DeltaTime)
+{
+	FSimUnit& Caster = Units[CasterIndex];
+	if (Caster.Health <= 0.0f)
+	{
+		return;
+	}
+
+	Caster.Resource = FMath::Min(Caster.MaxResource, Caster.Resource + Config.ResourceRegenPerSecond * DeltaTime);
+	if (Config.IncomingDamagePerSecond > 0.0f)
+	{
+		Caster.Health -= Config.IncomingDamagePerSecond * DeltaTime;
+		if (Caster.Health <= 0.0f)
+		{
+			Caster.Health = 0.0f;
+			Caster.CastingIndex = INDEX_NONE;
+			return;
+		}
+	}
+
+	if (Caster.CastingIndex != INDEX_NONE)
+	{
+		if (Now < Caster.CastEndTime)
+		{
+			return;
+		}
+
+		const int32 RotationIndex = Caster.CastingIndex;
+		Caster.CastingIndex = INDEX_NONE;
+		ResolveCast(CasterIndex, RotationIndex, Now);
+		Caster.NextActionTime = Now + Random.FRandRange(0.0f, Config.MaxReactionTime);
+		return;
+	}
+
+	if (Now < Caster.NextActionTime)
+	{
+		return;
+	}
+
+	const int32 RotationIndex = ChooseAbility(Caster, Now);
+	if (RotationIndex == INDEX_NONE)
+	{
+		return;
+	}
+
+	const float CastTime = Config.Rotation[RotationIndex]->CastTime;
+	if (CastTime > 0.0f)
+	{
+		Caster.CastingIndex = RotationIndex;
+		Caster.CastEndTime = Now + CastTime;
+		return;
+	}
+
+	ResolveCast(CasterIndex, RotationIndex, Now);
+	Caster.NextActionTime = Now + Random.FRandRange(0.0f, Config.MaxReactionTime);
+}
+
+int32 FEldaraCombatSimulator::ChooseAbility(const FSimUnit& Caster, double Now) const
+{
+	for (int32 RotationIndex = 0; RotationIndex < Config.Rotation.Num(); ++RotationIndex)
+	{
+		const UEldaraAbility* Ability = Config.Rotation[RotationIndex];
+		if (!Ability || Caster.Cooldowns.IsOnCooldown(Caster.Cooldowns.FindSlot(Ability), Now))
+		{
+			continue;
+		}
+
+		FString ErrorMessage;
+		if (EldaraCombatRules::CanPayCost(*Ability, Caster.Health, Caster.Resource, ErrorMessage))
+		{
+			return RotationIndex;
+		}
+	}
+	return INDEX_NONE;
+}
+
+void FEldaraCombatSimulator::ResolveCast(int32 CasterIndex, int32 RotationIndex, double Now)
+{
+	UEldaraAbility* Ability = Config.Rotation[RotationIndex];
+	FSimUnit& Caster = Units[CasterIndex];
+
+	// Vitals may have changed during a cast time
+	FString ErrorMessage;
+	if (!EldaraCombatRules::CanPayCost(*Ability, Caster.Health, Caster.Resource, ErrorMessage))
+	{
+		return;
+	}
+
+	if (Ability->ResourceType == EResourceType::Health)
+	{
+		Caster.Health -= FMath::Max(0.0f, Ability->ResourceCost);
+	}
+	else
+	{
+		Caster.Resource -= FMath::Max(0.0f, Ability->ResourceCost);
+	}
+	++Result.Casts;
+
+	for (UEldaraEffect* Effect : Ability->EffectsToApply)
+	{
+		if (!Effect)
+		{
+			continue;
+		}
+
+		const int32 TargetIndex = IsFriendlyEffect(*Effect) ? ChooseFriendlyTarget(CasterIndex, *Ability) : DummyIndex;
+		if (TargetIndex != INDEX_NONE)
+		{
+			ApplyEffect(TargetIndex, CasterIndex, Effect, Now);
+		}
+	}
+
+	Caster.Cooldowns.Commit(Caster.Cooldowns.FindSlot(Ability), Now, Config.GlobalCooldown);
+}
+
+int32 FEldaraCombatSimulator::ChooseFriendlyTarget(int32 CasterIndex, const UEldaraAbility& Ability) const
+{
+	if (Ability.TargetType == EAbilityTargetType::Self || Ability.TargetType == EAbilityTargetType::NoTarget)
+	{
+		return Units[CasterIndex].Health > 0.0f ? CasterIndex : INDEX_NONE;
+	}
+
+	// Most injured living caster; lowest index wins ties
+	int32 BestIndex = INDEX_NONE;
+	float BestFraction = TNumericLimits<float>::Max();
+	for (int32 UnitIndex = DummyIndex + 1; UnitIndex < Units.Num(); ++UnitIndex)
+	{
+		const FSimUnit& Unit = Units[UnitIndex];
+		const float Fraction = Unit.MaxHealth > 0.0f ? Unit.Health / Unit.MaxHealth : 0.0f;
+		if (Unit.Health > 0.0f && Fraction < BestFraction)
+		{
+			BestFraction = Fraction;
+			BestIndex = UnitIndex;
+		}
+	}
+	return BestIndex;
+}
+
+void FEldaraCombatSimulator::ApplyEffect(int32 TargetIndex, int32 CasterIndex, UEldaraEffect* Effect, double Now)
+{
+	const float SingleAmount = FEldaraEffectTickBatch::ComputeAmount(Effect->EffectType, Effect->Magnitude, 1,
+		Config.DamageTypeScales[static_cast<int32>(Effect->DamageType)]);
+
+	if (Effect->Duration <= 0.0f)
+	{
+		ApplyAmount(TargetIndex, CasterIndex, *Effect, SingleAmount);
+		return;
+	}
+
+	FSimUnit& Target = Units[TargetIndex];
+	for (int32 EffectIndex = 0; EffectIndex < Target.Effects.Num(); ++EffectIndex)
+	{
+		FSimEffect& Existing = Target.Effects[EffectIndex];
+		if (Existing.bActive && Existing.Runtime.Effect == Effect && (!Effect->bStacksPerInstigator || Existing.Caster == CasterIndex))
+		{
+			if (EldaraCombatRules::Reapply(Existing.Runtime, *Effect, Now))
+			{
+				ScheduleEvents(TargetIndex, EffectIndex);
+			}
+			return;
+		}
+	}
+
+	const int32 EffectIndex = Target.FreeEffects.Num() > 0 ? Target.FreeEffects.Pop(EAllowShrinking::No) : Target.Effects.AddDefaulted();
+	FSimEffect& Applied = Target.Effects[EffectIndex];
+	Applied.Runtime = FActiveEffectRuntime();
+	EldaraCombatRules::InitApplication(Applied.Runtime, Effect, Now);
+	Applied.Caster = CasterIndex;
+	Applied.bActive = true;
+	ScheduleEvents(TargetIndex, EffectIndex);
+
+	if (Effect->TickInterval <= 0.0f)
+	{
+		ApplyAmount(TargetIndex, CasterIndex, *Effect, SingleAmount);
+	}
+}
+
+void FEldaraCombatSimulator::ApplyAmount(int32 TargetIndex, int32 CasterIndex, const UEldaraEffect& Effect, float Amount)
+{
+	FSimUnit& Target = Units[TargetIndex];
+
+	switch (Effect.EffectType)
+	{
+	case EEffectType::Damage:
+		if (TargetIndex == DummyIndex)
+		{
+			Result.DamageDone += Amount;
+		}
+		else
+		{
+			Target.Health = FMath::Max(0.0f, Target.Health - Amount);
+		}
+		break;
+	case EEffectType::Healing:
+		if (TargetIndex != DummyIndex && Target.Health > 0.0f)
+		{
+			const float Before = Target.Health;
+			Target.Health = FMath::Clamp(Target.Health + Amount, 0.0f, Target.MaxHealth);
+			Result.HealingDone += Target.Health - Before;
+		}
+		break;
+	case EEffectType::ResourceRestore:
+		Target.Resource = FMath::Clamp(Target.Resource + Amount, 0.0f, Target.MaxResource);
+		break;
+	default:
+		// Buffs, debuffs and crowd control have no per-application payload
+		break;
+	}
+}
+
+FEldaraTimerHandle FEldaraCombatSimulator::Schedule(int32 UnitIndex, int32 EffectIndex, EEldaraEffectEvent Event, double DueTime)
+{
+	FSimEvent Scheduled;
+	Scheduled.Unit = UnitIndex;
+	Scheduled.EffectIndex = EffectIndex;
+	Scheduled.Serial = Units[UnitIndex].Effects[EffectIndex].Serial;
+	Scheduled.Event = Event;
+	Scheduled.Sequence = NextSequence++;
+	Scheduled.DueTime = DueTime;
+	return Wheel.Schedule(DueTime, Scheduled);
+}
+
+void FEldaraCombatSimulator::ScheduleEvents(int32 UnitIndex, int32 EffectIndex)
+{
+	FActiveEffectRuntime& Runtime = Units[UnitIndex].Effects[EffectIndex].Runtime;
+	Wheel.Cancel(Runtime.TickEvent);
+	Wheel.Cancel(Runtime.ExpireEvent);
+	Runtime.TickEvent.Invalidate();
+
+	if (Runtime.Effect->TickInterval > 0.0f)
+	{
+		Runtime.TickEvent = Schedule(UnitIndex, EffectIndex, EEldaraEffectEvent::Tick, Runtime.NextTickTime);
+	}
+	Runtime.ExpireEvent = Schedule(UnitIndex, EffectIndex, EEldaraEffectEvent::Expire, Runtime.ExpireTime);
+}
+
+void FEldaraCombatSimulator::RemoveEffect(int32 UnitIndex, int32 EffectIndex)
+{
+	FSimUnit& Unit = Units[UnitIndex];
+	FSimEffect& Effect = Unit.Effects[EffectIndex];
+
+	Wheel.Cancel(Effect.Runtime.TickEvent);
+	Wheel.Cancel(Effect.Runtime.ExpireEvent);
+	Effect.Runtime = FActiveEffectRuntime();
+	Effect.bActive = false;
+	++Effect.Serial;
+	Unit.FreeEffects.Add(EffectIndex);
+}
@@ -0,0 +1,158 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Math/RandomStream.h"
+#include "EldaraTimingWheel.h"
+#include "EldaraCooldownTable.h"
+#include "EldaraActiveEffectStore.h"
+#include "EldaraEffectTickBatch.h"
+#include "EldaraEffectScheduler.h"
+
+class UEldaraAbility;
+
+/** Scripted encounter: a party of identical casters working a priority list against a training dummy */
+struct ELDARA_API FEldaraCombatSimConfig
+{
+	/** Abilities in priority order; each decision casts the first one that is ready and affordable */
+	TArray<UEldaraAbility*> Rotation;
+
+	int32 NumCasters = 1;
+
+	/** Encounter length in seconds */
+	float Duration = 180.0f;
+
+	/** Fixed simulation step in seconds (also the effect timing resolution) */
+	float TimeStep = 1.0f / 60.0f;
+
+	float GlobalCooldown = 1.0f;
+
+	float CasterHealth = 1000.0f;
+	float CasterResource = 100.0f;
+	float ResourceRegenPerSecond = 5.0f;
+
+	/** Damage each caster takes per second, so heals have something to do */
+	float IncomingDamagePerSecond = 0.0f;
+
+	/** Upper bound of the random delay before a caster acts again after a cast */
+	float MaxReactionTime = 0.2f;
+
+	/** Damage multiplier per damage type */
+	float DamageTypeScales[FEldaraEffectTickBatch::NumDamageTypes];
+
+	FEldaraCombatSimConfig();
+};
+
+/** Totals for one simulated encounter */
+struct ELDARA_API FEldaraCombatSimResult
+{
+	double DamageDone = 0.0;
+	/** Effective healing (overhealing is not counted) */
+	double HealingDone = 0.0;
+	int32 Casts = 0;
+	int32 EffectTicks = 0;
+	float Duration = 0.0f;
+
+	/** Per-caster damage per second */
+	float GetDps(int32 NumCasters) const { return Duration > 0.0f ? static_cast<float>(DamageDone / (Duration * FMath::Max(1, NumCasters))) : 0.0f; }
+
+	/** Per-caster effective healing per second */
+	float GetHps(int32 NumCasters) const { return Duration > 0.0f ? static_cast<float>(HealingDone / (Duration * FMath::Max(1, NumCasters))) : 0.0f; }
+};
+
+/**
+ * Headless, fixed-timestep combat simulator for balance and performance regression runs.
+ *
+ * Runs the same rules as UEldaraCombatComponent - cost validation (EldaraCombatRules),
+ * charges and global cooldown (FEldaraCooldownTable), effect stacking and refresh, and
+ * DoT/HoT ticks and expiries on a timing wheel with the effect scheduler's same-instant
+ * ordering and amount formula - over plain structs, with no actors, world or Blueprint
+ * ExecuteEffect calls.
+ *
+ * Casters spend their ability on the dummy for hostile effects; healing, buffs and
+ * resource restores go to the caster for Self/NoTarget abilities and to the most injured
+ * living caster otherwise. The dummy never dies. Cast times delay the cast's resolution;
+ * cost, effects and cooldown resolve when the cast completes.
+ *
+ * Runs are deterministic: the same config and seed always give the same result. One
+ * simulator reuses its buffers across runs and is not thread-safe; RunBatch gives each
+ * worker its own. Ability and effect assets are only read and must stay loaded.
+ */
+class ELDARA_API FEldaraCombatSimulator
+{
+public:
+	explicit FEldaraCombatSimulator(const FEldaraCombatSimConfig& InConfig);
+
+	/** Simulate one encounter */
+	FEldaraCombatSimResult Run(int32 Seed);
+
+	/**
+	 * Simulate NumEncounters encounters with seeds BaseSeed + index across worker threads
+	 * @param bSingleThread Run everything on the calling thread (results are identical)
+	 */
+	static void RunBatch(const FEldaraCombatSimConfig& Config, int32 NumEncounters, int32 BaseSeed, bool bSingleThread, TArray<FEldaraCombatSimResult>& OutResults);
+
+private:
+	struct FSimEffect
+	{
+		FActiveEffectRuntime Runtime;
+		/** Unit that applied it; credited with its damage and healing */
+		int32 Caster = INDEX_NONE;
+		/** Bumped on removal so stale wheel events are ignored */
+		uint32 Serial = 0;
+		bool bActive = false;
+	};
+
+	struct FSimUnit
+	{
+		float Health = 0.0f;
+		float MaxHealth = 0.0f;
+		float Resource = 0.0f;
+		float MaxResource = 0.0f;
+		FEldaraCooldownTable Cooldowns;
+		TArray<FSimEffect> Effects;
+		TArray<int32> FreeEffects;
+		double NextActionTime = 0.0;
+		/** Rotation index being cast, INDEX_NONE when idle */
+		int32 CastingIndex = INDEX_NONE;
+		double CastEndTime = 0.0;
+	};
+
+	struct FSimEvent
+	{
+		int32 Unit = INDEX_NONE;
+		int32 EffectIndex = INDEX_NONE;
+		uint32 Serial = 0;
+		EEldaraEffectEvent Event = EEldaraEffectEvent::Tick;
+		uint64 Sequence = 0;
+		double DueTime = 0.0;
+	};
+
+	void ResetEncounter();
+	void DispatchDueEvents(double Now);
+	void UpdateCaster(int32 CasterIndex, double Now, float DeltaTime);
+
+	/** Pick the first castable ability; INDEX_NONE if none */
+	int32 ChooseAbility(const FSimUnit& Caster, double Now) const;
+	void ResolveCast(int32 CasterIndex, int32 RotationIndex, double Now);
+
+	int32 ChooseFriendlyTarget(int32 CasterIndex, const UEldaraAbility& Ability) const;
+	void ApplyEffect(int32 TargetIndex, int32 CasterIndex, UEldaraEffect* Effect, double Now);
+	void ApplyAmount(int32 TargetIndex, int32 CasterIndex, const UEldaraEffect& Effect, float Amount);
+	void ScheduleEvents(int32 UnitIndex, int32 EffectIndex);
+	void RemoveEffect(int32 UnitIndex, int32 EffectIndex);
+	FEldaraTimerHandle Schedule(int32 UnitIndex, int32 EffectIndex, EEldaraEffectEvent Event, double DueTime);
+
+	static bool IsFriendlyEffect(const UEldaraEffect& Effect);
+
+	const FEldaraCombatSimConfig& Config;
+
+	/** Index 0 is the dummy, casters follow */
+	TArray<FSimUnit> Units;
+
+	TEldaraTimingWheel<FSimEvent> Wheel;
+	TArray<FSimEvent> DueEvents;
+	uint64 NextSequence = 0;
+
+	FRandomStream Random;
+	FEldaraCombatSimResult Result;
+};
@@ -0,0 +1,292 @@
+#include "EldaraCombatSpatialGrid.h"
+#include "Eldara/Characters/EldaraCharacterBase.h"
+#include "Engine/World.h"
+
+namespace
+{
+	constexpr float MinCellSize = 100.0f;
+	constexpr float MaxHalfConeDegrees = 180.0f;
+}
+
+void UEldaraCombatSpatialGrid::Deinitialize()
+{
+	Entries.Reset();
+	EntryIndexByCharacter.Reset();
+	Cells.Reset();
+
+	Super::Deinitialize();
+}
+
+bool UEldaraCombatSpatialGrid::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId UEldaraCombatSpatialGrid::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UEldaraCombatSpatialGrid, STATGROUP_Tickables);
+}
+
+void UEldaraCombatSpatialGrid::Tick(float DeltaTime)
+{
+	// Walk backwards so swap-removal of destroyed actors does not skip entries
+	for (int32 EntryIndex = Entries.Num() - 1; EntryIndex >= 0; --EntryIndex)
+	{
+		FEntry& Entry = Entries[EntryIndex];
+		if (!RefreshEntry(Entry))
+		{
+			RemoveEntry(EntryIndex);
+			continue;
+		}
+
+		const FIntPoint NewCell = ToCell(Entry.Location);
+		if (NewCell != Entry.Cell)
+		{
+			RemoveFromCell(EntryIndex);
+			Entries[EntryIndex].Cell = NewCell;
+			AddToCell(EntryIndex);
+		}
+	}
+}
+
+void UEldaraCombatSpatialGrid::Register(AEldaraCharacterBase* Character)
+{
+	if (!Character || EntryIndexByCharacter.Contains(FObjectKey(Character)))
+	{
+		return;
+	}
+
+	const int32 EntryIndex = Entries.AddDefaulted();
+	FEntry& Entry = Entries[EntryIndex];
+	Entry.Character = Character;
+	Entry.Key = FObjectKey(Character);
+	RefreshEntry(Entry);
+	Entry.Cell = ToCell(Entry.Location);
+
+	EntryIndexByCharacter.Add(Entry.Key, EntryIndex);
+	AddToCell(EntryIndex);
+}
+
+void UEldaraCombatSpatialGrid::Unregister(AEldaraCharacterBase* Character)
+{
+	if (const int32* EntryIndex = EntryIndexByCharacter.Find(FObjectKey(Character)))
+	{
+		RemoveEntry(*EntryIndex);
+	}
+}
+
+FIntPoint UEldaraCombatSpatialGrid::ToCell(const FVector& Location) const
+{
+	const double InvCellSize = 1.0 / FMath::Max(CellSize, MinCellSize);
+	return FIntPoint(FMath::FloorToInt32(Location.X * InvCellSize), FMath::FloorToInt32(Location.Y * InvCellSize));
+}
+
+bool UEldaraCombatSpatialGrid::RefreshEntry(FEntry& Entry) const
+{
+	const AEldaraCharacterBase* Character = Entry.Character.Get();
+	if (!Character)
+	{
+		return false;
+	}
+
+	Entry.Location = Character->GetActorLocation();
+	Entry.Faction = Character->GetCombatFaction();
+	Entry.bAlive = !Character->IsDead();
+	Entry.bActive = !Character->IsHidden();
+	return true;
+}
+
+void UEldaraCombatSpatialGrid::AddToCell(int32 EntryIndex)
+{
+	FEntry& Entry = Entries[EntryIndex];
+	TArray<int32>& CellEntries = Cells.FindOrAdd(Entry.Cell);
+	Entry.IndexInCell = CellEntries.Add(EntryIndex);
+}
+
+void UEldaraCombatSpatialGrid::RemoveFromCell(int32 EntryIndex)
+{
+	FEntry& Entry = Entries[EntryIndex];
+	TArray<int32>* CellEntries = Cells.Find(Entry.Cell);
+	if (!CellEntries)
+	{
+		return;
+	}
+
+	const int32 IndexInCell = Entry.IndexInCell;
+	CellEntries->RemoveAtSwap(IndexInCell, 1, EAllowShrinking::No);
+	if (CellEntries->IsValidIndex(IndexInCell))
+	{
+		Entries[(*CellEntries)[IndexInCell]].IndexInCell = IndexInCell;
+	}
+	else if (CellEntries->IsEmpty())
+	{
+		Cells.Remove(Entry.Cell);
+	}
+	Entry.IndexInCell = INDEX_NONE;
+}
+
+void UEldaraCombatSpatialGrid::RemoveEntry(int32 EntryIndex)
+{
+	RemoveFromCell(EntryIndex);
+
+	EntryIndexByCharacter.Remove(Entries[EntryIndex].Key);
+
+	// Swap the last entry into the hole and repoint its cell slot and index
+	const int32 LastIndex = Entries.Num() - 1;
+	if (EntryIndex != LastIndex)
+	{
+		Entries[EntryIndex] = MoveTemp(Entries[LastIndex]);
+		const FEntry& Moved = Entries[EntryIndex];
+		Cells.FindChecked(Moved.Cell)[Moved.IndexInCell] = EntryIndex;
+		EntryIndexByCharacter.Add(Moved.Key, EntryIndex);
+	}
+	Entries.RemoveAt(LastIndex, 1, EAllowShrinking::No);
+}
+
+bool UEldaraCombatSpatialGrid::PassesFilter(const FEntry& Entry, const FEldaraTargetFilter& Filter) const
+{
+	if (!Entry.bActive || (Filter.bAliveOnly && !Entry.bAlive))
+	{
+		return false;
+	}
+	if (Filter.FactionMask != 0 && (Filter.FactionMask & FEldaraTargetFilter::FactionBit(Entry.Faction)) == 0)
+	{
+		return false;
+	}
+	return !Filter.IgnoreActor || Entry.Character.Get() != Filter.IgnoreActor;
+}
+
+template<typename VisitorType>
+void UEldaraCombatSpatialGrid::ForEachCandidate(const FVector& BoundsMin, const FVector& BoundsMax, const FEldaraTargetFilter& Filter, VisitorType&& Visit) const
+{
+	const FIntPoint MinCell = ToCell(BoundsMin);
+	const FIntPoint MaxCell = ToCell(BoundsMax);
+
+	auto VisitCell = [this, &Filter, &Visit](const TArray<int32>& CellEntries)
+	{
+		for (const int32 EntryIndex : CellEntries)
+		{
+			const FEntry& Entry = Entries[EntryIndex];
+			if (PassesFilter(Entry, Filter))
+			{
+				Visit(Entry);
+			}
+		}
+	};
+
+	// A query wider than the occupied area is cheaper to run over the occupied cells
+	const int64 CellsInBounds = int64(MaxCell.X - MinCell.X + 1) * int64(MaxCell.Y - MinCell.Y + 1);
+	if (CellsInBounds > Cells.Num())
+	{
+		for (const TPair<FIntPoint, TArray<int32>>& Cell : Cells)
+		{
+			if (Cell.Key.X >= MinCell.X && Cell.Key.X <= MaxCell.X && Cell.Key.Y >= MinCell.Y && Cell.Key.Y <= MaxCell.Y)
+			{
+				VisitCell(Cell.Value);
+			}
+		}
+		return;
+	}
+
+	for (int32 CellY = MinCell.Y; CellY <= MaxCell.Y; ++CellY)
+	{
+		for (int32 CellX = MinCell.X; CellX <= MaxCell.X; ++CellX)
+		{
+			if (const TArray<int32>* CellEntries = Cells.Find(FIntPoint(CellX, CellY)))
+			{
+				VisitCell(*CellEntries);
+			}
+		}
+	}
+}
+
+int32 UEldaraCombatSpatialGrid::QuerySphere(FVector Center, float Radius, const FEldaraTargetFilter& Filter, TArray<AEldaraCharacterBase*>& OutTargets) const
+{
+	OutTargets.Reset();
+	if (Radius < 0.0f)
+	{
+		return 0;
+	}
+
+	const FVector Extent(Radius);
+	const double RadiusSq = FMath::Square(static_cast<double>(Radius));
+	ForEachCandidate(Center - Extent, Center + Extent, Filter, [&](const FEntry& Entry)
+	{
+		if (FVector::DistSquared(Entry.Location, Center) <= RadiusSq)
+		{
+			OutTargets.Add(Entry.Character.Get());
+		}
+	});
+	return OutTargets.Num();
+}
+
+int32 UEldaraCombatSpatialGrid::QueryCone(FVector Origin, FVector Direction, float Range, float HalfAngleDegrees, const FEldaraTargetFilter& Filter, TArray<AEldaraCharacterBase*>& OutTargets) const
+{
+	OutTargets.Reset();
+	const FVector Forward = Direction.GetSafeNormal();
+	if (Range < 0.0f || Forward.IsNearlyZero())
+	{
+		return 0;
+	}
+
+	const double RangeSq = FMath::Square(static_cast<double>(Range));
+	const double CosHalfAngle = FMath::Cos(FMath::DegreesToRadians(FMath::Clamp(HalfAngleDegrees, 0.0f, MaxHalfConeDegrees)));
+	const FVector Extent(Range);
+	ForEachCandidate(Origin - Extent, Origin + Extent, Filter, [&](const FEntry& Entry)
+	{
+		const FVector Offset = Entry.Location - Origin;
+		const double DistanceSq = Offset.SizeSquared();
+		if (DistanceSq > RangeSq)
+		{
+			return;
+		}
+
+		// Inside the cone if the angle to Forward is at most the half angle; a target at the apex counts
+		const double Distance = FMath::Sqrt(DistanceSq);
+		if (Distance <= UE_KINDA_SMALL_NUMBER || FVector::DotProduct(Offset, Forward) >= CosHalfAngle * Distance)
+		{
+			OutTargets.Add(Entry.Character.Get());
+		}
+	});
+	return OutTargets.Num();
+}
+
+int32 UEldaraCombatSpatialGrid::QueryBox(FVector Center, FVector HalfExtent, FRotator Rotation, const FEldaraTargetFilter& Filter, TArray<AEldaraCharacterBase*>& OutTargets) const
+{
+	OutTargets.Reset();
+	HalfExtent = HalfExtent.GetAbs();
+
+	const FQuat BoxRotation = Rotation.Quaternion();
+	const FBox Bounds = FBox(-HalfExtent, HalfExtent).TransformBy(FTransform(BoxRotation, Center));
+	ForEachCandidate(Bounds.Min, Bounds.Max, Filter, [&](const FEntry& Entry)
+	{
+		const FVector Local = BoxRotation.UnrotateVector(Entry.Location - Center);
+		if (FMath::Abs(Local.X) <= HalfExtent.X && FMath::Abs(Local.Y) <= HalfExtent.Y && FMath::Abs(Local.Z) <= HalfExtent.Z)
+		{
+			OutTargets.Add(Entry.Character.Get());
+		}
+	});
+	return OutTargets.Num();
+}
+
+AEldaraCharacterBase* UEldaraCombatSpatialGrid::FindNearest(FVector Center, float Radius, const FEldaraTargetFilter& Filter) const
+{
+	if (Radius < 0.0f)
+	{
+		return nullptr;
+	}
+
+	const FEntry* Nearest = nullptr;
+	double NearestDistanceSq = FMath::Square(static_cast<double>(Radius));
+	const FVector Extent(Radius);
+	ForEachCandidate(Center - Extent, Center + Extent, Filter, [&](const FEntry& Entry)
+	{
+		const double DistanceSq = FVector::DistSquared(Entry.Location, Center);
+		if (DistanceSq <= NearestDistanceSq)
+		{
+			NearestDistanceSq = DistanceSq;
+			Nearest = &Entry;
+		}
+	});
+	return Nearest ? Nearest->Character.Get() : nullptr;
+}
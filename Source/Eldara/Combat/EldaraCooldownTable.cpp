@@ -0,0 +1,163 @@
+#include "EldaraCooldownTable.h"
+#include "Eldara/Characters/EldaraAbility.h"
+
+int32 FEldaraCooldownTable::Grant(UEldaraAbility* Ability)
+{
+	check(Ability);
+
+	if (const int32* Existing = SlotByAbility.Find(Ability))
+	{
+		return *Existing;
+	}
+
+	int32 TrackIndex = INDEX_NONE;
+	if (!Ability->CooldownGroup.IsNone())
+	{
+		if (const int32* GroupTrack = GroupTracks.Find(Ability->CooldownGroup))
+		{
+			TrackIndex = *GroupTrack;
+		}
+	}
+
+	if (TrackIndex == INDEX_NONE)
+	{
+		FTrack Track;
+		Track.RechargeTime = FMath::Max(0.0f, Ability->Cooldown);
+		Track.MaxCharges = FMath::Max(1, Ability->MaxCharges);
+		TrackIndex = Tracks.Add(Track);
+
+		if (!Ability->CooldownGroup.IsNone())
+		{
+			// The first ability granted in a group defines its charges and recharge time
+			GroupTracks.Add(Ability->CooldownGroup, TrackIndex);
+		}
+	}
+
+	const int32 Slot = Abilities.Add(Ability);
+	SlotTracks.Add(TrackIndex);
+	SlotUsesGlobal.Add(Ability->bOnGlobalCooldown);
+	SlotByAbility.Add(Ability, Slot);
+	return Slot;
+}
+
+int32 FEldaraCooldownTable::FindSlot(const UEldaraAbility* Ability) const
+{
+	const int32* Slot = SlotByAbility.Find(Ability);
+	return Slot ? *Slot : INDEX_NONE;
+}
+
+int32 FEldaraCooldownTable::GetMissingCharges(const FTrack& Track, double Now)
+{
+	if (Track.FullTime <= Now || Track.RechargeTime <= 0.0f)
+	{
+		return 0;
+	}
+	return FMath::Min(Track.MaxCharges, FMath::CeilToInt32((Track.FullTime - Now) / Track.RechargeTime));
+}
+
+int32 FEldaraCooldownTable::GetCharges(int32 Slot, double Now) const
+{
+	const FTrack& Track = Tracks[SlotTracks[Slot]];
+	return Track.MaxCharges - GetMissingCharges(Track, Now);
+}
+
+float FEldaraCooldownTable::GetRechargeRemaining(int32 Slot, double Now) const
+{
+	const FTrack& Track = Tracks[SlotTracks[Slot]];
+	const int32 Missing = GetMissingCharges(Track, Now);
+	if (Missing == 0)
+	{
+		return 0.0f;
+	}
+
+	// Charges come back one at a time; the next one is due (Missing - 1) recharges before full
+	return static_cast<float>(Track.FullTime - Now - (Missing - 1) * static_cast<double>(Track.RechargeTime));
+}
+
+float FEldaraCooldownTable::GetGlobalRemaining(int32 Slot, double Now) const
+{
+	return SlotUsesGlobal[Slot] ? FMath::Max(0.0f, static_cast<float>(GlobalCooldownEndTime - Now)) : 0.0f;
+}
+
+bool FEldaraCooldownTable::IsOnCooldown(int32 Slot, double Now) const
+{
+	const FTrack& Track = Tracks[SlotTracks[Slot]];
+	return GetMissingCharges(Track, Now) >= Track.MaxCharges || (SlotUsesGlobal[Slot] && GlobalCooldownEndTime > Now);
+}
+
+FEldaraCooldownCommit FEldaraCooldownTable::Commit(int32 Slot, double Now, float GlobalCooldown)
+{
+	FEldaraCooldownCommit Record;
+	Record.Slot = Slot;
+	Record.PreviousGlobalEndTime = GlobalCooldownEndTime;
+
+	FTrack& Track = Tracks[SlotTracks[Slot]];
+	if (Track.RechargeTime > 0.0f)
+	{
+		Track.FullTime = FMath::Max(Track.FullTime, Now) + Track.RechargeTime;
+		Record.bSpentCharge = true;
+	}
+
+	if (SlotUsesGlobal[Slot] && GlobalCooldown > 0.0f)
+	{
+		GlobalCooldownEndTime = FMath::Max(GlobalCooldownEndTime, Now + GlobalCooldown);
+	}
+	Record.GlobalEndTime = GlobalCooldownEndTime;
+	return Record;
+}
+
+void FEldaraCooldownTable::Revert(const FEldaraCooldownCommit& Commit)
+{
+	if (!SlotTracks.IsValidIndex(Commit.Slot))
+	{
+		return;
+	}
+
+	FTrack& Track = Tracks[SlotTracks[Commit.Slot]];
+	if (Commit.bSpentCharge)
+	{
+		// Never below zero: a full track already had every charge back
+		Track.FullTime = FMath::Max(0.0, Track.FullTime - Track.RechargeTime);
+	}
+
+	if (GlobalCooldownEndTime == Commit.GlobalEndTime)
+	{
+		GlobalCooldownEndTime = Commit.PreviousGlobalEndTime;
+	}
+}
+
+void FEldaraCooldownTable::GetSnapshot(double Now, TArray<FEldaraCooldownState>& OutStates) const
+{
+	OutStates.SetNum(Abilities.Num(), EAllowShrinking::No);
+	for (int32 Slot = 0; Slot < Abilities.Num(); ++Slot)
+	{
+		const FTrack& Track = Tracks[SlotTracks[Slot]];
+		FEldaraCooldownState& State = OutStates[Slot];
+		State.Charges = GetCharges(Slot, Now);
+		State.MaxCharges = Track.MaxCharges;
+		State.Duration = Track.RechargeTime;
+		State.Remaining = GetRechargeRemaining(Slot, Now);
+		State.GlobalRemaining = GetGlobalRemaining(Slot, Now);
+		State.bReady = State.Charges > 0 && State.GlobalRemaining <= 0.0f;
+	}
+}
+
+void FEldaraCooldownTable::ResetCooldowns()
+{
+	for (FTrack& Track : Tracks)
+	{
+		Track.FullTime = 0.0;
+	}
+	GlobalCooldownEndTime = 0.0;
+}
+
+void FEldaraCooldownTable::Reset()
+{
+	Abilities.Reset();
+	SlotTracks.Reset();
+	SlotUsesGlobal.Reset();
+	Tracks.Reset();
+	GroupTracks.Reset();
+	SlotByAbility.Reset();
+	GlobalCooldownEndTime = 0.0;
+}
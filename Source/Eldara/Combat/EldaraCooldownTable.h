@@ -0,0 +1,128 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "EldaraCooldownTable.generated.h"
+
+class UEldaraAbility;
+
+/** Cooldown state of one ability slot, for action bars */
+USTRUCT(BlueprintType)
+struct FEldaraCooldownState
+{
+	GENERATED_BODY()
+
+	/** Seconds until the next charge is back (0 when at full charges) */
+	UPROPERTY(BlueprintReadOnly, Category = "Combat")
+	float Remaining = 0.0f;
+
+	/** Recharge time of one charge, for drawing the sweep */
+	UPROPERTY(BlueprintReadOnly, Category = "Combat")
+	float Duration = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Combat")
+	int32 Charges = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Combat")
+	int32 MaxCharges = 0;
+
+	/** Seconds left on the global cooldown if this ability is subject to it */
+	UPROPERTY(BlueprintReadOnly, Category = "Combat")
+	float GlobalRemaining = 0.0f;
+
+	/** Has a charge and is not blocked by the global cooldown */
+	UPROPERTY(BlueprintReadOnly, Category = "Combat")
+	bool bReady = false;
+};
+
+/** What one Commit changed, so a rejected client prediction can hand it back */
+struct FEldaraCooldownCommit
+{
+	int32 Slot = INDEX_NONE;
+	bool bSpentCharge = false;
+	double PreviousGlobalEndTime = 0.0;
+	double GlobalEndTime = 0.0;
+};
+
+/**
+ * Ability cooldowns of one combat component in flat arrays.
+ *
+ * Each granted ability gets a dense slot; abilities that share a cooldown group share one
+ * charge track, ungrouped abilities get a track of their own. A track stores only the time
+ * at which it is back to full charges, so available charges and time to the next charge
+ * are derived arithmetically: queries are O(1) array reads, nothing ticks, and spending a
+ * charge is one add. The global cooldown is a single end time.
+ */
+USTRUCT()
+struct ELDARA_API FEldaraCooldownTable
+{
+	GENERATED_BODY()
+
+	/** Assign Ability a slot (returns the existing one if already granted) */
+	int32 Grant(UEldaraAbility* Ability);
+
+	/** Slot of a granted ability, or INDEX_NONE */
+	int32 FindSlot(const UEldaraAbility* Ability) const;
+
+	int32 Num() const { return Abilities.Num(); }
+	UEldaraAbility* GetAbility(int32 Slot) const { return Abilities[Slot]; }
+
+	/** Charges available on the slot's track at Now */
+	int32 GetCharges(int32 Slot, double Now) const;
+
+	/** Seconds until the slot's track regains a charge (0 when full) */
+	float GetRechargeRemaining(int32 Slot, double Now) const;
+
+	/** Seconds left on the global cooldown for this slot (0 if the ability ignores it) */
+	float GetGlobalRemaining(int32 Slot, double Now) const;
+
+	/** True if the slot has no charge or is blocked by the global cooldown */
+	bool IsOnCooldown(int32 Slot, double Now) const;
+
+	/** Spend one charge and start the global cooldown if the ability triggers it */
+	FEldaraCooldownCommit Commit(int32 Slot, double Now, float GlobalCooldown);
+
+	/**
+	 * Undo a commit: give the charge back and restore the global cooldown, unless a later
+	 * commit has moved the global cooldown since. Charges are refunded as one recharge
+	 * interval, so reverting out of order still leaves the right number of charges.
+	 */
+	void Revert(const FEldaraCooldownCommit& Commit);
+
+	/** Fill one state per slot (index = slot) */
+	void GetSnapshot(double Now, TArray<FEldaraCooldownState>& OutStates) const;
+
+	/** Put every track back to full charges and clear the global cooldown; grants are kept */
+	void ResetCooldowns();
+
+	/** Drop grants and cooldowns */
+	void Reset();
+
+private:
+	struct FTrack
+	{
+		/** Time at which every charge is back; at or before now means full */
+		double FullTime = 0.0;
+		float RechargeTime = 0.0f;
+		int32 MaxCharges = 1;
+	};
+
+	/** Charges still recharging on a track at Now */
+	static int32 GetMissingCharges(const FTrack& Track, double Now);
+
+	/** Granted abilities by slot */
+	UPROPERTY()
+	TArray<TObjectPtr<UEldaraAbility>> Abilities;
+
+	/** Per slot: charge track index and whether the global cooldown applies */
+	TArray<int32> SlotTracks;
+	TArray<bool> SlotUsesGlobal;
+
+	TArray<FTrack> Tracks;
+
+	/** Shared cooldown group name to track index */
+	TMap<FName, int32> GroupTracks;
+
+	TMap<const UEldaraAbility*, int32> SlotByAbility;
+
+	double GlobalCooldownEndTime = 0.0;
+};
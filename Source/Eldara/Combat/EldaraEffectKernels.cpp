@@ -0,0 +1,82 @@
+#include "EldaraEffectKernels.h"
+#include "EldaraCombatEventAggregator.h"
+#include "Eldara/Characters/EldaraCharacterBase.h"
+#include "GameFramework/DamageType.h"
+#include "Engine/DamageEvents.h"
+
+namespace
+{
+	constexpr int32 NumEffectTypes = static_cast<int32>(EEffectType::ResourceRestore) + 1;
+
+	void ApplyDamage(const FEldaraEffectApplication& Application)
+	{
+		if (Application.Aggregator && Application.TargetCharacter)
+		{
+			// Coalesced with the rest of this frame's hits on the target
+			Application.Aggregator->AddDamage(Application.TargetCharacter, Application.Instigator, Application.Effect, Application.Amount);
+		}
+		else if (Application.TargetCharacter)
+		{
+			FDamageEvent DamageEvent(UDamageType::StaticClass());
+			Application.TargetCharacter->TakeDamage(Application.Amount, DamageEvent, Application.InstigatorController, Application.Instigator);
+		}
+		else if (Application.Target)
+		{
+			Application.Target->TakeDamage(Application.Amount, FDamageEvent(), Application.InstigatorController, Application.Instigator);
+		}
+	}
+
+	void ApplyHealing(const FEldaraEffectApplication& Application)
+	{
+		if (Application.Aggregator && Application.TargetCharacter)
+		{
+			Application.Aggregator->AddHealing(Application.TargetCharacter, Application.Instigator, Application.Effect, Application.Amount);
+		}
+		else if (Application.TargetCharacter)
+		{
+			Application.TargetCharacter->ApplyHealing(Application.Amount);
+		}
+	}
+
+	void ApplyResourceRestore(const FEldaraEffectApplication& Application)
+	{
+		if (Application.TargetCharacter)
+		{
+			Application.TargetCharacter->RestoreResource(Application.Amount);
+		}
+	}
+
+	void ApplyNothing(const FEldaraEffectApplication&)
+	{
+	}
+
+	/** Indexed by EEffectType; keep in enum order */
+	constexpr EldaraEffectKernels::FKernel Kernels[] =
+	{
+		&ApplyDamage,           // Damage
+		&ApplyHealing,          // Healing
+		&ApplyNothing,          // Buff
+		&ApplyNothing,          // Debuff
+		&ApplyNothing,          // CrowdControl
+		&ApplyResourceRestore   // ResourceRestore
+	};
+	static_assert(UE_ARRAY_COUNT(Kernels) == NumEffectTypes, "Every effect type needs a kernel");
+}
+
+EldaraEffectKernels::FKernel EldaraEffectKernels::Get(EEffectType EffectType)
+{
+	const int32 Index = static_cast<int32>(EffectType);
+	return Index < NumEffectTypes ? Kernels[Index] : &ApplyNothing;
+}
+
+void EldaraEffectKernels::Execute(const FEldaraEffectApplication& Application)
+{
+	check(Application.Effect);
+
+	Get(Application.Effect->EffectType)(Application);
+
+	if (Application.Effect->bExecuteBlueprint)
+	{
+		Application.Effect->ExecuteEffect(Application.Target, Application.Instigator);
+	}
+}
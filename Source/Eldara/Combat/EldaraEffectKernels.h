@@ -0,0 +1,46 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Eldara/Characters/EldaraEffect.h"
+
+class AEldaraCharacterBase;
+class AController;
+class UEldaraCombatEventAggregator;
+
+/** One resolved effect application (instant payload or periodic tick) */
+struct FEldaraEffectApplication
+{
+	UEldaraEffect* Effect = nullptr;
+	AActor* Target = nullptr;
+
+	/** Target as a character, or nullptr for plain actors */
+	AEldaraCharacterBase* TargetCharacter = nullptr;
+
+	AActor* Instigator = nullptr;
+	AController* InstigatorController = nullptr;
+
+	/** Frame aggregator for the target's world; damage and healing bypass it when null */
+	UEldaraCombatEventAggregator* Aggregator = nullptr;
+
+	/** Final amount, already scaled by stacks and damage type */
+	float Amount = 0.0f;
+};
+
+/**
+ * Native payloads of the effect types, in a table indexed by EEffectType.
+ *
+ * Damage, healing and resource restores are applied here without entering the Blueprint VM.
+ * Buffs, debuffs and crowd control have no per-application payload: their stat modifiers
+ * and control state are held by the combat component for as long as the effect is active.
+ * Effects with custom logic set bExecuteBlueprint to also run their ExecuteEffect graph.
+ */
+namespace EldaraEffectKernels
+{
+	using FKernel = void (*)(const FEldaraEffectApplication& Application);
+
+	/** Native kernel of an effect type (never null) */
+	FKernel Get(EEffectType EffectType);
+
+	/** Run the native kernel, then the Blueprint graph if the asset asks for it */
+	void Execute(const FEldaraEffectApplication& Application);
+}
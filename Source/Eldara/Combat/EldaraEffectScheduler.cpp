@@ -0,0 +1,130 @@
+#include "EldaraEffectScheduler.h"
+#include "Eldara/Characters/EldaraCombatComponent.h"
+#include "Engine/World.h"
+
+namespace
+{
+	constexpr float MinTickResolution = 0.001f;
+}
+
+void UEldaraEffectScheduler::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	Wheel.Reset(FMath::Max(TickResolution, MinTickResolution));
+	NextSequence = 0;
+
+	for (const TPair<EDamageType, float>& Scale : DamageTypeScales)
+	{
+		TickBatch.SetDamageTypeScale(Scale.Key, Scale.Value);
+	}
+}
+
+void UEldaraEffectScheduler::Deinitialize()
+{
+	Wheel.Reset();
+	DueEvents.Reset();
+	TickBatch.Reset();
+
+	Super::Deinitialize();
+}
+
+bool UEldaraEffectScheduler::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId UEldaraEffectScheduler::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UEldaraEffectScheduler, STATGROUP_Tickables);
+}
+
+double UEldaraEffectScheduler::GetTime() const
+{
+	return GetWorld()->GetTimeSeconds();
+}
+
+FEldaraTimerHandle UEldaraEffectScheduler::ScheduleEffectEvent(UEldaraCombatComponent* Component, FEldaraActiveEffectHandle Effect, EEldaraEffectEvent Event, double DueTime)
+{
+	FScheduledEvent Scheduled;
+	Scheduled.Component = Component;
+	Scheduled.Effect = Effect;
+	Scheduled.Event = Event;
+	Scheduled.Sequence = NextSequence++;
+	Scheduled.DueTime = DueTime;
+	return Wheel.Schedule(DueTime, Scheduled);
+}
+
+void UEldaraEffectScheduler::CancelEffectEvent(FEldaraTimerHandle& Handle)
+{
+	if (Handle.IsValid())
+	{
+		Wheel.Cancel(Handle);
+		Handle.Invalidate();
+	}
+}
+
+void UEldaraEffectScheduler::Tick(float DeltaTime)
+{
+	DueEvents.Reset();
+	Wheel.Advance(GetTime(), [this](const FScheduledEvent& Event, double)
+	{
+		DueEvents.Add(Event);
+	});
+
+	EventsFiredLastTick = DueEvents.Num();
+	if (DueEvents.Num() == 0)
+	{
+		return;
+	}
+
+	// The wheel is tick-ordered; within a frame order by exact time so results do not depend on frame rate
+	DueEvents.Sort([](const FScheduledEvent& A, const FScheduledEvent& B)
+	{
+		if (A.DueTime != B.DueTime)
+		{
+			return A.DueTime < B.DueTime;
+		}
+		if (A.Event != B.Event)
+		{
+			return A.Event < B.Event;
+		}
+		return A.Sequence < B.Sequence;
+	});
+
+	// Gather: snapshot each due tick's inputs
+	TickBatch.Reset();
+	for (FScheduledEvent& Event : DueEvents)
+	{
+		UEldaraCombatComponent* Component = Event.Component.Get();
+		if (Component && Event.Event == EEldaraEffectEvent::Tick)
+		{
+			Event.BatchRow = Component->GatherEffectTick(Event.Effect, TickBatch);
+		}
+	}
+
+	// Compute: pure per-row arithmetic, split across workers
+	TickBatch.Compute(TickRowsPerTask, bForceSingleThreadedTicks);
+
+	// Commit: side effects in dispatch order; follow-ups land in the wheel, not in this batch
+	for (const FScheduledEvent& Event : DueEvents)
+	{
+		UEldaraCombatComponent* Component = Event.Component.Get();
+		if (!Component)
+		{
+			continue;
+		}
+
+		if (Event.Event == EEldaraEffectEvent::Tick)
+		{
+			if (Event.BatchRow != INDEX_NONE)
+			{
+				Component->CommitEffectTick(Event.Effect, Event.DueTime, TickBatch.GetAmount(Event.BatchRow));
+			}
+		}
+		else
+		{
+			Component->ExpireEffect(Event.Effect);
+		}
+	}
+}
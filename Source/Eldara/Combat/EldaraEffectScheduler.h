@@ -0,0 +1,115 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "EldaraTimingWheel.h"
+#include "EldaraEffectTickBatch.h"
+#include "EldaraActiveEffectStore.h"
+#include "EldaraEffectScheduler.generated.h"
+
+class UEldaraCombatComponent;
+
+/** Scheduled events for an active effect instance, in the order they resolve at the same instant */
+enum class EEldaraEffectEvent : uint8
+{
+	/** Periodic DoT/HoT tick */
+	Tick,
+	/** Duration ran out */
+	Expire
+};
+
+/**
+ * World-level scheduler for effect ticks and expiries.
+ *
+ * Combat components register each active effect's next tick and expiry here instead of
+ * counting them down every frame. One timing wheel holds every pending event in the world;
+ * each frame only the events that came due are dispatched back to their components, so
+ * cost scales with events fired rather than actors x effects x frames, and combat
+ * components do not tick at all.
+ *
+ * Events due in the same frame are dispatched in (due time, event kind, schedule order)
+ * order, so a tick and an expiry at the same instant resolve tick first, and the result
+ * does not depend on frame timing. A chained tick is rescheduled from its due time, not
+ * from the frame it fired in, so long frames do not drift or drop ticks.
+ *
+ * Due ticks are processed as a batch: their inputs are gathered into an
+ * FEldaraEffectTickBatch, amounts (stacks, damage-type scaling) are computed across worker
+ * threads, and the results are applied to actors in one serial commit pass in dispatch
+ * order. Only the arithmetic runs in parallel, so outcomes match a serial run exactly.
+ */
+UCLASS(Config=Game)
+class ELDARA_API UEldaraEffectScheduler : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	/** Current world time in the scheduler's clock */
+	double GetTime() const;
+
+	/** Schedule an event for an active effect on Component; fires no earlier than DueTime */
+	FEldaraTimerHandle ScheduleEffectEvent(UEldaraCombatComponent* Component, FEldaraActiveEffectHandle Effect, EEldaraEffectEvent Event, double DueTime);
+
+	/** Cancel a pending event and invalidate the handle; no-op for stale handles */
+	void CancelEffectEvent(FEldaraTimerHandle& Handle);
+
+	/** Multiplier applied to damage of this type (instant applications use it too) */
+	float GetDamageTypeScale(EDamageType DamageType) const { return TickBatch.GetDamageTypeScale(DamageType); }
+
+	/** Damage-type scales as configured (readable from the class default object) */
+	const TMap<EDamageType, float>& GetConfiguredDamageTypeScales() const { return DamageTypeScales; }
+
+	/** Events waiting in the wheel */
+	UFUNCTION(BlueprintPure, Category = "Eldara|Combat")
+	int32 GetPendingEventCount() const { return Wheel.Num(); }
+
+	/** Events dispatched on the last tick */
+	UFUNCTION(BlueprintPure, Category = "Eldara|Combat")
+	int32 GetEventsFiredLastTick() const { return EventsFiredLastTick; }
+
+protected:
+	/** Scheduler granularity in seconds; events fire at most this late */
+	UPROPERTY(Config, EditDefaultsOnly, Category = "Combat")
+	float TickResolution = 1.0f / 60.0f;
+
+	/** Damage multiplier per damage type; types not listed deal full damage */
+	UPROPERTY(Config, EditDefaultsOnly, Category = "Combat")
+	TMap<EDamageType, float> DamageTypeScales;
+
+	/** Effect ticks per worker task; frames with fewer than two tasks' worth compute inline */
+	UPROPERTY(Config, EditDefaultsOnly, Category = "Combat")
+	int32 TickRowsPerTask = 256;
+
+	/** Compute tick amounts on the game thread only (for verifying the parallel path) */
+	UPROPERTY(Config, EditDefaultsOnly, Category = "Combat")
+	bool bForceSingleThreadedTicks = false;
+
+private:
+	struct FScheduledEvent
+	{
+		TWeakObjectPtr<UEldaraCombatComponent> Component;
+		FEldaraActiveEffectHandle Effect;
+		EEldaraEffectEvent Event = EEldaraEffectEvent::Tick;
+		/** Schedule order, the final tie-breaker for same-instant events */
+		uint64 Sequence = 0;
+		double DueTime = 0.0;
+		/** Row in TickBatch for Tick events that gathered successfully */
+		int32 BatchRow = INDEX_NONE;
+	};
+
+	TEldaraTimingWheel<FScheduledEvent> Wheel;
+
+	/** Events collected by the current Advance; reused across frames */
+	TArray<FScheduledEvent> DueEvents;
+
+	/** Inputs and amounts for this frame's due ticks; reused across frames */
+	FEldaraEffectTickBatch TickBatch;
+
+	uint64 NextSequence = 0;
+	int32 EventsFiredLastTick = 0;
+};
@@ -0,0 +1,60 @@
+#include "EldaraEffectTickBatch.h"
+#include "Async/ParallelFor.h"
+
+FEldaraEffectTickBatch::FEldaraEffectTickBatch()
+{
+	for (float& Scale : DamageTypeScales)
+	{
+		Scale = 1.0f;
+	}
+}
+
+void FEldaraEffectTickBatch::Reset()
+{
+	EffectTypes.Reset();
+	DamageTypes.Reset();
+	Magnitudes.Reset();
+	Stacks.Reset();
+	Amounts.Reset();
+}
+
+int32 FEldaraEffectTickBatch::Add(const UEldaraEffect& Effect, int32 InStacks)
+{
+	EffectTypes.Add(Effect.EffectType);
+	DamageTypes.Add(Effect.DamageType);
+	Stacks.Add(InStacks);
+	return Magnitudes.Add(Effect.Magnitude);
+}
+
+void FEldaraEffectTickBatch::SetDamageTypeScale(EDamageType DamageType, float Scale)
+{
+	DamageTypeScales[static_cast<int32>(DamageType)] = Scale;
+}
+
+void FEldaraEffectTickBatch::Compute(int32 MinRowsPerTask, bool bForceSingleThread)
+{
+	const int32 Count = Num();
+	Amounts.SetNumUninitialized(Count, EAllowShrinking::No);
+
+	const int32 RowsPerTask = FMath::Max(1, MinRowsPerTask);
+	if (bForceSingleThread || Count < RowsPerTask * 2)
+	{
+		ComputeRange(0, Count);
+		return;
+	}
+
+	const int32 NumTasks = FMath::DivideAndRoundUp(Count, RowsPerTask);
+	ParallelFor(NumTasks, [this, Count, RowsPerTask](int32 TaskIndex)
+	{
+		const int32 BeginIndex = TaskIndex * RowsPerTask;
+		ComputeRange(BeginIndex, FMath::Min(BeginIndex + RowsPerTask, Count));
+	});
+}
+
+void FEldaraEffectTickBatch::ComputeRange(int32 BeginIndex, int32 EndIndex)
+{
+	for (int32 Row = BeginIndex; Row < EndIndex; ++Row)
+	{
+		Amounts[Row] = ComputeAmount(EffectTypes[Row], Magnitudes[Row], Stacks[Row], DamageTypeScales[static_cast<int32>(DamageTypes[Row])]);
+	}
+}
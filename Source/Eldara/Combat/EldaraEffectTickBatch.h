@@ -0,0 +1,61 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Eldara/Characters/EldaraEffect.h"
+
+/**
+ * One frame's due effect ticks in structure-of-arrays form.
+ *
+ * Rows are gathered serially from the combat components, the amounts are computed in
+ * contiguous batches across worker threads, and the scheduler then applies the results in
+ * a single serial pass. Compute reads only a row's own inputs and the damage-type scale
+ * table, with a fixed operation order, so the amounts are bit-identical to a serial loop
+ * regardless of how rows are split across threads.
+ */
+struct ELDARA_API FEldaraEffectTickBatch
+{
+	static constexpr int32 NumDamageTypes = static_cast<int32>(EDamageType::Void) + 1;
+
+	/** Final amount of one application: magnitude x stacks, scaled by damage type for damage */
+	static float ComputeAmount(EEffectType EffectType, float Magnitude, int32 Stacks, float DamageTypeScale)
+	{
+		const float StackedMagnitude = Magnitude * static_cast<float>(Stacks);
+		return EffectType == EEffectType::Damage ? StackedMagnitude * DamageTypeScale : StackedMagnitude;
+	}
+
+	FEldaraEffectTickBatch();
+
+	int32 Num() const { return Magnitudes.Num(); }
+
+	/** Drop all rows; arrays keep their capacity */
+	void Reset();
+
+	/** Append a row for one tick of Effect; returns the row index */
+	int32 Add(const UEldaraEffect& Effect, int32 Stacks);
+
+	void SetDamageTypeScale(EDamageType DamageType, float Scale);
+	float GetDamageTypeScale(EDamageType DamageType) const { return DamageTypeScales[static_cast<int32>(DamageType)]; }
+
+	/**
+	 * Fill Amounts for every row.
+	 * @param MinRowsPerTask Rows per worker task; batches smaller than two tasks run inline
+	 * @param bForceSingleThread Compute on the calling thread (for comparing against the parallel path)
+	 */
+	void Compute(int32 MinRowsPerTask, bool bForceSingleThread);
+
+	float GetAmount(int32 Row) const { return Amounts[Row]; }
+
+private:
+	void ComputeRange(int32 BeginIndex, int32 EndIndex);
+
+	// Inputs
+	TArray<EEffectType> EffectTypes;
+	TArray<EDamageType> DamageTypes;
+	TArray<float> Magnitudes;
+	TArray<int32> Stacks;
+
+	// Output
+	TArray<float> Amounts;
+
+	float DamageTypeScales[NumDamageTypes];
+};
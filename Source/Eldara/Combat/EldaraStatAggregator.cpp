@@ -0,0 +1,151 @@
+#include "EldaraStatAggregator.h"
+
+FEldaraStatAggregator::FEldaraStatAggregator()
+{
+	for (int32 StatIndex = 0; StatIndex < NumStats; ++StatIndex)
+	{
+		BaseValues[StatIndex] = 0.0f;
+		FinalValues[StatIndex] = 0.0f;
+	}
+}
+
+uint32 FEldaraStatAggregator::SetBaseValue(EEldaraStat Stat, float Value)
+{
+	BaseValues[static_cast<int32>(Stat)] = Value;
+	return Recompute(StatBit(Stat));
+}
+
+uint32 FEldaraStatAggregator::AddSource(FEldaraActiveEffectHandle Source, TConstArrayView<FEldaraStatModifier> InModifiers, int32 Stacks)
+{
+	uint32 DirtyMask = 0;
+	if (const uint32* ExistingMask = SourceStatMasks.Find(Source))
+	{
+		DirtyMask = *ExistingMask;
+		for (int32 StatIndex = 0; StatIndex < NumStats; ++StatIndex)
+		{
+			if (DirtyMask & (1u << StatIndex))
+			{
+				Modifiers[StatIndex].RemoveAll([Source](const FModifierEntry& Entry) { return Entry.Source == Source; });
+			}
+		}
+	}
+
+	uint32 SourceMask = 0;
+	for (const FEldaraStatModifier& Modifier : InModifiers)
+	{
+		FModifierEntry Entry;
+		Entry.Source = Source;
+		Entry.Operation = Modifier.Operation;
+		Entry.Value = Modifier.Value;
+		Entry.Stacks = Stacks;
+		Modifiers[static_cast<int32>(Modifier.Stat)].Add(Entry);
+		SourceMask |= StatBit(Modifier.Stat);
+	}
+
+	if (SourceMask != 0)
+	{
+		SourceStatMasks.Add(Source, SourceMask);
+	}
+	else
+	{
+		SourceStatMasks.Remove(Source);
+	}
+	return Recompute(DirtyMask | SourceMask);
+}
+
+uint32 FEldaraStatAggregator::SetSourceStacks(FEldaraActiveEffectHandle Source, int32 Stacks)
+{
+	const uint32* SourceMask = SourceStatMasks.Find(Source);
+	if (!SourceMask)
+	{
+		return 0;
+	}
+
+	for (int32 StatIndex = 0; StatIndex < NumStats; ++StatIndex)
+	{
+		if (*SourceMask & (1u << StatIndex))
+		{
+			for (FModifierEntry& Entry : Modifiers[StatIndex])
+			{
+				if (Entry.Source == Source)
+				{
+					Entry.Stacks = Stacks;
+				}
+			}
+		}
+	}
+	return Recompute(*SourceMask);
+}
+
+uint32 FEldaraStatAggregator::RemoveSource(FEldaraActiveEffectHandle Source)
+{
+	uint32 SourceMask = 0;
+	if (!SourceStatMasks.RemoveAndCopyValue(Source, SourceMask))
+	{
+		return 0;
+	}
+
+	for (int32 StatIndex = 0; StatIndex < NumStats; ++StatIndex)
+	{
+		if (SourceMask & (1u << StatIndex))
+		{
+			// Stable removal keeps the remaining modifiers in application order
+			Modifiers[StatIndex].RemoveAll([Source](const FModifierEntry& Entry) { return Entry.Source == Source; });
+		}
+	}
+	return Recompute(SourceMask);
+}
+
+uint32 FEldaraStatAggregator::RemoveAllSources()
+{
+	uint32 DirtyMask = 0;
+	for (int32 StatIndex = 0; StatIndex < NumStats; ++StatIndex)
+	{
+		if (Modifiers[StatIndex].Num() > 0)
+		{
+			Modifiers[StatIndex].Reset();
+			DirtyMask |= 1u << StatIndex;
+		}
+	}
+	SourceStatMasks.Reset();
+	return Recompute(DirtyMask);
+}
+
+uint32 FEldaraStatAggregator::Recompute(uint32 DirtyMask)
+{
+	uint32 ChangedMask = 0;
+	for (int32 StatIndex = 0; StatIndex < NumStats; ++StatIndex)
+	{
+		if ((DirtyMask & (1u << StatIndex)) == 0)
+		{
+			continue;
+		}
+
+		float Additive = 0.0f;
+		float Multiplier = 1.0f;
+		const FModifierEntry* LatestOverride = nullptr;
+		for (const FModifierEntry& Entry : Modifiers[StatIndex])
+		{
+			switch (Entry.Operation)
+			{
+			case EEldaraStatModOp::Additive:
+				Additive += Entry.Value * Entry.Stacks;
+				break;
+			case EEldaraStatModOp::Multiplicative:
+				Multiplier += Entry.Value * Entry.Stacks;
+				break;
+			case EEldaraStatModOp::Override:
+				LatestOverride = &Entry;
+				break;
+			}
+		}
+
+		const float NewValue = LatestOverride ? LatestOverride->Value : (BaseValues[StatIndex] + Additive) * Multiplier;
+		if (NewValue != FinalValues[StatIndex])
+		{
+			FinalValues[StatIndex] = NewValue;
+			ChangedMask |= 1u << StatIndex;
+		}
+	}
+	return ChangedMask;
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "EldaraStatTypes.h"
+#include "EldaraActiveEffectStore.h"
+#include "EldaraStatAggregator.generated.h"
+
+/**
+ * Final stat values of one combat component, with the modifiers that produce them.
+ *
+ * Each stat keeps a base value, the list of modifiers currently applied to it, and its
+ * cached final value. Adding, restacking or removing an effect's modifiers recomputes only
+ * the stats that effect touches and reports which of them actually changed, as a bit mask,
+ * so callers notify HUD and replicated properties only for real changes. Reads are a
+ * plain array lookup.
+ *
+ * Final = Override if any (latest wins), else (Base + sum(Additive x Stacks)) x
+ * (1 + sum(Multiplicative x Stacks)), summed in application order for determinism.
+ */
+USTRUCT()
+struct ELDARA_API FEldaraStatAggregator
+{
+	GENERATED_BODY()
+
+	static constexpr int32 NumStats = static_cast<int32>(EEldaraStat::CritChance) + 1;
+	static_assert(NumStats <= 32, "Stat change masks are 32 bits");
+
+	static uint32 StatBit(EEldaraStat Stat) { return 1u << static_cast<uint32>(Stat); }
+
+	FEldaraStatAggregator();
+
+	float GetValue(EEldaraStat Stat) const { return FinalValues[static_cast<int32>(Stat)]; }
+	float GetBaseValue(EEldaraStat Stat) const { return BaseValues[static_cast<int32>(Stat)]; }
+
+	/** @return Mask of stats whose final value changed */
+	uint32 SetBaseValue(EEldaraStat Stat, float Value);
+
+	/** Start applying Source's modifiers at Stacks; replaces any modifiers Source already had */
+	uint32 AddSource(FEldaraActiveEffectHandle Source, TConstArrayView<FEldaraStatModifier> Modifiers, int32 Stacks);
+
+	/** Rescale a source's stacking modifiers */
+	uint32 SetSourceStacks(FEldaraActiveEffectHandle Source, int32 Stacks);
+
+	uint32 RemoveSource(FEldaraActiveEffectHandle Source);
+
+	/** Drop every modifier; base values are kept */
+	uint32 RemoveAllSources();
+
+	bool HasSource(FEldaraActiveEffectHandle Source) const { return SourceStatMasks.Contains(Source); }
+
+private:
+	struct FModifierEntry
+	{
+		FEldaraActiveEffectHandle Source;
+		EEldaraStatModOp Operation = EEldaraStatModOp::Additive;
+		float Value = 0.0f;
+		int32 Stacks = 1;
+	};
+
+	/** Recompute the final value of every stat in DirtyMask; returns the ones that changed */
+	uint32 Recompute(uint32 DirtyMask);
+
+	float BaseValues[NumStats];
+	float FinalValues[NumStats];
+
+	/** Applied modifiers per stat, in application order */
+	TArray<FModifierEntry> Modifiers[NumStats];
+
+	/** Stats each source touches */
+	TMap<FEldaraActiveEffectHandle, uint32> SourceStatMasks;
+};
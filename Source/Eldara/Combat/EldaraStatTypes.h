@@ -0,0 +1,53 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "EldaraStatTypes.generated.h"
+
+/**
+ * Character stats that effects can modify
+ */
+UENUM(BlueprintType)
+enum class EEldaraStat : uint8
+{
+	MaxHealth       UMETA(DisplayName = "Max Health"),
+	MaxResource     UMETA(DisplayName = "Max Resource"),
+	MaxStamina      UMETA(DisplayName = "Max Stamina"),
+	Armor           UMETA(DisplayName = "Armor"),
+	Haste           UMETA(DisplayName = "Haste"),
+	AttackPower     UMETA(DisplayName = "Attack Power"),
+	SpellPower      UMETA(DisplayName = "Spell Power"),
+	CritChance      UMETA(DisplayName = "Crit Chance")
+};
+
+/**
+ * How a modifier combines with the base value
+ */
+UENUM(BlueprintType)
+enum class EEldaraStatModOp : uint8
+{
+	/** Added to the base value */
+	Additive        UMETA(DisplayName = "Additive"),
+	/** Fraction added to the multiplier (0.1 = +10%), applied after additive modifiers */
+	Multiplicative  UMETA(DisplayName = "Multiplicative"),
+	/** Replaces the final value; the most recently applied override wins */
+	Override        UMETA(DisplayName = "Override")
+};
+
+/**
+ * One stat change held by an active effect
+ */
+USTRUCT(BlueprintType)
+struct FEldaraStatModifier
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Stats")
+	EEldaraStat Stat = EEldaraStat::MaxHealth;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Stats")
+	EEldaraStatModOp Operation = EEldaraStatModOp::Additive;
+
+	/** Amount per stack (overrides ignore stacks) */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Stats")
+	float Value = 0.0f;
+};
@@ -0,0 +1,325 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** Identifies one scheduled entry; stale once the entry fires or is cancelled */
+struct FEldaraTimerHandle
+{
+	int32 Index = INDEX_NONE;
+	uint32 Serial = 0;
+
+	bool IsValid() const { return Index != INDEX_NONE; }
+	void Invalidate() { Index = INDEX_NONE; Serial = 0; }
+};
+
+/**
+ * Hierarchical timing wheel (hashed, four levels of 64 slots).
+ *
+ * Time is quantized to Resolution-second ticks. An entry sits in the level whose span
+ * covers its distance from now and is cascaded one level down each time the wheel rolls
+ * over into its slot, so Schedule and Cancel are O(1) and Advance costs the entries it
+ * fires plus one cascade per 64 ticks per level. Empty stretches of level 0 are skipped
+ * with an occupancy mask instead of being stepped through.
+ *
+ * Entries never fire early: a due time is rounded up to the next tick. Entries further out
+ * than the wheel spans (64^4 ticks) are parked in the top level and re-placed as it turns.
+ *
+ * Nodes live in one pooled array linked into per-slot FIFO lists; freed nodes are reused.
+ * Not thread-safe.
+ */
+template<typename PayloadType>
+class TEldaraTimingWheel
+{
+public:
+	static constexpr int32 SlotBits = 6;
+	static constexpr int32 SlotsPerLevel = 1 << SlotBits;
+	static constexpr int32 SlotMask = SlotsPerLevel - 1;
+	static constexpr int32 NumLevels = 4;
+	static constexpr int64 MaxSpan = int64(1) << (SlotBits * NumLevels);
+
+	explicit TEldaraTimingWheel(double InResolution = 1.0 / 60.0)
+		: Resolution(InResolution)
+	{
+		check(Resolution > 0.0);
+		ResetSlots();
+	}
+
+	double GetResolution() const { return Resolution; }
+
+	/** Time the wheel has advanced to (start of the current tick) */
+	double GetCurrentTime() const { return CurrentTick * Resolution; }
+
+	int32 Num() const { return NumScheduled; }
+
+	/** Schedule Payload to fire at DueTime; times at or before the current tick fire on the next one */
+	FEldaraTimerHandle Schedule(double DueTime, const PayloadType& Payload)
+	{
+		int32 Index = FreeHead;
+		if (Index != INDEX_NONE)
+		{
+			FreeHead = Nodes[Index].Next;
+		}
+		else
+		{
+			Index = Nodes.AddDefaulted();
+		}
+
+		FNode& Node = Nodes[Index];
+		Node.Payload = Payload;
+		Node.DueTime = DueTime;
+		Node.DueTick = FMath::Max(FMath::CeilToInt64(DueTime / Resolution), CurrentTick + 1);
+		Place(Index);
+		++NumScheduled;
+
+		FEldaraTimerHandle Handle;
+		Handle.Index = Index;
+		Handle.Serial = Node.Serial;
+		return Handle;
+	}
+
+	/** True if the handle refers to an entry that has not fired or been cancelled */
+	bool IsScheduled(const FEldaraTimerHandle& Handle) const
+	{
+		return Nodes.IsValidIndex(Handle.Index) && Nodes[Handle.Index].Serial == Handle.Serial && Nodes[Handle.Index].Slot != INDEX_NONE;
+	}
+
+	/** Remove a pending entry; false if it already fired or was cancelled */
+	bool Cancel(const FEldaraTimerHandle& Handle)
+	{
+		if (!IsScheduled(Handle))
+		{
+			return false;
+		}
+
+		Unlink(Handle.Index);
+		Release(Handle.Index);
+		--NumScheduled;
+		return true;
+	}
+
+	/**
+	 * Move the wheel to Now and hand every entry due by then to OnDue(Payload, DueTime), in
+	 * tick order and FIFO within a tick. OnDue must not Schedule or Cancel; collect and act
+	 * after Advance returns.
+	 */
+	template<typename CallbackType>
+	void Advance(double Now, CallbackType&& OnDue)
+	{
+		const int64 TargetTick = FMath::FloorToInt64(Now / Resolution);
+		while (CurrentTick < TargetTick)
+		{
+			// Nothing in level 0: jump to the tick before the next cascade boundary
+			if (OccupiedMask[0] == 0)
+			{
+				CurrentTick = FMath::Min(TargetTick, CurrentTick | SlotMask);
+				if (CurrentTick == TargetTick)
+				{
+					break;
+				}
+			}
+
+			++CurrentTick;
+			if ((CurrentTick & SlotMask) == 0)
+			{
+				Cascade();
+			}
+			FireSlot(static_cast<int32>(CurrentTick & SlotMask), OnDue);
+		}
+	}
+
+	/** Drop every entry and switch to a new resolution */
+	void Reset(double InResolution)
+	{
+		check(InResolution > 0.0);
+		Reset();
+		Resolution = InResolution;
+		CurrentTick = 0;
+	}
+
+	/** Drop every entry; outstanding handles become stale */
+	void Reset()
+	{
+		for (int32 Index = 0; Index < Nodes.Num(); ++Index)
+		{
+			if (Nodes[Index].Slot != INDEX_NONE)
+			{
+				Release(Index);
+			}
+		}
+		ResetSlots();
+		NumScheduled = 0;
+	}
+
+private:
+	struct FNode
+	{
+		PayloadType Payload;
+		double DueTime = 0.0;
+		int64 DueTick = 0;
+		int32 Prev = INDEX_NONE;
+		int32 Next = INDEX_NONE;
+		/** Flat slot index (Level * SlotsPerLevel + Slot), INDEX_NONE while free */
+		int32 Slot = INDEX_NONE;
+		/** Bumped on release so stale handles do not match a reused node */
+		uint32 Serial = 1;
+	};
+
+	struct FSlotList
+	{
+		int32 Head = INDEX_NONE;
+		int32 Tail = INDEX_NONE;
+	};
+
+	void ResetSlots()
+	{
+		for (FSlotList& List : Slots)
+		{
+			List = FSlotList();
+		}
+		for (uint64& Mask : OccupiedMask)
+		{
+			Mask = 0;
+		}
+	}
+
+	void Place(int32 Index)
+	{
+		FNode& Node = Nodes[Index];
+		const int64 PlaceTick = FMath::Min(Node.DueTick, CurrentTick + MaxSpan - 1);
+		const int64 Delta = PlaceTick - CurrentTick;
+
+		int32 Level = 0;
+		while (Level < NumLevels - 1 && Delta >= (int64(1) << (SlotBits * (Level + 1))))
+		{
+			++Level;
+		}
+
+		// A level-0 entry that is due this tick (only during a cascade) lands in the slot about to fire
+		const int32 SlotInLevel = static_cast<int32>((PlaceTick >> (SlotBits * Level)) & SlotMask);
+		const int32 FlatSlot = Level * SlotsPerLevel + SlotInLevel;
+
+		FSlotList& List = Slots[FlatSlot];
+		Node.Slot = FlatSlot;
+		Node.Next = INDEX_NONE;
+		Node.Prev = List.Tail;
+		if (List.Tail != INDEX_NONE)
+		{
+			Nodes[List.Tail].Next = Index;
+		}
+		else
+		{
+			List.Head = Index;
+		}
+		List.Tail = Index;
+		OccupiedMask[Level] |= uint64(1) << SlotInLevel;
+	}
+
+	void Unlink(int32 Index)
+	{
+		FNode& Node = Nodes[Index];
+		FSlotList& List = Slots[Node.Slot];
+
+		if (Node.Prev != INDEX_NONE)
+		{
+			Nodes[Node.Prev].Next = Node.Next;
+		}
+		else
+		{
+			List.Head = Node.Next;
+		}
+
+		if (Node.Next != INDEX_NONE)
+		{
+			Nodes[Node.Next].Prev = Node.Prev;
+		}
+		else
+		{
+			List.Tail = Node.Prev;
+		}
+
+		if (List.Head == INDEX_NONE)
+		{
+			OccupiedMask[Node.Slot / SlotsPerLevel] &= ~(uint64(1) << (Node.Slot & SlotMask));
+		}
+		Node.Slot = INDEX_NONE;
+	}
+
+	void Release(int32 Index)
+	{
+		FNode& Node = Nodes[Index];
+		Node.Slot = INDEX_NONE;
+		Node.Payload = PayloadType();
+		++Node.Serial;
+		Node.Next = FreeHead;
+		FreeHead = Index;
+	}
+
+	/** Detach a slot's list and re-place its entries closer to their due tick */
+	void CascadeSlot(int32 Level, int32 SlotInLevel)
+	{
+		FSlotList& List = Slots[Level * SlotsPerLevel + SlotInLevel];
+		int32 Index = List.Head;
+		List = FSlotList();
+		OccupiedMask[Level] &= ~(uint64(1) << SlotInLevel);
+
+		while (Index != INDEX_NONE)
+		{
+			const int32 Next = Nodes[Index].Next;
+			Place(Index);
+			Index = Next;
+		}
+	}
+
+	/** At a level-0 rollover, pull down the slots of every level that also rolled over (top first) */
+	void Cascade()
+	{
+		int32 TopLevel = 1;
+		while (TopLevel < NumLevels - 1 && ((CurrentTick >> (SlotBits * TopLevel)) & SlotMask) == 0)
+		{
+			++TopLevel;
+		}
+
+		for (int32 Level = TopLevel; Level >= 1; --Level)
+		{
+			CascadeSlot(Level, static_cast<int32>((CurrentTick >> (SlotBits * Level)) & SlotMask));
+		}
+	}
+
+	template<typename CallbackType>
+	void FireSlot(int32 SlotInLevel, CallbackType& OnDue)
+	{
+		FSlotList& List = Slots[SlotInLevel];
+		int32 Index = List.Head;
+		List = FSlotList();
+		OccupiedMask[0] &= ~(uint64(1) << SlotInLevel);
+
+		while (Index != INDEX_NONE)
+		{
+			FNode& Node = Nodes[Index];
+			const int32 Next = Node.Next;
+
+			// Parked beyond the wheel's span: not due yet, goes back around
+			if (Node.DueTick > CurrentTick)
+			{
+				Place(Index);
+			}
+			else
+			{
+				OnDue(static_cast<const PayloadType&>(Node.Payload), Node.DueTime);
+				Release(Index);
+				--NumScheduled;
+			}
+			Index = Next;
+		}
+	}
+
+	TArray<FNode> Nodes;
+	int32 FreeHead = INDEX_NONE;
+	int32 NumScheduled = 0;
+
+	FSlotList Slots[NumLevels * SlotsPerLevel];
+	uint64 OccupiedMask[NumLevels];
+
+	double Resolution;
+	int64 CurrentTick = 0;
+};
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/PlatformTime.h"
+
+/**
+ * Timing shared by the benchmark commandlets.
+ *
+ * The benches time per-item costs of nanoseconds to microseconds and report the fastest of
+ * several rounds: the minimum is the run least disturbed by scheduling and cold caches, and
+ * the one that stays comparable between machines and builds.
+ */
+namespace EldaraBenchmark
+{
+	/** Fastest of several timings of the same work */
+	struct FBestTime
+	{
+		double Seconds = TNumericLimits<double>::Max();
+
+		/** Record the time since StartTime; returns the current time so consecutive phases can chain */
+		double Lap(double StartTime)
+		{
+			const double Now = FPlatformTime::Seconds();
+			Seconds = FMath::Min(Seconds, Now - StartTime);
+			return Now;
+		}
+	};
+
+	/** Seconds taken by the fastest of NumRounds calls to Round */
+	template <typename RoundFunc>
+	double TimeBestOf(int32 NumRounds, RoundFunc&& Round)
+	{
+		FBestTime Best;
+		for (int32 Index = 0; Index < NumRounds; ++Index)
+		{
+			const double StartTime = FPlatformTime::Seconds();
+			Round();
+			Best.Lap(StartTime);
+		}
+		return Best.Seconds;
+	}
+}
@@ -2,6 +2,7 @@
 
 #include "CoreMinimal.h"
 #include "Engine/DataAsset.h"
+#include "EldaraFaction.h"
 #include "EldaraRaceData.generated.h"
 
 // Forward declarations
@@ -55,6 +56,10 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Race", meta = (MultiLine = "true"))
 	FText Description;
 
+	/** Faction characters of this race fight for; used by combat targeting filters */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Race")
+	EEldaraFaction Faction = EEldaraFaction::Neutral;
+
 	/** Classes this race is allowed to play */
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Race")
 	TArray<TObjectPtr<UEldaraClassData>> AllowedClasses;
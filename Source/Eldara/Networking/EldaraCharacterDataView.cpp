@@ -0,0 +1,137 @@
+#include "EldaraCharacterDataView.h"
+#include "PacketDeserializer.h"
+#include "NetworkPackets.h"
+
+template<typename ReaderType>
+bool FEldaraCharacterDataView::ReadField(EField Field, ReaderType&& Reader) const
+{
+	if (!Buffer.IsValid())
+	{
+		return false;
+	}
+
+	// The deserializer keeps a single cursor; restore it so a lazy read never disturbs a packet being decoded
+	TGuardValue<int32> CursorGuard(FPacketDeserializer::ReadPosition, FieldOffsets[static_cast<int32>(Field)]);
+	return Reader(*Buffer);
+}
+
+int64 FEldaraCharacterDataView::GetCharacterId() const
+{
+	int64 Value = 0;
+	ReadField(EField::CharacterId, [&Value](const TArray<uint8>& Bytes) { return FPacketDeserializer::ReadInt64(Bytes, Value); });
+	return Value;
+}
+
+FString FEldaraCharacterDataView::GetName() const
+{
+	FString Value;
+	ReadField(EField::Name, [&Value](const TArray<uint8>& Bytes) { return FPacketDeserializer::ReadString(Bytes, Value); });
+	return Value;
+}
+
+ERace FEldaraCharacterDataView::GetRace() const
+{
+	int32 Value = 0;
+	return ReadField(EField::Race, [&Value](const TArray<uint8>& Bytes) { return FPacketDeserializer::ReadInt(Bytes, Value); })
+		? static_cast<ERace>(Value) : ERace::None;
+}
+
+EClass FEldaraCharacterDataView::GetClass() const
+{
+	int32 Value = 0;
+	return ReadField(EField::Class, [&Value](const TArray<uint8>& Bytes) { return FPacketDeserializer::ReadInt(Bytes, Value); })
+		? static_cast<EClass>(Value) : EClass::None;
+}
+
+EFaction FEldaraCharacterDataView::GetFaction() const
+{
+	int32 Value = 0;
+	return ReadField(EField::Faction, [&Value](const TArray<uint8>& Bytes) { return FPacketDeserializer::ReadInt(Bytes, Value); })
+		? static_cast<EFaction>(Value) : EFaction::Neutral;
+}
+
+int32 FEldaraCharacterDataView::GetLevel() const
+{
+	int32 Value = 1;
+	ReadField(EField::Level, [&Value](const TArray<uint8>& Bytes) { return FPacketDeserializer::ReadInt(Bytes, Value); });
+	return Value;
+}
+
+int64 FEldaraCharacterDataView::GetExperiencePoints() const
+{
+	int64 Value = 0;
+	ReadField(EField::ExperiencePoints, [&Value](const TArray<uint8>& Bytes) { return FPacketDeserializer::ReadInt64(Bytes, Value); });
+	return Value;
+}
+
+ETotemSpirit FEldaraCharacterDataView::GetTotemSpirit() const
+{
+	// Nullable on the server; nil means no totem
+	int32 Value = 0;
+	ReadField(EField::TotemSpirit, [&Value](const TArray<uint8>& Bytes)
+	{
+		return FPacketDeserializer::TryReadNil(Bytes) || FPacketDeserializer::ReadInt(Bytes, Value);
+	});
+	return static_cast<ETotemSpirit>(Value);
+}
+
+bool FEldaraCharacterDataView::GetPosition(FCharacterPosition& OutPosition) const
+{
+	return ReadField(EField::Position, [&OutPosition](const TArray<uint8>& Bytes)
+	{
+		// CharacterPosition: [ZoneId, X, Y, Z, RotationYaw, RotationPitch]
+		constexpr int32 MinimumPositionFields = 5;
+		int32 FieldCount;
+		if (!FPacketDeserializer::ReadArrayHeader(Bytes, FieldCount) || FieldCount < MinimumPositionFields)
+			return false;
+
+		if (!FPacketDeserializer::ReadString(Bytes, OutPosition.ZoneId) ||
+			!FPacketDeserializer::ReadFloat(Bytes, OutPosition.X) ||
+			!FPacketDeserializer::ReadFloat(Bytes, OutPosition.Y) ||
+			!FPacketDeserializer::ReadFloat(Bytes, OutPosition.Z) ||
+			!FPacketDeserializer::ReadFloat(Bytes, OutPosition.RotationYaw))
+		{
+			return false;
+		}
+
+		return FieldCount == MinimumPositionFields || FPacketDeserializer::ReadFloat(Bytes, OutPosition.RotationPitch);
+	});
+}
+
+bool FEldaraCharacterDataView::GetAppearance(FCharacterAppearance& OutAppearance) const
+{
+	return ReadField(EField::Appearance, [&OutAppearance](const TArray<uint8>& Bytes)
+	{
+		// CharacterAppearance: 10 fields, same order as the create-character request
+		constexpr int32 AppearanceFields = 10;
+		int32 FieldCount;
+		if (!FPacketDeserializer::ReadArrayHeader(Bytes, FieldCount) || FieldCount < AppearanceFields)
+			return false;
+
+		return FPacketDeserializer::ReadInt(Bytes, OutAppearance.FaceType) &&
+			FPacketDeserializer::ReadInt(Bytes, OutAppearance.HairStyle) &&
+			FPacketDeserializer::ReadInt(Bytes, OutAppearance.HairColor) &&
+			FPacketDeserializer::ReadInt(Bytes, OutAppearance.SkinTone) &&
+			FPacketDeserializer::ReadInt(Bytes, OutAppearance.EyeColor) &&
+			FPacketDeserializer::ReadFloat(Bytes, OutAppearance.Height) &&
+			FPacketDeserializer::ReadFloat(Bytes, OutAppearance.BuildType) &&
+			FPacketDeserializer::ReadInt(Bytes, OutAppearance.FurPattern) &&
+			FPacketDeserializer::ReadInt(Bytes, OutAppearance.FurColor) &&
+			FPacketDeserializer::ReadFloat(Bytes, OutAppearance.VoidIntensity);
+	});
+}
+
+bool FEldaraCharacterDataView::GetSummary(FCharacterInfo& OutInfo) const
+{
+	if (!IsValid())
+	{
+		return false;
+	}
+
+	OutInfo.CharacterId = GetCharacterId();
+	OutInfo.Name = GetName();
+	OutInfo.Race = GetRace();
+	OutInfo.Class = GetClass();
+	OutInfo.Level = GetLevel();
+	return true;
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "NetworkTypes.h"
+
+struct FCharacterInfo;
+
+/**
+ * Lazily decoded view of a MessagePack CharacterData object.
+ *
+ * The deserializer makes one validating pass over the object and records where each field
+ * starts; nested objects (stats, position, appearance, equipment, faction standings) are
+ * walked but not decoded. Accessors decode a single field on demand from the shared packet
+ * buffer, so a character-select screen only pays for the fields it actually displays.
+ *
+ * Accessors use the packet deserializer's readers and must be called on the game thread.
+ */
+class ELDARA_API FEldaraCharacterDataView
+{
+public:
+	/** Field indices, matching the C# CharacterData [Key] attributes */
+	enum class EField : uint8
+	{
+		CharacterId,
+		AccountId,
+		Name,
+		Race,
+		Class,
+		Faction,
+		Level,
+		ExperiencePoints,
+		Stats,
+		Position,
+		Appearance,
+		Equipment,
+		FactionStandings,
+		TotemSpirit,
+		CreatedAt,
+		LastPlayedAt,
+		Count
+	};
+
+	/** True once the deserializer has indexed a CharacterData object into this view */
+	bool IsValid() const { return Buffer.IsValid(); }
+
+	// Scalar accessors return the field's default if it cannot be decoded
+	int64 GetCharacterId() const;
+	FString GetName() const;
+	ERace GetRace() const;
+	EClass GetClass() const;
+	EFaction GetFaction() const;
+	int32 GetLevel() const;
+	int64 GetExperiencePoints() const;
+	ETotemSpirit GetTotemSpirit() const;
+
+	bool GetPosition(FCharacterPosition& OutPosition) const;
+	bool GetAppearance(FCharacterAppearance& OutAppearance) const;
+
+	/** Decode just the fields shown in character lists (id, name, race, class, level) */
+	bool GetSummary(FCharacterInfo& OutInfo) const;
+
+private:
+	friend class FPacketDeserializer;
+
+	/** Point the deserializer at a field and run Reader over the shared buffer */
+	template<typename ReaderType>
+	bool ReadField(EField Field, ReaderType&& Reader) const;
+
+	TSharedPtr<const TArray<uint8>> Buffer;
+	int32 FieldOffsets[static_cast<int32>(EField::Count)] = {};
+};
@@ -0,0 +1,253 @@
+#include "EldaraEntityReplicaStore.h"
+
+FEldaraEntityHandle FEldaraEntityReplicaStore::Spawn(const FEntitySpawnPacket& Packet)
+{
+	// Re-spawn of a known entity (e.g. zone resync) refreshes the row in place
+	if (const FEldaraEntityHandle* ExistingHandle = EntityIdToHandle.Find(Packet.EntityId))
+	{
+		WriteSpawnRow(Slots[ExistingHandle->SlotIndex].DenseIndex, Packet);
+		return *ExistingHandle;
+	}
+
+	int32 SlotIndex;
+	if (FreeSlots.Num() > 0)
+	{
+		SlotIndex = FreeSlots.Pop(EAllowShrinking::No);
+	}
+	else
+	{
+		SlotIndex = Slots.AddDefaulted();
+	}
+
+	const int32 DenseIndex = EntityIds.Num();
+	FSlot& Slot = Slots[SlotIndex];
+	Slot.DenseIndex = DenseIndex;
+
+	DenseToSlot.Add(SlotIndex);
+	EntityIds.AddUninitialized();
+	EntityTypes.AddUninitialized();
+	Names.AddDefaulted();
+	Positions.AddUninitialized();
+	RotationYaws.AddUninitialized();
+	RotationPitches.AddUninitialized();
+	Velocities.AddUninitialized();
+	MovementStates.AddUninitialized();
+	ServerTimestamps.AddUninitialized();
+	NPCStates.AddUninitialized();
+	TargetEntityIds.AddUninitialized();
+	CurrentHealth.AddUninitialized();
+	MaxHealth.AddUninitialized();
+	Resources.AddDefaulted();
+
+	WriteSpawnRow(DenseIndex, Packet);
+
+	FEldaraEntityHandle Handle;
+	Handle.SlotIndex = SlotIndex;
+	Handle.Generation = Slot.Generation;
+	EntityIdToHandle.Add(Packet.EntityId, Handle);
+	return Handle;
+}
+
+bool FEldaraEntityReplicaStore::Despawn(int64 EntityId)
+{
+	FEldaraEntityHandle Handle;
+	if (!EntityIdToHandle.RemoveAndCopyValue(EntityId, Handle))
+	{
+		return false;
+	}
+
+	FSlot& Slot = Slots[Handle.SlotIndex];
+	const int32 RemovedIndex = Slot.DenseIndex;
+	const int32 LastIndex = EntityIds.Num() - 1;
+
+	// Swap-remove: move the last row into the hole and repoint its slot
+	if (RemovedIndex != LastIndex)
+	{
+		MoveRow(LastIndex, RemovedIndex);
+		const int32 MovedSlotIndex = DenseToSlot[RemovedIndex];
+		Slots[MovedSlotIndex].DenseIndex = RemovedIndex;
+	}
+	PopRow();
+
+	// Bump generation so any outstanding handle to this slot goes stale
+	Slot.DenseIndex = INDEX_NONE;
+	++Slot.Generation;
+	FreeSlots.Add(Handle.SlotIndex);
+	return true;
+}
+
+void FEldaraEntityReplicaStore::Reset()
+{
+	// Keep slots (with bumped generations) so handles issued before the reset stay detectable
+	FreeSlots.Reset();
+	for (int32 SlotIndex = 0; SlotIndex < Slots.Num(); ++SlotIndex)
+	{
+		FSlot& Slot = Slots[SlotIndex];
+		if (Slot.DenseIndex != INDEX_NONE)
+		{
+			Slot.DenseIndex = INDEX_NONE;
+			++Slot.Generation;
+		}
+		FreeSlots.Add(SlotIndex);
+	}
+
+	EntityIdToHandle.Reset();
+	DenseToSlot.Reset();
+	EntityIds.Reset();
+	EntityTypes.Reset();
+	Names.Reset();
+	Positions.Reset();
+	RotationYaws.Reset();
+	RotationPitches.Reset();
+	Velocities.Reset();
+	MovementStates.Reset();
+	ServerTimestamps.Reset();
+	NPCStates.Reset();
+	TargetEntityIds.Reset();
+	CurrentHealth.Reset();
+	MaxHealth.Reset();
+	Resources.Reset();
+}
+
+bool FEldaraEntityReplicaStore::ApplyMovementUpdate(const FMovementUpdatePacket& Packet)
+{
+	const int32 DenseIndex = GetDenseIndex(Packet.EntityId);
+	if (DenseIndex == INDEX_NONE)
+	{
+		return false;
+	}
+
+	// Drop out-of-order updates; the newest authoritative sample wins
+	if (Packet.ServerTimestamp != 0 && Packet.ServerTimestamp < ServerTimestamps[DenseIndex])
+	{
+		return true;
+	}
+
+	Positions[DenseIndex] = Packet.Position;
+	Velocities[DenseIndex] = Packet.Velocity;
+	RotationYaws[DenseIndex] = Packet.RotationYaw;
+	RotationPitches[DenseIndex] = Packet.RotationPitch;
+	MovementStates[DenseIndex] = Packet.State;
+	ServerTimestamps[DenseIndex] = Packet.ServerTimestamp;
+	return true;
+}
+
+bool FEldaraEntityReplicaStore::ApplyNPCStateUpdate(const FNPCStateUpdatePacket& Packet)
+{
+	const int32 DenseIndex = GetDenseIndex(Packet.EntityId);
+	if (DenseIndex == INDEX_NONE)
+	{
+		return false;
+	}
+
+	NPCStates[DenseIndex] = Packet.State;
+	TargetEntityIds[DenseIndex] = Packet.bHasTargetEntityId ? Packet.TargetEntityId : 0;
+	return true;
+}
+
+FEldaraEntityHandle FEldaraEntityReplicaStore::FindHandle(int64 EntityId) const
+{
+	const FEldaraEntityHandle* Handle = EntityIdToHandle.Find(EntityId);
+	return Handle ? *Handle : FEldaraEntityHandle();
+}
+
+int32 FEldaraEntityReplicaStore::GetDenseIndex(FEldaraEntityHandle Handle) const
+{
+	if (!Slots.IsValidIndex(Handle.SlotIndex))
+	{
+		return INDEX_NONE;
+	}
+
+	const FSlot& Slot = Slots[Handle.SlotIndex];
+	return Slot.Generation == Handle.Generation ? Slot.DenseIndex : INDEX_NONE;
+}
+
+int32 FEldaraEntityReplicaStore::GetDenseIndex(int64 EntityId) const
+{
+	const FEldaraEntityHandle* Handle = EntityIdToHandle.Find(EntityId);
+	return Handle ? Slots[Handle->SlotIndex].DenseIndex : INDEX_NONE;
+}
+
+FEldaraEntityHandle FEldaraEntityReplicaStore::GetHandleAt(int32 DenseIndex) const
+{
+	FEldaraEntityHandle Handle;
+	if (DenseToSlot.IsValidIndex(DenseIndex))
+	{
+		Handle.SlotIndex = DenseToSlot[DenseIndex];
+		Handle.Generation = Slots[Handle.SlotIndex].Generation;
+	}
+	return Handle;
+}
+
+void FEldaraEntityReplicaStore::WriteSpawnRow(int32 DenseIndex, const FEntitySpawnPacket& Packet)
+{
+	EntityIds[DenseIndex] = Packet.EntityId;
+	EntityTypes[DenseIndex] = Packet.Type;
+	Names[DenseIndex] = Packet.Name;
+	Positions[DenseIndex] = Packet.Position;
+	RotationYaws[DenseIndex] = Packet.RotationYaw;
+	RotationPitches[DenseIndex] = 0.0f;
+	Velocities[DenseIndex] = FVector::ZeroVector;
+	MovementStates[DenseIndex] = EMovementState::Idle;
+	ServerTimestamps[DenseIndex] = 0;
+	NPCStates[DenseIndex] = ENPCState::Idle;
+	TargetEntityIds[DenseIndex] = 0;
+
+	// Vitals: explicit resource snapshot wins, NPC data is the fallback
+	if (Packet.bHasResources)
+	{
+		Resources[DenseIndex] = Packet.Resources;
+		CurrentHealth[DenseIndex] = Packet.Resources.CurrentHealth;
+		MaxHealth[DenseIndex] = Packet.Resources.MaxHealth;
+	}
+	else if (Packet.bHasNPCData)
+	{
+		Resources[DenseIndex] = Packet.NPCData.Resources;
+		CurrentHealth[DenseIndex] = Packet.NPCData.CurrentHealth;
+		MaxHealth[DenseIndex] = Packet.NPCData.MaxHealth;
+	}
+	else
+	{
+		Resources[DenseIndex] = FResourceSnapshot();
+		CurrentHealth[DenseIndex] = 0;
+		MaxHealth[DenseIndex] = 0;
+	}
+}
+
+void FEldaraEntityReplicaStore::MoveRow(int32 SourceIndex, int32 TargetIndex)
+{
+	DenseToSlot[TargetIndex] = DenseToSlot[SourceIndex];
+	EntityIds[TargetIndex] = EntityIds[SourceIndex];
+	EntityTypes[TargetIndex] = EntityTypes[SourceIndex];
+	Names[TargetIndex] = MoveTemp(Names[SourceIndex]);
+	Positions[TargetIndex] = Positions[SourceIndex];
+	RotationYaws[TargetIndex] = RotationYaws[SourceIndex];
+	RotationPitches[TargetIndex] = RotationPitches[SourceIndex];
+	Velocities[TargetIndex] = Velocities[SourceIndex];
+	MovementStates[TargetIndex] = MovementStates[SourceIndex];
+	ServerTimestamps[TargetIndex] = ServerTimestamps[SourceIndex];
+	NPCStates[TargetIndex] = NPCStates[SourceIndex];
+	TargetEntityIds[TargetIndex] = TargetEntityIds[SourceIndex];
+	CurrentHealth[TargetIndex] = CurrentHealth[SourceIndex];
+	MaxHealth[TargetIndex] = MaxHealth[SourceIndex];
+	Resources[TargetIndex] = Resources[SourceIndex];
+}
+
+void FEldaraEntityReplicaStore::PopRow()
+{
+	DenseToSlot.Pop(EAllowShrinking::No);
+	EntityIds.Pop(EAllowShrinking::No);
+	EntityTypes.Pop(EAllowShrinking::No);
+	Names.Pop(EAllowShrinking::No);
+	Positions.Pop(EAllowShrinking::No);
+	RotationYaws.Pop(EAllowShrinking::No);
+	RotationPitches.Pop(EAllowShrinking::No);
+	Velocities.Pop(EAllowShrinking::No);
+	MovementStates.Pop(EAllowShrinking::No);
+	ServerTimestamps.Pop(EAllowShrinking::No);
+	NPCStates.Pop(EAllowShrinking::No);
+	TargetEntityIds.Pop(EAllowShrinking::No);
+	CurrentHealth.Pop(EAllowShrinking::No);
+	MaxHealth.Pop(EAllowShrinking::No);
+	Resources.Pop(EAllowShrinking::No);
+}
@@ -0,0 +1,188 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Async/ParallelFor.h"
+#include "NetworkTypes.h"
+#include "NetworkPackets.h"
+
+/**
+ * Generational handle to a replicated entity.
+ * Stays cheap to copy and detects use-after-despawn: once the slot is reused the
+ * generation no longer matches and lookups fail instead of aliasing a new entity.
+ */
+struct ELDARA_API FEldaraEntityHandle
+{
+	int32 SlotIndex = INDEX_NONE;
+	uint32 Generation = 0;
+
+	bool IsSet() const { return SlotIndex != INDEX_NONE; }
+
+	bool operator==(const FEldaraEntityHandle& Other) const
+	{
+		return SlotIndex == Other.SlotIndex && Generation == Other.Generation;
+	}
+
+	bool operator!=(const FEldaraEntityHandle& Other) const { return !(*this == Other); }
+
+	friend uint32 GetTypeHash(const FEldaraEntityHandle& Handle)
+	{
+		return HashCombine(::GetTypeHash(Handle.SlotIndex), ::GetTypeHash(Handle.Generation));
+	}
+};
+
+/**
+ * Client-side store for remote entities (players, NPCs, monsters) fed by
+ * EntitySpawn, EntityDespawn, MovementUpdate and NPCStateUpdate packets.
+ *
+ * Entity state lives in dense structure-of-arrays columns so systems such as
+ * interpolation, nameplates and culling can scan a single column linearly.
+ * EntityId -> handle lookup goes through a hash map; handles map to a sparse slot
+ * that records the entity's current dense index. Spawn and despawn are O(1):
+ * despawn swap-removes the dense row and patches the moved entity's slot.
+ *
+ * Dense indices are only stable until the next Spawn/Despawn; hold handles or
+ * EntityIds across frames, not indices.
+ */
+class ELDARA_API FEldaraEntityReplicaStore
+{
+public:
+	/**
+	 * Insert an entity from a spawn packet. A spawn for an EntityId that is already
+	 * present refreshes the existing row and returns its handle.
+	 */
+	FEldaraEntityHandle Spawn(const FEntitySpawnPacket& Packet);
+
+	/** Remove an entity. Returns false if the EntityId was not present. */
+	bool Despawn(int64 EntityId);
+
+	/** Drop every entity and invalidate all outstanding handles */
+	void Reset();
+
+	/** Apply an authoritative movement update. Returns false for unknown entities. */
+	bool ApplyMovementUpdate(const FMovementUpdatePacket& Packet);
+
+	/** Apply an NPC state/target change. Returns false for unknown entities. */
+	bool ApplyNPCStateUpdate(const FNPCStateUpdatePacket& Packet);
+
+	/** Resolve an EntityId to its handle (unset handle if not present) */
+	FEldaraEntityHandle FindHandle(int64 EntityId) const;
+
+	/** True if the handle still refers to a live entity */
+	bool IsValid(FEldaraEntityHandle Handle) const { return GetDenseIndex(Handle) != INDEX_NONE; }
+
+	/** Current dense row for a handle, or INDEX_NONE if the handle is stale */
+	int32 GetDenseIndex(FEldaraEntityHandle Handle) const;
+
+	/** Current dense row for an EntityId, or INDEX_NONE if not present */
+	int32 GetDenseIndex(int64 EntityId) const;
+
+	/** Handle for the entity currently stored at a dense row */
+	FEldaraEntityHandle GetHandleAt(int32 DenseIndex) const;
+
+	bool Contains(int64 EntityId) const { return EntityIdToHandle.Contains(EntityId); }
+
+	int32 Num() const { return EntityIds.Num(); }
+
+	// ========================================================================
+	// Column access (indexed by dense row, 0..Num()-1)
+	// ========================================================================
+
+	TConstArrayView<int64> GetEntityIds() const { return EntityIds; }
+	TConstArrayView<EEntityType> GetEntityTypes() const { return EntityTypes; }
+	TConstArrayView<FString> GetNames() const { return Names; }
+	TConstArrayView<FVector> GetPositions() const { return Positions; }
+	TConstArrayView<float> GetRotationYaws() const { return RotationYaws; }
+	TConstArrayView<float> GetRotationPitches() const { return RotationPitches; }
+	TConstArrayView<FVector> GetVelocities() const { return Velocities; }
+	TConstArrayView<EMovementState> GetMovementStates() const { return MovementStates; }
+	TConstArrayView<int64> GetServerTimestamps() const { return ServerTimestamps; }
+	TConstArrayView<ENPCState> GetNPCStates() const { return NPCStates; }
+	TConstArrayView<int64> GetTargetEntityIds() const { return TargetEntityIds; }
+	TConstArrayView<int32> GetCurrentHealth() const { return CurrentHealth; }
+	TConstArrayView<int32> GetMaxHealth() const { return MaxHealth; }
+	TConstArrayView<FResourceSnapshot> GetResources() const { return Resources; }
+
+	/** Mutable column views for systems that integrate state locally (e.g. interpolation) */
+	TArrayView<FVector> GetPositionsMutable() { return Positions; }
+	TArrayView<float> GetRotationYawsMutable() { return RotationYaws; }
+
+	/**
+	 * Visit every live entity by dense row.
+	 * @param Func Callable with signature void(int32 DenseIndex)
+	 */
+	template<typename FuncType>
+	void ForEachEntity(FuncType&& Func) const
+	{
+		const int32 Count = EntityIds.Num();
+		for (int32 DenseIndex = 0; DenseIndex < Count; ++DenseIndex)
+		{
+			Func(DenseIndex);
+		}
+	}
+
+	/**
+	 * Visit dense rows in contiguous batches across worker threads.
+	 * The store must not be structurally modified (Spawn/Despawn/Reset) while this runs;
+	 * callers may write to their own per-row output but not to shared state.
+	 * @param BatchSize Rows per task
+	 * @param Func Callable with signature void(int32 BeginIndex, int32 EndIndex) (EndIndex exclusive)
+	 */
+	template<typename FuncType>
+	void ParallelForEachBatch(int32 BatchSize, FuncType&& Func) const
+	{
+		const int32 Count = EntityIds.Num();
+		if (Count == 0)
+		{
+			return;
+		}
+
+		const int32 SafeBatchSize = FMath::Max(1, BatchSize);
+		const int32 NumBatches = FMath::DivideAndRoundUp(Count, SafeBatchSize);
+		ParallelFor(NumBatches, [&Func, Count, SafeBatchSize](int32 BatchIndex)
+		{
+			const int32 BeginIndex = BatchIndex * SafeBatchSize;
+			const int32 EndIndex = FMath::Min(BeginIndex + SafeBatchSize, Count);
+			Func(BeginIndex, EndIndex);
+		});
+	}
+
+private:
+	/** Sparse slot: maps a handle to its dense row and carries the generation */
+	struct FSlot
+	{
+		int32 DenseIndex = INDEX_NONE;
+		uint32 Generation = 0;
+	};
+
+	/** Write spawn packet fields into an existing dense row */
+	void WriteSpawnRow(int32 DenseIndex, const FEntitySpawnPacket& Packet);
+
+	/** Move the row at SourceIndex into TargetIndex across every column */
+	void MoveRow(int32 SourceIndex, int32 TargetIndex);
+
+	/** Remove the last row from every column */
+	void PopRow();
+
+	TArray<FSlot> Slots;
+	TArray<int32> FreeSlots;
+	TMap<int64, FEldaraEntityHandle> EntityIdToHandle;
+
+	/** Dense row -> owning slot (for patching handles on swap-remove) */
+	TArray<int32> DenseToSlot;
+
+	// Dense columns - every array has exactly Num() elements
+	TArray<int64> EntityIds;
+	TArray<EEntityType> EntityTypes;
+	TArray<FString> Names;
+	TArray<FVector> Positions;
+	TArray<float> RotationYaws;
+	TArray<float> RotationPitches;
+	TArray<FVector> Velocities;
+	TArray<EMovementState> MovementStates;
+	TArray<int64> ServerTimestamps;
+	TArray<ENPCState> NPCStates;
+	TArray<int64> TargetEntityIds;
+	TArray<int32> CurrentHealth;
+	TArray<int32> MaxHealth;
+	TArray<FResourceSnapshot> Resources;
+};
@@ -0,0 +1,104 @@
+#include "EldaraFlatCodec.h"
+
+namespace EldaraFlatCodec
+{
+	// The wire format is little-endian and packed; a layout change here is a protocol change
+	static_assert(PLATFORM_LITTLE_ENDIAN, "Flat packet bodies are copied as-is and assume a little-endian host");
+
+	static_assert(sizeof(FHeader) == HeaderSize, "Flat header layout changed");
+	static_assert(STRUCT_OFFSET(FHeader, PacketType) == 2, "Flat header layout changed");
+
+	static_assert(sizeof(FMovementInputBody) == 41, "MovementInput flat layout changed");
+	static_assert(STRUCT_OFFSET(FMovementInputBody, Flags) == 16, "MovementInput flat layout changed");
+	static_assert(STRUCT_OFFSET(FMovementInputBody, LookYaw) == 17, "MovementInput flat layout changed");
+	static_assert(STRUCT_OFFSET(FMovementInputBody, PredictedPosition) == 25, "MovementInput flat layout changed");
+	static_assert(STRUCT_OFFSET(FMovementInputBody, PredictedRotationYaw) == 37, "MovementInput flat layout changed");
+
+	static_assert(sizeof(FMovementUpdateBody) == 49, "MovementUpdate flat layout changed");
+	static_assert(STRUCT_OFFSET(FMovementUpdateBody, Position) == 8, "MovementUpdate flat layout changed");
+	static_assert(STRUCT_OFFSET(FMovementUpdateBody, Velocity) == 20, "MovementUpdate flat layout changed");
+	static_assert(STRUCT_OFFSET(FMovementUpdateBody, RotationYaw) == 32, "MovementUpdate flat layout changed");
+	static_assert(STRUCT_OFFSET(FMovementUpdateBody, State) == 40, "MovementUpdate flat layout changed");
+	static_assert(STRUCT_OFFSET(FMovementUpdateBody, ServerTimestamp) == 41, "MovementUpdate flat layout changed");
+
+	namespace
+	{
+		void WriteHeader(EPacketType PacketType, uint8* Dest)
+		{
+			FHeader Header;
+			Header.Marker = Marker;
+			Header.Version = Version;
+			Header.PacketType = static_cast<uint16>(PacketType);
+			FMemory::Memcpy(Dest, &Header, sizeof(Header));
+		}
+
+		/** Validate the header and that at least BodySize bytes follow it */
+		bool CheckHeader(const TArray<uint8>& InBytes, EPacketType ExpectedType, int32 BodySize)
+		{
+			if (!IsFlatPayload(InBytes.GetData(), InBytes.Num()))
+			{
+				return false;
+			}
+
+			FHeader Header;
+			FMemory::Memcpy(&Header, InBytes.GetData(), sizeof(Header));
+			if (Header.Version != Version)
+			{
+				UE_LOG(LogTemp, Error, TEXT("EldaraFlatCodec: Unsupported flat packet version %d"), Header.Version);
+				return false;
+			}
+
+			if (Header.PacketType != static_cast<uint16>(ExpectedType) || InBytes.Num() < HeaderSize + BodySize)
+			{
+				UE_LOG(LogTemp, Error, TEXT("EldaraFlatCodec: Malformed flat packet (type %d, %d bytes)"), Header.PacketType, InBytes.Num());
+				return false;
+			}
+
+			return true;
+		}
+	}
+
+	EPacketType GetPacketType(const uint8* Data)
+	{
+		return static_cast<EPacketType>(Data[2] | (Data[3] << 8));
+	}
+
+	void EncodeMovementInput(const FMovementInputPacket& Packet, TArray<uint8>& OutBytes)
+	{
+		FMovementInputBody Body;
+		Body.InputSequence = static_cast<uint32>(Packet.InputSequence);
+		Body.DeltaTime = Packet.DeltaTime;
+		Body.Forward = Packet.Input.Forward;
+		Body.Strafe = Packet.Input.Strafe;
+		Body.Flags = (Packet.Input.bJump ? 1 : 0) | (Packet.Input.bSprint ? 2 : 0);
+		Body.LookYaw = Packet.Input.LookYaw;
+		Body.LookPitch = Packet.Input.LookPitch;
+		Body.PredictedPosition[0] = static_cast<float>(Packet.PredictedPosition.X);
+		Body.PredictedPosition[1] = static_cast<float>(Packet.PredictedPosition.Y);
+		Body.PredictedPosition[2] = static_cast<float>(Packet.PredictedPosition.Z);
+		Body.PredictedRotationYaw = Packet.PredictedRotationYaw;
+
+		OutBytes.SetNumUninitialized(HeaderSize + sizeof(Body), EAllowShrinking::No);
+		WriteHeader(EPacketType::MovementInput, OutBytes.GetData());
+		FMemory::Memcpy(OutBytes.GetData() + HeaderSize, &Body, sizeof(Body));
+	}
+
+	bool DecodeMovementUpdate(const TArray<uint8>& InBytes, FMovementUpdatePacket& OutPacket)
+	{
+		FMovementUpdateBody Body;
+		if (!CheckHeader(InBytes, EPacketType::MovementUpdate, sizeof(Body)))
+		{
+			return false;
+		}
+
+		FMemory::Memcpy(&Body, InBytes.GetData() + HeaderSize, sizeof(Body));
+		OutPacket.EntityId = static_cast<int64>(Body.EntityId);
+		OutPacket.Position = FVector(Body.Position[0], Body.Position[1], Body.Position[2]);
+		OutPacket.Velocity = FVector(Body.Velocity[0], Body.Velocity[1], Body.Velocity[2]);
+		OutPacket.RotationYaw = Body.RotationYaw;
+		OutPacket.RotationPitch = Body.RotationPitch;
+		OutPacket.State = static_cast<EMovementState>(Body.State);
+		OutPacket.ServerTimestamp = Body.ServerTimestamp;
+		return true;
+	}
+}
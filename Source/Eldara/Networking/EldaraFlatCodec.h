@@ -0,0 +1,79 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "NetworkTypes.h"
+#include "NetworkPackets.h"
+
+/**
+ * Fixed-layout binary encoding for the tick-rate movement packets (MovementInput,
+ * MovementUpdate); everything else stays on MessagePack.
+ *
+ * A flat payload is [ Marker, Version, PacketType (uint16) ] followed by a packed
+ * little-endian body that is decoded with a single memcpy instead of a type-tag branch per
+ * field. Marker is 0xC1, which MessagePack never emits, so both encodings share the same
+ * length-prefixed stream. The encoding is only used after the server accepted it at login.
+ *
+ * Layouts must match Shared/WorldofEldara.Shared/Protocol/FlatCodec.cs; the static_asserts in
+ * EldaraFlatCodec.cpp pin every size and offset.
+ *
+ * Payload sizes with typical values (small entity ids), MessagePack vs flat:
+ *   MovementInput   55 vs 45 bytes
+ *   MovementUpdate  58 vs 53 bytes
+ * Decode cost is measured by -run=EldaraPacketCodecBench. ThreatUpdate is not in the set:
+ * MessagePack's variable-length ints make it about half the flat size (40 vs 82 bytes with
+ * 5 entries) and it is sent at combat-event rate, not tick rate.
+ */
+namespace EldaraFlatCodec
+{
+	constexpr uint8 Marker = 0xC1;
+	constexpr uint8 Version = 1;
+	constexpr int32 HeaderSize = 4;
+
+#pragma pack(push, 1)
+	struct FHeader
+	{
+		uint8 Marker;
+		uint8 Version;
+		uint16 PacketType;
+	};
+
+	struct FMovementInputBody
+	{
+		uint32 InputSequence;
+		float DeltaTime;
+		float Forward;
+		float Strafe;
+		/** Bit 0: jump, bit 1: sprint */
+		uint8 Flags;
+		float LookYaw;
+		float LookPitch;
+		float PredictedPosition[3];
+		float PredictedRotationYaw;
+	};
+
+	struct FMovementUpdateBody
+	{
+		uint64 EntityId;
+		float Position[3];
+		float Velocity[3];
+		float RotationYaw;
+		float RotationPitch;
+		uint8 State;
+		int64 ServerTimestamp;
+	};
+#pragma pack(pop)
+
+	/** True if the payload uses this encoding (any version) */
+	inline bool IsFlatPayload(const uint8* Data, int32 Num)
+	{
+		return Num >= HeaderSize && Data[0] == Marker;
+	}
+
+	/** Packet type of a flat payload; call IsFlatPayload first */
+	EPacketType GetPacketType(const uint8* Data);
+
+	void EncodeMovementInput(const FMovementInputPacket& Packet, TArray<uint8>& OutBytes);
+
+	/** Decoders reject unknown versions, wrong packet types and truncated bodies */
+	bool DecodeMovementUpdate(const TArray<uint8>& InBytes, FMovementUpdatePacket& OutPacket);
+}
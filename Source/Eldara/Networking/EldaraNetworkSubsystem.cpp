@@ -2,11 +2,34 @@
 #include "SocketSubsystem.h"
 #include "IPAddress.h"
 #include "TimerManager.h"
+#include "EldaraFlatCodec.h"
+
+namespace
+{
+	/**
+	 * Per-poll packet budgets; 0 is unlimited. Control, combat and movement always go out in
+	 * full, everything else spills into the next poll once its budget is used. Entity spawns
+	 * travel with movement and are not capped here; the spawn subsystem paces materialization.
+	 */
+	constexpr int32 IncomingWorldBudget = 64;
+	constexpr int32 IncomingChatBudget = 8;
+	constexpr int32 IncomingBulkBudget = 1;
+	constexpr int32 OutgoingWorldBudget = 32;
+	constexpr int32 OutgoingChatBudget = 4;
+	constexpr int32 OutgoingBulkBudget = 1;
+}
 
 void UEldaraNetworkSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 {
 	Super::Initialize(Collection);
 	
+	IncomingTraffic.SetBudget(EEldaraTrafficClass::World, IncomingWorldBudget);
+	IncomingTraffic.SetBudget(EEldaraTrafficClass::Chat, IncomingChatBudget);
+	IncomingTraffic.SetBudget(EEldaraTrafficClass::Bulk, IncomingBulkBudget);
+	OutgoingTraffic.SetBudget(EEldaraTrafficClass::World, OutgoingWorldBudget);
+	OutgoingTraffic.SetBudget(EEldaraTrafficClass::Chat, OutgoingChatBudget);
+	OutgoingTraffic.SetBudget(EEldaraTrafficClass::Bulk, OutgoingBulkBudget);
+	
 	UE_LOG(LogTemp, Log, TEXT("EldaraNetworkSubsystem: Initialized"));
 }
 
@@ -22,13 +45,26 @@ void UEldaraNetworkSubsystem::Deinitialize()
 
 bool UEldaraNetworkSubsystem::ConnectToGameServer(FString IpAddress, int32 Port)
 {
-	// If already connected, disconnect first
-	if (bIsConnected)
+	// If already connected (or recovering a session), disconnect first
+	if (bIsConnected || bReconnecting)
 	{
 		UE_LOG(LogTemp, Warning, TEXT("EldaraNetworkSubsystem: Already connected. Disconnecting first..."));
 		Disconnect();
 	}
 	
+	if (!OpenSocket(IpAddress, Port))
+	{
+		return false;
+	}
+	
+	LastServerIp = IpAddress;
+	LastServerPort = Port;
+	bIsConnected = true;
+	return true;
+}
+
+bool UEldaraNetworkSubsystem::OpenSocket(const FString& IpAddress, int32 Port)
+{
 	// Get the socket subsystem
 	ISocketSubsystem* SocketSubsystem = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM);
 	if (!SocketSubsystem)
@@ -79,8 +115,7 @@ bool UEldaraNetworkSubsystem::ConnectToGameServer(FString IpAddress, int32 Port)
 		}
 	}
 	
-	bIsConnected = true;
-	UE_LOG(LogTemp, Log, TEXT("EldaraNetworkSubsystem: Connected to %s:%d"), *IpAddress, Port);
+	UE_LOG(LogTemp, Log, TEXT("EldaraNetworkSubsystem: Connecting to %s:%d"), *IpAddress, Port);
 	
 	// Start polling for data
 	if (UWorld* World = GetWorld())
@@ -104,6 +139,35 @@ bool UEldaraNetworkSubsystem::ConnectToServer(FString IpAddress, int32 Port)
 }
 
 void UEldaraNetworkSubsystem::Disconnect()
+{
+	CloseSocket();
+	
+	if (UWorld* World = GetWorld())
+	{
+		World->GetTimerManager().ClearTimer(ReconnectTimerHandle);
+	}
+	
+	// Remote entity state is only valid for the current session
+	ClearEntityReplicas();
+	
+	// An explicit disconnect ends the session; nothing is resumable after this
+	SessionToken.Empty();
+	AccountId = 0;
+	PendingCharacterId = 0;
+	ActiveCharacterId = 0;
+	bReconnecting = false;
+	bResumeSent = false;
+	ReconnectAttempt = 0;
+	CachedCharacterList = FCharacterListResponse();
+	bHasCachedCharacterList = false;
+	FlatCodecVersion = 0;
+	MovementInputSequence = 0;
+	
+	bIsConnected = false;
+	UE_LOG(LogTemp, Log, TEXT("EldaraNetworkSubsystem: Disconnected"));
+}
+
+void UEldaraNetworkSubsystem::CloseSocket()
 {
 	// Stop polling timer
 	if (UWorld* World = GetWorld())
@@ -124,21 +188,203 @@ void UEldaraNetworkSubsystem::Disconnect()
 		ConnectionSocket = nullptr;
 	}
 	
-	// Clear receive buffers
+	// Partial packets from the old stream are meaningless on a new one
 	ReceiveBuffer.Empty();
 	ExpectedPacketSize = 0;
+	IncomingTraffic.Reset();
+	OutgoingTraffic.Reset();
+	PartialSend.Reset();
+	PartialSendOffset = 0;
 	
 	bIsConnected = false;
-	UE_LOG(LogTemp, Log, TEXT("EldaraNetworkSubsystem: Disconnected"));
+}
+
+void UEldaraNetworkSubsystem::ClearEntityReplicas()
+{
+	const TArray<int64> EntityIds(EntityReplicas.GetEntityIds());
+	EntityReplicas.Reset();
+	
+	for (const int64 EntityId : EntityIds)
+	{
+		OnEntityDespawn.Broadcast(EntityId);
+	}
+}
+
+void UEldaraNetworkSubsystem::HandleConnectionLost()
+{
+	if (!HasResumableSession())
+	{
+		Disconnect();
+		return;
+	}
+	
+	// Keep the session and replicas; only the transport is gone
+	CloseSocket();
+	
+	if (!bReconnecting)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("EldaraNetworkSubsystem: Connection lost, attempting to resume session"));
+		bReconnecting = true;
+		ReconnectAttempt = 0;
+		OnConnectionLost.Broadcast();
+	}
+	
+	ScheduleReconnect();
+}
+
+void UEldaraNetworkSubsystem::ScheduleReconnect()
+{
+	if (ReconnectAttempt >= MaxReconnectAttempts)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("EldaraNetworkSubsystem: Giving up after %d reconnect attempts"), ReconnectAttempt);
+		FailReconnect(EResponseCode::Timeout);
+		return;
+	}
+	
+	const float Delay = FMath::Min(InitialReconnectDelay * static_cast<float>(1 << ReconnectAttempt), MaxReconnectDelay);
+	
+	UWorld* World = GetWorld();
+	if (!World)
+	{
+		FailReconnect(EResponseCode::Error);
+		return;
+	}
+	
+	UE_LOG(LogTemp, Log, TEXT("EldaraNetworkSubsystem: Reconnect attempt %d in %.1fs"), ReconnectAttempt + 1, Delay);
+	World->GetTimerManager().SetTimer(ReconnectTimerHandle, this, &UEldaraNetworkSubsystem::TryReconnect, Delay, false);
+}
+
+void UEldaraNetworkSubsystem::TryReconnect()
+{
+	++ReconnectAttempt;
+	bResumeSent = false;
+	
+	if (!OpenSocket(LastServerIp, LastServerPort))
+	{
+		ScheduleReconnect();
+		return;
+	}
+	
+	ConnectAttemptStartTime = FPlatformTime::Seconds();
+}
+
+void UEldaraNetworkSubsystem::PollReconnect()
+{
+	const ESocketConnectionState State = ConnectionSocket->GetConnectionState();
+	if (State == SCS_Connected)
+	{
+		bIsConnected = true;
+		SendResumeSession();
+		return;
+	}
+	
+	if (State == SCS_ConnectionError || FPlatformTime::Seconds() - ConnectAttemptStartTime > ConnectAttemptTimeout)
+	{
+		CloseSocket();
+		ScheduleReconnect();
+	}
+}
+
+void UEldaraNetworkSubsystem::SendResumeSession()
+{
+	// Replicas past the cap are dropped locally; the server sends them back as fresh spawns
+	while (EntityReplicas.Num() > MaxKnownEntityIds)
+	{
+		const int64 EntityId = EntityReplicas.GetEntityIds().Last();
+		EntityReplicas.Despawn(EntityId);
+		OnEntityDespawn.Broadcast(EntityId);
+	}
+	
+	FResumeSessionRequest Request;
+	Request.SessionToken = SessionToken;
+	Request.CharacterId = ActiveCharacterId;
+	Request.KnownEntityIds.Append(EntityReplicas.GetEntityIds().GetData(), EntityReplicas.Num());
+	Request.ProtocolVersion = ProtocolVersion;
+	
+	SendPacket(Request);
+	bResumeSent = true;
+	
+	UE_LOG(LogTemp, Log, TEXT("EldaraNetworkSubsystem: Resume request sent (%d known entities)"), Request.KnownEntityIds.Num());
+}
+
+void UEldaraNetworkSubsystem::HandleResumeSessionResponse(const FResumeSessionResponse& Response)
+{
+	if (!bReconnecting)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("EldaraNetworkSubsystem: Ignoring unexpected ResumeSessionResponse"));
+		return;
+	}
+	
+	if (Response.Result != EResponseCode::Success)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("EldaraNetworkSubsystem: Session resume rejected: %s"), *Response.Message);
+		FailReconnect(Response.Result);
+		return;
+	}
+	
+	for (const int64 EntityId : Response.DespawnedEntityIds)
+	{
+		if (EntityReplicas.Despawn(EntityId))
+		{
+			OnEntityDespawn.Broadcast(EntityId);
+		}
+	}
+	
+	bReconnecting = false;
+	ReconnectAttempt = 0;
+	
+	UE_LOG(LogTemp, Log, TEXT("EldaraNetworkSubsystem: Session resumed (%d entities despawned while away)"), Response.DespawnedEntityIds.Num());
+	OnSessionResumed.Broadcast(Response);
+}
+
+void UEldaraNetworkSubsystem::FailReconnect(EResponseCode Result)
+{
+	if (UWorld* World = GetWorld())
+	{
+		World->GetTimerManager().ClearTimer(ReconnectTimerHandle);
+	}
+	
+	if (bIsConnected)
+	{
+		// The transport is fine, only the session is gone: keep the socket so the player can log in again
+		ClearEntityReplicas();
+		SessionToken.Empty();
+		AccountId = 0;
+		PendingCharacterId = 0;
+		ActiveCharacterId = 0;
+		CachedCharacterList = FCharacterListResponse();
+		bHasCachedCharacterList = false;
+		FlatCodecVersion = 0;
+		bReconnecting = false;
+		bResumeSent = false;
+		ReconnectAttempt = 0;
+	}
+	else
+	{
+		Disconnect();
+	}
+	
+	OnReconnectFailed.Broadcast(Result);
 }
 
 void UEldaraNetworkSubsystem::CheckForData()
 {
+	if (ConnectionSocket && bReconnecting && !bResumeSent)
+	{
+		PollReconnect();
+		return;
+	}
+	
 	if (!ConnectionSocket || !bIsConnected)
 	{
 		return;
 	}
 	
+	// One poll is one traffic frame: refill budgets and send what spilled over last time
+	IncomingTraffic.RefillBudgets();
+	OutgoingTraffic.RefillBudgets();
+	FlushOutgoing();
+	
 	// === ADD THIS LOG ===
 	UE_LOG(LogTemp, VeryVerbose, TEXT("EldaraNetworkSubsystem: CheckForData - checking for data..."));
 	
@@ -147,27 +393,25 @@ void UEldaraNetworkSubsystem::CheckForData()
 	if (ConnectionSocket->HasPendingData(PendingDataSize))
 	{
 		// === ADD THIS LOG ===
-		UE_LOG(LogTemp, Log, TEXT("EldaraNetworkSubsystem: HasPendingData returned TRUE - %d bytes pending"), PendingDataSize);
+		UE_LOG(LogTemp, VeryVerbose, TEXT("EldaraNetworkSubsystem: HasPendingData returned TRUE - %d bytes pending"), PendingDataSize);
 		
-		// Allocate buffer for received data
-		TArray<uint8> ReceivedData;
-		ReceivedData.SetNumUninitialized(PendingDataSize);
+		// Receive straight onto the end of the receive buffer; it keeps its capacity between polls
+		const int32 PreviousBufferSize = ReceiveBuffer.Num();
+		ReceiveBuffer.AddUninitialized(PendingDataSize);
 		
 		// Read the data
 		int32 BytesRead = 0;
-		if (ConnectionSocket->Recv(ReceivedData.GetData(), PendingDataSize, BytesRead))
+		const bool bReceived = ConnectionSocket->Recv(ReceiveBuffer.GetData() + PreviousBufferSize, PendingDataSize, BytesRead);
+		ReceiveBuffer.SetNum(PreviousBufferSize + (bReceived ? BytesRead : 0), EAllowShrinking::No);
+		if (bReceived)
 		{
 			// === ADD THIS LOG ===
-			UE_LOG(LogTemp, Log, TEXT("EldaraNetworkSubsystem: Successfully read %d bytes from socket"), BytesRead);
+			UE_LOG(LogTemp, VeryVerbose, TEXT("EldaraNetworkSubsystem: Successfully read %d bytes from socket"), BytesRead);
 			
 			if (BytesRead > 0)
 			{
 				// === ADD THIS LOG ===
-				UE_LOG(LogTemp, Log, TEXT("EldaraNetworkSubsystem: Appending %d bytes to ReceiveBuffer (current size: %d)"), 
-					BytesRead, ReceiveBuffer.Num());
-				
-				// Append to receive buffer
-				ReceiveBuffer.Append(ReceivedData.GetData(), BytesRead);
+				UE_LOG(LogTemp, VeryVerbose, TEXT("EldaraNetworkSubsystem: ReceiveBuffer now holds %d bytes"), ReceiveBuffer.Num());
 				
 				// Process complete packets from buffer
 				while (true)
@@ -193,13 +437,13 @@ void UEldaraNetworkSubsystem::CheckForData()
 						                    (ReceiveBuffer[2] << 16) | (ReceiveBuffer[3] << 24);
 						
 						// === ADD THIS LOG ===
-						UE_LOG(LogTemp, Log, TEXT("EldaraNetworkSubsystem: Read length prefix - expecting %d byte packet"), ExpectedPacketSize);
+						UE_LOG(LogTemp, VeryVerbose, TEXT("EldaraNetworkSubsystem: Read length prefix - expecting %d byte packet"), ExpectedPacketSize);
 						
 						// Validate packet size
 						if (ExpectedPacketSize <= 0 || ExpectedPacketSize > MaxPacketSize)
 						{
 							UE_LOG(LogTemp, Error, TEXT("EldaraNetworkSubsystem: Invalid packet size: %d"), ExpectedPacketSize);
-							Disconnect();
+							HandleConnectionLost();
 							return;
 						}
 						
@@ -221,21 +465,15 @@ void UEldaraNetworkSubsystem::CheckForData()
 					}
 					
 					// === ADD THIS LOG ===
-					UE_LOG(LogTemp, Log, TEXT("EldaraNetworkSubsystem: Complete packet received (%d bytes), processing..."), ExpectedPacketSize);
+					UE_LOG(LogTemp, VeryVerbose, TEXT("EldaraNetworkSubsystem: Complete packet received (%d bytes), processing..."), ExpectedPacketSize);
 					
-					// Extract packet data
-					TArray<uint8> PacketData;
-					PacketData.Append(ReceiveBuffer.GetData(), ExpectedPacketSize);
+					// Queue the packet in its traffic class; dispatch happens below, within budgets
+					const EEldaraTrafficClass TrafficClass = FEldaraTrafficQueue::ClassifyPayload(ReceiveBuffer.GetData(), ExpectedPacketSize);
+					IncomingTraffic.Enqueue(TrafficClass, ReceiveBuffer.GetData(), ExpectedPacketSize, FPlatformTime::Seconds());
 					
 					// Remove packet from buffer
 					ReceiveBuffer.RemoveAt(0, ExpectedPacketSize, EAllowShrinking::No);
 					
-					// === ADD THIS LOG ===
-					UE_LOG(LogTemp, Log, TEXT("EldaraNetworkSubsystem: Calling ProcessReceivedData with %d bytes"), PacketData.Num());
-					
-					// Process the packet
-					ProcessReceivedData(PacketData);
-					
 					// Reset for next packet
 					ExpectedPacketSize = 0;
 					
@@ -259,7 +497,8 @@ void UEldaraNetworkSubsystem::CheckForData()
 			if (Error != SE_EWOULDBLOCK && Error != SE_NO_ERROR)
 			{
 				UE_LOG(LogTemp, Error, TEXT("EldaraNetworkSubsystem: Error receiving data (Error: %d)"), (int32)Error);
-				Disconnect();
+				HandleConnectionLost();
+				return;
 			}
 		}
 	}
@@ -275,19 +514,157 @@ void UEldaraNetworkSubsystem::CheckForData()
 		}
 	}
 	
-	// Check socket state
+	DispatchIncoming();
+	
+	// Check socket state (a packet handler may have closed it)
+	if (!ConnectionSocket)
+	{
+		return;
+	}
+	
 	ESocketConnectionState State = ConnectionSocket->GetConnectionState();
 	if (State == SCS_ConnectionError || State == SCS_NotConnected)
 	{
 		UE_LOG(LogTemp, Warning, TEXT("EldaraNetworkSubsystem: Connection lost (State: %d)"), (int32)State);
-		Disconnect();
+		HandleConnectionLost();
+	}
+}
+
+void UEldaraNetworkSubsystem::HandleMovementUpdate(const FMovementUpdatePacket& Update)
+{
+	EntityReplicas.ApplyMovementUpdate(Update);
+	
+	if (OnMovementUpdateResponse.IsBound())
+	{
+		FMovementUpdateResponse& Response = ReceivePackets.MovementUpdateResponse;
+		Response.EntityId = Update.EntityId;
+		Response.Position = Update.Position;
+		Response.Rotation = FRotator(Update.RotationPitch, Update.RotationYaw, 0.0f);
+		Response.Velocity = Update.Velocity;
+		OnMovementUpdateResponse.Broadcast(Response);
+	}
+}
+
+void UEldaraNetworkSubsystem::ProcessFlatPacket(const TArray<uint8>& Data)
+{
+	const EPacketType PacketType = EldaraFlatCodec::GetPacketType(Data.GetData());
+	switch (PacketType)
+	{
+		case EPacketType::MovementUpdate:
+		{
+			if (EldaraFlatCodec::DecodeMovementUpdate(Data, ReceivePackets.MovementUpdate))
+			{
+				HandleMovementUpdate(ReceivePackets.MovementUpdate);
+			}
+			break;
+		}
+		
+		default:
+			UE_LOG(LogTemp, Warning, TEXT("EldaraNetworkSubsystem: Unhandled flat packet type %d"), static_cast<int32>(PacketType));
+			break;
+	}
+}
+
+void UEldaraNetworkSubsystem::DispatchIncoming()
+{
+	IncomingTraffic.Drain(FPlatformTime::Seconds(), [this](TArray<uint8>& Data)
+	{
+		ProcessReceivedData(Data);
+		
+		// A handler may have dropped the connection; CloseSocket already cleared the queue
+		return ConnectionSocket != nullptr;
+	});
+}
+
+void UEldaraNetworkSubsystem::QueueOutgoing(const TArray<uint8>& Payload)
+{
+	const int32 PayloadSize = Payload.Num();
+	
+	// Prepend 4-byte length prefix (Little Endian) as expected by C# server
+	FrameBuffer.SetNumUninitialized(LengthPrefixSize + PayloadSize, EAllowShrinking::No);
+	uint8* PacketData = FrameBuffer.GetData();
+	PacketData[0] = static_cast<uint8>(PayloadSize & 0xFF);
+	PacketData[1] = static_cast<uint8>((PayloadSize >> 8) & 0xFF);
+	PacketData[2] = static_cast<uint8>((PayloadSize >> 16) & 0xFF);
+	PacketData[3] = static_cast<uint8>((PayloadSize >> 24) & 0xFF);
+	FMemory::Memcpy(PacketData + LengthPrefixSize, Payload.GetData(), PayloadSize);
+	
+	const EEldaraTrafficClass TrafficClass = FEldaraTrafficQueue::ClassifyPayload(Payload.GetData(), PayloadSize);
+	OutgoingTraffic.Enqueue(TrafficClass, FrameBuffer.GetData(), FrameBuffer.Num(), FPlatformTime::Seconds());
+}
+
+void UEldaraNetworkSubsystem::FlushOutgoing()
+{
+	if (!ConnectionSocket || !bIsConnected)
+	{
+		return;
+	}
+	
+	// Finish a partly sent packet first; interleaving another frame would corrupt the stream
+	if (PartialSendOffset < PartialSend.Num())
+	{
+		int32 BytesSent = 0;
+		if (!ConnectionSocket->Send(PartialSend.GetData() + PartialSendOffset, PartialSend.Num() - PartialSendOffset, BytesSent))
+		{
+			UE_LOG(LogTemp, Error, TEXT("EldaraNetworkSubsystem: Failed to send packet"));
+			return;
+		}
+		
+		PartialSendOffset += BytesSent;
+		if (PartialSendOffset < PartialSend.Num())
+		{
+			return;
+		}
+		
+		PartialSend.Reset();
+		PartialSendOffset = 0;
 	}
+	
+	OutgoingTraffic.Drain(FPlatformTime::Seconds(), [this](const TArray<uint8>& Frame)
+	{
+		if (PartialSendOffset < PartialSend.Num())
+		{
+			return false;
+		}
+		
+		int32 BytesSent = 0;
+		if (!ConnectionSocket->Send(Frame.GetData(), Frame.Num(), BytesSent))
+		{
+			// Leave it queued; the poll's connection state check handles a dead socket
+			UE_LOG(LogTemp, Error, TEXT("EldaraNetworkSubsystem: Failed to send packet"));
+			return false;
+		}
+		
+		if (BytesSent < Frame.Num())
+		{
+			UE_LOG(LogTemp, Verbose, TEXT("EldaraNetworkSubsystem: Partial send (%d of %d bytes), remainder deferred"), BytesSent, Frame.Num());
+			PartialSend.Reset();
+			PartialSend.Append(Frame.GetData() + BytesSent, Frame.Num() - BytesSent);
+			PartialSendOffset = 0;
+		}
+		else
+		{
+			UE_LOG(LogTemp, Verbose, TEXT("EldaraNetworkSubsystem: Successfully sent packet (%d bytes total)"), Frame.Num());
+		}
+		return true;
+	});
 }
 
-void UEldaraNetworkSubsystem::ProcessReceivedData(const TArray<uint8>& Data)
+FEldaraTrafficClassStats UEldaraNetworkSubsystem::GetTrafficStats(EEldaraTrafficClass Class, bool bOutgoing) const
+{
+	return bOutgoing ? OutgoingTraffic.GetStats(Class) : IncomingTraffic.GetStats(Class);
+}
+
+void UEldaraNetworkSubsystem::ProcessReceivedData(TArray<uint8>& Data)
 {
 	// === ADD THIS LOG ===
-	UE_LOG(LogTemp, Log, TEXT("EldaraNetworkSubsystem: ProcessReceivedData called with %d bytes"), Data.Num());
+	UE_LOG(LogTemp, VeryVerbose, TEXT("EldaraNetworkSubsystem: ProcessReceivedData called with %d bytes"), Data.Num());
+	
+	if (EldaraFlatCodec::IsFlatPayload(Data.GetData(), Data.Num()))
+	{
+		ProcessFlatPacket(Data);
+		return;
+	}
 	
 	// Determine packet type
 	int32 PacketType = -1;
@@ -298,9 +675,10 @@ void UEldaraNetworkSubsystem::ProcessReceivedData(const TArray<uint8>& Data)
 	}
 	
 	// === ADD THIS LOG ===
-	UE_LOG(LogTemp, Log, TEXT("EldaraNetworkSubsystem: Received packet type %d, routing to deserializer..."), PacketType);
+	UE_LOG(LogTemp, VeryVerbose, TEXT("EldaraNetworkSubsystem: Received packet type %d, routing to deserializer..."), PacketType);
 	
-	// Deserialize based on packet type
+	// Deserialize based on packet type. High-rate world packets decode into the recycled
+	// instances in ReceivePackets; rare session packets still use a local.
 	switch (PacketType)
 	{
 		case 1: // LoginResponse
@@ -308,16 +686,47 @@ void UEldaraNetworkSubsystem::ProcessReceivedData(const TArray<uint8>& Data)
 			FLoginResponse Response;
 			if (FPacketDeserializer::DeserializeLoginResponse(Data, Response))
 			{
+				if (Response.Result == EResponseCode::Success)
+				{
+					if (Response.AccountId != AccountId)
+					{
+						CachedCharacterList = FCharacterListResponse();
+						bHasCachedCharacterList = false;
+					}
+					AccountId = Response.AccountId;
+					SessionToken = Response.SessionToken;
+					FlatCodecVersion = FMath::Min(Response.FlatCodecVersion, static_cast<int32>(EldaraFlatCodec::Version));
+				}
 				OnLoginResponse.Broadcast(Response);
 			}
 			break;
 		}
 		
+		case 9: // ResumeSessionResponse
+		{
+			FResumeSessionResponse Response;
+			if (FPacketDeserializer::DeserializeResumeSessionResponse(Data, Response))
+			{
+				HandleResumeSessionResponse(Response);
+			}
+			break;
+		}
+		
 		case 3: // CharacterListResponse
 		{
+			// The views keep the packet, so hand over the queue's buffer instead of copying it
 			FCharacterListResponse Response;
-			if (FPacketDeserializer::DeserializeCharacterListResponse(Data, Response))
+			if (FPacketDeserializer::DeserializeCharacterListResponse(MoveTemp(Data), Response))
 			{
+				if (OnCharacterListResponse.IsBound())
+				{
+					DecodeCharacterSummaries(Response);
+				}
+				if (Response.Result == EResponseCode::Success)
+				{
+					CachedCharacterList = Response;
+					bHasCachedCharacterList = true;
+				}
 				OnCharacterListResponse.Broadcast(Response);
 			}
 			break;
@@ -328,6 +737,11 @@ void UEldaraNetworkSubsystem::ProcessReceivedData(const TArray<uint8>& Data)
 			FCreateCharacterResponse Response;
 			if (FPacketDeserializer::DeserializeCreateCharacterResponse(Data, Response))
 			{
+				if (Response.Result == EResponseCode::Success)
+				{
+					// The account has a new character; the cached list is stale
+					bHasCachedCharacterList = false;
+				}
 				OnCreateCharacterResponse.Broadcast(Response);
 			}
 			break;
@@ -338,14 +752,25 @@ void UEldaraNetworkSubsystem::ProcessReceivedData(const TArray<uint8>& Data)
 			FSelectCharacterResponse Response;
 			if (FPacketDeserializer::DeserializeSelectCharacterResponse(Data, Response))
 			{
+				if (Response.Result == EResponseCode::Success)
+				{
+					ActiveCharacterId = Response.Character.CharacterId != 0 ? Response.Character.CharacterId : PendingCharacterId;
+				}
 				OnSelectCharacterResponse.Broadcast(Response);
 			}
 			break;
 		}
 		
-		case 11: // MovementUpdateResponse
+		case 11: // MovementUpdate
 		{
-			FMovementUpdateResponse Response;
+			// Server layout (7 fields) feeds the replica store; legacy 4-field layout is still accepted
+			if (FPacketDeserializer::DeserializeMovementUpdate(Data, ReceivePackets.MovementUpdate))
+			{
+				HandleMovementUpdate(ReceivePackets.MovementUpdate);
+				break;
+			}
+			
+			FMovementUpdateResponse& Response = ReceivePackets.MovementUpdateResponse;
 			if (FPacketDeserializer::DeserializeMovementUpdateResponse(Data, Response))
 			{
 				OnMovementUpdateResponse.Broadcast(Response);
@@ -353,6 +778,57 @@ void UEldaraNetworkSubsystem::ProcessReceivedData(const TArray<uint8>& Data)
 			break;
 		}
 		
+		case 102: // EntitySpawn
+		{
+			FEntitySpawnPacket& Packet = ReceivePackets.EntitySpawn;
+			if (FPacketDeserializer::DeserializeEntitySpawn(Data, Packet))
+			{
+				EntityReplicas.Spawn(Packet);
+				OnEntitySpawnNative.Broadcast(Packet);
+				
+				// Dynamic delegates take the packet by value; skip the copy when nobody listens
+				if (OnEntitySpawn.IsBound())
+				{
+					OnEntitySpawn.Broadcast(Packet);
+				}
+			}
+			break;
+		}
+		
+		case 103: // EntityDespawn
+		{
+			FEntityDespawnPacket& Packet = ReceivePackets.EntityDespawn;
+			if (FPacketDeserializer::DeserializeEntityDespawn(Data, Packet))
+			{
+				if (EntityReplicas.Despawn(Packet.EntityId))
+				{
+					OnEntityDespawn.Broadcast(Packet.EntityId);
+				}
+			}
+			break;
+		}
+		
+		case 106: // NPCStateUpdate
+		{
+			FNPCStateUpdatePacket& Packet = ReceivePackets.NPCStateUpdate;
+			if (FPacketDeserializer::DeserializeNPCStateUpdate(Data, Packet))
+			{
+				EntityReplicas.ApplyNPCStateUpdate(Packet);
+				OnNPCStateUpdate.Broadcast(Packet);
+			}
+			break;
+		}
+		
+		case 21: // AbilityResult
+		{
+			FAbilityResultPacket& Packet = ReceivePackets.AbilityResult;
+			if (FPacketDeserializer::DeserializeAbilityResult(Data, Packet))
+			{
+				OnAbilityResult.Broadcast(Packet);
+			}
+			break;
+		}
+		
 		default:
 			UE_LOG(LogTemp, Warning, TEXT("EldaraNetworkSubsystem: Unhandled packet type %d"), PacketType);
 			break;
@@ -361,18 +837,34 @@ void UEldaraNetworkSubsystem::ProcessReceivedData(const TArray<uint8>& Data)
 
 void UEldaraNetworkSubsystem::SendMovementInput(FVector2D Input, FRotator Rotation, float DeltaTime, FVector Position)
 {
-	// TODO: Implement proper movement packet sending
-	// For now, just log the call
-	UE_LOG(LogTemp, Log, TEXT("EldaraNetworkSubsystem: SendMovementInput called - Input:(%.2f,%.2f) Rotation:(%.1f,%.1f,%.1f) DeltaTime:%.3f Position:(%.1f,%.1f,%.1f)"),
-		Input.X, Input.Y, Rotation.Pitch, Rotation.Yaw, Rotation.Roll, DeltaTime, Position.X, Position.Y, Position.Z);
+	if (!ConnectionSocket || !bIsConnected)
+	{
+		return;
+	}
 	
-	// When implementing, create and send FMovementInputPacket here
-	// Example:
-	// FMovementInputPacket Packet;
-	// Packet.Forward = Input.X;
-	// Packet.Strafe = Input.Y;
-	// ... populate other fields ...
-	// SendPacket(Packet);
+	FMovementInputPacket Packet;
+	Packet.InputSequence = ++MovementInputSequence;
+	Packet.DeltaTime = DeltaTime;
+	Packet.Input.Forward = Input.X;
+	Packet.Input.Strafe = Input.Y;
+	Packet.Input.LookYaw = Rotation.Yaw;
+	Packet.Input.LookPitch = Rotation.Pitch;
+	Packet.PredictedPosition = Position;
+	Packet.PredictedRotationYaw = Rotation.Yaw;
+	
+	UE_LOG(LogTemp, VeryVerbose, TEXT("EldaraNetworkSubsystem: SendMovementInput #%d - Input:(%.2f,%.2f) Position:(%.1f,%.1f,%.1f)"),
+		Packet.InputSequence, Input.X, Input.Y, Position.X, Position.Y, Position.Z);
+	
+	// Tick-rate packet: use the fixed-layout encoding when the server accepted it
+	if (FlatCodecVersion > 0)
+	{
+		EldaraFlatCodec::EncodeMovementInput(Packet, FlatEncodeBuffer);
+		QueueOutgoing(FlatEncodeBuffer);
+		FlushOutgoing();
+		return;
+	}
+	
+	SendPacket(Packet);
 }
 
 void UEldaraNetworkSubsystem::SendLogin(FString Username, FString PasswordHash)
@@ -388,7 +880,8 @@ void UEldaraNetworkSubsystem::SendLogin(FString Username, FString PasswordHash)
 	Packet.Username = Username;
 	Packet.PasswordHash = PasswordHash;
 	Packet.ClientVersion = "1.0.0";
-	Packet.ProtocolVersion = "1.0.0";
+	Packet.ProtocolVersion = ProtocolVersion;
+	Packet.FlatCodecVersion = EldaraFlatCodec::Version;
 	Packet.Timestamp = FDateTime::UtcNow().ToUnixTimestamp();
 	Packet.SequenceNumber = 0;
 	
@@ -398,8 +891,30 @@ void UEldaraNetworkSubsystem::SendLogin(FString Username, FString PasswordHash)
 	UE_LOG(LogTemp, Log, TEXT("EldaraNetworkSubsystem: Login request sent for user: %s"), *Username);
 }
 
-void UEldaraNetworkSubsystem::SendCharacterListRequest()
+void UEldaraNetworkSubsystem::DecodeCharacterSummaries(FCharacterListResponse& Response)
 {
+	if (Response.Characters.Num() == Response.CharacterViews.Num())
+	{
+		return;
+	}
+	
+	Response.Characters.Reset(Response.CharacterViews.Num());
+	for (const FEldaraCharacterDataView& View : Response.CharacterViews)
+	{
+		View.GetSummary(Response.Characters.AddDefaulted_GetRef());
+	}
+}
+
+void UEldaraNetworkSubsystem::SendCharacterListRequest(bool bForceRefresh)
+{
+	if (bHasCachedCharacterList && !bForceRefresh)
+	{
+		UE_LOG(LogTemp, Log, TEXT("EldaraNetworkSubsystem: Character list served from cache"));
+		DecodeCharacterSummaries(CachedCharacterList);
+		OnCharacterListResponse.Broadcast(CachedCharacterList);
+		return;
+	}
+	
 	FCharacterListRequest Request;
 	SendPacket(Request);
 	UE_LOG(LogTemp, Log, TEXT("EldaraNetworkSubsystem: Character list request sent"));
@@ -424,11 +939,25 @@ void UEldaraNetworkSubsystem::SendSelectCharacter(int64 CharacterId)
 {
 	FSelectCharacterRequest Request;
 	Request.CharacterId = CharacterId;
+	PendingCharacterId = CharacterId;
 	
 	SendPacket(Request);
 	UE_LOG(LogTemp, Log, TEXT("EldaraNetworkSubsystem: Select character request sent (ID: %lld)"), CharacterId);
 }
 
+void UEldaraNetworkSubsystem::SendInterestUpdate(float FullRateRadius, float InterestRadius, TConstArrayView<int64> DormantEntityIds)
+{
+	// Worst case int64 encoding is 9 bytes; stay well under MaxPacketSize
+	constexpr int32 MaxDormantIdsPerPacket = 512;
+	
+	FInterestUpdatePacket Packet;
+	Packet.FullRateRadius = FullRateRadius;
+	Packet.InterestRadius = InterestRadius;
+	Packet.DormantEntityIds.Append(DormantEntityIds.GetData(), FMath::Min(DormantEntityIds.Num(), MaxDormantIdsPerPacket));
+	
+	SendPacket(Packet);
+}
+
 bool UEldaraNetworkSubsystem::IsResponseSuccess(EResponseCode ResponseCode)
 {
 	return ResponseCode == EResponseCode::Success;
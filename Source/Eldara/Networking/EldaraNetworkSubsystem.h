@@ -8,6 +8,8 @@
 #include "NetworkPackets.h"
 #include "PacketSerializer.h"
 #include "PacketDeserializer.h"
+#include "EldaraEntityReplicaStore.h"
+#include "EldaraTrafficQueue.h"
 #include "EldaraNetworkSubsystem.generated.h"
 
 /**
@@ -26,6 +28,16 @@ public:
 	DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnCreateCharacterResponse, FCreateCharacterResponse, Response);
 	DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnSelectCharacterResponse, FSelectCharacterResponse, Response);
 	DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnMovementUpdateResponse, FMovementUpdateResponse, Response);
+	DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnEntitySpawn, FEntitySpawnPacket, Packet);
+	DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnEntityDespawn, int64, EntityId);
+	DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnNPCStateUpdate, FNPCStateUpdatePacket, Packet);
+	DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnAbilityResult, FAbilityResultPacket, Packet);
+	DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnConnectionLost);
+	DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnSessionResumed, FResumeSessionResponse, Response);
+	DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnReconnectFailed, EResponseCode, Result);
+
+	/** Native listeners get the recycled packet by reference; valid only for the call */
+	DECLARE_MULTICAST_DELEGATE_OneParam(FOnEntitySpawnNative, const FEntitySpawnPacket&);
 
 	// Blueprint-assignable events
 	UPROPERTY(BlueprintAssignable, Category = "Eldara|Networking")
@@ -43,6 +55,39 @@ public:
 	UPROPERTY(BlueprintAssignable, Category = "Eldara|Networking")
 	FOnMovementUpdateResponse OnMovementUpdateResponse;
 
+	/** Fired after a remote entity has been added to the replica store */
+	UPROPERTY(BlueprintAssignable, Category = "Eldara|Networking")
+	FOnEntitySpawn OnEntitySpawn;
+
+	/** C++ counterpart of OnEntitySpawn without the per-packet copy a dynamic broadcast makes */
+	FOnEntitySpawnNative OnEntitySpawnNative;
+
+	/** Fired after a remote entity has been removed from the replica store */
+	UPROPERTY(BlueprintAssignable, Category = "Eldara|Networking")
+	FOnEntityDespawn OnEntityDespawn;
+
+	UPROPERTY(BlueprintAssignable, Category = "Eldara|Networking")
+	FOnNPCStateUpdate OnNPCStateUpdate;
+
+	/**
+	 * Server verdict on a socket ability request. InputSequence is the socket request's own
+	 * sequence, not a combat component prediction key; predictions resolve over the RPC path.
+	 */
+	UPROPERTY(BlueprintAssignable, Category = "Eldara|Networking")
+	FOnAbilityResult OnAbilityResult;
+
+	/** Fired when an in-world connection drops and automatic reconnect starts */
+	UPROPERTY(BlueprintAssignable, Category = "Eldara|Networking")
+	FOnConnectionLost OnConnectionLost;
+
+	/** Fired once the server accepted the resume; entity replicas are still valid */
+	UPROPERTY(BlueprintAssignable, Category = "Eldara|Networking")
+	FOnSessionResumed OnSessionResumed;
+
+	/** Fired when the session could not be resumed; the player has to log in again */
+	UPROPERTY(BlueprintAssignable, Category = "Eldara|Networking")
+	FOnReconnectFailed OnReconnectFailed;
+
 	/** Initialize the subsystem */
 	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
 	
@@ -94,9 +139,10 @@ public:
 	/**
 	 * Send character list request to the server
 	 * Requests the list of characters for the current account
+	 * @param bForceRefresh Ignore the list cached for this session and ask the server again
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Eldara|Networking")
-	void SendCharacterListRequest();
+	void SendCharacterListRequest(bool bForceRefresh = false);
 
 	/**
 	 * Send create character request to the server
@@ -117,6 +163,14 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Eldara|Networking")
 	void SendSelectCharacter(int64 CharacterId);
 
+	/**
+	 * Report client-side interest so the server can thin out updates
+	 * @param FullRateRadius Radius (cm) where updates are applied at full rate
+	 * @param InterestRadius Radius (cm) beyond which updates are ignored
+	 * @param DormantEntityIds Entities currently dormant on this client (truncated to fit one packet)
+	 */
+	void SendInterestUpdate(float FullRateRadius, float InterestRadius, TConstArrayView<int64> DormantEntityIds);
+
 	/**
 	 * Send a packet to the server
 	 * Template function for sending typed packets
@@ -156,36 +210,9 @@ public:
 			return;
 		}
 		
-		// Allocate final packet buffer with length prefix + payload in a single allocation
-		TArray<uint8> FinalPacket;
-		FinalPacket.SetNumUninitialized(LengthPrefixSize + PayloadSize);
-		uint8* PacketData = FinalPacket.GetData();
-		
-		// Write 4-byte length prefix as Little Endian bytes
-		PacketData[0] = static_cast<uint8>(PayloadSize & 0xFF);
-		PacketData[1] = static_cast<uint8>((PayloadSize >> 8) & 0xFF);
-		PacketData[2] = static_cast<uint8>((PayloadSize >> 16) & 0xFF);
-		PacketData[3] = static_cast<uint8>((PayloadSize >> 24) & 0xFF);
-		
-		// Copy the serialized payload after the length prefix
-		FMemory::Memcpy(PacketData + LengthPrefixSize, SerializedData.GetData(), PayloadSize);
-		
-		// Send the final packet with length prefix
-		int32 BytesSent = 0;
-		if (!ConnectionSocket->Send(FinalPacket.GetData(), FinalPacket.Num(), BytesSent))
-		{
-			UE_LOG(LogTemp, Error, TEXT("EldaraNetworkSubsystem: Failed to send packet"));
-			return;
-		}
-		
-		if (BytesSent != FinalPacket.Num())
-		{
-			UE_LOG(LogTemp, Warning, TEXT("EldaraNetworkSubsystem: Partial send (%d of %d bytes)"), BytesSent, FinalPacket.Num());
-		}
-		else
-		{
-			UE_LOG(LogTemp, Log, TEXT("EldaraNetworkSubsystem: Successfully sent packet (%d bytes payload, %d bytes total)"), PayloadSize, FinalPacket.Num());
-		}
+		// Queue by traffic class and send whatever this frame's budgets allow right away
+		QueueOutgoing(SerializedData);
+		FlushOutgoing();
 	}
 
 	/**
@@ -210,14 +237,53 @@ public:
 	UFUNCTION(BlueprintPure, Category = "Eldara|Networking")
 	bool IsConnected() const { return bIsConnected; }
 
+	/** True while the subsystem is trying to get a dropped session back */
+	UFUNCTION(BlueprintPure, Category = "Eldara|Networking")
+	bool IsReconnecting() const { return bReconnecting; }
+
+	/** True if a dropped connection can be recovered without logging in again */
+	UFUNCTION(BlueprintPure, Category = "Eldara|Networking")
+	bool HasResumableSession() const { return !SessionToken.IsEmpty() && ActiveCharacterId != 0 && !LastServerIp.IsEmpty(); }
+
+	/**
+	 * Queue wait metrics for one traffic class
+	 * @param Class Traffic class to report
+	 * @param bOutgoing Send queue if true, receive/dispatch queue otherwise
+	 */
+	UFUNCTION(BlueprintPure, Category = "Eldara|Networking")
+	FEldaraTrafficClassStats GetTrafficStats(EEldaraTrafficClass Class, bool bOutgoing) const;
+
+	/** Flat binary codec version negotiated at login (0 = MessagePack only) */
+	UFUNCTION(BlueprintPure, Category = "Eldara|Networking")
+	int32 GetFlatCodecVersion() const { return FlatCodecVersion; }
+
+	/** Replicated state of remote entities (players, NPCs, monsters) in the current zone */
+	const FEldaraEntityReplicaStore& GetEntityReplicas() const { return EntityReplicas; }
+	FEldaraEntityReplicaStore& GetEntityReplicas() { return EntityReplicas; }
+
 private:
+	/** Drives ProcessReceivedData directly to count allocations in the receive path */
+	friend class UEldaraPacketCodecBenchCommandlet;
+	
 	/** Network protocol constants matching C# server NetworkConstants */
 	static constexpr int32 MaxPacketSize = 8192;  // 8KB - C# NetworkConstants.MaxPacketSize
 	static constexpr int32 LengthPrefixSize = 4;  // 4-byte int32 length prefix
+	static constexpr const TCHAR* ProtocolVersion = TEXT("1.0.0");  // C# ProtocolVersions.Current
 	
 	/** Polling interval for checking socket data (60 times per second) */
 	static constexpr float PollInterval = 0.016f;
 	
+	/** Reconnect backoff: first retry after InitialReconnectDelay, doubling up to MaxReconnectDelay */
+	static constexpr float InitialReconnectDelay = 0.5f;
+	static constexpr float MaxReconnectDelay = 8.0f;
+	static constexpr int32 MaxReconnectAttempts = 8;
+	
+	/** Seconds a single non-blocking connect may stay pending before the attempt counts as failed */
+	static constexpr double ConnectAttemptTimeout = 3.0;
+	
+	/** Known entity ids sent with a resume; worst case 9 bytes each keeps the request under MaxPacketSize */
+	static constexpr int32 MaxKnownEntityIds = 700;
+	
 	/** The TCP socket connection to the server */
 	FSocket* ConnectionSocket = nullptr;
 	
@@ -227,21 +293,127 @@ private:
 	/** Timer handle for polling data from the socket */
 	FTimerHandle PollTimerHandle;
 	
+	/** Create the socket, start a non-blocking connect and begin polling */
+	bool OpenSocket(const FString& IpAddress, int32 Port);
+	
+	/** Stop polling and destroy the socket without touching session or replica state */
+	void CloseSocket();
+	
+	/** Drop every replica, broadcasting a despawn for each so actors are released */
+	void ClearEntityReplicas();
+	
+	/** Unexpected loss of the connection: try to resume if we have a session, otherwise disconnect */
+	void HandleConnectionLost();
+	
+	/** Queue the next reconnect attempt with exponential backoff */
+	void ScheduleReconnect();
+	
+	/** Timer callback: open a new socket to the last server */
+	void TryReconnect();
+	
+	/** While reconnecting: wait for the connect to complete, then send the resume request */
+	void PollReconnect();
+	
+	/** Send the single resume request carrying the session token and known replicas */
+	void SendResumeSession();
+	
+	/** Apply a resume result from the server */
+	void HandleResumeSessionResponse(const FResumeSessionResponse& Response);
+	
+	/** Give up on the dropped session and forget it */
+	void FailReconnect(EResponseCode Result);
+	
 	/**
 	 * Check for incoming data on the socket
 	 * Called periodically by a timer
 	 */
 	void CheckForData();
 	
+	/** Apply a movement update from either encoding to the replica store and listeners */
+	void HandleMovementUpdate(const FMovementUpdatePacket& Update);
+	
+	/** Route a payload in the flat binary encoding */
+	void ProcessFlatPacket(const TArray<uint8>& Data);
+	
+	/** Add the length prefix and queue a serialized packet in its traffic class */
+	void QueueOutgoing(const TArray<uint8>& Payload);
+	
+	/** Send queued packets in priority order until budgets run out or the socket would block */
+	void FlushOutgoing();
+	
+	/** Dispatch received packets in priority order within this frame's budgets */
+	void DispatchIncoming();
+	
 	/**
 	 * Process received packet data
-	 * @param Data Raw packet data (without length prefix)
+	 * @param Data Raw packet data (without length prefix); handlers that keep the packet move it out
 	 */
-	void ProcessReceivedData(const TArray<uint8>& Data);
+	void ProcessReceivedData(TArray<uint8>& Data);
+	
+	/** Fill Characters from the lazy views, once; only done when a listener will read them */
+	static void DecodeCharacterSummaries(FCharacterListResponse& Response);
 	
 	/** Buffer for assembling multi-part packets */
 	TArray<uint8> ReceiveBuffer;
 	
+	/** Complete received packets waiting for dispatch, and framed packets waiting to be sent */
+	FEldaraTrafficQueue IncomingTraffic;
+	FEldaraTrafficQueue OutgoingTraffic;
+	
+	/** Unsent tail of a packet the socket only partly accepted; must go out before anything else */
+	TArray<uint8> PartialSend;
+	int32 PartialSendOffset = 0;
+	
+	/** Reused framing buffer for QueueOutgoing */
+	TArray<uint8> FrameBuffer;
+	
+	/** Reused encode buffer for flat MovementInput */
+	TArray<uint8> FlatEncodeBuffer;
+	
+	/** Flat codec version the server accepted; kept across a resumed session */
+	int32 FlatCodecVersion = 0;
+	
+	/** Client-side movement input sequence, echoed by the server in position corrections */
+	int32 MovementInputSequence = 0;
+	
+	/**
+	 * Recycled decode targets for the high-rate world packets. The deserializer overwrites every
+	 * field, so containers (AbilityIds, names) keep their capacity from one packet to the next.
+	 * Handlers must copy anything they keep; the instance is overwritten by the next packet.
+	 */
+	struct FReceivePacketPool
+	{
+		FMovementUpdatePacket MovementUpdate;
+		FMovementUpdateResponse MovementUpdateResponse;
+		FEntitySpawnPacket EntitySpawn;
+		FEntityDespawnPacket EntityDespawn;
+		FNPCStateUpdatePacket NPCStateUpdate;
+		FAbilityResultPacket AbilityResult;
+	};
+	FReceivePacketPool ReceivePackets;
+	
 	/** Expected size of the current packet being received */
 	int32 ExpectedPacketSize = 0;
+	
+	/** Dense store of remote entity state fed by world/movement packets */
+	FEldaraEntityReplicaStore EntityReplicas;
+	
+	/** Session state kept across a dropped connection */
+	FString LastServerIp;
+	int32 LastServerPort = 0;
+	FString SessionToken;
+	int64 AccountId = 0;
+	int64 PendingCharacterId = 0;
+	int64 ActiveCharacterId = 0;
+	
+	/** Reconnect state */
+	bool bReconnecting = false;
+	bool bResumeSent = false;
+	int32 ReconnectAttempt = 0;
+	double ConnectAttemptStartTime = 0.0;
+	FTimerHandle ReconnectTimerHandle;
+	
+	/** Character list for the current account, reused until it is known to be stale */
+	FCharacterListResponse CachedCharacterList;
+	bool bHasCachedCharacterList = false;
 };
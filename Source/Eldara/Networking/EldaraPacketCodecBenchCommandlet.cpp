@@ -0,0 +1,596 @@
+#include "EldaraPacketCodecBenchCommandlet.h"
+#include "EldaraFlatCodec.h"
+#include "EldaraNetworkSubsystem.h"
+#include "EldaraUTF8.h"
+#include "MessagePackFormat.h"
+#include "PacketDeserializer.h"
+#include "PacketSerializer.h"
+#include "Eldara/Core/EldaraBenchmark.h"
+#include "Engine/GameInstance.h"
+#include "HAL/MemoryBase.h"
+#include "HAL/PlatformTLS.h"
+#include "Misc/Parse.h"
+#include "Misc/ScopeExit.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogEldaraPacketCodecBench, Log, All);
+
+namespace
+{
+	constexpr int32 DefaultBenchPackets = 10000;
+	constexpr int32 DefaultBenchRounds = 20;
+
+	/** Distinct payloads cycled through, so the branch predictor cannot learn a single packet */
+	constexpr int32 NumSamplePackets = 64;
+
+	FMovementUpdatePacket MakeSampleUpdate(int32 Index)
+	{
+		FMovementUpdatePacket Update;
+		Update.EntityId = 1000 + Index;
+		Update.Position = FVector(1200.0f + Index * 37.5f, -800.0f + Index * 11.25f, 96.0f);
+		Update.Velocity = FVector(Index % 3 == 0 ? 0.0f : 420.0f, 35.0f * (Index & 7), 0.0f);
+		Update.RotationYaw = (Index * 23) % 360 - 180.0f;
+		Update.RotationPitch = 0.0f;
+		Update.State = static_cast<EMovementState>(Index % 3);
+		Update.ServerTimestamp = 1700000000000LL + Index * 50;
+		return Update;
+	}
+
+	/** Same layout the server's MessagePack serializer writes (see DeserializeMovementUpdate) */
+	void EncodeMessagePack(const FMovementUpdatePacket& Update, TArray<uint8>& OutBytes)
+	{
+		OutBytes.Reset();
+		FPacketSerializer::WriteArrayHeader(OutBytes, 2);
+		FPacketSerializer::WriteInt(OutBytes, static_cast<int32>(EPacketType::MovementUpdate));
+		FPacketSerializer::WriteArrayHeader(OutBytes, 7);
+		FPacketSerializer::WriteInt64(OutBytes, Update.EntityId);
+		FPacketSerializer::WriteArrayHeader(OutBytes, 3);
+		FPacketSerializer::WriteFloat(OutBytes, static_cast<float>(Update.Position.X));
+		FPacketSerializer::WriteFloat(OutBytes, static_cast<float>(Update.Position.Y));
+		FPacketSerializer::WriteFloat(OutBytes, static_cast<float>(Update.Position.Z));
+		FPacketSerializer::WriteArrayHeader(OutBytes, 3);
+		FPacketSerializer::WriteFloat(OutBytes, static_cast<float>(Update.Velocity.X));
+		FPacketSerializer::WriteFloat(OutBytes, static_cast<float>(Update.Velocity.Y));
+		FPacketSerializer::WriteFloat(OutBytes, static_cast<float>(Update.Velocity.Z));
+		FPacketSerializer::WriteFloat(OutBytes, Update.RotationYaw);
+		FPacketSerializer::WriteFloat(OutBytes, Update.RotationPitch);
+		FPacketSerializer::WriteInt(OutBytes, static_cast<int32>(Update.State));
+		FPacketSerializer::WriteInt64(OutBytes, Update.ServerTimestamp);
+	}
+
+	/** Same layout as FlatCodec.Encode(MovementUpdatePacket) on the server */
+	void EncodeFlat(const FMovementUpdatePacket& Update, TArray<uint8>& OutBytes)
+	{
+		EldaraFlatCodec::FHeader Header;
+		Header.Marker = EldaraFlatCodec::Marker;
+		Header.Version = EldaraFlatCodec::Version;
+		Header.PacketType = static_cast<uint16>(EPacketType::MovementUpdate);
+
+		EldaraFlatCodec::FMovementUpdateBody Body;
+		Body.EntityId = static_cast<uint64>(Update.EntityId);
+		Body.Position[0] = static_cast<float>(Update.Position.X);
+		Body.Position[1] = static_cast<float>(Update.Position.Y);
+		Body.Position[2] = static_cast<float>(Update.Position.Z);
+		Body.Velocity[0] = static_cast<float>(Update.Velocity.X);
+		Body.Velocity[1] = static_cast<float>(Update.Velocity.Y);
+		Body.Velocity[2] = static_cast<float>(Update.Velocity.Z);
+		Body.RotationYaw = Update.RotationYaw;
+		Body.RotationPitch = Update.RotationPitch;
+		Body.State = static_cast<uint8>(Update.State);
+		Body.ServerTimestamp = Update.ServerTimestamp;
+
+		OutBytes.SetNumUninitialized(sizeof(Header) + sizeof(Body));
+		FMemory::Memcpy(OutBytes.GetData(), &Header, sizeof(Header));
+		FMemory::Memcpy(OutBytes.GetData() + sizeof(Header), &Body, sizeof(Body));
+	}
+
+	void WriteResourceSnapshot(TArray<uint8>& OutBytes, int32 Health)
+	{
+		FPacketSerializer::WriteArrayHeader(OutBytes, 6);
+		FPacketSerializer::WriteInt(OutBytes, 1000);
+		FPacketSerializer::WriteInt(OutBytes, Health);
+		FPacketSerializer::WriteInt(OutBytes, 200);
+		FPacketSerializer::WriteInt(OutBytes, 150);
+		FPacketSerializer::WriteInt(OutBytes, 100);
+		FPacketSerializer::WriteInt(OutBytes, 100);
+	}
+
+	/** A monster spawn with NPC data, as the server resends it on zone resync (see DeserializeEntitySpawn) */
+	void EncodeEntitySpawn(int32 Index, TArray<uint8>& OutBytes)
+	{
+		const FString Name = FString::Printf(TEXT("Ashen Wolf %d"), Index);
+		const int32 NumAbilities = 1 + Index % 4;
+
+		OutBytes.Reset();
+		FPacketSerializer::WriteArrayHeader(OutBytes, 2);
+		FPacketSerializer::WriteInt(OutBytes, static_cast<int32>(EPacketType::EntitySpawn));
+		FPacketSerializer::WriteArrayHeader(OutBytes, 9);
+		FPacketSerializer::WriteInt64(OutBytes, 1000 + Index);
+		FPacketSerializer::WriteInt(OutBytes, static_cast<int32>(EEntityType::Monster));
+		FPacketSerializer::WriteString(OutBytes, Name);
+		FPacketSerializer::WriteArrayHeader(OutBytes, 3);
+		FPacketSerializer::WriteFloat(OutBytes, 1200.0f + Index * 37.5f);
+		FPacketSerializer::WriteFloat(OutBytes, -800.0f + Index * 11.25f);
+		FPacketSerializer::WriteFloat(OutBytes, 96.0f);
+		FPacketSerializer::WriteFloat(OutBytes, (Index * 23) % 360 - 180.0f);
+		OutBytes.Add(MessagePackFormat::Nil);
+
+		FPacketSerializer::WriteArrayHeader(OutBytes, 11);
+		FPacketSerializer::WriteInt(OutBytes, 300 + Index % 8);
+		FPacketSerializer::WriteString(OutBytes, Name);
+		FPacketSerializer::WriteInt(OutBytes, 10 + Index % 20);
+		FPacketSerializer::WriteInt(OutBytes, 0);
+		FPacketSerializer::WriteBool(OutBytes, true);
+		FPacketSerializer::WriteBool(OutBytes, false);
+		FPacketSerializer::WriteBool(OutBytes, false);
+		FPacketSerializer::WriteInt(OutBytes, 1000);
+		FPacketSerializer::WriteInt(OutBytes, 1000 - Index * 7);
+		WriteResourceSnapshot(OutBytes, 1000 - Index * 7);
+		FPacketSerializer::WriteArrayHeader(OutBytes, NumAbilities);
+		for (int32 Ability = 0; Ability < NumAbilities; ++Ability)
+		{
+			FPacketSerializer::WriteInt(OutBytes, 5000 + Ability);
+		}
+
+		WriteResourceSnapshot(OutBytes, 1000 - Index * 7);
+		OutBytes.Add(MessagePackFormat::Nil);
+	}
+
+	void EncodeNPCStateUpdate(int32 Index, TArray<uint8>& OutBytes)
+	{
+		OutBytes.Reset();
+		FPacketSerializer::WriteArrayHeader(OutBytes, 2);
+		FPacketSerializer::WriteInt(OutBytes, static_cast<int32>(EPacketType::NPCStateUpdate));
+		FPacketSerializer::WriteArrayHeader(OutBytes, 3);
+		FPacketSerializer::WriteInt64(OutBytes, 1000 + Index);
+		FPacketSerializer::WriteInt(OutBytes, Index % 4);
+		if (Index % 2 == 0)
+		{
+			FPacketSerializer::WriteInt64(OutBytes, 1);
+		}
+		else
+		{
+			OutBytes.Add(MessagePackFormat::Nil);
+		}
+	}
+
+	void EncodeAbilityResult(int32 Index, TArray<uint8>& OutBytes)
+	{
+		OutBytes.Reset();
+		FPacketSerializer::WriteArrayHeader(OutBytes, 2);
+		FPacketSerializer::WriteInt(OutBytes, static_cast<int32>(EPacketType::AbilityResult));
+		FPacketSerializer::WriteArrayHeader(OutBytes, 5);
+		FPacketSerializer::WriteInt(OutBytes, Index % 3 == 0 ? 1 : 0);
+		FPacketSerializer::WriteInt64(OutBytes, 1);
+		FPacketSerializer::WriteInt(OutBytes, 5000 + Index % 4);
+		FPacketSerializer::WriteInt(OutBytes, Index);
+		FPacketSerializer::WriteString(OutBytes, Index % 3 == 0 ? TEXT("Target is out of range") : TEXT(""));
+	}
+
+	/**
+	 * Synthetic chat capture as UTF-8: mostly ASCII lines, with accented Latin (2-byte),
+	 * CJK (3-byte) and emoji (4-byte, a surrogate pair in UTF-16) mixed in
+	 */
+	const ANSICHAR* const ChatLines[] =
+	{
+		"[Guild] Thandor: LFG Ashen Caverns, need 1 healer and 1 tank, pst",
+		"[Trade] Mirelle: WTS Frostbound Greaves 45g or best offer",
+		"[Party] Kael: pull the left pack first, cc the caster",
+		"[Guild] \xC3\x89lodie: \xC3\xA0 bient\xC3\xB4t, merci pour l'aide !",
+		"[Say] Old Man Ferrow: The road north is not safe after dark, traveler.",
+		"[Whisper] Brann: omw, 2 min",
+		"[General] \xE5\xB0\x8F\xE9\xBE\x99: \xE6\x9C\x89\xE4\xBA\xBA\xE4\xB8\x80\xE8\xB5\xB7\xE6\x89\x93\xE5\x89\xAF\xE6\x9C\xAC\xE5\x90\x97\xEF\xBC\x9F",
+		"[General] Selwyn: anyone know where the Sunken Shrine quest giver is?",
+		"[Trade] J\xC3\xBCrgen: Verkaufe Eisenerz, 3g pro St\xC3\xBC" "ck",
+		"[Party] Nyx: gg \xF0\x9F\x98\x80 nice pull, ready for the boss?",
+	};
+
+	/** Well-formed UTF-8 at the edges of each sequence length; must round-trip exactly */
+	const ANSICHAR* const ValidCases[] =
+	{
+		"",
+		// 2-byte: U+0080, U+07FF
+		"\xC2\x80 \xDF\xBF",
+		// 3-byte: U+0800, U+20AC, either side of the surrogate gap, U+FFFD
+		"\xE0\xA0\x80 \xE2\x82\xAC \xED\x9F\xBF \xEE\x80\x80 \xEF\xBF\xBD",
+		// 4-byte: U+10000, U+1F600, U+10FFFF
+		"\xF0\x90\x80\x80 \xF0\x9F\x98\x80 \xF4\x8F\xBF\xBF",
+		// Multibyte right after a vector-width ASCII run
+		"0123456789abcdefghijklmnopqrstuvwxyz\xC3\xA9" "0123456789abcdefghijklmnop",
+	};
+
+	/** Malformed UTF-8 the decoder must reject */
+	const ANSICHAR* const InvalidCases[] =
+	{
+		"\xC3", // Truncated 2-byte
+		"\xE2\x82", // Truncated 3-byte
+		"\xF0\x9F\x98", // Truncated 4-byte
+		"0123456789abcdefghijklmnopqrstuvwxyz\xE2\x82", // Truncated after a vector-width ASCII run
+		"\x80", // Stray continuation
+		"a\xBF" "b", // Stray continuation mid-string
+		"\xE2\x28\xA1", // Missing continuation
+		"\xC0\x80", // Overlong NUL
+		"\xC1\xBF", // Overlong 2-byte
+		"\xE0\x80\xAF", // Overlong 3-byte
+		"\xF0\x80\x80\xAF", // Overlong 4-byte
+		"\xED\xA0\x80", // Encoded surrogate
+		"\xF4\x90\x80\x80", // Past U+10FFFF
+		"\xF5\x80\x80\x80", // Invalid lead byte
+		"\xFF", // Invalid lead byte
+	};
+
+	/** What ReadString did before EldaraUTF8 (minus its temporary byte copy) */
+	void DecodeWithEngine(const uint8* Bytes, int32 Length, FString& OutString)
+	{
+		FUTF8ToTCHAR Converter(reinterpret_cast<const ANSICHAR*>(Bytes), Length);
+		OutString = FString(Converter.Length(), Converter.Get());
+	}
+
+	/** What WriteString does: size the payload, then encode straight into the buffer */
+	void EncodeWithEldara(const FString& Value, TArray<uint8>& OutBytes)
+	{
+		const int32 Offset = OutBytes.AddUninitialized(EldaraUTF8::EncodedLength(*Value, Value.Len()));
+		EldaraUTF8::Encode(*Value, Value.Len(), OutBytes.GetData() + Offset);
+	}
+
+	/** Round-trip the valid cases and the chat lines, and reject the malformed ones; logs every failure */
+	bool CheckUTF8Codec()
+	{
+		bool bPassed = true;
+		FString Decoded;
+		FString Expected;
+		TArray<uint8> Encoded;
+
+		auto CheckRoundTrip = [&](const ANSICHAR* Case)
+		{
+			const uint8* Bytes = reinterpret_cast<const uint8*>(Case);
+			const int32 Length = FCStringAnsi::Strlen(Case);
+			DecodeWithEngine(Bytes, Length, Expected);
+
+			Encoded.Reset();
+			const bool bDecoded = EldaraUTF8::Decode(Bytes, Length, Decoded);
+			if (bDecoded)
+			{
+				EncodeWithEldara(Decoded, Encoded);
+			}
+			if (!bDecoded || !Decoded.Equals(Expected, ESearchCase::CaseSensitive) ||
+				Encoded.Num() != Length || (Length > 0 && FMemory::Memcmp(Encoded.GetData(), Bytes, Length) != 0))
+			{
+				UE_LOG(LogEldaraPacketCodecBench, Error, TEXT("Round trip failed for %s"), *BytesToHex(Bytes, Length));
+				bPassed = false;
+			}
+		};
+
+		for (const ANSICHAR* Case : ValidCases)
+		{
+			CheckRoundTrip(Case);
+		}
+		for (const ANSICHAR* Line : ChatLines)
+		{
+			CheckRoundTrip(Line);
+		}
+
+		for (const ANSICHAR* Case : InvalidCases)
+		{
+			const uint8* Bytes = reinterpret_cast<const uint8*>(Case);
+			const int32 Length = FCStringAnsi::Strlen(Case);
+			Decoded = TEXT("stale");
+			if (EldaraUTF8::Decode(Bytes, Length, Decoded) || !Decoded.IsEmpty())
+			{
+				UE_LOG(LogEldaraPacketCodecBench, Error, TEXT("Malformed input accepted: %s"), *BytesToHex(Bytes, Length));
+				bPassed = false;
+			}
+		}
+
+		// An unpaired surrogate cannot be encoded; it is written as U+FFFD
+		if constexpr (sizeof(TCHAR) == 2)
+		{
+			const TCHAR LoneSurrogate[] = { static_cast<TCHAR>(0xD83D), TEXT('a') };
+			const uint8 Replacement[] = { 0xEF, 0xBF, 0xBD, 'a' };
+			constexpr int32 NumChars = UE_ARRAY_COUNT(LoneSurrogate);
+			constexpr int32 ExpectedLength = UE_ARRAY_COUNT(Replacement);
+			uint8 Buffer[8];
+			const int32 Length = EldaraUTF8::Encode(LoneSurrogate, NumChars, Buffer);
+			if (Length != ExpectedLength || EldaraUTF8::EncodedLength(LoneSurrogate, NumChars) != ExpectedLength ||
+				FMemory::Memcmp(Buffer, Replacement, ExpectedLength) != 0)
+			{
+				UE_LOG(LogEldaraPacketCodecBench, Error, TEXT("Unpaired surrogate was not encoded as U+FFFD"));
+				bPassed = false;
+			}
+		}
+
+		return bPassed;
+	}
+
+	/**
+	 * Routes GMalloc through itself while in scope and counts the allocations made by the
+	 * thread that created it. Everything is forwarded, so blocks may cross the swap either way.
+	 */
+	class FScopedAllocationCounter final : public FMalloc
+	{
+	public:
+		FScopedAllocationCounter()
+			: Inner(GMalloc)
+			, CountedThreadId(FPlatformTLS::GetCurrentThreadId())
+		{
+			GMalloc = this;
+		}
+
+		virtual ~FScopedAllocationCounter() override
+		{
+			GMalloc = Inner;
+		}
+
+		int64 GetNumAllocations() const { return NumAllocations; }
+
+		virtual void* Malloc(SIZE_T Size, uint32 Alignment) override
+		{
+			CountAllocation();
+			return Inner->Malloc(Size, Alignment);
+		}
+
+		virtual void* Realloc(void* Original, SIZE_T Size, uint32 Alignment) override
+		{
+			if (Size > 0)
+			{
+				CountAllocation();
+			}
+			return Inner->Realloc(Original, Size, Alignment);
+		}
+
+		virtual void Free(void* Original) override { Inner->Free(Original); }
+		virtual SIZE_T QuantizeSize(SIZE_T Size, uint32 Alignment) override { return Inner->QuantizeSize(Size, Alignment); }
+		virtual bool GetAllocationSize(void* Original, SIZE_T& SizeOut) override { return Inner->GetAllocationSize(Original, SizeOut); }
+		virtual bool IsInternallyThreadSafe() const override { return Inner->IsInternallyThreadSafe(); }
+		virtual const TCHAR* GetDescriptiveName() override { return TEXT("EldaraAllocationCounter"); }
+
+	private:
+		void CountAllocation()
+		{
+			if (FPlatformTLS::GetCurrentThreadId() == CountedThreadId)
+			{
+				++NumAllocations;
+			}
+		}
+
+		FMalloc* Inner;
+		uint32 CountedThreadId;
+		int64 NumAllocations = 0;
+	};
+}
+
+UEldaraPacketCodecBenchCommandlet::UEldaraPacketCodecBenchCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = false;
+	LogToConsole = true;
+}
+
+int32 UEldaraPacketCodecBenchCommandlet::Main(const FString& Params)
+{
+	if (FParse::Param(*Params, TEXT("ReceiveAllocs")))
+	{
+		return RunReceiveAllocCheck(Params);
+	}
+
+	if (FParse::Param(*Params, TEXT("UTF8Bench")))
+	{
+		return RunUTF8Bench(Params);
+	}
+
+	return RunMovementDecodeBench(Params);
+}
+
+int32 UEldaraPacketCodecBenchCommandlet::RunMovementDecodeBench(const FString& Params)
+{
+	int32 NumPackets = DefaultBenchPackets;
+	int32 NumRounds = DefaultBenchRounds;
+	FParse::Value(*Params, TEXT("Packets="), NumPackets);
+	FParse::Value(*Params, TEXT("Rounds="), NumRounds);
+	NumPackets = FMath::Max(1, NumPackets);
+	NumRounds = FMath::Max(1, NumRounds);
+
+	TArray<TArray<uint8>> MessagePackPayloads;
+	TArray<TArray<uint8>> FlatPayloads;
+	MessagePackPayloads.SetNum(NumSamplePackets);
+	FlatPayloads.SetNum(NumSamplePackets);
+	int64 MessagePackBytes = 0;
+	int64 FlatBytes = 0;
+	for (int32 Index = 0; Index < NumSamplePackets; ++Index)
+	{
+		const FMovementUpdatePacket Update = MakeSampleUpdate(Index);
+		EncodeMessagePack(Update, MessagePackPayloads[Index]);
+		EncodeFlat(Update, FlatPayloads[Index]);
+		MessagePackBytes += MessagePackPayloads[Index].Num();
+		FlatBytes += FlatPayloads[Index].Num();
+	}
+
+	// Decode into one recycled packet, as the network subsystem does
+	FMovementUpdatePacket Decoded;
+	int64 Checksum = 0;
+
+	auto TimeDecode = [&](auto&& Decode, const TArray<TArray<uint8>>& Payloads)
+	{
+		return EldaraBenchmark::TimeBestOf(NumRounds, [&]()
+		{
+			for (int32 Packet = 0; Packet < NumPackets; ++Packet)
+			{
+				if (Decode(Payloads[Packet % NumSamplePackets], Decoded))
+				{
+					Checksum += Decoded.EntityId;
+				}
+			}
+		});
+	};
+
+	const double MessagePackSeconds = TimeDecode(&FPacketDeserializer::DeserializeMovementUpdate, MessagePackPayloads);
+	const double FlatSeconds = TimeDecode(&EldaraFlatCodec::DecodeMovementUpdate, FlatPayloads);
+	const double PacketsScale = 10000.0 / NumPackets;
+
+	UE_LOG(LogEldaraPacketCodecBench, Display, TEXT("MovementUpdate decode per 10k packets (best of %d rounds of %d):"), NumRounds, NumPackets);
+	UE_LOG(LogEldaraPacketCodecBench, Display, TEXT("  MessagePack: %.3f ms, %.1f bytes/packet"),
+		MessagePackSeconds * PacketsScale * 1000.0, static_cast<double>(MessagePackBytes) / NumSamplePackets);
+	UE_LOG(LogEldaraPacketCodecBench, Display, TEXT("  flat:        %.3f ms, %.1f bytes/packet (%.1fx faster)"),
+		FlatSeconds * PacketsScale * 1000.0, static_cast<double>(FlatBytes) / NumSamplePackets,
+		MessagePackSeconds / FMath::Max(FlatSeconds, UE_SMALL_NUMBER));
+	UE_LOG(LogEldaraPacketCodecBench, Verbose, TEXT("Checksum %lld"), Checksum);
+	return 0;
+}
+
+int32 UEldaraPacketCodecBenchCommandlet::RunReceiveAllocCheck(const FString& Params)
+{
+	int32 NumPackets = DefaultBenchPackets;
+	FParse::Value(*Params, TEXT("Packets="), NumPackets);
+	NumPackets = FMath::Max(1, NumPackets);
+
+	// Interleaved world traffic for NumSamplePackets entities, which the spawns keep resyncing
+	TArray<TArray<uint8>> Payloads;
+	Payloads.SetNum(NumSamplePackets * 5);
+	for (int32 Index = 0; Index < NumSamplePackets; ++Index)
+	{
+		const FMovementUpdatePacket Update = MakeSampleUpdate(Index);
+		TArray<uint8>* Sample = &Payloads[Index * 5];
+		EncodeEntitySpawn(Index, Sample[0]);
+		EncodeMessagePack(Update, Sample[1]);
+		EncodeFlat(Update, Sample[2]);
+		EncodeNPCStateUpdate(Index, Sample[3]);
+		EncodeAbilityResult(Index, Sample[4]);
+	}
+
+	UGameInstance* GameInstance = NewObject<UGameInstance>(GetTransientPackage());
+	UEldaraNetworkSubsystem* Network = NewObject<UEldaraNetworkSubsystem>(GameInstance);
+
+	// A native spawn listener, as the entity spawn subsystem registers one in game
+	int32 NumSpawns = 0;
+	const FDelegateHandle SpawnHandle = Network->OnEntitySpawnNative.AddLambda([&NumSpawns](const FEntitySpawnPacket& Packet)
+	{
+		NumSpawns += Packet.bHasNPCData ? 1 : 0;
+	});
+	ON_SCOPE_EXIT
+	{
+		Network->OnEntitySpawnNative.Remove(SpawnHandle);
+	};
+
+	// Warm-up: creates the replica rows and grows the recycled packets to their largest payloads
+	for (TArray<uint8>& Payload : Payloads)
+	{
+		Network->ProcessReceivedData(Payload);
+	}
+
+	if (Network->GetEntityReplicas().Num() != NumSamplePackets || NumSpawns != NumSamplePackets)
+	{
+		UE_LOG(LogEldaraPacketCodecBench, Error, TEXT("Sample traffic did not decode: %d replicas, %d spawns (expected %d)"),
+			Network->GetEntityReplicas().Num(), NumSpawns, NumSamplePackets);
+		return 1;
+	}
+
+	int64 NumAllocations = 0;
+	{
+		FScopedAllocationCounter Counter;
+		for (int32 Packet = 0; Packet < NumPackets; ++Packet)
+		{
+			Network->ProcessReceivedData(Payloads[Packet % Payloads.Num()]);
+		}
+		NumAllocations = Counter.GetNumAllocations();
+	}
+
+	UE_LOG(LogEldaraPacketCodecBench, Display, TEXT("Receive dispatch of %d packets after warm-up: %lld heap allocations"),
+		NumPackets, NumAllocations);
+	if (NumAllocations > 0)
+	{
+		UE_LOG(LogEldaraPacketCodecBench, Error, TEXT("Steady-state receive path allocated; expected none"));
+		return 1;
+	}
+	return 0;
+}
+
+int32 UEldaraPacketCodecBenchCommandlet::RunUTF8Bench(const FString& Params)
+{
+	if (!CheckUTF8Codec())
+	{
+		return 1;
+	}
+	UE_LOG(LogEldaraPacketCodecBench, Display, TEXT("UTF-8 round trips and malformed-input checks passed"));
+
+	int32 NumStrings = DefaultBenchPackets;
+	int32 NumRounds = DefaultBenchRounds;
+	FParse::Value(*Params, TEXT("Strings="), NumStrings);
+	FParse::Value(*Params, TEXT("Rounds="), NumRounds);
+	NumStrings = FMath::Max(1, NumStrings);
+	NumRounds = FMath::Max(1, NumRounds);
+
+	constexpr int32 NumLines = UE_ARRAY_COUNT(ChatLines);
+	TArray<FString> Lines;
+	Lines.SetNum(NumLines);
+	int64 TotalBytes = 0;
+	for (int32 Index = 0; Index < NumLines; ++Index)
+	{
+		const int32 Length = FCStringAnsi::Strlen(ChatLines[Index]);
+		DecodeWithEngine(reinterpret_cast<const uint8*>(ChatLines[Index]), Length, Lines[Index]);
+	}
+	for (int32 Index = 0; Index < NumStrings; ++Index)
+	{
+		TotalBytes += FCStringAnsi::Strlen(ChatLines[Index % NumLines]);
+	}
+
+	// Decode into one recycled string and encode into one recycled buffer, as the packet paths do
+	FString Decoded;
+	TArray<uint8> Encoded;
+	int64 Checksum = 0;
+
+	auto TimeDecode = [&](auto&& Decode)
+	{
+		return EldaraBenchmark::TimeBestOf(NumRounds, [&]()
+		{
+			for (int32 Index = 0; Index < NumStrings; ++Index)
+			{
+				const ANSICHAR* Line = ChatLines[Index % NumLines];
+				Decode(reinterpret_cast<const uint8*>(Line), FCStringAnsi::Strlen(Line), Decoded);
+				Checksum += Decoded.Len();
+			}
+		});
+	};
+
+	auto TimeEncode = [&](auto&& Encode)
+	{
+		return EldaraBenchmark::TimeBestOf(NumRounds, [&]()
+		{
+			for (int32 Index = 0; Index < NumStrings; ++Index)
+			{
+				Encoded.Reset();
+				Encode(Lines[Index % NumLines], Encoded);
+				Checksum += Encoded.Num();
+			}
+		});
+	};
+
+	const double EngineDecodeSeconds = TimeDecode(&DecodeWithEngine);
+	const double EldaraDecodeSeconds = TimeDecode([](const uint8* Bytes, int32 Length, FString& OutString)
+	{
+		EldaraUTF8::Decode(Bytes, Length, OutString);
+	});
+
+	// What WriteString did before EldaraUTF8, with a bulk append instead of its byte-by-byte loop
+	const double EngineEncodeSeconds = TimeEncode([](const FString& Value, TArray<uint8>& OutBytes)
+	{
+		FTCHARToUTF8 Converter(*Value, Value.Len());
+		OutBytes.Append(reinterpret_cast<const uint8*>(Converter.Get()), Converter.Length());
+	});
+	const double EldaraEncodeSeconds = TimeEncode(&EncodeWithEldara);
+
+	const double StringsScale = 10000.0 / NumStrings;
+	auto LogResult = [&](const TCHAR* Label, double EngineSeconds, double EldaraSeconds)
+	{
+		UE_LOG(LogEldaraPacketCodecBench, Display, TEXT("  %s: engine %.3f ms, EldaraUTF8 %.3f ms (%.1fx faster, %.0f MB/s)"),
+			Label, EngineSeconds * StringsScale * 1000.0, EldaraSeconds * StringsScale * 1000.0,
+			EngineSeconds / FMath::Max(EldaraSeconds, UE_SMALL_NUMBER),
+			TotalBytes / FMath::Max(EldaraSeconds, UE_SMALL_NUMBER) / (1024.0 * 1024.0));
+	};
+
+	UE_LOG(LogEldaraPacketCodecBench, Display, TEXT("Chat text per 10k strings, %.1f UTF-8 bytes each (best of %d rounds of %d):"),
+		static_cast<double>(TotalBytes) / NumStrings, NumRounds, NumStrings);
+	LogResult(TEXT("decode"), EngineDecodeSeconds, EldaraDecodeSeconds);
+	LogResult(TEXT("encode"), EngineEncodeSeconds, EldaraEncodeSeconds);
+	UE_LOG(LogEldaraPacketCodecBench, Verbose, TEXT("Checksum %lld"), Checksum);
+	return 0;
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "EldaraPacketCodecBenchCommandlet.generated.h"
+
+/**
+ * Times client-side decoding of the tick-rate MovementUpdate packet in both wire encodings:
+ * the MessagePack deserializer against the flat codec. Used to justify which packets belong
+ * in the flat set.
+ *
+ * UnrealEditor-Cmd Eldara.uproject -run=EldaraPacketCodecBench [-Packets=10000 -Rounds=20]
+ *
+ * -ReceiveAllocs [-Packets=10000] instead feeds steady-state world traffic (movement updates in
+ * both encodings, resync spawns, NPC state changes and ability results) through the network
+ * subsystem's receive dispatch and counts heap allocations on the game thread. Any allocation
+ * after the warm-up pass fails the run.
+ *
+ * -UTF8Bench [-Strings=10000 -Rounds=20] instead checks EldaraUTF8 against the engine converters
+ * (multibyte round trips, rejection of truncated and invalid sequences) and then times decoding
+ * and encoding of chat-heavy text against FUTF8ToTCHAR and FTCHARToUTF8. A failed check fails
+ * the run before anything is timed.
+ */
+UCLASS()
+class UEldaraPacketCodecBenchCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UEldaraPacketCodecBenchCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+
+private:
+	/** Time MovementUpdate decoding in both encodings; returns the exit code */
+	int32 RunMovementDecodeBench(const FString& Params);
+
+	/** Count heap allocations in steady-state receive dispatch; returns the exit code */
+	int32 RunReceiveAllocCheck(const FString& Params);
+
+	/** Check EldaraUTF8 and time it against the engine converters; returns the exit code */
+	int32 RunUTF8Bench(const FString& Params);
+};
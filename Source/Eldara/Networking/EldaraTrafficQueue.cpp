@@ -0,0 +1,167 @@
+#include "EldaraTrafficQueue.h"
+#include "MessagePackFormat.h"
+#include "EldaraFlatCodec.h"
+
+namespace
+{
+	constexpr int32 InitialRingSize = 8;
+}
+
+EEldaraTrafficClass FEldaraTrafficQueue::Classify(EPacketType PacketType)
+{
+	switch (PacketType)
+	{
+		case EPacketType::MovementInput:
+		case EPacketType::MovementUpdate:
+		case EPacketType::PositionCorrection:
+		case EPacketType::MovementSync:
+		case EPacketType::EntitySpawn:
+		case EPacketType::EntityDespawn:
+		case EPacketType::EntityUpdate:
+		case EPacketType::NPCStateUpdate:
+		case EPacketType::InterestUpdate:
+			return EEldaraTrafficClass::Movement;
+
+		case EPacketType::UseAbilityRequest:
+		case EPacketType::AbilityResult:
+		case EPacketType::Damage:
+		case EPacketType::Healing:
+		case EPacketType::StatusEffect:
+		case EPacketType::ThreatUpdate:
+		case EPacketType::CombatEvent:
+			return EEldaraTrafficClass::Combat;
+
+		case EPacketType::ChatMessage:
+		case EPacketType::QuestDialogueRequest:
+		case EPacketType::QuestDialogueResponse:
+			return EEldaraTrafficClass::Chat;
+
+		case EPacketType::QuestLogSnapshot:
+		case EPacketType::QuestAcceptRequest:
+		case EPacketType::QuestAcceptResponse:
+		case EPacketType::QuestProgressUpdate:
+			return EEldaraTrafficClass::World;
+
+		default:
+			// Auth, character management, enter/leave world and player spawn
+			return EEldaraTrafficClass::Control;
+	}
+}
+
+EEldaraTrafficClass FEldaraTrafficQueue::ClassifyPayload(const uint8* Data, int32 Num)
+{
+	if (EldaraFlatCodec::IsFlatPayload(Data, Num))
+	{
+		return Classify(EldaraFlatCodec::GetPacketType(Data));
+	}
+
+	// Packet: [ UnionKey, [ Fields... ] ] - the key is a positive fixint, uint8 or uint16
+	if (Num < 2 || Data[0] != (MessagePackFormat::FixArrayMask | 2))
+	{
+		return EEldaraTrafficClass::Control;
+	}
+
+	const uint8 KeyByte = Data[1];
+	if (KeyByte <= MessagePackFormat::FixIntMax)
+	{
+		return Classify(static_cast<EPacketType>(KeyByte));
+	}
+	if (KeyByte == MessagePackFormat::Uint8 && Num >= 3)
+	{
+		return Classify(static_cast<EPacketType>(Data[2]));
+	}
+	if (KeyByte == MessagePackFormat::Uint16 && Num >= 4)
+	{
+		return Classify(static_cast<EPacketType>((Data[2] << 8) | Data[3]));
+	}
+	return EEldaraTrafficClass::Control;
+}
+
+void FEldaraTrafficQueue::SetBudget(EEldaraTrafficClass Class, int32 MaxPacketsPerFrame)
+{
+	FClassQueue& Queue = Queues[static_cast<int32>(Class)];
+	Queue.Budget = FMath::Max(0, MaxPacketsPerFrame);
+	Queue.RemainingBudget = Queue.Budget;
+}
+
+void FEldaraTrafficQueue::RefillBudgets()
+{
+	for (FClassQueue& Queue : Queues)
+	{
+		Queue.RemainingBudget = Queue.Budget;
+	}
+}
+
+void FEldaraTrafficQueue::Enqueue(EEldaraTrafficClass Class, const uint8* Data, int32 Num, double Now)
+{
+	FClassQueue& Queue = Queues[static_cast<int32>(Class)];
+
+	if (Queue.Count == Queue.Entries.Num())
+	{
+		// Full: unroll the ring into a larger array so Head is back at 0
+		const int32 OldSize = Queue.Entries.Num();
+		TArray<FEntry> Grown;
+		Grown.SetNum(FMath::Max(InitialRingSize, OldSize * 2));
+		for (int32 Index = 0; Index < OldSize; ++Index)
+		{
+			Grown[Index] = MoveTemp(Queue.Entries[(Queue.Head + Index) % OldSize]);
+		}
+		Queue.Entries = MoveTemp(Grown);
+		Queue.Head = 0;
+	}
+
+	FEntry& Entry = Queue.Entries[(Queue.Head + Queue.Count) % Queue.Entries.Num()];
+	Entry.Payload.Reset();
+	Entry.Payload.Append(Data, Num);
+	Entry.EnqueueTime = Now;
+
+	++Queue.Count;
+	Queue.PeakCount = FMath::Max(Queue.PeakCount, Queue.Count);
+}
+
+void FEldaraTrafficQueue::PopFront(FClassQueue& Queue, double Now)
+{
+	const double WaitSeconds = FMath::Max(0.0, Now - Queue.Entries[Queue.Head].EnqueueTime);
+	Queue.TotalWaitSeconds += WaitSeconds;
+	Queue.MaxWaitSeconds = FMath::Max(Queue.MaxWaitSeconds, WaitSeconds);
+	++Queue.Dispatched;
+
+	Queue.Head = (Queue.Head + 1) % Queue.Entries.Num();
+	--Queue.Count;
+	--Queue.RemainingBudget;
+}
+
+bool FEldaraTrafficQueue::IsEmpty() const
+{
+	for (const FClassQueue& Queue : Queues)
+	{
+		if (Queue.Count > 0)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+void FEldaraTrafficQueue::Reset()
+{
+	for (FClassQueue& Queue : Queues)
+	{
+		Queue.Head = 0;
+		Queue.Count = 0;
+	}
+	++ResetSerial;
+}
+
+FEldaraTrafficClassStats FEldaraTrafficQueue::GetStats(EEldaraTrafficClass Class) const
+{
+	const FClassQueue& Queue = Queues[static_cast<int32>(Class)];
+
+	FEldaraTrafficClassStats Stats;
+	Stats.QueuedPackets = Queue.Count;
+	Stats.PeakQueuedPackets = Queue.PeakCount;
+	Stats.DispatchedPackets = Queue.Dispatched;
+	Stats.AverageWaitMs = Queue.Dispatched > 0 ? static_cast<float>(Queue.TotalWaitSeconds * 1000.0 / Queue.Dispatched) : 0.0f;
+	Stats.MaxWaitMs = static_cast<float>(Queue.MaxWaitSeconds * 1000.0);
+	return Stats;
+}
@@ -0,0 +1,151 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "NetworkTypes.h"
+#include "EldaraTrafficQueue.generated.h"
+
+/** Traffic classes in dispatch priority order (highest first) */
+UENUM(BlueprintType)
+enum class EEldaraTrafficClass : uint8
+{
+	/** Login, session resume, character select, zone transitions; ordering-critical and rare */
+	Control,
+	Combat,
+	/**
+	 * Movement plus entity spawn/despawn and per-entity state. Updates for an entity the
+	 * replica store has not spawned are dropped, so they must share the spawn's queue.
+	 */
+	Movement,
+	/** Quest state: the quest log snapshot shares this queue so it never lands after newer progress */
+	World,
+	/** Chat and quest dialogue */
+	Chat,
+	/** Large snapshots with no ordering dependency on other classes; none at present */
+	Bulk,
+	Count UMETA(Hidden)
+};
+
+/** Queue wait metrics for one traffic class */
+USTRUCT(BlueprintType)
+struct FEldaraTrafficClassStats
+{
+	GENERATED_BODY()
+
+	/** Packets waiting right now */
+	UPROPERTY(BlueprintReadOnly, Category = "Network")
+	int32 QueuedPackets = 0;
+
+	/** Highest queue depth seen */
+	UPROPERTY(BlueprintReadOnly, Category = "Network")
+	int32 PeakQueuedPackets = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Network")
+	int64 DispatchedPackets = 0;
+
+	/** Average time between enqueue and dispatch */
+	UPROPERTY(BlueprintReadOnly, Category = "Network")
+	float AverageWaitMs = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Network")
+	float MaxWaitMs = 0.0f;
+};
+
+/**
+ * Per-traffic-class packet queues for one direction of the connection.
+ *
+ * Each class has its own FIFO and a per-frame packet budget; Drain walks the classes in
+ * priority order and stops a class when its budget for the frame is spent, so a chat burst
+ * or a bulk snapshot spills into later frames instead of delaying combat and movement.
+ * Order is preserved within a class, not across classes, so packets that depend on each
+ * other must be classified together.
+ *
+ * Queues are rings of reusable payload buffers: once warmed up, Enqueue copies into an
+ * existing allocation. Not thread-safe; the network subsystem drives both directions from
+ * the game thread.
+ */
+class ELDARA_API FEldaraTrafficQueue
+{
+public:
+	static constexpr int32 NumClasses = static_cast<int32>(EEldaraTrafficClass::Count);
+
+	/** Traffic class a packet type travels in */
+	static EEldaraTrafficClass Classify(EPacketType PacketType);
+
+	/** Classify a serialized packet by peeking its union key; unparseable payloads count as Control */
+	static EEldaraTrafficClass ClassifyPayload(const uint8* Data, int32 Num);
+
+	/** Packets a class may dispatch per frame; 0 means unlimited */
+	void SetBudget(EEldaraTrafficClass Class, int32 MaxPacketsPerFrame);
+
+	/** Start a new frame: every class gets its full budget again */
+	void RefillBudgets();
+
+	/** Copy a packet payload into its class queue */
+	void Enqueue(EEldaraTrafficClass Class, const uint8* Data, int32 Num, double Now);
+
+	/**
+	 * Hand queued payloads to Consumer in priority order within this frame's budgets.
+	 * Consumer returns false to leave the packet queued and stop draining (e.g. the socket
+	 * would block). Consumer may move the payload out to keep it; the slot allocates again
+	 * on its next Enqueue. Consumer may Reset the queue but must not Enqueue into it.
+	 */
+	template<typename ConsumerType>
+	void Drain(double Now, ConsumerType&& Consumer)
+	{
+		const uint32 DrainSerial = ResetSerial;
+		for (FClassQueue& Queue : Queues)
+		{
+			while (Queue.Count > 0 && (Queue.Budget == 0 || Queue.RemainingBudget > 0))
+			{
+				if (!Consumer(Queue.Entries[Queue.Head].Payload))
+				{
+					return;
+				}
+
+				if (ResetSerial != DrainSerial)
+				{
+					return;
+				}
+
+				PopFront(Queue, Now);
+			}
+		}
+	}
+
+	bool IsEmpty() const;
+
+	/** Drop every queued packet; buffers keep their capacity */
+	void Reset();
+
+	FEldaraTrafficClassStats GetStats(EEldaraTrafficClass Class) const;
+
+private:
+	struct FEntry
+	{
+		TArray<uint8> Payload;
+		double EnqueueTime = 0.0;
+	};
+
+	struct FClassQueue
+	{
+		/** Ring buffer; grows by doubling, never shrinks */
+		TArray<FEntry> Entries;
+		int32 Head = 0;
+		int32 Count = 0;
+
+		int32 Budget = 0;
+		int32 RemainingBudget = 0;
+
+		int32 PeakCount = 0;
+		int64 Dispatched = 0;
+		double TotalWaitSeconds = 0.0;
+		double MaxWaitSeconds = 0.0;
+	};
+
+	void PopFront(FClassQueue& Queue, double Now);
+
+	FClassQueue Queues[NumClasses];
+
+	/** Bumped by Reset so an in-progress Drain notices the queues were cleared under it */
+	uint32 ResetSerial = 0;
+};
@@ -0,0 +1,377 @@
+#include "EldaraUTF8.h"
+
+#if PLATFORM_ENABLE_VECTORINTRINSICS_NEON
+	#include <arm_neon.h>
+	#define ELDARA_UTF8_NEON 1
+	#define ELDARA_UTF8_SSE2 0
+#elif PLATFORM_ENABLE_VECTORINTRINSICS && PLATFORM_CPU_X86_FAMILY
+	#include <emmintrin.h>
+	#define ELDARA_UTF8_NEON 0
+	#define ELDARA_UTF8_SSE2 1
+#else
+	#define ELDARA_UTF8_NEON 0
+	#define ELDARA_UTF8_SSE2 0
+#endif
+
+namespace
+{
+	constexpr uint32 ReplacementChar = 0xFFFD;
+	constexpr uint32 MaxCodePoint = 0x10FFFF;
+
+	/** The vector paths assume 16-bit TCHAR; other platforms use the scalar loops only */
+	constexpr bool bVectorizeTCHAR = (ELDARA_UTF8_SSE2 || ELDARA_UTF8_NEON) && sizeof(TCHAR) == 2;
+
+	FORCEINLINE bool IsHighSurrogate(uint32 Char) { return Char >= 0xD800 && Char <= 0xDBFF; }
+	FORCEINLINE bool IsLowSurrogate(uint32 Char) { return Char >= 0xDC00 && Char <= 0xDFFF; }
+
+	/**
+	 * Widen a run of ASCII bytes to TCHAR. Stops at the first non-ASCII byte.
+	 * @return Number of bytes consumed
+	 */
+	FORCEINLINE int32 WidenASCII(const uint8* Src, int32 Count, TCHAR* Dest)
+	{
+		int32 Index = 0;
+
+		if constexpr (bVectorizeTCHAR)
+		{
+#if ELDARA_UTF8_SSE2
+			const __m128i Zero = _mm_setzero_si128();
+			for (; Index + 32 <= Count; Index += 32)
+			{
+				const __m128i Block0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Src + Index));
+				const __m128i Block1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Src + Index + 16));
+				if (_mm_movemask_epi8(_mm_or_si128(Block0, Block1)) != 0)
+				{
+					break;
+				}
+
+				__m128i* Out = reinterpret_cast<__m128i*>(Dest + Index);
+				_mm_storeu_si128(Out + 0, _mm_unpacklo_epi8(Block0, Zero));
+				_mm_storeu_si128(Out + 1, _mm_unpackhi_epi8(Block0, Zero));
+				_mm_storeu_si128(Out + 2, _mm_unpacklo_epi8(Block1, Zero));
+				_mm_storeu_si128(Out + 3, _mm_unpackhi_epi8(Block1, Zero));
+			}
+			if (Index + 16 <= Count)
+			{
+				const __m128i Block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Src + Index));
+				if (_mm_movemask_epi8(Block) == 0)
+				{
+					__m128i* Out = reinterpret_cast<__m128i*>(Dest + Index);
+					_mm_storeu_si128(Out + 0, _mm_unpacklo_epi8(Block, Zero));
+					_mm_storeu_si128(Out + 1, _mm_unpackhi_epi8(Block, Zero));
+					Index += 16;
+				}
+			}
+#elif ELDARA_UTF8_NEON
+			for (; Index + 32 <= Count; Index += 32)
+			{
+				const uint8x16_t Block0 = vld1q_u8(Src + Index);
+				const uint8x16_t Block1 = vld1q_u8(Src + Index + 16);
+				if (vmaxvq_u8(vorrq_u8(Block0, Block1)) >= 0x80)
+				{
+					break;
+				}
+
+				uint16* Out = reinterpret_cast<uint16*>(Dest + Index);
+				vst1q_u16(Out + 0, vmovl_u8(vget_low_u8(Block0)));
+				vst1q_u16(Out + 8, vmovl_u8(vget_high_u8(Block0)));
+				vst1q_u16(Out + 16, vmovl_u8(vget_low_u8(Block1)));
+				vst1q_u16(Out + 24, vmovl_u8(vget_high_u8(Block1)));
+			}
+			if (Index + 16 <= Count)
+			{
+				const uint8x16_t Block = vld1q_u8(Src + Index);
+				if (vmaxvq_u8(Block) < 0x80)
+				{
+					uint16* Out = reinterpret_cast<uint16*>(Dest + Index);
+					vst1q_u16(Out + 0, vmovl_u8(vget_low_u8(Block)));
+					vst1q_u16(Out + 8, vmovl_u8(vget_high_u8(Block)));
+					Index += 16;
+				}
+			}
+#endif
+		}
+
+		for (; Index < Count && Src[Index] < 0x80; ++Index)
+		{
+			Dest[Index] = static_cast<TCHAR>(Src[Index]);
+		}
+		return Index;
+	}
+
+	/**
+	 * Length of the ASCII prefix of Chars, in whole 16-character blocks
+	 */
+	FORCEINLINE int32 CountASCIIBlocks(const TCHAR* Chars, int32 Count)
+	{
+		int32 Index = 0;
+
+		if constexpr (bVectorizeTCHAR)
+		{
+#if ELDARA_UTF8_SSE2
+			const __m128i NonASCIIMask = _mm_set1_epi16(static_cast<int16>(0xFF80));
+			const __m128i Zero = _mm_setzero_si128();
+			for (; Index + 16 <= Count; Index += 16)
+			{
+				const __m128i Block0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Chars + Index));
+				const __m128i Block1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Chars + Index + 8));
+				const __m128i HighBits = _mm_and_si128(_mm_or_si128(Block0, Block1), NonASCIIMask);
+				if (_mm_movemask_epi8(_mm_cmpeq_epi16(HighBits, Zero)) != 0xFFFF)
+				{
+					break;
+				}
+			}
+#elif ELDARA_UTF8_NEON
+			for (; Index + 16 <= Count; Index += 16)
+			{
+				const uint16* In = reinterpret_cast<const uint16*>(Chars + Index);
+				if (vmaxvq_u16(vorrq_u16(vld1q_u16(In), vld1q_u16(In + 8))) >= 0x80)
+				{
+					break;
+				}
+			}
+#endif
+		}
+
+		return Index;
+	}
+
+	/**
+	 * Narrow a run of ASCII characters to bytes, 16 per iteration. Stops at the first block with a non-ASCII character.
+	 * @return Number of characters consumed
+	 */
+	FORCEINLINE int32 NarrowASCIIBlocks(const TCHAR* Chars, int32 Count, uint8* Dest)
+	{
+		int32 Index = 0;
+
+		if constexpr (bVectorizeTCHAR)
+		{
+#if ELDARA_UTF8_SSE2
+			const __m128i NonASCIIMask = _mm_set1_epi16(static_cast<int16>(0xFF80));
+			const __m128i Zero = _mm_setzero_si128();
+			for (; Index + 16 <= Count; Index += 16)
+			{
+				const __m128i Block0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Chars + Index));
+				const __m128i Block1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Chars + Index + 8));
+				const __m128i HighBits = _mm_and_si128(_mm_or_si128(Block0, Block1), NonASCIIMask);
+				if (_mm_movemask_epi8(_mm_cmpeq_epi16(HighBits, Zero)) != 0xFFFF)
+				{
+					break;
+				}
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(Dest + Index), _mm_packus_epi16(Block0, Block1));
+			}
+#elif ELDARA_UTF8_NEON
+			for (; Index + 16 <= Count; Index += 16)
+			{
+				const uint16* In = reinterpret_cast<const uint16*>(Chars + Index);
+				const uint16x8_t Block0 = vld1q_u16(In);
+				const uint16x8_t Block1 = vld1q_u16(In + 8);
+				if (vmaxvq_u16(vorrq_u16(Block0, Block1)) >= 0x80)
+				{
+					break;
+				}
+				vst1q_u8(Dest + Index, vcombine_u8(vmovn_u16(Block0), vmovn_u16(Block1)));
+			}
+#endif
+		}
+
+		return Index;
+	}
+
+	/**
+	 * Strict UTF-8 decode (Unicode Table 3-7). Dest must hold ByteCount characters.
+	 * @return Characters written, or INDEX_NONE if the input is malformed
+	 */
+	int32 DecodeInto(const uint8* Src, int32 ByteCount, TCHAR* Dest)
+	{
+		const uint8* In = Src;
+		const uint8* const End = Src + ByteCount;
+		TCHAR* Out = Dest;
+
+		while (In < End)
+		{
+			const uint8 Lead = *In;
+			if (Lead < 0x80)
+			{
+				const int32 Consumed = WidenASCII(In, static_cast<int32>(End - In), Out);
+				In += Consumed;
+				Out += Consumed;
+				continue;
+			}
+
+			int32 TrailCount;
+			uint32 CodePoint;
+			uint8 SecondMin = 0x80;
+			uint8 SecondMax = 0xBF;
+			if (Lead >= 0xC2 && Lead <= 0xDF)
+			{
+				TrailCount = 1;
+				CodePoint = Lead & 0x1F;
+			}
+			else if (Lead >= 0xE0 && Lead <= 0xEF)
+			{
+				TrailCount = 2;
+				CodePoint = Lead & 0x0F;
+				if (Lead == 0xE0)
+				{
+					SecondMin = 0xA0; // Overlong
+				}
+				else if (Lead == 0xED)
+				{
+					SecondMax = 0x9F; // Surrogates
+				}
+			}
+			else if (Lead >= 0xF0 && Lead <= 0xF4)
+			{
+				TrailCount = 3;
+				CodePoint = Lead & 0x07;
+				if (Lead == 0xF0)
+				{
+					SecondMin = 0x90; // Overlong
+				}
+				else if (Lead == 0xF4)
+				{
+					SecondMax = 0x8F; // Past U+10FFFF
+				}
+			}
+			else
+			{
+				return INDEX_NONE;
+			}
+
+			if (End - In <= TrailCount || In[1] < SecondMin || In[1] > SecondMax)
+			{
+				return INDEX_NONE;
+			}
+
+			CodePoint = (CodePoint << 6) | (In[1] & 0x3F);
+			for (int32 Trail = 2; Trail <= TrailCount; ++Trail)
+			{
+				if ((In[Trail] & 0xC0) != 0x80)
+				{
+					return INDEX_NONE;
+				}
+				CodePoint = (CodePoint << 6) | (In[Trail] & 0x3F);
+			}
+			In += TrailCount + 1;
+
+			if constexpr (sizeof(TCHAR) == 2)
+			{
+				if (CodePoint >= 0x10000)
+				{
+					CodePoint -= 0x10000;
+					*Out++ = static_cast<TCHAR>(0xD800 + (CodePoint >> 10));
+					*Out++ = static_cast<TCHAR>(0xDC00 + (CodePoint & 0x3FF));
+					continue;
+				}
+			}
+			*Out++ = static_cast<TCHAR>(CodePoint);
+		}
+
+		return static_cast<int32>(Out - Dest);
+	}
+
+	/** Read one code point starting at Chars[Index], combining surrogate pairs; advances Index */
+	FORCEINLINE uint32 ReadCodePoint(const TCHAR* Chars, int32 Count, int32& Index)
+	{
+		const uint32 Char = static_cast<uint32>(Chars[Index++]);
+		if (IsHighSurrogate(Char))
+		{
+			if (Index < Count && IsLowSurrogate(static_cast<uint32>(Chars[Index])))
+			{
+				const uint32 Low = static_cast<uint32>(Chars[Index++]);
+				return 0x10000 + ((Char - 0xD800) << 10) + (Low - 0xDC00);
+			}
+			return ReplacementChar;
+		}
+		if (IsLowSurrogate(Char) || Char > MaxCodePoint)
+		{
+			return ReplacementChar;
+		}
+		return Char;
+	}
+}
+
+bool EldaraUTF8::Decode(const uint8* Bytes, int32 ByteCount, FString& OutString)
+{
+	if (ByteCount <= 0)
+	{
+		OutString.Reset();
+		return ByteCount == 0;
+	}
+
+	// UTF-8 never produces more UTF-16/UTF-32 units than it has bytes, so decode in place
+	auto& Chars = OutString.GetCharArray();
+	Chars.SetNumUninitialized(ByteCount + 1, EAllowShrinking::No);
+
+	const int32 Written = DecodeInto(Bytes, ByteCount, Chars.GetData());
+	if (Written <= 0)
+	{
+		OutString.Reset();
+		return Written == 0;
+	}
+
+	Chars[Written] = TEXT('\0');
+	Chars.SetNum(Written + 1, EAllowShrinking::No);
+	return true;
+}
+
+int32 EldaraUTF8::EncodedLength(const TCHAR* Chars, int32 CharCount)
+{
+	int32 Index = CountASCIIBlocks(Chars, CharCount);
+	int32 Length = Index;
+
+	while (Index < CharCount)
+	{
+		const uint32 CodePoint = ReadCodePoint(Chars, CharCount, Index);
+		Length += CodePoint < 0x80 ? 1 : CodePoint < 0x800 ? 2 : CodePoint < 0x10000 ? 3 : 4;
+	}
+
+	return Length;
+}
+
+int32 EldaraUTF8::Encode(const TCHAR* Chars, int32 CharCount, uint8* Dest)
+{
+	uint8* Out = Dest;
+	int32 Index = 0;
+
+	while (Index < CharCount)
+	{
+		if (static_cast<uint32>(Chars[Index]) < 0x80)
+		{
+			const int32 Narrowed = NarrowASCIIBlocks(Chars + Index, CharCount - Index, Out);
+			Index += Narrowed;
+			Out += Narrowed;
+			if (Index >= CharCount)
+			{
+				break;
+			}
+		}
+
+		const uint32 CodePoint = ReadCodePoint(Chars, CharCount, Index);
+		if (CodePoint < 0x80)
+		{
+			*Out++ = static_cast<uint8>(CodePoint);
+		}
+		else if (CodePoint < 0x800)
+		{
+			*Out++ = static_cast<uint8>(0xC0 | (CodePoint >> 6));
+			*Out++ = static_cast<uint8>(0x80 | (CodePoint & 0x3F));
+		}
+		else if (CodePoint < 0x10000)
+		{
+			*Out++ = static_cast<uint8>(0xE0 | (CodePoint >> 12));
+			*Out++ = static_cast<uint8>(0x80 | ((CodePoint >> 6) & 0x3F));
+			*Out++ = static_cast<uint8>(0x80 | (CodePoint & 0x3F));
+		}
+		else
+		{
+			*Out++ = static_cast<uint8>(0xF0 | (CodePoint >> 18));
+			*Out++ = static_cast<uint8>(0x80 | ((CodePoint >> 12) & 0x3F));
+			*Out++ = static_cast<uint8>(0x80 | ((CodePoint >> 6) & 0x3F));
+			*Out++ = static_cast<uint8>(0x80 | (CodePoint & 0x3F));
+		}
+	}
+
+	return static_cast<int32>(Out - Dest);
+}
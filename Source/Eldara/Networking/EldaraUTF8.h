@@ -0,0 +1,35 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * UTF-8 <-> TCHAR transcoding for MessagePack strings.
+ *
+ * Input from the wire is validated strictly: overlong forms, surrogate code points,
+ * values past U+10FFFF and truncated sequences are rejected instead of being replaced.
+ * Runs of ASCII (the bulk of names, chat and dialogue) are widened or narrowed 16-32
+ * characters per iteration with SSE2 or NEON; everything else takes a scalar path.
+ */
+namespace EldaraUTF8
+{
+	/**
+	 * Decode UTF-8 bytes into a string
+	 * @param Bytes UTF-8 input
+	 * @param ByteCount Number of input bytes
+	 * @param OutString Receives the decoded string (emptied on failure)
+	 * @return False if the input is not well-formed UTF-8
+	 */
+	ELDARA_API bool Decode(const uint8* Bytes, int32 ByteCount, FString& OutString);
+
+	/**
+	 * Number of bytes Encode will produce for these characters
+	 */
+	ELDARA_API int32 EncodedLength(const TCHAR* Chars, int32 CharCount);
+
+	/**
+	 * Encode characters as UTF-8. Unpaired surrogates are written as U+FFFD.
+	 * @param Dest Output buffer, must hold at least EncodedLength(Chars, CharCount) bytes
+	 * @return Number of bytes written
+	 */
+	ELDARA_API int32 Encode(const TCHAR* Chars, int32 CharCount, uint8* Dest);
+}
@@ -2,6 +2,7 @@
 
 #include "CoreMinimal.h"
 #include "NetworkTypes.h"
+#include "EldaraCharacterDataView.h"
 #include "NetworkPackets.generated.h"
 
 // ============================================================================
@@ -40,6 +41,10 @@ struct FLoginRequest : public FPacketBase
 
 	UPROPERTY(BlueprintReadWrite, Category = "Network")
 	FString ProtocolVersion;
+
+	/** Highest flat binary codec version the client supports (0 = MessagePack only) */
+	UPROPERTY(BlueprintReadWrite, Category = "Network")
+	int32 FlatCodecVersion = 0;
 };
 
 // MessagePack deserialization structures
@@ -83,6 +88,62 @@ struct FLoginResponse : public FPacketBase
 
 	UPROPERTY(BlueprintReadWrite, Category = "Network")
 	FString ServerProtocolVersion;
+
+	/** Flat codec version the server agreed to use for tick-rate packets (0 = MessagePack only) */
+	UPROPERTY(BlueprintReadWrite, Category = "Network")
+	int32 FlatCodecVersion = 0;
+};
+
+/** Client -> server: reclaim a dropped session on a fresh socket */
+USTRUCT(BlueprintType)
+struct FResumeSessionRequest : public FPacketBase
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadWrite, Category = "Network")
+	FString SessionToken;
+
+	UPROPERTY(BlueprintReadWrite, Category = "Network")
+	int64 CharacterId = 0;
+
+	/** Entities still held in the replica store; the server only sends spawns for ones missing here */
+	UPROPERTY(BlueprintReadWrite, Category = "Network")
+	TArray<int64> KnownEntityIds;
+
+	UPROPERTY(BlueprintReadWrite, Category = "Network")
+	FString ProtocolVersion;
+};
+
+/** Server -> client: resume result, followed in the same flight by spawn/movement packets for the delta */
+USTRUCT(BlueprintType)
+struct FResumeSessionResponse : public FPacketBase
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadWrite, Category = "Network")
+	EResponseCode Result = EResponseCode::Success;
+
+	UPROPERTY(BlueprintReadWrite, Category = "Network")
+	FString Message;
+
+	UPROPERTY(BlueprintReadWrite, Category = "Network")
+	int64 AccountId = 0;
+
+	UPROPERTY(BlueprintReadWrite, Category = "Network")
+	int64 PlayerEntityId = 0;
+
+	UPROPERTY(BlueprintReadWrite, Category = "Network")
+	FVector Position = FVector::ZeroVector;
+
+	UPROPERTY(BlueprintReadWrite, Category = "Network")
+	float RotationYaw = 0.0f;
+
+	UPROPERTY(BlueprintReadWrite, Category = "Network")
+	int64 ServerTime = 0;
+
+	/** Known entities that left while the client was away */
+	UPROPERTY(BlueprintReadWrite, Category = "Network")
+	TArray<int64> DespawnedEntityIds;
 };
 
 // ============================================================================
@@ -105,8 +166,12 @@ struct FCharacterListResponse : public FPacketBase
 	UPROPERTY(BlueprintReadWrite, Category = "Network")
 	EResponseCode Result = EResponseCode::Success;
 
+	/** Summaries for Blueprint listeners; empty until decoded from CharacterViews */
 	UPROPERTY(BlueprintReadWrite, Category = "Network")
 	TArray<FCharacterInfo> Characters;
+
+	/** Lazily decoded full CharacterData, one per character; owns the packet's bytes */
+	TArray<FEldaraCharacterDataView> CharacterViews;
 };
 
 USTRUCT(BlueprintType)
@@ -493,6 +558,25 @@ struct FChatMessagePacket : public FPacketBase
 	bool bHasTargetEntityId = false;
 };
 
+/** Client -> server: which remote entities the client currently cares about */
+USTRUCT(BlueprintType)
+struct FInterestUpdatePacket : public FPacketBase
+{
+	GENERATED_BODY()
+
+	/** Radius (cm) inside which the client applies updates at full rate */
+	UPROPERTY(BlueprintReadWrite, Category = "Network")
+	float FullRateRadius = 0.0f;
+
+	/** Radius (cm) beyond which the client ignores updates */
+	UPROPERTY(BlueprintReadWrite, Category = "Network")
+	float InterestRadius = 0.0f;
+
+	/** Entities the client has put to sleep (may be truncated to fit a packet) */
+	UPROPERTY(BlueprintReadWrite, Category = "Network")
+	TArray<int64> DormantEntityIds;
+};
+
 // ============================================================================
 // WORLD PACKETS
 // ============================================================================
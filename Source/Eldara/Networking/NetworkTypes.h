@@ -13,6 +13,8 @@ enum class EPacketType : uint16
 	// Authentication (0-9)
 	LoginRequest = 0,
 	LoginResponse = 1,
+	ResumeSessionRequest = 8,
+	ResumeSessionResponse = 9,
 	
 	// Character Management (2-9)
 	CharacterListRequest = 2,
@@ -48,6 +50,7 @@ enum class EPacketType : uint16
 	EntityUpdate = 104,
 	PlayerSpawn = 105,
 	NPCStateUpdate = 106,
+	InterestUpdate = 107,
 	
 	// Quest (250-299)
 	QuestAcceptRequest = 250,
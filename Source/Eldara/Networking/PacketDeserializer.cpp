@@ -1,5 +1,22 @@
 #include "PacketDeserializer.h"
 #include "MessagePackFormat.h"
+#include "EldaraUTF8.h"
+
+namespace
+{
+	/**
+	 * Restore a nested struct to its defaults while keeping the allocation of one container member,
+	 * so a recycled packet does not free and re-grow it on the next decode
+	 */
+	template<typename StructType, typename ContainerType>
+	void ResetKeepingCapacity(StructType& Value, ContainerType StructType::* Container)
+	{
+		ContainerType Kept = MoveTemp(Value.*Container);
+		Kept.Reset();
+		Value = StructType();
+		Value.*Container = MoveTemp(Kept);
+	}
+}
 
 int32 FPacketDeserializer::ReadPosition = 0;
 
@@ -31,11 +48,11 @@ bool FPacketDeserializer::ReadArrayHeader(const TArray<uint8>& InBytes, int32& O
 	if (!ReadByte(InBytes, Byte))
 		return false;
 	
+	uint32 Count = 0;
 	if ((Byte & 0xf0) == MessagePackFormat::FixArrayMask)
 	{
 		// FixArray: 0x90 - 0x9f
-		OutCount = Byte & 0x0f;
-		return true;
+		Count = Byte & 0x0f;
 	}
 	else if (Byte == MessagePackFormat::Array16)
 	{
@@ -43,8 +60,7 @@ bool FPacketDeserializer::ReadArrayHeader(const TArray<uint8>& InBytes, int32& O
 		uint8 High, Low;
 		if (!ReadByte(InBytes, High) || !ReadByte(InBytes, Low))
 			return false;
-		OutCount = (High << 8) | Low;
-		return true;
+		Count = (static_cast<uint32>(High) << 8) | Low;
 	}
 	else if (Byte == MessagePackFormat::Array32)
 	{
@@ -52,12 +68,24 @@ bool FPacketDeserializer::ReadArrayHeader(const TArray<uint8>& InBytes, int32& O
 		uint8 B1, B2, B3, B4;
 		if (!ReadByte(InBytes, B1) || !ReadByte(InBytes, B2) || !ReadByte(InBytes, B3) || !ReadByte(InBytes, B4))
 			return false;
-		OutCount = (B1 << 24) | (B2 << 16) | (B3 << 8) | B4;
-		return true;
+		Count = (static_cast<uint32>(B1) << 24) | (static_cast<uint32>(B2) << 16) | (static_cast<uint32>(B3) << 8) | B4;
+	}
+	else
+	{
+		UE_LOG(LogTemp, Error, TEXT("PacketDeserializer: Invalid array header byte: 0x%02X"), Byte);
+		return false;
 	}
 	
-	UE_LOG(LogTemp, Error, TEXT("PacketDeserializer: Invalid array header byte: 0x%02X"), Byte);
-	return false;
+	// Every element takes at least one byte, so a larger count is corrupt. Callers size
+	// containers from the count, which must never allocate more than the packet could fill.
+	if (Count > static_cast<uint32>(InBytes.Num() - ReadPosition))
+	{
+		UE_LOG(LogTemp, Error, TEXT("PacketDeserializer: Array count %u exceeds the %d bytes left"), Count, InBytes.Num() - ReadPosition);
+		return false;
+	}
+	
+	OutCount = static_cast<int32>(Count);
+	return true;
 }
 
 bool FPacketDeserializer::ReadInt(const TArray<uint8>& InBytes, int32& OutValue)
@@ -229,6 +257,23 @@ bool FPacketDeserializer::ReadInt64(const TArray<uint8>& InBytes, int64& OutValu
 }
 
 bool FPacketDeserializer::ReadString(const TArray<uint8>& InBytes, FString& OutValue)
+{
+	int32 Length;
+	if (!ReadStringHeader(InBytes, Length))
+		return false;
+	
+	// Decode directly from the packet buffer; malformed UTF-8 from the wire is rejected
+	if (!EldaraUTF8::Decode(InBytes.GetData() + ReadPosition, Length, OutValue))
+	{
+		UE_LOG(LogTemp, Error, TEXT("PacketDeserializer: Malformed UTF-8 in string (%d bytes)"), Length);
+		return false;
+	}
+	
+	ReadPosition += Length;
+	return true;
+}
+
+bool FPacketDeserializer::ReadStringHeader(const TArray<uint8>& InBytes, int32& OutLength)
 {
 	uint8 Byte;
 	if (!ReadByte(InBytes, Byte))
@@ -268,18 +313,13 @@ bool FPacketDeserializer::ReadString(const TArray<uint8>& InBytes, FString& OutV
 		return false;
 	}
 	
-	// Read string bytes
-	TArray<uint8> StrBytes;
-	StrBytes.SetNum(Length);
-	for (int32 i = 0; i < Length; i++)
+	if (Length < 0 || Length > InBytes.Num() - ReadPosition)
 	{
-		if (!ReadByte(InBytes, StrBytes[i]))
-			return false;
+		UE_LOG(LogTemp, Error, TEXT("PacketDeserializer: String length %d exceeds remaining buffer"), Length);
+		return false;
 	}
 	
-	// Convert from UTF-8 to FString
-	FUTF8ToTCHAR Converter(reinterpret_cast<const ANSICHAR*>(StrBytes.GetData()), Length);
-	OutValue = FString(Converter.Length(), Converter.Get());
+	OutLength = Length;
 	return true;
 }
 
@@ -620,7 +660,8 @@ bool FPacketDeserializer::SkipMap(const TArray<uint8>& InBytes, int32 MapSize)
 	return true;
 }
 
-bool FPacketDeserializer::ReadCharacterData(const TArray<uint8>& InBytes, FCharacterInfo& OutCharacter)
+template<typename CharacterType>
+bool FPacketDeserializer::ReadCharacterData(const TArray<uint8>& InBytes, CharacterType& OutCharacter)
 {
 	// CharacterData is array of at least 16 fields
 	// NOTE: This must match the C# server's CharacterData structure in 
@@ -709,12 +750,126 @@ bool FPacketDeserializer::ReadCharacterData(const TArray<uint8>& InBytes, FChara
 			return false;
 	}
 	
-	UE_LOG(LogTemp, Log, TEXT("PacketDeserializer: Successfully read CharacterData - ID: %lld, Name: %s, Race: %d, Class: %d, Level: %d"),
+	UE_LOG(LogTemp, Verbose, TEXT("PacketDeserializer: Successfully read CharacterData - ID: %lld, Name: %s, Race: %d, Class: %d, Level: %d"),
 		OutCharacter.CharacterId, *OutCharacter.Name, (int32)OutCharacter.Race, (int32)OutCharacter.Class, OutCharacter.Level);
 	
 	return true;
 }
 
+bool FPacketDeserializer::ReadCharacterDataView(const TSharedRef<const TArray<uint8>>& InBytes, FEldaraCharacterDataView& OutView)
+{
+	// Same layout as ReadCharacterData; every field is skipped but its start is remembered
+	constexpr int32 MinimumCharacterDataFields = 16;
+	static_assert(static_cast<int32>(FEldaraCharacterDataView::EField::Count) == MinimumCharacterDataFields, "View fields must match CharacterData");
+	
+	const TArray<uint8>& Bytes = *InBytes;
+	int32 FieldCount;
+	if (!ReadArrayHeader(Bytes, FieldCount) || FieldCount < MinimumCharacterDataFields)
+	{
+		UE_LOG(LogTemp, Error, TEXT("PacketDeserializer: Invalid CharacterData field count: %d (expected at least %d)"), FieldCount, MinimumCharacterDataFields);
+		return false;
+	}
+	
+	for (int32 FieldIndex = 0; FieldIndex < FieldCount; FieldIndex++)
+	{
+		if (FieldIndex < MinimumCharacterDataFields)
+		{
+			OutView.FieldOffsets[FieldIndex] = ReadPosition;
+		}
+		
+		if (!SkipValue(Bytes))
+			return false;
+	}
+	
+	OutView.Buffer = InBytes;
+	return true;
+}
+
+bool FPacketDeserializer::TryReadNil(const TArray<uint8>& InBytes)
+{
+	uint8 NextByte;
+	if (!PeekByte(InBytes, NextByte) || NextByte != MessagePackFormat::Nil)
+	{
+		return false;
+	}
+	
+	ReadPosition++;
+	return true;
+}
+
+bool FPacketDeserializer::ReadResourceSnapshot(const TArray<uint8>& InBytes, FResourceSnapshot& OutResources)
+{
+	// ResourceSnapshot: [MaxHealth, CurrentHealth, MaxMana, CurrentMana, MaxStamina, CurrentStamina]
+	constexpr int32 ResourceSnapshotFields = 6;
+	int32 FieldCount;
+	if (!ReadArrayHeader(InBytes, FieldCount) || FieldCount < ResourceSnapshotFields)
+	{
+		UE_LOG(LogTemp, Error, TEXT("PacketDeserializer: Invalid ResourceSnapshot field count: %d"), FieldCount);
+		return false;
+	}
+	
+	if (!ReadInt(InBytes, OutResources.MaxHealth) || !ReadInt(InBytes, OutResources.CurrentHealth) ||
+		!ReadInt(InBytes, OutResources.MaxMana) || !ReadInt(InBytes, OutResources.CurrentMana) ||
+		!ReadInt(InBytes, OutResources.MaxStamina) || !ReadInt(InBytes, OutResources.CurrentStamina))
+	{
+		return false;
+	}
+	
+	return SkipArray(InBytes, FieldCount - ResourceSnapshotFields);
+}
+
+bool FPacketDeserializer::ReadIntArray(const TArray<uint8>& InBytes, TArray<int32>& OutValues)
+{
+	int32 Count;
+	if (!ReadArrayHeader(InBytes, Count))
+		return false;
+	
+	// Keep the existing allocation so reused packets decode without touching the heap
+	OutValues.SetNum(Count, EAllowShrinking::No);
+	for (int32 i = 0; i < Count; i++)
+	{
+		if (!ReadInt(InBytes, OutValues[i]))
+			return false;
+	}
+	return true;
+}
+
+bool FPacketDeserializer::ReadNPCData(const TArray<uint8>& InBytes, FNPCData& OutNPCData)
+{
+	// NPCData: [NPCTemplateId, Name, Level, Faction, IsHostile, IsQuestGiver, IsVendor,
+	//           MaxHealth, CurrentHealth, Resources, AbilityIds]
+	constexpr int32 MinimumNPCDataFields = 11;
+	int32 FieldCount;
+	if (!ReadArrayHeader(InBytes, FieldCount) || FieldCount < MinimumNPCDataFields)
+	{
+		UE_LOG(LogTemp, Error, TEXT("PacketDeserializer: Invalid NPCData field count: %d (expected at least %d)"), FieldCount, MinimumNPCDataFields);
+		return false;
+	}
+	
+	if (!ReadInt(InBytes, OutNPCData.NPCTemplateId))
+		return false;
+	if (!ReadString(InBytes, OutNPCData.Name))
+		return false;
+	if (!ReadInt(InBytes, OutNPCData.Level))
+		return false;
+	
+	int32 FactionInt;
+	if (!ReadInt(InBytes, FactionInt))
+		return false;
+	OutNPCData.Faction = static_cast<EFaction>(FactionInt);
+	
+	if (!ReadBool(InBytes, OutNPCData.bIsHostile) || !ReadBool(InBytes, OutNPCData.bIsQuestGiver) || !ReadBool(InBytes, OutNPCData.bIsVendor))
+		return false;
+	if (!ReadInt(InBytes, OutNPCData.MaxHealth) || !ReadInt(InBytes, OutNPCData.CurrentHealth))
+		return false;
+	if (!ReadResourceSnapshot(InBytes, OutNPCData.Resources))
+		return false;
+	if (!ReadIntArray(InBytes, OutNPCData.AbilityIds))
+		return false;
+	
+	return SkipArray(InBytes, FieldCount - MinimumNPCDataFields);
+}
+
 bool FPacketDeserializer::Deserialize(const TArray<uint8>& InBytes, int32& OutPacketType)
 {
 	ResetReadPosition();
@@ -748,11 +903,12 @@ bool FPacketDeserializer::DeserializeLoginResponse(const TArray<uint8>& InBytes,
 		return false;
 	}
 	
-	// Read field array header (5 fields now)
+	// Read field array header (5 fields, plus FlatCodecVersion from servers that support it)
+	constexpr int32 MinimumLoginResponseFields = 5;
 	int32 FieldCount;
-	if (!ReadArrayHeader(InBytes, FieldCount) || FieldCount != 5)
+	if (!ReadArrayHeader(InBytes, FieldCount) || FieldCount < MinimumLoginResponseFields)
 	{
-		UE_LOG(LogTemp, Error, TEXT("PacketDeserializer: LoginResponse expected 5 fields, got %d"), FieldCount);
+		UE_LOG(LogTemp, Error, TEXT("PacketDeserializer: LoginResponse expected at least %d fields, got %d"), MinimumLoginResponseFields, FieldCount);
 		return false;
 	}
 	
@@ -771,18 +927,89 @@ bool FPacketDeserializer::DeserializeLoginResponse(const TArray<uint8>& InBytes,
 	if (!ReadString(InBytes, OutPacket.ServerProtocolVersion))
 		return false;
 	
+	OutPacket.FlatCodecVersion = 0;
+	if (FieldCount > MinimumLoginResponseFields)
+	{
+		if (!ReadInt(InBytes, OutPacket.FlatCodecVersion))
+			return false;
+		if (!SkipArray(InBytes, FieldCount - MinimumLoginResponseFields - 1))
+			return false;
+	}
+	
 	UE_LOG(LogTemp, Log, TEXT("PacketDeserializer: Deserialized LoginResponse - Result: %d, Message: %s, AccountId: %lld, Protocol: %s"),
 		static_cast<int32>(OutPacket.Result), *OutPacket.Message, OutPacket.AccountId, *OutPacket.ServerProtocolVersion);
 	
 	return true;
 }
 
-bool FPacketDeserializer::DeserializeCharacterListResponse(const TArray<uint8>& InBytes, FCharacterListResponse& OutPacket)
+bool FPacketDeserializer::DeserializeResumeSessionResponse(const TArray<uint8>& InBytes, FResumeSessionResponse& OutPacket)
+{
+	ResetReadPosition();
+	
+	int32 PacketType;
+	if (!Deserialize(InBytes, PacketType) || PacketType != 9)
+	{
+		UE_LOG(LogTemp, Error, TEXT("PacketDeserializer: Expected ResumeSessionResponse (9), got packet type %d"), PacketType);
+		return false;
+	}
+	
+	// Fields: Result, Message, AccountId, PlayerEntityId, Position, RotationYaw, ServerTime, DespawnedEntityIds
+	int32 FieldCount;
+	if (!ReadArrayHeader(InBytes, FieldCount) || FieldCount != 8)
+	{
+		UE_LOG(LogTemp, Error, TEXT("PacketDeserializer: ResumeSessionResponse expected 8 fields, got %d"), FieldCount);
+		return false;
+	}
+	
+	int32 ResultInt;
+	if (!ReadInt(InBytes, ResultInt))
+		return false;
+	OutPacket.Result = static_cast<EResponseCode>(ResultInt);
+	
+	if (!ReadString(InBytes, OutPacket.Message))
+		return false;
+	if (!ReadInt64(InBytes, OutPacket.AccountId))
+		return false;
+	if (!ReadInt64(InBytes, OutPacket.PlayerEntityId))
+		return false;
+	if (!ReadVector(InBytes, OutPacket.Position))
+		return false;
+	if (!ReadFloat(InBytes, OutPacket.RotationYaw))
+		return false;
+	if (!ReadInt64(InBytes, OutPacket.ServerTime))
+		return false;
+	
+	int32 DespawnedCount;
+	if (!ReadArrayHeader(InBytes, DespawnedCount))
+		return false;
+	
+	// ReadArrayHeader bounds the count by the bytes left, so the reserve cannot exceed the packet
+	OutPacket.DespawnedEntityIds.Reset(DespawnedCount);
+	for (int32 Index = 0; Index < DespawnedCount; ++Index)
+	{
+		int64 EntityId;
+		if (!ReadInt64(InBytes, EntityId))
+			return false;
+		OutPacket.DespawnedEntityIds.Add(EntityId);
+	}
+	
+	UE_LOG(LogTemp, Log, TEXT("PacketDeserializer: Deserialized ResumeSessionResponse - Result: %d, PlayerEntityId: %lld, Despawned: %d"),
+		static_cast<int32>(OutPacket.Result), OutPacket.PlayerEntityId, OutPacket.DespawnedEntityIds.Num());
+	
+	return true;
+}
+
+bool FPacketDeserializer::DeserializeCharacterListResponse(TArray<uint8>&& InBytes, FCharacterListResponse& OutPacket)
 {
+	// Characters are indexed rather than decoded; the views share the packet, which is moved
+	// in rather than copied, so the character-select screen decodes fields only when it needs them
+	const TSharedRef<const TArray<uint8>> SharedBytes = MakeShared<TArray<uint8>>(MoveTemp(InBytes));
+	const TArray<uint8>& Bytes = *SharedBytes;
+	
 	ResetReadPosition();
 	
 	int32 PacketType;
-	if (!Deserialize(InBytes, PacketType) || PacketType != 3)
+	if (!Deserialize(Bytes, PacketType) || PacketType != 3)
 	{
 		UE_LOG(LogTemp, Error, TEXT("PacketDeserializer: Expected CharacterListResponse (3), got packet type %d"), PacketType);
 		return false;
@@ -790,7 +1017,7 @@ bool FPacketDeserializer::DeserializeCharacterListResponse(const TArray<uint8>&
 	
 	// Read field array header (2 fields: Result, Characters)
 	int32 FieldCount;
-	if (!ReadArrayHeader(InBytes, FieldCount) || FieldCount != 2)
+	if (!ReadArrayHeader(Bytes, FieldCount) || FieldCount != 2)
 	{
 		UE_LOG(LogTemp, Error, TEXT("PacketDeserializer: CharacterListResponse expected 2 fields, got %d"), FieldCount);
 		return false;
@@ -798,78 +1025,23 @@ bool FPacketDeserializer::DeserializeCharacterListResponse(const TArray<uint8>&
 	
 	// Read Result
 	int32 ResultInt;
-	if (!ReadInt(InBytes, ResultInt))
+	if (!ReadInt(Bytes, ResultInt))
 		return false;
 	OutPacket.Result = static_cast<EResponseCode>(ResultInt);
 	
 	// Read Characters array
 	int32 CharacterCount;
-	if (!ReadArrayHeader(InBytes, CharacterCount))
+	if (!ReadArrayHeader(Bytes, CharacterCount))
 		return false;
 	
-	OutPacket.Characters.Empty();
+	// Summaries are decoded from the views on demand, see UEldaraNetworkSubsystem::DecodeCharacterSummaries.
+	// ReadArrayHeader bounds CharacterCount by the bytes left, so the reserve cannot exceed the packet.
+	OutPacket.Characters.Reset();
+	OutPacket.CharacterViews.Reset(CharacterCount);
 	for (int32 i = 0; i < CharacterCount; i++)
 	{
-		FCharacterInfo CharInfo;
-		
-		// Each CharacterData from C# server has 16 fields:
-		// 0: CharacterId, 1: AccountId, 2: Name, 3: Race, 4: Class, 5: Faction, 6: Level,
-		// 7: ExperiencePoints, 8: Stats, 9: Position, 10: Appearance, 11: Equipment,
-		// 12: FactionStandings, 13: TotemSpirit, 14: CreatedAt, 15: LastPlayedAt
-		// We only need fields: 0, 2, 3, 4, 6
-		int32 CharFieldCount;
-		if (!ReadArrayHeader(InBytes, CharFieldCount))
-		{
-			UE_LOG(LogTemp, Error, TEXT("PacketDeserializer: Failed to read character field array header"));
-			return false;
-		}
-		
-		if (CharFieldCount < 7)
-		{
-			UE_LOG(LogTemp, Error, TEXT("PacketDeserializer: Character has too few fields: %d (expected at least 7)"), CharFieldCount);
-			return false;
-		}
-		
-		// Field 0: CharacterId
-		if (!ReadInt64(InBytes, CharInfo.CharacterId))
+		if (!ReadCharacterDataView(SharedBytes, OutPacket.CharacterViews.AddDefaulted_GetRef()))
 			return false;
-		
-		// Field 1: AccountId (skip)
-		if (!SkipValue(InBytes))
-			return false;
-		
-		// Field 2: Name
-		if (!ReadString(InBytes, CharInfo.Name))
-			return false;
-		
-		// Field 3: Race
-		int32 RaceInt;
-		if (!ReadInt(InBytes, RaceInt))
-			return false;
-		CharInfo.Race = static_cast<ERace>(RaceInt);
-		
-		// Field 4: Class
-		int32 ClassInt;
-		if (!ReadInt(InBytes, ClassInt))
-			return false;
-		CharInfo.Class = static_cast<EClass>(ClassInt);
-		
-		// Field 5: Faction (skip)
-		if (!SkipValue(InBytes))
-			return false;
-		
-		// Field 6: Level
-		if (!ReadInt(InBytes, CharInfo.Level))
-			return false;
-		
-		// Skip remaining fields (7 through CharFieldCount-1)
-		for (int32 FieldIndex = 7; FieldIndex < CharFieldCount; FieldIndex++)
-		{
-			if (!SkipValue(InBytes))
-				return false;
-		}
-		
-		OutPacket.Characters.Add(CharInfo);
 	}
 	
 	UE_LOG(LogTemp, Log, TEXT("PacketDeserializer: Deserialized CharacterListResponse - Result: %d, Characters: %d"), 
@@ -1017,3 +1189,244 @@ bool FPacketDeserializer::DeserializeMovementUpdateResponse(const TArray<uint8>&
 	
 	return true;
 }
+
+bool FPacketDeserializer::DeserializeMovementUpdate(const TArray<uint8>& InBytes, FMovementUpdatePacket& OutPacket)
+{
+	ResetReadPosition();
+	
+	int32 PacketType;
+	if (!Deserialize(InBytes, PacketType) || PacketType != 11)
+	{
+		UE_LOG(LogTemp, Error, TEXT("PacketDeserializer: Expected MovementUpdate (11), got packet type %d"), PacketType);
+		return false;
+	}
+	
+	// Read field array header (7 fields: EntityId, Position, Velocity, RotationYaw, RotationPitch, State, ServerTimestamp)
+	// Verbose only: callers fall back to the legacy 4-field MovementUpdateResponse layout on mismatch
+	int32 FieldCount;
+	if (!ReadArrayHeader(InBytes, FieldCount) || FieldCount != 7)
+	{
+		UE_LOG(LogTemp, Verbose, TEXT("PacketDeserializer: MovementUpdate expected 7 fields, got %d"), FieldCount);
+		return false;
+	}
+	
+	if (!ReadInt64(InBytes, OutPacket.EntityId))
+		return false;
+	if (!ReadVector(InBytes, OutPacket.Position))
+		return false;
+	if (!ReadVector(InBytes, OutPacket.Velocity))
+		return false;
+	if (!ReadFloat(InBytes, OutPacket.RotationYaw))
+		return false;
+	if (!ReadFloat(InBytes, OutPacket.RotationPitch))
+		return false;
+	
+	int32 StateInt;
+	if (!ReadInt(InBytes, StateInt))
+		return false;
+	OutPacket.State = static_cast<EMovementState>(StateInt);
+	
+	if (!ReadInt64(InBytes, OutPacket.ServerTimestamp))
+		return false;
+	
+	UE_LOG(LogTemp, Verbose, TEXT("PacketDeserializer: Deserialized MovementUpdate - EntityId: %lld, Position: %s"),
+		OutPacket.EntityId, *OutPacket.Position.ToString());
+	
+	return true;
+}
+
+bool FPacketDeserializer::DeserializeEntitySpawn(const TArray<uint8>& InBytes, FEntitySpawnPacket& OutPacket)
+{
+	ResetReadPosition();
+	
+	int32 PacketType;
+	if (!Deserialize(InBytes, PacketType) || PacketType != 102)
+	{
+		UE_LOG(LogTemp, Error, TEXT("PacketDeserializer: Expected EntitySpawn (102), got packet type %d"), PacketType);
+		return false;
+	}
+	
+	// Fields: EntityId, Type, Name, Position, RotationYaw, CharacterData?, NPCData?, Resources?, AbilityIds?
+	int32 FieldCount;
+	if (!ReadArrayHeader(InBytes, FieldCount) || FieldCount != 9)
+	{
+		UE_LOG(LogTemp, Error, TEXT("PacketDeserializer: EntitySpawn expected 9 fields, got %d"), FieldCount);
+		return false;
+	}
+	
+	if (!ReadInt64(InBytes, OutPacket.EntityId))
+		return false;
+	
+	int32 TypeInt;
+	if (!ReadInt(InBytes, TypeInt))
+		return false;
+	OutPacket.Type = static_cast<EEntityType>(TypeInt);
+	
+	if (!ReadString(InBytes, OutPacket.Name))
+		return false;
+	if (!ReadVector(InBytes, OutPacket.Position))
+		return false;
+	if (!ReadFloat(InBytes, OutPacket.RotationYaw))
+		return false;
+	
+	// OutPacket may be a recycled instance: absent optionals are reset in place so their
+	// containers keep capacity for the next spawn that carries them
+	
+	// CharacterData (players only) - only the identity fields are kept for remote players
+	OutPacket.bHasCharacterData = !TryReadNil(InBytes);
+	if (OutPacket.bHasCharacterData)
+	{
+		if (!ReadCharacterData(InBytes, OutPacket.CharacterData))
+			return false;
+	}
+	else
+	{
+		ResetKeepingCapacity(OutPacket.CharacterData, &FCharacterData::Name);
+	}
+	
+	OutPacket.bHasNPCData = !TryReadNil(InBytes);
+	if (OutPacket.bHasNPCData)
+	{
+		if (!ReadNPCData(InBytes, OutPacket.NPCData))
+			return false;
+	}
+	else
+	{
+		ResetKeepingCapacity(OutPacket.NPCData, &FNPCData::AbilityIds);
+	}
+	
+	OutPacket.bHasResources = !TryReadNil(InBytes);
+	if (OutPacket.bHasResources)
+	{
+		if (!ReadResourceSnapshot(InBytes, OutPacket.Resources))
+			return false;
+	}
+	else
+	{
+		OutPacket.Resources = FResourceSnapshot();
+	}
+	
+	OutPacket.bHasAbilityIds = !TryReadNil(InBytes);
+	if (OutPacket.bHasAbilityIds)
+	{
+		if (!ReadIntArray(InBytes, OutPacket.AbilityIds))
+			return false;
+	}
+	else
+	{
+		OutPacket.AbilityIds.Reset();
+	}
+	
+	UE_LOG(LogTemp, Verbose, TEXT("PacketDeserializer: Deserialized EntitySpawn - EntityId: %lld, Type: %d, Name: %s"),
+		OutPacket.EntityId, static_cast<int32>(OutPacket.Type), *OutPacket.Name);
+	
+	return true;
+}
+
+bool FPacketDeserializer::DeserializeEntityDespawn(const TArray<uint8>& InBytes, FEntityDespawnPacket& OutPacket)
+{
+	ResetReadPosition();
+	
+	int32 PacketType;
+	if (!Deserialize(InBytes, PacketType) || PacketType != 103)
+	{
+		UE_LOG(LogTemp, Error, TEXT("PacketDeserializer: Expected EntityDespawn (103), got packet type %d"), PacketType);
+		return false;
+	}
+	
+	int32 FieldCount;
+	if (!ReadArrayHeader(InBytes, FieldCount) || FieldCount != 1)
+	{
+		UE_LOG(LogTemp, Error, TEXT("PacketDeserializer: EntityDespawn expected 1 field, got %d"), FieldCount);
+		return false;
+	}
+	
+	if (!ReadInt64(InBytes, OutPacket.EntityId))
+		return false;
+	
+	UE_LOG(LogTemp, Verbose, TEXT("PacketDeserializer: Deserialized EntityDespawn - EntityId: %lld"), OutPacket.EntityId);
+	
+	return true;
+}
+
+bool FPacketDeserializer::DeserializeNPCStateUpdate(const TArray<uint8>& InBytes, FNPCStateUpdatePacket& OutPacket)
+{
+	ResetReadPosition();
+	
+	int32 PacketType;
+	if (!Deserialize(InBytes, PacketType) || PacketType != 106)
+	{
+		UE_LOG(LogTemp, Error, TEXT("PacketDeserializer: Expected NPCStateUpdate (106), got packet type %d"), PacketType);
+		return false;
+	}
+	
+	// Fields: EntityId, State, TargetEntityId?
+	int32 FieldCount;
+	if (!ReadArrayHeader(InBytes, FieldCount) || FieldCount != 3)
+	{
+		UE_LOG(LogTemp, Error, TEXT("PacketDeserializer: NPCStateUpdate expected 3 fields, got %d"), FieldCount);
+		return false;
+	}
+	
+	if (!ReadInt64(InBytes, OutPacket.EntityId))
+		return false;
+	
+	int32 StateInt;
+	if (!ReadInt(InBytes, StateInt))
+		return false;
+	OutPacket.State = static_cast<ENPCState>(StateInt);
+	
+	OutPacket.bHasTargetEntityId = !TryReadNil(InBytes);
+	if (!OutPacket.bHasTargetEntityId)
+	{
+		OutPacket.TargetEntityId = 0;
+	}
+	else if (!ReadInt64(InBytes, OutPacket.TargetEntityId))
+	{
+		return false;
+	}
+	
+	UE_LOG(LogTemp, Verbose, TEXT("PacketDeserializer: Deserialized NPCStateUpdate - EntityId: %lld, State: %d"),
+		OutPacket.EntityId, static_cast<int32>(OutPacket.State));
+	
+	return true;
+}
+
+bool FPacketDeserializer::DeserializeAbilityResult(const TArray<uint8>& InBytes, FAbilityResultPacket& OutPacket)
+{
+	ResetReadPosition();
+	
+	int32 PacketType;
+	if (!Deserialize(InBytes, PacketType) || PacketType != 21)
+	{
+		UE_LOG(LogTemp, Error, TEXT("PacketDeserializer: Expected AbilityResult (21), got packet type %d"), PacketType);
+		return false;
+	}
+	
+	// Fields: Result, CasterEntityId, AbilityId, InputSequence, Message
+	int32 FieldCount;
+	if (!ReadArrayHeader(InBytes, FieldCount) || FieldCount != 5)
+	{
+		UE_LOG(LogTemp, Error, TEXT("PacketDeserializer: AbilityResult expected 5 fields, got %d"), FieldCount);
+		return false;
+	}
+	
+	int32 ResultInt;
+	if (!ReadInt(InBytes, ResultInt))
+		return false;
+	OutPacket.Result = static_cast<EResponseCode>(ResultInt);
+	
+	if (!ReadInt64(InBytes, OutPacket.CasterEntityId))
+		return false;
+	if (!ReadInt(InBytes, OutPacket.AbilityId))
+		return false;
+	if (!ReadInt(InBytes, OutPacket.InputSequence))
+		return false;
+	if (!ReadString(InBytes, OutPacket.Message))
+		return false;
+	
+	UE_LOG(LogTemp, Verbose, TEXT("PacketDeserializer: Deserialized AbilityResult - AbilityId: %d, InputSequence: %d, Result: %d"),
+		OutPacket.AbilityId, OutPacket.InputSequence, static_cast<int32>(OutPacket.Result));
+	
+	return true;
+}
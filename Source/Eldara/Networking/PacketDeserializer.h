@@ -25,14 +25,25 @@ public:
 	
 	/**
 	 * Deserialize specific packet types
+	 * Every field of OutPacket is overwritten, so the receive path can pass recycled instances;
+	 * containers and strings are refilled in place and keep their capacity.
 	 */
 	static bool DeserializeLoginResponse(const TArray<uint8>& InBytes, FLoginResponse& OutPacket);
-	static bool DeserializeCharacterListResponse(const TArray<uint8>& InBytes, FCharacterListResponse& OutPacket);
+	static bool DeserializeResumeSessionResponse(const TArray<uint8>& InBytes, FResumeSessionResponse& OutPacket);
+	/** Takes ownership of InBytes: the character views keep the packet for lazy decoding */
+	static bool DeserializeCharacterListResponse(TArray<uint8>&& InBytes, FCharacterListResponse& OutPacket);
 	static bool DeserializeCreateCharacterResponse(const TArray<uint8>& InBytes, FCreateCharacterResponse& OutPacket);
 	static bool DeserializeSelectCharacterResponse(const TArray<uint8>& InBytes, FSelectCharacterResponse& OutPacket);
 	static bool DeserializeMovementUpdateResponse(const TArray<uint8>& InBytes, FMovementUpdateResponse& OutPacket);
+	static bool DeserializeMovementUpdate(const TArray<uint8>& InBytes, FMovementUpdatePacket& OutPacket);
+	static bool DeserializeEntitySpawn(const TArray<uint8>& InBytes, FEntitySpawnPacket& OutPacket);
+	static bool DeserializeEntityDespawn(const TArray<uint8>& InBytes, FEntityDespawnPacket& OutPacket);
+	static bool DeserializeNPCStateUpdate(const TArray<uint8>& InBytes, FNPCStateUpdatePacket& OutPacket);
+	static bool DeserializeAbilityResult(const TArray<uint8>& InBytes, FAbilityResultPacket& OutPacket);
 
 private:
+	friend class FEldaraCharacterDataView;
+
 	// Current read position in the byte array
 	static int32 ReadPosition;
 	
@@ -43,6 +54,7 @@ private:
 	static bool ReadInt(const TArray<uint8>& InBytes, int32& OutValue);
 	static bool ReadInt64(const TArray<uint8>& InBytes, int64& OutValue);
 	static bool ReadString(const TArray<uint8>& InBytes, FString& OutValue);
+	static bool ReadStringHeader(const TArray<uint8>& InBytes, int32& OutLength);
 	static bool ReadFloat(const TArray<uint8>& InBytes, float& OutValue);
 	static bool ReadBool(const TArray<uint8>& InBytes, bool& OutValue);
 	static bool ReadVector(const TArray<uint8>& InBytes, FVector& OutValue);
@@ -60,9 +72,30 @@ private:
 	static bool SkipArray(const TArray<uint8>& InBytes, int32 ArraySize);
 	
 	/**
-	 * Read CharacterData (full 16-field object)
+	 * Read CharacterData (full 16-field object) into any struct with the identity fields
+	 * (CharacterId, Name, Race, Class, Level), e.g. FCharacterInfo or FCharacterData
+	 */
+	template<typename CharacterType>
+	static bool ReadCharacterData(const TArray<uint8>& InBytes, CharacterType& OutCharacter);
+	
+	/**
+	 * Index a CharacterData object into a lazy view: validates the object and records field offsets
+	 * without decoding them. InBytes must be the buffer the view shares.
+	 */
+	static bool ReadCharacterDataView(const TSharedRef<const TArray<uint8>>& InBytes, FEldaraCharacterDataView& OutView);
+	
+	/**
+	 * Read nested world data objects
+	 */
+	static bool ReadResourceSnapshot(const TArray<uint8>& InBytes, FResourceSnapshot& OutResources);
+	static bool ReadNPCData(const TArray<uint8>& InBytes, FNPCData& OutNPCData);
+	static bool ReadIntArray(const TArray<uint8>& InBytes, TArray<int32>& OutValues);
+	
+	/**
+	 * Consume a nil value if one is next (for C# nullable fields)
+	 * @return true if a nil was consumed
 	 */
-	static bool ReadCharacterData(const TArray<uint8>& InBytes, FCharacterInfo& OutCharacter);
+	static bool TryReadNil(const TArray<uint8>& InBytes);
 	
 	/**
 	 * Helper to peek at a byte without advancing read position
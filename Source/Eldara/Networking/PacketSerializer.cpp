@@ -1,5 +1,6 @@
 #include "PacketSerializer.h"
 #include "MessagePackFormat.h"
+#include "EldaraUTF8.h"
 #include <limits>
 
 bool FPacketSerializer::Serialize(const FPacketBase& Packet, TArray<uint8>& OutBytes)
@@ -46,6 +47,27 @@ bool FPacketSerializer::Serialize(const FPacketBase& Packet, TArray<uint8>& OutB
 			SerializeSelectCharacterRequest(*SelectReq, OutBytes);
 			return true;
 		}
+
+		case 8: // ResumeSessionRequest
+		{
+			const FResumeSessionRequest* ResumeReq = static_cast<const FResumeSessionRequest*>(&Packet);
+			SerializeResumeSessionRequest(*ResumeReq, OutBytes);
+			return true;
+		}
+
+		case 10: // MovementInput
+		{
+			const FMovementInputPacket* MovementInput = static_cast<const FMovementInputPacket*>(&Packet);
+			SerializeMovementInput(*MovementInput, OutBytes);
+			return true;
+		}
+
+		case 107: // InterestUpdate
+		{
+			const FInterestUpdatePacket* InterestUpdate = static_cast<const FInterestUpdatePacket*>(&Packet);
+			SerializeInterestUpdate(*InterestUpdate, OutBytes);
+			return true;
+		}
 		
 		default:
 			UE_LOG(LogTemp, Error, TEXT("PacketSerializer: Serialization not implemented for packet type %d"), PacketType);
@@ -200,9 +222,9 @@ void FPacketSerializer::WriteInt64(TArray<uint8>& OutBytes, int64 Value)
 
 void FPacketSerializer::WriteString(TArray<uint8>& OutBytes, const FString& Value)
 {
-	// Convert FString to UTF-8
-	FTCHARToUTF8 UTF8String(*Value);
-	int32 Length = UTF8String.Length();
+	// Size the UTF-8 payload first so the header can be written ahead of it
+	const int32 CharCount = Value.Len();
+	const int32 Length = EldaraUTF8::EncodedLength(*Value, CharCount);
 	
 	// Write string header
 	if (Length <= 31)
@@ -233,11 +255,9 @@ void FPacketSerializer::WriteString(TArray<uint8>& OutBytes, const FString& Valu
 		OutBytes.Add(Length & 0xFF);
 	}
 	
-	// Write string data
-	for (int32 i = 0; i < Length; ++i)
-	{
-		OutBytes.Add(static_cast<uint8>(UTF8String.Get()[i]));
-	}
+	// Encode straight into the output buffer
+	const int32 Offset = OutBytes.AddUninitialized(Length);
+	EldaraUTF8::Encode(*Value, CharCount, OutBytes.GetData() + Offset);
 }
 
 void FPacketSerializer::WriteFloat(TArray<uint8>& OutBytes, float Value)
@@ -278,16 +298,17 @@ void FPacketSerializer::SerializeLoginRequest(const FLoginRequest& Packet, TArra
 	// Write union key (0 for LoginRequest)
 	WriteInt(OutBytes, 0);
 	
-	// Write inner array header (4 fields: Username, PasswordHash, ClientVersion, ProtocolVersion)
+	// Write inner array header (5 fields: Username, PasswordHash, ClientVersion, ProtocolVersion, FlatCodecVersion)
 	// Note: Timestamp and SequenceNumber are NOT serialized because the C# server
 	// has [IgnoreMember] on these fields in PacketBase
-	WriteArrayHeader(OutBytes, 4);
+	WriteArrayHeader(OutBytes, 5);
 	
 	// Write fields in order (matching C# LoginRequest [Key] attributes)
 	WriteString(OutBytes, Packet.Username);      // [Key(0)]
 	WriteString(OutBytes, Packet.PasswordHash);  // [Key(1)]
 	WriteString(OutBytes, Packet.ClientVersion); // [Key(2)]
 	WriteString(OutBytes, Packet.ProtocolVersion); // [Key(3)]
+	WriteInt(OutBytes, Packet.FlatCodecVersion); // [Key(4)]
 	
 	UE_LOG(LogTemp, Log, TEXT("PacketSerializer: Serialized LoginRequest (Size: %d bytes)"), OutBytes.Num());
 }
@@ -305,8 +326,12 @@ int32 FPacketSerializer::GetPacketTypeFromInstance(const FPacketBase& Packet)
 		return 4;
 	if (StructType == FSelectCharacterRequest::StaticStruct())
 		return 6;
+	if (StructType == FResumeSessionRequest::StaticStruct())
+		return 8;
 	if (StructType == FMovementInputPacket::StaticStruct())
 		return 10;
+	if (StructType == FInterestUpdatePacket::StaticStruct())
+		return 107;
 	
 	return -1;
 }
@@ -370,3 +395,77 @@ void FPacketSerializer::SerializeSelectCharacterRequest(const FSelectCharacterRe
 	
 	UE_LOG(LogTemp, Log, TEXT("PacketSerializer: Serialized SelectCharacterRequest (Size: %d bytes)"), OutBytes.Num());
 }
+
+void FPacketSerializer::SerializeResumeSessionRequest(const FResumeSessionRequest& Packet, TArray<uint8>& OutBytes)
+{
+	// Wire format: [ UnionKey, [ SessionToken, CharacterId, [ KnownEntityIds... ], ProtocolVersion ] ]
+	
+	WriteArrayHeader(OutBytes, 2);
+	WriteInt(OutBytes, 8); // Packet ID for ResumeSessionRequest
+	WriteArrayHeader(OutBytes, 4); // 4 fields
+	
+	WriteString(OutBytes, Packet.SessionToken);
+	WriteInt64(OutBytes, Packet.CharacterId);
+	
+	WriteArrayHeader(OutBytes, Packet.KnownEntityIds.Num());
+	for (const int64 EntityId : Packet.KnownEntityIds)
+	{
+		WriteInt64(OutBytes, EntityId);
+	}
+	
+	WriteString(OutBytes, Packet.ProtocolVersion);
+	
+	UE_LOG(LogTemp, Log, TEXT("PacketSerializer: Serialized ResumeSessionRequest (%d known entities, Size: %d bytes)"),
+		Packet.KnownEntityIds.Num(), OutBytes.Num());
+}
+
+void FPacketSerializer::SerializeInterestUpdate(const FInterestUpdatePacket& Packet, TArray<uint8>& OutBytes)
+{
+	// Wire format: [ UnionKey, [ FullRateRadius, InterestRadius, [ DormantEntityIds... ] ] ]
+	
+	WriteArrayHeader(OutBytes, 2);
+	WriteInt(OutBytes, 107); // Packet ID for InterestUpdate
+	WriteArrayHeader(OutBytes, 3); // 3 fields
+	
+	WriteFloat(OutBytes, Packet.FullRateRadius);
+	WriteFloat(OutBytes, Packet.InterestRadius);
+	
+	WriteArrayHeader(OutBytes, Packet.DormantEntityIds.Num());
+	for (const int64 EntityId : Packet.DormantEntityIds)
+	{
+		WriteInt64(OutBytes, EntityId);
+	}
+	
+	UE_LOG(LogTemp, Verbose, TEXT("PacketSerializer: Serialized InterestUpdate (%d dormant, Size: %d bytes)"),
+		Packet.DormantEntityIds.Num(), OutBytes.Num());
+}
+
+void FPacketSerializer::SerializeMovementInput(const FMovementInputPacket& Packet, TArray<uint8>& OutBytes)
+{
+	// Wire format: [ UnionKey, [ InputSequence, DeltaTime, Input, PredictedPosition, PredictedRotationYaw ] ]
+	// Input: [ Forward, Strafe, Jump, Sprint, LookYaw, LookPitch ], PredictedPosition: [ X, Y, Z ]
+	
+	WriteArrayHeader(OutBytes, 2);
+	WriteInt(OutBytes, 10); // Packet ID for MovementInput
+	WriteArrayHeader(OutBytes, 5); // 5 fields
+	
+	WriteInt(OutBytes, Packet.InputSequence);
+	WriteFloat(OutBytes, Packet.DeltaTime);
+	
+	WriteArrayHeader(OutBytes, 6);
+	WriteFloat(OutBytes, Packet.Input.Forward);
+	WriteFloat(OutBytes, Packet.Input.Strafe);
+	WriteBool(OutBytes, Packet.Input.bJump);
+	WriteBool(OutBytes, Packet.Input.bSprint);
+	WriteFloat(OutBytes, Packet.Input.LookYaw);
+	WriteFloat(OutBytes, Packet.Input.LookPitch);
+	
+	WriteArrayHeader(OutBytes, 3);
+	WriteFloat(OutBytes, static_cast<float>(Packet.PredictedPosition.X));
+	WriteFloat(OutBytes, static_cast<float>(Packet.PredictedPosition.Y));
+	WriteFloat(OutBytes, static_cast<float>(Packet.PredictedPosition.Z));
+	
+	WriteFloat(OutBytes, Packet.PredictedRotationYaw);
+	
+	UE_LOG(LogTemp, VeryVerbose, TEXT("PacketSerializer: Serialized MovementInput (Size: %d bytes)"), OutBytes.Num());
+}
@@ -50,6 +50,21 @@ public:
 			SerializeSelectCharacterRequest(static_cast<const FSelectCharacterRequest&>(Packet), OutBytes);
 			return true;
 		}
+		else if constexpr (std::is_same_v<T, FResumeSessionRequest>)
+		{
+			SerializeResumeSessionRequest(static_cast<const FResumeSessionRequest&>(Packet), OutBytes);
+			return true;
+		}
+		else if constexpr (std::is_same_v<T, FInterestUpdatePacket>)
+		{
+			SerializeInterestUpdate(static_cast<const FInterestUpdatePacket&>(Packet), OutBytes);
+			return true;
+		}
+		else if constexpr (std::is_same_v<T, FMovementInputPacket>)
+		{
+			SerializeMovementInput(static_cast<const FMovementInputPacket&>(Packet), OutBytes);
+			return true;
+		}
 		// Add more packet types here as they are implemented
 		// else if constexpr (std::is_same_v<T, FCharacterListRequest>)
 		// {
@@ -129,6 +144,9 @@ private:
 	static void SerializeCharacterListRequest(const FCharacterListRequest& Packet, TArray<uint8>& OutBytes);
 	static void SerializeCreateCharacterRequest(const FCreateCharacterRequest& Packet, TArray<uint8>& OutBytes);
 	static void SerializeSelectCharacterRequest(const FSelectCharacterRequest& Packet, TArray<uint8>& OutBytes);
+	static void SerializeResumeSessionRequest(const FResumeSessionRequest& Packet, TArray<uint8>& OutBytes);
+	static void SerializeInterestUpdate(const FInterestUpdatePacket& Packet, TArray<uint8>& OutBytes);
+	static void SerializeMovementInput(const FMovementInputPacket& Packet, TArray<uint8>& OutBytes);
 
 	/**
 	 * Determine the packet type from the base packet
@@ -0,0 +1,193 @@
+#include "EldaraActorPoolSubsystem.h"
+#include "Eldara/AI/EldaraAIController.h"
+#include "Eldara/Characters/EldaraCharacterBase.h"
+#include "Components/ActorComponent.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "Engine/World.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogEldaraPool, Log, All);
+
+void UEldaraActorPoolSubsystem::Deinitialize()
+{
+	// Parked actors belong to the world and are torn down with it
+	Buckets.Reset();
+	Super::Deinitialize();
+}
+
+bool UEldaraActorPoolSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+AActor* UEldaraActorPoolSubsystem::AcquireActor(TSubclassOf<AActor> ActorClass, const FTransform& SpawnTransform, bool& bOutReused)
+{
+	bOutReused = false;
+	if (!ActorClass)
+	{
+		return nullptr;
+	}
+
+	FEldaraActorPoolBucket& Bucket = Buckets.FindOrAdd(ActorClass.Get());
+
+	// Parked actors can be destroyed behind our back (level streaming, editor), skip those
+	while (Bucket.ParkedActors.Num() > 0)
+	{
+		AActor* Actor = Bucket.ParkedActors.Pop(EAllowShrinking::No);
+		Bucket.Stats.Parked = Bucket.ParkedActors.Num();
+		if (IsValid(Actor))
+		{
+			UnparkActor(Actor, SpawnTransform);
+			++Bucket.Stats.Hits;
+			bOutReused = true;
+			return Actor;
+		}
+	}
+
+	++Bucket.Stats.Misses;
+	return SpawnNewActor(ActorClass.Get(), SpawnTransform);
+}
+
+void UEldaraActorPoolSubsystem::ReleaseActor(AActor* Actor)
+{
+	if (!IsValid(Actor))
+	{
+		return;
+	}
+
+	FEldaraActorPoolBucket& Bucket = Buckets.FindOrAdd(Actor->GetClass());
+	if (!ensureMsgf(!Bucket.ParkedActors.Contains(Actor), TEXT("ReleaseActor: %s released twice"), *Actor->GetName()))
+	{
+		return;
+	}
+
+	++Bucket.Stats.Releases;
+
+	if (Bucket.ParkedActors.Num() >= MaxPooledPerClass)
+	{
+		++Bucket.Stats.Evictions;
+		Actor->Destroy();
+		return;
+	}
+
+	ParkActor(Actor);
+	Bucket.ParkedActors.Add(Actor);
+	Bucket.Stats.Parked = Bucket.ParkedActors.Num();
+}
+
+void UEldaraActorPoolSubsystem::Prewarm(TSubclassOf<AActor> ActorClass, int32 Count)
+{
+	if (!ActorClass)
+	{
+		return;
+	}
+
+	FEldaraActorPoolBucket& Bucket = Buckets.FindOrAdd(ActorClass.Get());
+	const int32 TargetCount = FMath::Min(Count, MaxPooledPerClass);
+	while (Bucket.ParkedActors.Num() < TargetCount)
+	{
+		AActor* Actor = SpawnNewActor(ActorClass.Get(), FTransform::Identity);
+		if (!Actor)
+		{
+			UE_LOG(LogEldaraPool, Warning, TEXT("Prewarm: failed to spawn %s"), *ActorClass->GetName());
+			break;
+		}
+
+		ParkActor(Actor);
+		Bucket.ParkedActors.Add(Actor);
+	}
+	Bucket.Stats.Parked = Bucket.ParkedActors.Num();
+}
+
+FEldaraActorPoolStats UEldaraActorPoolSubsystem::GetTotalStats() const
+{
+	FEldaraActorPoolStats Total;
+	for (const TPair<TObjectPtr<UClass>, FEldaraActorPoolBucket>& Pair : Buckets)
+	{
+		const FEldaraActorPoolStats& Stats = Pair.Value.Stats;
+		Total.Hits += Stats.Hits;
+		Total.Misses += Stats.Misses;
+		Total.Releases += Stats.Releases;
+		Total.Evictions += Stats.Evictions;
+		Total.Parked += Stats.Parked;
+	}
+	return Total;
+}
+
+FEldaraActorPoolStats UEldaraActorPoolSubsystem::GetClassStats(TSubclassOf<AActor> ActorClass) const
+{
+	const FEldaraActorPoolBucket* Bucket = ActorClass ? Buckets.Find(ActorClass.Get()) : nullptr;
+	return Bucket ? Bucket->Stats : FEldaraActorPoolStats();
+}
+
+AActor* UEldaraActorPoolSubsystem::SpawnNewActor(UClass* ActorClass, const FTransform& SpawnTransform) const
+{
+	UWorld* World = GetWorld();
+	if (!World)
+	{
+		return nullptr;
+	}
+
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+	return World->SpawnActor<AActor>(ActorClass, SpawnTransform, SpawnParams);
+}
+
+void UEldaraActorPoolSubsystem::ParkActor(AActor* Actor) const
+{
+	if (APawn* Pawn = Cast<APawn>(Actor))
+	{
+		if (AEldaraAIController* AIController = Cast<AEldaraAIController>(Pawn->GetController()))
+		{
+			AIController->SuspendForPool();
+		}
+	}
+
+	if (ACharacter* Character = Cast<ACharacter>(Actor))
+	{
+		if (UCharacterMovementComponent* MovementComponent = Character->GetCharacterMovement())
+		{
+			MovementComponent->StopMovementImmediately();
+			MovementComponent->DisableMovement();
+		}
+	}
+
+	Actor->SetActorHiddenInGame(true);
+	Actor->SetActorEnableCollision(false);
+	Actor->SetActorTickEnabled(false);
+	for (UActorComponent* Component : Actor->GetComponents())
+	{
+		Component->SetComponentTickEnabled(false);
+	}
+}
+
+void UEldaraActorPoolSubsystem::UnparkActor(AActor* Actor, const FTransform& SpawnTransform) const
+{
+	Actor->SetActorLocationAndRotation(SpawnTransform.GetLocation(), SpawnTransform.GetRotation(), false, nullptr, ETeleportType::ResetPhysics);
+
+	// Restore tick state to what the class asked for at construction
+	Actor->SetActorTickEnabled(Actor->PrimaryActorTick.bStartWithTickEnabled);
+	for (UActorComponent* Component : Actor->GetComponents())
+	{
+		Component->SetComponentTickEnabled(Component->PrimaryComponentTick.bStartWithTickEnabled);
+	}
+
+	Actor->SetActorEnableCollision(true);
+	Actor->SetActorHiddenInGame(false);
+
+	if (AEldaraCharacterBase* Character = Cast<AEldaraCharacterBase>(Actor))
+	{
+		if (UCharacterMovementComponent* MovementComponent = Character->GetCharacterMovement())
+		{
+			MovementComponent->SetDefaultMovementMode();
+		}
+		Character->ResetForReuse();
+	}
+
+	if (APawn* Pawn = Cast<APawn>(Actor))
+	{
+		if (AEldaraAIController* AIController = Cast<AEldaraAIController>(Pawn->GetController()))
+		{
+			AIController->ResumeFromPool();
+		}
+	}
+}
@@ -0,0 +1,115 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "EldaraActorPoolSubsystem.generated.h"
+
+/** Pool usage counters (per class and aggregated) */
+USTRUCT(BlueprintType)
+struct FEldaraActorPoolStats
+{
+	GENERATED_BODY()
+
+	/** Acquire calls served from a parked actor */
+	UPROPERTY(BlueprintReadOnly, Category = "Pool")
+	int32 Hits = 0;
+
+	/** Acquire calls that had to spawn a new actor */
+	UPROPERTY(BlueprintReadOnly, Category = "Pool")
+	int32 Misses = 0;
+
+	/** Actors returned to the pool */
+	UPROPERTY(BlueprintReadOnly, Category = "Pool")
+	int32 Releases = 0;
+
+	/** Released actors destroyed because the pool was full */
+	UPROPERTY(BlueprintReadOnly, Category = "Pool")
+	int32 Evictions = 0;
+
+	/** Actors currently parked */
+	UPROPERTY(BlueprintReadOnly, Category = "Pool")
+	int32 Parked = 0;
+
+	float GetHitRate() const
+	{
+		const int32 Acquires = Hits + Misses;
+		return Acquires > 0 ? static_cast<float>(Hits) / Acquires : 0.0f;
+	}
+};
+
+/** Parked actors of one class */
+USTRUCT()
+struct FEldaraActorPoolBucket
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<TObjectPtr<AActor>> ParkedActors;
+
+	FEldaraActorPoolStats Stats;
+};
+
+/**
+ * Reuses actors for entities that repeatedly enter and leave relevance.
+ *
+ * Released actors are hidden, have collision/tick/movement disabled and stay in the
+ * world instead of being destroyed. Pawns keep their AI controller possessed; the
+ * controller only stops its behavior tree and perception, so reuse skips
+ * UObject construction, component registration and possession. On acquire the
+ * actor is teleported, re-enabled and its character state reset for the new entity.
+ */
+UCLASS(Config=Game)
+class ELDARA_API UEldaraActorPoolSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	/**
+	 * Get an actor of the given class, reusing a parked one when available
+	 * @param ActorClass Exact class to acquire
+	 * @param SpawnTransform Where the actor should appear
+	 * @param bOutReused True if the actor came from the pool
+	 * @return The active actor, or nullptr if spawning failed
+	 */
+	AActor* AcquireActor(TSubclassOf<AActor> ActorClass, const FTransform& SpawnTransform, bool& bOutReused);
+
+	/** Return an actor to the pool (destroyed instead when its class pool is full) */
+	UFUNCTION(BlueprintCallable, Category = "Eldara|Pool")
+	void ReleaseActor(AActor* Actor);
+
+	/** Spawn and park actors ahead of time (e.g. during zone load) */
+	UFUNCTION(BlueprintCallable, Category = "Eldara|Pool")
+	void Prewarm(TSubclassOf<AActor> ActorClass, int32 Count);
+
+	/** Counters summed over every class */
+	UFUNCTION(BlueprintPure, Category = "Eldara|Pool")
+	FEldaraActorPoolStats GetTotalStats() const;
+
+	/** Counters for one class */
+	UFUNCTION(BlueprintPure, Category = "Eldara|Pool")
+	FEldaraActorPoolStats GetClassStats(TSubclassOf<AActor> ActorClass) const;
+
+	/** Fraction of acquires served from the pool (0-1) */
+	UFUNCTION(BlueprintPure, Category = "Eldara|Pool")
+	float GetHitRate() const { return GetTotalStats().GetHitRate(); }
+
+protected:
+	/** Maximum parked actors kept per class */
+	UPROPERTY(Config, EditDefaultsOnly, Category = "Pool")
+	int32 MaxPooledPerClass = 64;
+
+	UPROPERTY()
+	TMap<TObjectPtr<UClass>, FEldaraActorPoolBucket> Buckets;
+
+private:
+	AActor* SpawnNewActor(UClass* ActorClass, const FTransform& SpawnTransform) const;
+
+	/** Hide and disable an actor so it costs nothing while parked */
+	void ParkActor(AActor* Actor) const;
+
+	/** Re-enable a parked actor at a new transform and reset its gameplay state */
+	void UnparkActor(AActor* Actor, const FTransform& SpawnTransform) const;
+};
@@ -0,0 +1,289 @@
+#include "EldaraEntityRelevanceSubsystem.h"
+#include "EldaraEntitySpawnSubsystem.h"
+#include "Eldara/Networking/EldaraNetworkSubsystem.h"
+#include "Eldara/Networking/EldaraEntityReplicaStore.h"
+#include "Camera/PlayerCameraManager.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+
+namespace
+{
+	constexpr float DefaultFOVDegrees = 90.0f;
+	constexpr float MaxHalfConeDegrees = 89.0f;
+	constexpr float ConvergedDistanceSq = 1.0f;
+}
+
+void UEldaraEntityRelevanceSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	if (UGameInstance* GameInstance = InWorld.GetGameInstance())
+	{
+		NetworkSubsystem = GameInstance->GetSubsystem<UEldaraNetworkSubsystem>();
+	}
+	SpawnSubsystem = InWorld.GetSubsystem<UEldaraEntitySpawnSubsystem>();
+}
+
+bool UEldaraEntityRelevanceSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId UEldaraEntityRelevanceSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UEldaraEntityRelevanceSubsystem, STATGROUP_Tickables);
+}
+
+void UEldaraEntityRelevanceSubsystem::Tick(float DeltaTime)
+{
+	if (!NetworkSubsystem.IsValid())
+	{
+		return;
+	}
+
+	const double Now = GetWorld()->GetTimeSeconds();
+	if (Now >= NextClassifyTime)
+	{
+		ClassifyEntities(Now);
+		NextClassifyTime = Now + ClassifyInterval;
+	}
+
+	ApplyEntityState(DeltaTime, Now);
+	ReportInterest(Now);
+}
+
+EEldaraRelevanceTier UEldaraEntityRelevanceSubsystem::GetEntityTier(int64 EntityId) const
+{
+	const UEldaraNetworkSubsystem* Network = NetworkSubsystem.Get();
+	if (!Network)
+	{
+		return EEldaraRelevanceTier::Dormant;
+	}
+
+	const FEldaraEntityHandle Handle = Network->GetEntityReplicas().FindHandle(EntityId);
+	if (!SlotStates.IsValidIndex(Handle.SlotIndex))
+	{
+		return EEldaraRelevanceTier::Dormant;
+	}
+
+	const FEntityRelevanceState& State = SlotStates[Handle.SlotIndex];
+	return State.bInitialized && State.Generation == Handle.Generation ? State.Tier : EEldaraRelevanceTier::Dormant;
+}
+
+void UEldaraEntityRelevanceSubsystem::ClassifyEntities(double Now)
+{
+	const APlayerController* PlayerController = GetWorld()->GetFirstPlayerController();
+	if (!PlayerController)
+	{
+		return;
+	}
+
+	FVector ViewLocation;
+	FRotator ViewRotation;
+	PlayerController->GetPlayerViewPoint(ViewLocation, ViewRotation);
+
+	const float FOVDegrees = PlayerController->PlayerCameraManager ? PlayerController->PlayerCameraManager->GetFOVAngle() : DefaultFOVDegrees;
+	const float HalfConeDegrees = FMath::Min(FOVDegrees * 0.5f + ViewConeMarginDegrees, MaxHalfConeDegrees);
+	const float CosHalfConeSq = FMath::Square(FMath::Cos(FMath::DegreesToRadians(HalfConeDegrees)));
+	const FVector ViewForward = ViewRotation.Vector();
+
+	const float AlwaysFullRadiusSq = FMath::Square(AlwaysFullRadius);
+	const float FullRadiusSq = FMath::Square(FullRadius);
+	const float ReducedRadiusSq = FMath::Square(ReducedRadius);
+
+	const FEldaraEntityReplicaStore& Replicas = NetworkSubsystem->GetEntityReplicas();
+	const TConstArrayView<FVector> Positions = Replicas.GetPositions();
+	const TConstArrayView<int64> EntityIds = Replicas.GetEntityIds();
+	UEldaraEntitySpawnSubsystem* Spawner = SpawnSubsystem.Get();
+
+	TierCounts[0] = TierCounts[1] = TierCounts[2] = 0;
+	++ClassifyPass;
+
+	for (int32 DenseIndex = 0; DenseIndex < Replicas.Num(); ++DenseIndex)
+	{
+		const FEldaraEntityHandle Handle = Replicas.GetHandleAt(DenseIndex);
+		if (Handle.SlotIndex >= SlotStates.Num())
+		{
+			SlotStates.SetNum(Handle.SlotIndex + 1);
+		}
+
+		FEntityRelevanceState& State = SlotStates[Handle.SlotIndex];
+		bool bNewEntity = false;
+		if (!State.bInitialized || State.Generation != Handle.Generation)
+		{
+			// Slot was reused by a new entity; the previous one left the dormant set if it was in it
+			bInterestDirty |= State.bInitialized && State.Tier == EEldaraRelevanceTier::Dormant;
+			State = FEntityRelevanceState();
+			State.Generation = Handle.Generation;
+			State.bInitialized = true;
+			bNewEntity = true;
+		}
+		State.LastClassifyPass = ClassifyPass;
+
+		const FVector Offset = Positions[DenseIndex] - ViewLocation;
+		const float DistanceSq = Offset.SizeSquared();
+
+		EEldaraRelevanceTier NewTier = EEldaraRelevanceTier::Dormant;
+		if (DistanceSq <= AlwaysFullRadiusSq)
+		{
+			NewTier = EEldaraRelevanceTier::Full;
+		}
+		else
+		{
+			// Cone test without a sqrt: dot > 0 and dot^2 >= cos^2 * |offset|^2
+			const float Dot = FVector::DotProduct(Offset, ViewForward);
+			const bool bInView = Dot > 0.0f && Dot * Dot >= CosHalfConeSq * DistanceSq;
+
+			if (bInView && DistanceSq <= FullRadiusSq)
+			{
+				NewTier = EEldaraRelevanceTier::Full;
+			}
+			else if ((bInView && DistanceSq <= ReducedRadiusSq) || DistanceSq <= FullRadiusSq)
+			{
+				NewTier = EEldaraRelevanceTier::Reduced;
+			}
+		}
+
+		// New entities start Dormant, so one that stays Dormant joins the dormant set without a tier change
+		bInterestDirty |= bNewEntity && NewTier == EEldaraRelevanceTier::Dormant;
+
+		if (NewTier != State.Tier)
+		{
+			if (State.Tier == EEldaraRelevanceTier::Dormant || NewTier == EEldaraRelevanceTier::Dormant)
+			{
+				bInterestDirty = true;
+			}
+
+			// Coming out of dormancy: jump straight to the latest coalesced state
+			if (State.Tier == EEldaraRelevanceTier::Dormant)
+			{
+				State.bNeedsSnap = true;
+				State.NextApplyTime = Now;
+			}
+			State.Tier = NewTier;
+		}
+
+		if (NewTier != EEldaraRelevanceTier::Dormant && !State.Actor.IsValid() && Spawner)
+		{
+			State.Actor = Spawner->FindEntityActor(EntityIds[DenseIndex]);
+		}
+
+		++TierCounts[static_cast<int32>(NewTier)];
+	}
+
+	// Entities not seen this pass have despawned; a dormant one leaves the dormant set
+	for (FEntityRelevanceState& State : SlotStates)
+	{
+		if (State.bInitialized && State.LastClassifyPass != ClassifyPass)
+		{
+			bInterestDirty |= State.Tier == EEldaraRelevanceTier::Dormant;
+			State = FEntityRelevanceState();
+		}
+	}
+}
+
+void UEldaraEntityRelevanceSubsystem::ApplyEntityState(float DeltaTime, double Now)
+{
+	const FEldaraEntityReplicaStore& Replicas = NetworkSubsystem->GetEntityReplicas();
+	const TConstArrayView<FVector> Positions = Replicas.GetPositions();
+	const TConstArrayView<float> Yaws = Replicas.GetRotationYaws();
+	const TConstArrayView<int64> Timestamps = Replicas.GetServerTimestamps();
+
+	for (int32 DenseIndex = 0; DenseIndex < Replicas.Num(); ++DenseIndex)
+	{
+		const FEldaraEntityHandle Handle = Replicas.GetHandleAt(DenseIndex);
+		if (!SlotStates.IsValidIndex(Handle.SlotIndex))
+		{
+			continue;
+		}
+
+		FEntityRelevanceState& State = SlotStates[Handle.SlotIndex];
+		if (!State.bInitialized || State.Generation != Handle.Generation || State.Tier == EEldaraRelevanceTier::Dormant)
+		{
+			continue;
+		}
+
+		const bool bHasNewSample = Timestamps[DenseIndex] != State.AppliedTimestamp;
+		if (State.Tier == EEldaraRelevanceTier::Reduced)
+		{
+			if (Now < State.NextApplyTime)
+			{
+				continue;
+			}
+			State.NextApplyTime = Now + ReducedApplyInterval;
+
+			// Reduced entities never interpolate: apply the latest coalesced sample in one step
+			State.bNeedsSnap |= bHasNewSample;
+			if (!State.bNeedsSnap)
+			{
+				continue;
+			}
+		}
+		else if (!bHasNewSample && State.bConverged && !State.bNeedsSnap)
+		{
+			continue;
+		}
+
+		AActor* Actor = State.Actor.Get();
+		if (!Actor)
+		{
+			continue;
+		}
+
+		const FVector TargetLocation = Positions[DenseIndex];
+		const FRotator TargetRotation(0.0f, Yaws[DenseIndex], 0.0f);
+		State.AppliedTimestamp = Timestamps[DenseIndex];
+
+		if (State.bNeedsSnap)
+		{
+			Actor->SetActorLocationAndRotation(TargetLocation, TargetRotation, false, nullptr, ETeleportType::TeleportPhysics);
+			State.bNeedsSnap = false;
+			State.bConverged = true;
+			continue;
+		}
+
+		const FVector NewLocation = FMath::VInterpTo(Actor->GetActorLocation(), TargetLocation, DeltaTime, InterpSpeed);
+		const FRotator NewRotation = FMath::RInterpTo(Actor->GetActorRotation(), TargetRotation, DeltaTime, InterpSpeed);
+		Actor->SetActorLocationAndRotation(NewLocation, NewRotation);
+		State.bConverged = FVector::DistSquared(NewLocation, TargetLocation) <= ConvergedDistanceSq;
+	}
+}
+
+void UEldaraEntityRelevanceSubsystem::ReportInterest(double Now)
+{
+	if (!bInterestDirty || Now < NextInterestReportTime)
+	{
+		return;
+	}
+
+	UEldaraNetworkSubsystem* Network = NetworkSubsystem.Get();
+	if (!Network || !Network->IsConnected())
+	{
+		return;
+	}
+
+	const FEldaraEntityReplicaStore& Replicas = Network->GetEntityReplicas();
+	const TConstArrayView<int64> EntityIds = Replicas.GetEntityIds();
+
+	TArray<int64> DormantEntityIds;
+	DormantEntityIds.Reserve(TierCounts[static_cast<int32>(EEldaraRelevanceTier::Dormant)]);
+	for (int32 DenseIndex = 0; DenseIndex < Replicas.Num(); ++DenseIndex)
+	{
+		const FEldaraEntityHandle Handle = Replicas.GetHandleAt(DenseIndex);
+		if (!SlotStates.IsValidIndex(Handle.SlotIndex))
+		{
+			continue;
+		}
+
+		const FEntityRelevanceState& State = SlotStates[Handle.SlotIndex];
+		if (State.bInitialized && State.Generation == Handle.Generation && State.Tier == EEldaraRelevanceTier::Dormant)
+		{
+			DormantEntityIds.Add(EntityIds[DenseIndex]);
+		}
+	}
+
+	Network->SendInterestUpdate(FullRadius, ReducedRadius, DormantEntityIds);
+	bInterestDirty = false;
+	NextInterestReportTime = Now + InterestReportInterval;
+}
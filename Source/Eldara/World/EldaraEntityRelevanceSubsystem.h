@@ -0,0 +1,119 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "EldaraEntityRelevanceSubsystem.generated.h"
+
+class UEldaraNetworkSubsystem;
+class UEldaraEntitySpawnSubsystem;
+
+/** How often a remote entity's replicated state is pushed to its actor */
+UENUM(BlueprintType)
+enum class EEldaraRelevanceTier : uint8
+{
+	/** Near or on screen: smoothed every frame */
+	Full,
+	/** Visible but far, or close behind the camera: snapped at a low rate */
+	Reduced,
+	/** Out of interest: no per-frame work until promoted */
+	Dormant
+};
+
+/**
+ * Client-side area-of-interest filter for remote entities.
+ *
+ * Movement updates always land in the entity replica store (latest sample wins), so
+ * skipped frames coalesce for free. This subsystem periodically classifies every
+ * replica into a tier by distance and view cone, then pushes store state to actors at
+ * the tier's rate: Full entities interpolate each frame, Reduced entities snap at a
+ * fixed interval, Dormant entities cost nothing and snap to the latest state when
+ * promoted. The dormant set is reported to the server so it can filter upstream.
+ */
+UCLASS(Config=Game)
+class ELDARA_API UEldaraEntityRelevanceSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	/** Current tier of an entity (Dormant if unknown) */
+	UFUNCTION(BlueprintPure, Category = "Eldara|Relevance")
+	EEldaraRelevanceTier GetEntityTier(int64 EntityId) const;
+
+	/** Number of entities in a tier as of the last classification pass */
+	UFUNCTION(BlueprintPure, Category = "Eldara|Relevance")
+	int32 GetTierCount(EEldaraRelevanceTier Tier) const { return TierCounts[static_cast<int32>(Tier)]; }
+
+protected:
+	/** Entities inside this radius (cm) are always Full, even behind the camera */
+	UPROPERTY(Config, EditDefaultsOnly, Category = "Relevance")
+	float AlwaysFullRadius = 1500.0f;
+
+	/** On-screen entities inside this radius (cm) are Full */
+	UPROPERTY(Config, EditDefaultsOnly, Category = "Relevance")
+	float FullRadius = 5000.0f;
+
+	/** On-screen entities inside this radius (cm) are Reduced; beyond it everything is Dormant */
+	UPROPERTY(Config, EditDefaultsOnly, Category = "Relevance")
+	float ReducedRadius = 15000.0f;
+
+	/** Extra degrees added to the camera half-FOV so entities at the screen edge do not pop */
+	UPROPERTY(Config, EditDefaultsOnly, Category = "Relevance")
+	float ViewConeMarginDegrees = 15.0f;
+
+	/** Seconds between classification passes */
+	UPROPERTY(Config, EditDefaultsOnly, Category = "Relevance")
+	float ClassifyInterval = 0.25f;
+
+	/** Seconds between applies for Reduced entities */
+	UPROPERTY(Config, EditDefaultsOnly, Category = "Relevance")
+	float ReducedApplyInterval = 0.2f;
+
+	/** Interpolation speed for Full entities */
+	UPROPERTY(Config, EditDefaultsOnly, Category = "Relevance")
+	float InterpSpeed = 12.0f;
+
+	/** Minimum seconds between interest reports to the server */
+	UPROPERTY(Config, EditDefaultsOnly, Category = "Relevance")
+	float InterestReportInterval = 1.0f;
+
+private:
+	/** Per-entity relevance state, indexed by replica slot (validated by generation) */
+	struct FEntityRelevanceState
+	{
+		uint32 Generation = 0;
+		bool bInitialized = false;
+		EEldaraRelevanceTier Tier = EEldaraRelevanceTier::Dormant;
+		bool bNeedsSnap = true;
+		bool bConverged = false;
+		double NextApplyTime = 0.0;
+		int64 AppliedTimestamp = -1;
+		/** Classification pass that last saw this entity; older means it despawned */
+		uint32 LastClassifyPass = 0;
+		TWeakObjectPtr<AActor> Actor;
+	};
+
+	/** Reassign tiers for every replica from the current viewpoint */
+	void ClassifyEntities(double Now);
+
+	/** Push replica state to actors according to tier */
+	void ApplyEntityState(float DeltaTime, double Now);
+
+	/** Send the dormant set upstream if it changed */
+	void ReportInterest(double Now);
+
+	TWeakObjectPtr<UEldaraNetworkSubsystem> NetworkSubsystem;
+	TWeakObjectPtr<UEldaraEntitySpawnSubsystem> SpawnSubsystem;
+
+	TArray<FEntityRelevanceState> SlotStates;
+	int32 TierCounts[3] = { 0, 0, 0 };
+
+	uint32 ClassifyPass = 0;
+	double NextClassifyTime = 0.0;
+	double NextInterestReportTime = 0.0;
+	bool bInterestDirty = false;
+};
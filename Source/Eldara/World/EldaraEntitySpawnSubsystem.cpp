@@ -0,0 +1,417 @@
+#include "EldaraEntitySpawnSubsystem.h"
+#include "EldaraActorPoolSubsystem.h"
+#include "Eldara/Networking/EldaraNetworkSubsystem.h"
+#include "Eldara/Networking/EldaraEntityReplicaStore.h"
+#include "Eldara/Characters/EldaraCharacterBase.h"
+#include "Eldara/Characters/EldaraNPCBase.h"
+#include "Eldara/Characters/EldaraEnemyBase.h"
+#include "Engine/AssetManager.h"
+#include "Engine/StreamableManager.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/PlatformTime.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogEldaraSpawn, Log, All);
+
+void UEldaraEntitySpawnSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	UGameInstance* GameInstance = InWorld.GetGameInstance();
+	UEldaraNetworkSubsystem* Network = GameInstance ? GameInstance->GetSubsystem<UEldaraNetworkSubsystem>() : nullptr;
+	if (!Network)
+	{
+		return;
+	}
+
+	NetworkSubsystem = Network;
+	EntitySpawnHandle = Network->OnEntitySpawnNative.AddUObject(this, &UEldaraEntitySpawnSubsystem::HandleEntitySpawn);
+	Network->OnEntityDespawn.AddDynamic(this, &UEldaraEntitySpawnSubsystem::HandleEntityDespawn);
+	LastPriorityOrigin = GetPriorityOrigin();
+}
+
+void UEldaraEntitySpawnSubsystem::Deinitialize()
+{
+	if (UEldaraNetworkSubsystem* Network = NetworkSubsystem.Get())
+	{
+		Network->OnEntitySpawnNative.Remove(EntitySpawnHandle);
+		Network->OnEntityDespawn.RemoveDynamic(this, &UEldaraEntitySpawnSubsystem::HandleEntityDespawn);
+	}
+
+	for (TPair<FSoftObjectPath, TSharedPtr<FStreamableHandle>>& Pair : ClassLoadHandles)
+	{
+		if (Pair.Value.IsValid())
+		{
+			Pair.Value->CancelHandle();
+		}
+	}
+
+	ClassLoadHandles.Reset();
+	WaitingForClass.Reset();
+	PendingSpawns.Reset();
+	SpawnQueue.Reset();
+	MaterializedActors.Reset();
+
+	Super::Deinitialize();
+}
+
+bool UEldaraEntitySpawnSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId UEldaraEntitySpawnSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UEldaraEntitySpawnSubsystem, STATGROUP_Tickables);
+}
+
+void UEldaraEntitySpawnSubsystem::Tick(float DeltaTime)
+{
+	LastFrameSpawnCount = 0;
+	LastFrameSpawnMs = 0.0;
+
+	if (SpawnQueue.Num() == 0)
+	{
+		return;
+	}
+
+	RefreshPriorities();
+
+	const double StartTime = FPlatformTime::Seconds();
+	const double BudgetSeconds = FMath::Max(0.0f, SpawnBudgetMs) / 1000.0;
+	const int32 SpawnCap = FMath::Max(1, MaxSpawnsPerFrame);
+
+	while (SpawnQueue.Num() > 0 && LastFrameSpawnCount < SpawnCap)
+	{
+		// Always make progress: the budget only applies after the first spawn
+		if (LastFrameSpawnCount > 0 && FPlatformTime::Seconds() - StartTime >= BudgetSeconds)
+		{
+			break;
+		}
+
+		FSpawnQueueEntry Entry;
+		SpawnQueue.HeapPop(Entry, FSpawnQueuePredicate(), EAllowShrinking::No);
+
+		// Cancelled by a despawn or superseded by a newer spawn for the same id
+		const FPendingEntitySpawn* Pending = PendingSpawns.Find(Entry.EntityId);
+		if (!Pending || Pending->Sequence != Entry.Sequence)
+		{
+			continue;
+		}
+
+		UClass* ActorClass = Pending->ActorClass.Get();
+		if (AActor* Actor = ActorClass ? MaterializeEntity(Entry.EntityId, *Pending, ActorClass) : nullptr)
+		{
+			MaterializedActors.Add(Entry.EntityId, Actor);
+		}
+		else
+		{
+			UE_LOG(LogEldaraSpawn, Warning, TEXT("Failed to materialize entity %lld"), Entry.EntityId);
+		}
+
+		PendingSpawns.Remove(Entry.EntityId);
+		++LastFrameSpawnCount;
+	}
+
+	LastFrameSpawnMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+	UE_LOG(LogEldaraSpawn, VeryVerbose, TEXT("Materialized %d entities in %.2f ms (%d pending)"),
+		LastFrameSpawnCount, LastFrameSpawnMs, PendingSpawns.Num());
+}
+
+void UEldaraEntitySpawnSubsystem::EnqueueSpawn(const FEntitySpawnPacket& Packet)
+{
+	// A spawn for an entity that already has an actor is a resync; the replica store
+	// already refreshed its state, so just keep the existing actor
+	if (const TWeakObjectPtr<AActor>* Existing = MaterializedActors.Find(Packet.EntityId))
+	{
+		if (Existing->IsValid())
+		{
+			return;
+		}
+		MaterializedActors.Remove(Packet.EntityId);
+	}
+
+	const TSoftClassPtr<AActor> ActorClass = ResolveActorClass(Packet);
+	if (ActorClass.IsNull())
+	{
+		UE_LOG(LogEldaraSpawn, Verbose, TEXT("No actor class for entity %lld (type %d); replica only"),
+			Packet.EntityId, static_cast<int32>(Packet.Type));
+		return;
+	}
+
+	FPendingEntitySpawn& Pending = PendingSpawns.FindOrAdd(Packet.EntityId);
+	Pending.Position = Packet.Position;
+	Pending.RotationYaw = Packet.RotationYaw;
+	Pending.Level = Packet.bHasNPCData ? Packet.NPCData.Level : (Packet.bHasCharacterData ? Packet.CharacterData.Level : INDEX_NONE);
+	Pending.Resources = Packet.Resources;
+	Pending.bHasResources = Packet.bHasResources;
+	Pending.bHasNPCHealth = !Packet.bHasResources && Packet.bHasNPCData;
+	if (Pending.bHasNPCHealth)
+	{
+		Pending.Resources.CurrentHealth = Packet.NPCData.CurrentHealth;
+	}
+	Pending.ActorClass = ActorClass;
+	Pending.Sequence = NextSequence++;
+	Pending.bHostile = Packet.Type == EEntityType::Monster || (Packet.bHasNPCData && Packet.NPCData.bIsHostile);
+
+	if (ActorClass.Get())
+	{
+		PushToQueue(Packet.EntityId, Pending);
+		return;
+	}
+
+	// Class not resident yet: park the request and stream the class in the background
+	const FSoftObjectPath ClassPath = ActorClass.ToSoftObjectPath();
+	WaitingForClass.FindOrAdd(ClassPath).Add(Packet.EntityId);
+
+	if (!ClassLoadHandles.Contains(ClassPath))
+	{
+		FStreamableManager& Streamable = UAssetManager::GetStreamableManager();
+		TSharedPtr<FStreamableHandle> Handle = Streamable.RequestAsyncLoad(ClassPath,
+			FStreamableDelegate::CreateUObject(this, &UEldaraEntitySpawnSubsystem::OnActorClassLoaded, ClassPath));
+		ClassLoadHandles.Add(ClassPath, Handle);
+	}
+}
+
+bool UEldaraEntitySpawnSubsystem::CancelOrDespawn(int64 EntityId)
+{
+	// Not materialized yet: dropping the request is enough, stale heap entries are skipped on pop
+	if (PendingSpawns.Remove(EntityId) > 0)
+	{
+		return true;
+	}
+
+	TWeakObjectPtr<AActor> Actor;
+	if (MaterializedActors.RemoveAndCopyValue(EntityId, Actor))
+	{
+		if (AActor* LiveActor = Actor.Get())
+		{
+			// Park instead of destroying so the next entity of this class skips spawn cost
+			if (UEldaraActorPoolSubsystem* Pool = GetWorld() ? GetWorld()->GetSubsystem<UEldaraActorPoolSubsystem>() : nullptr)
+			{
+				Pool->ReleaseActor(LiveActor);
+			}
+			else
+			{
+				LiveActor->Destroy();
+			}
+		}
+		return true;
+	}
+
+	return false;
+}
+
+AActor* UEldaraEntitySpawnSubsystem::FindEntityActor(int64 EntityId) const
+{
+	const TWeakObjectPtr<AActor>* Actor = MaterializedActors.Find(EntityId);
+	return Actor ? Actor->Get() : nullptr;
+}
+
+void UEldaraEntitySpawnSubsystem::HandleEntitySpawn(const FEntitySpawnPacket& Packet)
+{
+	EnqueueSpawn(Packet);
+}
+
+void UEldaraEntitySpawnSubsystem::HandleEntityDespawn(int64 EntityId)
+{
+	CancelOrDespawn(EntityId);
+}
+
+void UEldaraEntitySpawnSubsystem::PushToQueue(int64 EntityId, const FPendingEntitySpawn& Pending)
+{
+	FSpawnQueueEntry Entry;
+	Entry.EntityId = EntityId;
+	Entry.Sequence = Pending.Sequence;
+	Entry.bHostile = Pending.bHostile;
+	Entry.DistanceSq = FVector::DistSquared(GetEntityLocation(EntityId, Pending), LastPriorityOrigin);
+	SpawnQueue.HeapPush(Entry, FSpawnQueuePredicate());
+}
+
+void UEldaraEntitySpawnSubsystem::OnActorClassLoaded(FSoftObjectPath ClassPath)
+{
+	ClassLoadHandles.Remove(ClassPath);
+
+	TArray<int64> EntityIds;
+	if (!WaitingForClass.RemoveAndCopyValue(ClassPath, EntityIds))
+	{
+		return;
+	}
+
+	for (const int64 EntityId : EntityIds)
+	{
+		// Entities despawned while their class was loading are simply gone from PendingSpawns
+		if (const FPendingEntitySpawn* Pending = PendingSpawns.Find(EntityId))
+		{
+			if (Pending->ActorClass.Get())
+			{
+				PushToQueue(EntityId, *Pending);
+			}
+			else
+			{
+				UE_LOG(LogEldaraSpawn, Warning, TEXT("Actor class %s failed to load for entity %lld"),
+					*ClassPath.ToString(), EntityId);
+				PendingSpawns.Remove(EntityId);
+			}
+		}
+	}
+}
+
+void UEldaraEntitySpawnSubsystem::RefreshPriorities()
+{
+	const FVector Origin = GetPriorityOrigin();
+	if (FVector::DistSquared(Origin, LastPriorityOrigin) < FMath::Square(ReprioritizeDistance))
+	{
+		return;
+	}
+
+	LastPriorityOrigin = Origin;
+
+	// Compact out stale entries while re-scoring so the heap does not accumulate garbage
+	for (int32 Index = SpawnQueue.Num() - 1; Index >= 0; --Index)
+	{
+		FSpawnQueueEntry& Entry = SpawnQueue[Index];
+		const FPendingEntitySpawn* Pending = PendingSpawns.Find(Entry.EntityId);
+		if (!Pending || Pending->Sequence != Entry.Sequence)
+		{
+			SpawnQueue.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+			continue;
+		}
+
+		Entry.DistanceSq = FVector::DistSquared(GetEntityLocation(Entry.EntityId, *Pending), Origin);
+	}
+
+	SpawnQueue.Heapify(FSpawnQueuePredicate());
+}
+
+AActor* UEldaraEntitySpawnSubsystem::MaterializeEntity(int64 EntityId, const FPendingEntitySpawn& Pending, UClass* ActorClass)
+{
+	UWorld* World = GetWorld();
+	if (!World)
+	{
+		return nullptr;
+	}
+
+	// Spawn at the latest known state; movement updates may have arrived while queued
+	FVector Location = Pending.Position;
+	float Yaw = Pending.RotationYaw;
+	ENPCState NPCState = ENPCState::Idle;
+	const FString* Name = nullptr;
+	if (const FEldaraEntityReplicaStore* Replicas = GetReplicaStore())
+	{
+		const int32 DenseIndex = Replicas->GetDenseIndex(EntityId);
+		if (DenseIndex != INDEX_NONE)
+		{
+			Location = Replicas->GetPositions()[DenseIndex];
+			Yaw = Replicas->GetRotationYaws()[DenseIndex];
+			NPCState = Replicas->GetNPCStates()[DenseIndex];
+			Name = &Replicas->GetNames()[DenseIndex];
+		}
+	}
+
+	const FTransform SpawnTransform(FRotator(0.0f, Yaw, 0.0f), Location);
+	AActor* Actor = nullptr;
+	if (UEldaraActorPoolSubsystem* Pool = World->GetSubsystem<UEldaraActorPoolSubsystem>())
+	{
+		bool bReused = false;
+		Actor = Pool->AcquireActor(ActorClass, SpawnTransform, bReused);
+	}
+	else
+	{
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+		Actor = World->SpawnActor<AActor>(ActorClass, SpawnTransform, SpawnParams);
+	}
+
+	if (!Actor)
+	{
+		return nullptr;
+	}
+
+	if (AEldaraCharacterBase* Character = Cast<AEldaraCharacterBase>(Actor))
+	{
+		if (Name)
+		{
+			Character->SetCharacterName(*Name);
+		}
+		if (Pending.Level != INDEX_NONE)
+		{
+			Character->SetLevel(Pending.Level);
+		}
+
+		// A reused actor was reset to full vitals; the entity may be wounded
+		const FResourceSnapshot& Resources = Pending.Resources;
+		if (Pending.bHasResources)
+		{
+			Character->SetVitals(Resources.CurrentHealth, Resources.CurrentMana, Resources.CurrentStamina);
+		}
+		else if (Pending.bHasNPCHealth)
+		{
+			Character->SetVitals(Resources.CurrentHealth, Character->GetResource(), Character->GetStamina());
+		}
+	}
+
+	if (AEldaraNPCBase* NPC = Cast<AEldaraNPCBase>(Actor))
+	{
+		NPC->ApplyServerState(static_cast<EEldaraNPCServerState>(NPCState));
+	}
+
+	return Actor;
+}
+
+TSoftClassPtr<AActor> UEldaraEntitySpawnSubsystem::ResolveActorClass(const FEntitySpawnPacket& Packet) const
+{
+	if (Packet.bHasNPCData)
+	{
+		if (const TSoftClassPtr<AActor>* TemplateClass = NPCTemplateActorClasses.Find(Packet.NPCData.NPCTemplateId))
+		{
+			return *TemplateClass;
+		}
+	}
+
+	if (const TSoftClassPtr<AActor>* TypeClass = EntityActorClasses.Find(Packet.Type))
+	{
+		return *TypeClass;
+	}
+
+	switch (Packet.Type)
+	{
+	case EEntityType::Player:
+		return TSoftClassPtr<AActor>(AEldaraCharacterBase::StaticClass());
+	case EEntityType::NPC:
+		return TSoftClassPtr<AActor>(AEldaraNPCBase::StaticClass());
+	case EEntityType::Monster:
+		return TSoftClassPtr<AActor>(AEldaraEnemyBase::StaticClass());
+	default:
+		return TSoftClassPtr<AActor>();
+	}
+}
+
+FVector UEldaraEntitySpawnSubsystem::GetEntityLocation(int64 EntityId, const FPendingEntitySpawn& Pending) const
+{
+	if (const FEldaraEntityReplicaStore* Replicas = GetReplicaStore())
+	{
+		const int32 DenseIndex = Replicas->GetDenseIndex(EntityId);
+		if (DenseIndex != INDEX_NONE)
+		{
+			return Replicas->GetPositions()[DenseIndex];
+		}
+	}
+	return Pending.Position;
+}
+
+FVector UEldaraEntitySpawnSubsystem::GetPriorityOrigin() const
+{
+	const UWorld* World = GetWorld();
+	const APlayerController* PlayerController = World ? World->GetFirstPlayerController() : nullptr;
+	const APawn* Pawn = PlayerController ? PlayerController->GetPawn() : nullptr;
+	return Pawn ? Pawn->GetActorLocation() : LastPriorityOrigin;
+}
+
+const FEldaraEntityReplicaStore* UEldaraEntitySpawnSubsystem::GetReplicaStore() const
+{
+	const UEldaraNetworkSubsystem* Network = NetworkSubsystem.Get();
+	return Network ? &Network->GetEntityReplicas() : nullptr;
+}
@@ -0,0 +1,171 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Eldara/Networking/NetworkPackets.h"
+#include "EldaraEntitySpawnSubsystem.generated.h"
+
+class UEldaraNetworkSubsystem;
+class FEldaraEntityReplicaStore;
+struct FStreamableHandle;
+
+/**
+ * Turns EntitySpawn packets into actors without hitching.
+ *
+ * Spawn packets arrive in bursts (zone entry can deliver hundreds at once), so the
+ * receive path only queues a request here. Each frame the scheduler materializes
+ * the highest-priority requests (hostile first, then nearest to the local player)
+ * until the per-frame millisecond budget is spent. Actor classes are streamed in
+ * asynchronously and a request only becomes eligible once its class is loaded.
+ * A despawn for an entity that has not been materialized yet just drops the request.
+ */
+UCLASS(Config=Game)
+class ELDARA_API UEldaraEntitySpawnSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual void Deinitialize() override;
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	/** Queue an entity for materialization (re-queueing an id supersedes the old request) */
+	void EnqueueSpawn(const FEntitySpawnPacket& Packet);
+
+	/**
+	 * Cancel a pending spawn or destroy the materialized actor for an entity
+	 * @return True if anything was cancelled or destroyed
+	 */
+	bool CancelOrDespawn(int64 EntityId);
+
+	/** Actor materialized for an entity, or nullptr if none (yet) */
+	UFUNCTION(BlueprintPure, Category = "Eldara|Spawning")
+	AActor* FindEntityActor(int64 EntityId) const;
+
+	/** Number of spawn requests not yet materialized (queued or waiting for assets) */
+	UFUNCTION(BlueprintPure, Category = "Eldara|Spawning")
+	int32 GetPendingSpawnCount() const { return PendingSpawns.Num(); }
+
+	UFUNCTION(BlueprintPure, Category = "Eldara|Spawning")
+	int32 GetMaterializedCount() const { return MaterializedActors.Num(); }
+
+protected:
+	/** Time budget per frame for actor spawning (at least one spawn always runs) */
+	UPROPERTY(Config, EditDefaultsOnly, Category = "Spawning")
+	float SpawnBudgetMs = 2.0f;
+
+	/** Hard cap on spawns per frame regardless of budget */
+	UPROPERTY(Config, EditDefaultsOnly, Category = "Spawning")
+	int32 MaxSpawnsPerFrame = 16;
+
+	/** Re-score queued requests once the local player has moved this far (cm) */
+	UPROPERTY(Config, EditDefaultsOnly, Category = "Spawning")
+	float ReprioritizeDistance = 1000.0f;
+
+	/** Actor class per entity type; unset types fall back to the Eldara base classes */
+	UPROPERTY(Config, EditDefaultsOnly, Category = "Spawning")
+	TMap<EEntityType, TSoftClassPtr<AActor>> EntityActorClasses;
+
+	/** Per-template overrides for NPCs and monsters (NPCData.NPCTemplateId -> class) */
+	UPROPERTY(Config, EditDefaultsOnly, Category = "Spawning")
+	TMap<int32, TSoftClassPtr<AActor>> NPCTemplateActorClasses;
+
+private:
+	/**
+	 * A spawn request that has not been materialized yet. Only the packet fields the actor
+	 * needs are kept; the name and latest transform come from the replica store, so queueing
+	 * a spawn copies no strings or arrays.
+	 */
+	struct FPendingEntitySpawn
+	{
+		/** Spawn transform, used if the replica store no longer has the entity */
+		FVector Position = FVector::ZeroVector;
+		float RotationYaw = 0.0f;
+
+		/** Level from the NPC or character data; INDEX_NONE if the packet had neither */
+		int32 Level = INDEX_NONE;
+
+		/** Vitals: a full snapshot if the packet had one, else NPC health only */
+		FResourceSnapshot Resources;
+		bool bHasResources = false;
+		bool bHasNPCHealth = false;
+
+		TSoftClassPtr<AActor> ActorClass;
+		uint32 Sequence = 0;
+		bool bHostile = false;
+	};
+
+	/** Heap entry; stale entries (cancelled/superseded) are skipped when popped */
+	struct FSpawnQueueEntry
+	{
+		int64 EntityId = 0;
+		uint32 Sequence = 0;
+		bool bHostile = false;
+		double DistanceSq = 0.0;
+	};
+
+	/** Orders the heap: hostile first, then nearest, then oldest */
+	struct FSpawnQueuePredicate
+	{
+		bool operator()(const FSpawnQueueEntry& A, const FSpawnQueueEntry& B) const
+		{
+			if (A.bHostile != B.bHostile)
+			{
+				return A.bHostile;
+			}
+			if (A.DistanceSq != B.DistanceSq)
+			{
+				return A.DistanceSq < B.DistanceSq;
+			}
+			return A.Sequence < B.Sequence;
+		}
+	};
+
+	void HandleEntitySpawn(const FEntitySpawnPacket& Packet);
+
+	UFUNCTION()
+	void HandleEntityDespawn(int64 EntityId);
+
+	/** Push a request onto the priority heap (its class must be loaded) */
+	void PushToQueue(int64 EntityId, const FPendingEntitySpawn& Pending);
+
+	/** Async load completion: move waiting requests for this class into the heap */
+	void OnActorClassLoaded(FSoftObjectPath ClassPath);
+
+	/** Re-score the heap when the player has moved far enough */
+	void RefreshPriorities();
+
+	/** Spawn the actor for a request whose class is loaded */
+	AActor* MaterializeEntity(int64 EntityId, const FPendingEntitySpawn& Pending, UClass* ActorClass);
+
+	/** Pick the actor class for a spawn packet */
+	TSoftClassPtr<AActor> ResolveActorClass(const FEntitySpawnPacket& Packet) const;
+
+	/** Current position for an entity: latest replica state if known, else the spawn packet's */
+	FVector GetEntityLocation(int64 EntityId, const FPendingEntitySpawn& Pending) const;
+
+	/** Local player pawn location used for distance priority */
+	FVector GetPriorityOrigin() const;
+
+	const FEldaraEntityReplicaStore* GetReplicaStore() const;
+
+	TWeakObjectPtr<UEldaraNetworkSubsystem> NetworkSubsystem;
+	FDelegateHandle EntitySpawnHandle;
+
+	TMap<int64, FPendingEntitySpawn> PendingSpawns;
+	TMap<int64, TWeakObjectPtr<AActor>> MaterializedActors;
+	TArray<FSpawnQueueEntry> SpawnQueue;
+
+	/** Requests whose actor class is still streaming in, keyed by class path */
+	TMap<FSoftObjectPath, TArray<int64>> WaitingForClass;
+	TMap<FSoftObjectPath, TSharedPtr<FStreamableHandle>> ClassLoadHandles;
+
+	FVector LastPriorityOrigin = FVector::ZeroVector;
+	uint32 NextSequence = 1;
+
+	/** Last frame stats for profiling the zone-entry ramp */
+	int32 LastFrameSpawnCount = 0;
+	double LastFrameSpawnMs = 0.0;
+};